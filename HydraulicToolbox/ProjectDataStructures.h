@@ -1,6 +1,8 @@
 #ifndef PROJECTDATASTRUCTURES_H
 #define PROJECTDATASTRUCTURES_H
 
+#include "CalculationInputs.h"
+#include "UncertaintyAnalyzer.h"
 #include <QString>
 
 struct ProjectData
@@ -10,19 +12,15 @@ struct ProjectData
     bool useUsCustomary{true};
 };
 
-struct GeometryData
+// Monte Carlo band for normal depth. Off until the user enables it, since
+// each run costs the full sample count of normal-depth solves. A Fixed
+// distribution stands for the value entered for that input.
+struct UncertaintyData
 {
-    QString channelType;
-    double bottomWidth{0.0};
-    double sideSlope{0.0};
-    double length{0.0};
-    double bedSlope{0.0};
-};
-
-struct HydraulicData
-{
-    double discharge{0.0};
-    double manningN{0.0};
+    bool isEnabled{false};
+    Distribution manningN;
+    Distribution discharge;
+    Distribution bedSlope;
 };
 
 #endif // PROJECTDATASTRUCTURES_H
@@ -1,59 +1,163 @@
 #include "Analyzer.h"
 #include "Channel.h"
-#include "Flow.h"
-#include <cmath>
+#include "CompoundSection.h"
+#include <algorithm>
 
-AnalysisResult Analyzer::solve_for_depth(Channel& channel, const Flow& flow, double slope, double manningsCoefficient, double gravity) const
+FlowRegime classify_flow_regime(double froudeNumber)
 {
-    AnalysisResult result;
+    if (froudeNumber < 0.99)
+        return FlowRegime::Subcritical;
+    else if (froudeNumber > 1.01)
+        return FlowRegime::Supercritical;
 
-    if (!flow.is_valid() || slope <= 0.0)
+    return FlowRegime::Critical;
+}
+
+FlowRegime classify_flow_regime_by_depth(double normalDepth, double criticalDepth, double relativeTolerance)
+{
+    double tolerance = relativeTolerance * criticalDepth;
+
+    if (normalDepth > criticalDepth + tolerance)
+        return FlowRegime::Subcritical;
+    else if (normalDepth < criticalDepth - tolerance)
+        return FlowRegime::Supercritical;
+
+    return FlowRegime::Critical;
+}
+
+const char* get_flow_regime_name(FlowRegime regime)
+{
+    switch (regime)
+    {
+    case FlowRegime::Subcritical:
+        return "Subcritical";
+    case FlowRegime::Critical:
+        return "Critical";
+    case FlowRegime::Supercritical:
+        return "Supercritical";
+    default:
+        return "Unknown";
+    }
+}
+
+Analyzer::Analyzer(const SolverSettings& settings)
+    : settings_{settings}
+{
+}
+
+const SolverSettings& Analyzer::get_settings() const
+{
+    return settings_;
+}
+
+void Analyzer::finish_solve(const AnalysisResult& result, SolveTimer& timer, SolverTelemetry* telemetry)
+{
+    if (telemetry)
+    {
+        telemetry->iterations = result.iterations;
+        telemetry->residual = result.residual;
+        telemetry->isConverged = result.isValid;
+    }
+
+    timer.finish(MetricSolver::NormalDepth, 1, result.isValid ? 0 : 1, static_cast<std::uint64_t>(result.iterations));
+}
+
+AnalysisResult Analyzer::solve_for_depth(Channel& channel, const Flow& flow, double slope, double manningsCoefficient, double gravity,
+                                         SolverTelemetry* telemetry) const
+{
+    // Prismatic channels take the section kernels, which also seed the width
+    // and side slope, so their dimension sensitivities are not left at zero.
+    if (std::optional<ChannelSection> section = channel.get_channel_section())
+        return solve_section(*section, flow, slope, manningsCoefficient, gravity, telemetry);
+
+    auto evaluate = [&channel](double depth)
+    {
+        channel.set_depth(depth);
+        return SectionProperties{channel.calculate_area(),
+                                 channel.calculate_wetted_perimeter(),
+                                 channel.calculate_top_width(),
+                                 channel.calculate_wetted_perimeter_derivative()};
+    };
+
+    // Only the depth is seeded here: dA/dy is the top width and dP/dy comes
+    // from the channel. The section dimensions are not seeded, so the width
+    // and side-slope sensitivities are reported as unavailable.
+    auto evaluateSensitivity = [&channel](const SensitivityScalar& depth)
+    {
+        channel.set_depth(depth.value);
+        double topWidth = channel.calculate_top_width();
+        double wettedPerimeterDerivative = channel.calculate_wetted_perimeter_derivative();
+
+        return BasicSectionProperties<SensitivityScalar>{
+            SensitivityScalar::compose(channel.calculate_area(), topWidth, depth),
+            SensitivityScalar::compose(channel.calculate_wetted_perimeter(), wettedPerimeterDerivative, depth),
+            SensitivityScalar{topWidth},
+            SensitivityScalar{wettedPerimeterDerivative}};
+    };
+
+    // Closed conduits are only searched up to their conveyance maximum, so
+    // the lower of two roots is returned.
+    double maxDepth = std::min(settings_.maxDepth, channel.get_max_conveyance_depth());
+
+    AnalysisResult result = solve(evaluate, evaluateSensitivity, flow, slope, manningsCoefficient, gravity, 0.0,
+                                  maxDepth, telemetry);
+    result.sensitivities.hasDimensions = false;
+    return result;
+}
+
+AnalysisResult Analyzer::solve_compound(const CompoundSection& section, double discharge, double slope, double manningsCoefficient,
+                                        double gravity, SolverTelemetry* telemetry) const
+{
+    SolveTimer timer{telemetry};
+
+    if (telemetry)
+        *telemetry = SolverTelemetry{};
+
+    if (!section.is_valid() || !(discharge > 0.0) || slope <= 0.0)
     {
-        return result;
+        timer.finish(MetricSolver::NormalDepth, 1, 1, 0);
+        return AnalysisResult{};
     }
 
-    double targetDischarge{flow.get_discharge()};
-    double manningN{flow.get_manning_n()};
+    double targetConveyance = discharge / (manningsCoefficient * std::sqrt(slope));
+    double logTargetConveyance = std::log(targetConveyance);
 
-    double minDepth{0.001};
-    double maxDepth{1000.0};
-    double tolerance{0.001};
-    int maxIterations{100};
+    auto evaluateDischarge = [&](double depth)
+    {
+        return manningsCoefficient * std::sqrt(slope) * section.evaluate(depth).conveyance;
+    };
 
-    for (int i = 0; i < maxIterations; ++i)
+    // One pass over the subsections gives K and dK/dy, so g'(y) = K' / K.
+    auto evaluateResidual = [&](double depth, double& residual, double& derivative) -> bool
     {
-        double midDepth = (minDepth + maxDepth) / 2.0;
-        channel.set_depth(midDepth);
+        CompoundSectionProperties properties = section.evaluate(depth);
 
-        double area{channel.calculate_area()};
-        double hydraulicRadius{channel.calculate_hydraulic_radius()};
-        double calculatedDischarge = (manningsCoefficient / manningN) * area * std::pow(hydraulicRadius, 2.0/3.0) * std::sqrt(slope);
+        if (!(properties.conveyance > 0.0))
+            return false;
 
-        if (std::abs(calculatedDischarge - targetDischarge) < tolerance)
-        {
-            result.normalDepth = midDepth;
-            result.velocity = targetDischarge / area;
+        residual = std::log(properties.conveyance) - logTargetConveyance;
+        derivative = properties.conveyanceDerivative / properties.conveyance;
+        return std::isfinite(residual);
+    };
 
-            double topWidth = channel.calculate_top_width();
-            double hydraulicDepth = area / topWidth;
-            result.froudeNumber = result.velocity / std::sqrt(gravity * hydraulicDepth);
+    double depthEstimate = settings_.useDepthEstimates ? estimate_normal_depth(section, targetConveyance) : 0.0;
 
-            if (result.froudeNumber < 0.99)
-                result.flowRegime = FlowRegime::Subcritical;
-            else if (result.froudeNumber > 1.01)
-                result.flowRegime = FlowRegime::Supercritical;
-            else
-                result.flowRegime = FlowRegime::Critical;
+    AnalysisResult result = settings_.method == SolverMethod::Bisection
+                                ? solve_by_bisection(evaluateDischarge, discharge, settings_.maxDepth, telemetry)
+                                : solve_by_newton(evaluateResidual, depthEstimate, settings_.maxDepth, telemetry);
 
-            result.isValid = true;
-            return result;
-        }
+    // Fr^2 = alpha Q^2 T / (g A^3), the energy-weighted Froude number.
+    if (result.isValid)
+    {
+        CompoundSectionProperties properties = section.evaluate(result.normalDepth);
+        result.velocity = discharge / properties.area;
+        result.velocityCoefficient = properties.velocityCoefficient;
 
-        if (calculatedDischarge < targetDischarge)
-            minDepth = midDepth;
-        else
-            maxDepth = midDepth;
+        double hydraulicDepth = properties.area / properties.topWidth;
+        result.froudeNumber = result.velocity * std::sqrt(properties.velocityCoefficient / (gravity * hydraulicDepth));
+        result.flowRegime = classify_flow_regime(result.froudeNumber);
     }
 
+    finish_solve(result, timer, telemetry);
     return result;
 }
@@ -1,8 +1,18 @@
 #ifndef ANALYZER_H
 #define ANALYZER_H
 
+#include "ChannelGeometry.h"
+#include "CompositeRoughness.h"
+#include "DualNumber.h"
+#include "Flow.h"
+#include "NormalDepthEstimator.h"
+#include "SolverTelemetry.h"
+#include <cmath>
+#include <cstddef>
+#include <variant>
+
 class Channel;
-class Flow;
+class CompoundSection;
 
 enum class FlowRegime
 {
@@ -11,6 +21,128 @@ enum class FlowRegime
     Supercritical
 };
 
+FlowRegime classify_flow_regime(double froudeNumber);
+
+// Regime from normal against critical depth: critical when the two agree to
+// within relativeTolerance of the critical depth. The default matches the
+// width of the 0.99-1.01 Froude band for a rectangular channel, where
+// Fr = (yc / yn)^(3/2).
+FlowRegime classify_flow_regime_by_depth(double normalDepth, double criticalDepth,
+                                         double relativeTolerance = 0.0067);
+const char* get_flow_regime_name(FlowRegime regime);
+
+// Manning's equation Q = (k / n) A R^(2/3) sqrt(S).
+template <typename Scalar>
+Scalar calculate_manning_discharge(const Scalar& area, const Scalar& wettedPerimeter, const Scalar& manningN,
+                                   const Scalar& slope, double manningsCoefficient)
+{
+    using std::pow;
+    using std::sqrt;
+
+    Scalar hydraulicRadius = area / wettedPerimeter;
+    return (manningsCoefficient / manningN) * area * pow(hydraulicRadius, 2.0/3.0) * sqrt(slope);
+}
+
+// Gradient slots used when differentiating Manning's equation at the normal depth.
+namespace SensitivityIndex
+{
+constexpr std::size_t MANNING_N = 0;
+constexpr std::size_t DISCHARGE = 1;
+constexpr std::size_t BED_SLOPE = 2;
+constexpr std::size_t WIDTH = 3;        // Bottom width (rectangular: width)
+constexpr std::size_t SIDE_SLOPE = 4;
+constexpr std::size_t DEPTH = 5;
+constexpr std::size_t COUNT = 6;
+}
+
+using SensitivityScalar = DualNumber<SensitivityIndex::COUNT>;
+
+// Derivatives of the normal depth with respect to each input. A dimension
+// the section does not have (width of a triangle, side slope of a
+// rectangle) has zero sensitivity. Width and side slope are only computed
+// for the seeded section kernels; hasDimensions is false otherwise, and
+// both are then unknown rather than zero.
+struct NormalDepthSensitivities
+{
+    double manningN{0.0};    // dy/dn
+    double discharge{0.0};   // dy/dQ
+    double bedSlope{0.0};    // dy/dS
+    double width{0.0};       // dy/db
+    double sideSlope{0.0};   // dy/dz
+    bool hasDimensions{false};
+    bool isValid{false};
+};
+
+// Section whose dimensions are seeded as independent variables.
+inline BasicRectangularSection<SensitivityScalar> make_sensitivity_section(const RectangularSection& section)
+{
+    return {SensitivityScalar::variable(section.width, SensitivityIndex::WIDTH)};
+}
+
+inline BasicTrapezoidalSection<SensitivityScalar> make_sensitivity_section(const TrapezoidalSection& section)
+{
+    return {SensitivityScalar::variable(section.bottomWidth, SensitivityIndex::WIDTH),
+            SensitivityScalar::variable(section.sideSlope, SensitivityIndex::SIDE_SLOPE)};
+}
+
+inline BasicTriangularSection<SensitivityScalar> make_sensitivity_section(const TriangularSection& section)
+{
+    return {SensitivityScalar::variable(section.sideSlope, SensitivityIndex::SIDE_SLOPE)};
+}
+
+// Exact normal-depth sensitivities at a converged depth. The normal depth
+// solves G(y, p) = ln Q_manning(y, p) - ln Q = 0, so by the implicit function
+// theorem dy/dp = -(dG/dp) / (dG/dy). One dual-number evaluation of
+// Manning's equation gives every partial of G at once, so no extra solves
+// are needed. `evaluate` maps a SensitivityScalar depth to the section
+// properties computed with SensitivityScalar.
+template <typename Evaluate>
+NormalDepthSensitivities calculate_normal_depth_sensitivities(Evaluate&& evaluate, double depth, const Flow& flow,
+                                                              double slope, double manningsCoefficient)
+{
+    using namespace SensitivityIndex;
+
+    NormalDepthSensitivities sensitivities;
+
+    BasicSectionProperties<SensitivityScalar> properties = evaluate(SensitivityScalar::variable(depth, DEPTH));
+    SensitivityScalar discharge = calculate_manning_discharge(properties.area, properties.wettedPerimeter,
+                                                              SensitivityScalar::variable(flow.get_manning_n(), MANNING_N),
+                                                              SensitivityScalar::variable(slope, BED_SLOPE),
+                                                              manningsCoefficient);
+    SensitivityScalar residual = log(discharge) - log(SensitivityScalar::variable(flow.get_discharge(), DISCHARGE));
+
+    double depthDerivative = residual.gradient[DEPTH];
+    if (!(depthDerivative > 0.0) || !std::isfinite(depthDerivative))
+        return sensitivities;
+
+    sensitivities.manningN = -residual.gradient[MANNING_N] / depthDerivative;
+    sensitivities.discharge = -residual.gradient[DISCHARGE] / depthDerivative;
+    sensitivities.bedSlope = -residual.gradient[BED_SLOPE] / depthDerivative;
+    sensitivities.width = -residual.gradient[WIDTH] / depthDerivative;
+    sensitivities.sideSlope = -residual.gradient[SIDE_SLOPE] / depthDerivative;
+    sensitivities.hasDimensions = true;
+    sensitivities.isValid = true;
+    return sensitivities;
+}
+
+enum class SolverMethod
+{
+    Bisection,
+    SafeguardedNewton
+};
+
+struct SolverSettings
+{
+    SolverMethod method{SolverMethod::SafeguardedNewton};
+    double minDepth{0.001};
+    double maxDepth{1000.0};
+    double relativeTolerance{1e-10};    // Newton: relative discharge error
+    double dischargeTolerance{0.001};   // Bisection: absolute discharge error
+    int maxIterations{100};
+    bool useDepthEstimates{true};       // Newton: seed from closed forms / dimensionless table
+    bool computeSensitivities{false};   // Fill AnalysisResult::sensitivities
+};
+
 struct AnalysisResult
 {
     double normalDepth{0.0};
@@ -18,16 +150,412 @@ struct AnalysisResult
     double froudeNumber{0.0};
     FlowRegime flowRegime{FlowRegime::Subcritical};
     bool isValid{false};
+    int iterations{0};
+    double residual{0.0};   // |Q(y) - Q| / Q at the returned depth
+    double velocityCoefficient{1.0};   // Energy coefficient alpha; 1 for a single-roughness section
+    NormalDepthSensitivities sensitivities;
 };
 
 class Analyzer
 {
 public:
     Analyzer() = default;
+    explicit Analyzer(const SolverSettings& settings);
+
+    // Every solve accepts an optional SolverTelemetry that receives the
+    // iteration count, final residual, bracket history and wall time. Solves
+    // are also counted in SolverMetrics under NormalDepth when it is enabled.
+
+    // Virtual-dispatch path for any Channel subtype.
+    AnalysisResult solve_for_depth(Channel& channel, const Flow& flow, double slope, double manningsCoefficient, double gravity,
+                                   SolverTelemetry* telemetry = nullptr) const;
+
+    // Devirtualized path, instantiated per section type.
+    template <typename Section>
+    AnalysisResult solve_section(const Section& section, const Flow& flow, double slope, double manningsCoefficient, double gravity,
+                                 SolverTelemetry* telemetry = nullptr) const;
+
+    AnalysisResult solve_section(const ChannelSection& section, const Flow& flow, double slope, double manningsCoefficient, double gravity,
+                                 SolverTelemetry* telemetry = nullptr) const;
+
+    // Roughness that varies around the perimeter: the equivalent n is
+    // recomputed from the wetted bed and bank lengths at every iterate.
+    // Sensitivities are not computed.
+    template <typename Section>
+    AnalysisResult solve_section(const Section& section, const CompositeRoughness& roughness, double discharge, double slope,
+                                 double manningsCoefficient, double gravity, SolverTelemetry* telemetry = nullptr) const;
 
-    AnalysisResult solve_for_depth(Channel& channel, const Flow& flow, double slope, double manningsCoefficient, double gravity) const;
+    AnalysisResult solve_section(const ChannelSection& section, const CompositeRoughness& roughness, double discharge,
+                                 double slope, double manningsCoefficient, double gravity,
+                                 SolverTelemetry* telemetry = nullptr) const;
+
+    // Divided-channel method: the discharge is carried by the summed
+    // subsection conveyances, each with its own Manning's n. The result also
+    // holds the velocity coefficient alpha, and the Froude number includes
+    // it. Sensitivities are not computed for compound sections.
+    AnalysisResult solve_compound(const CompoundSection& section, double discharge, double slope, double manningsCoefficient,
+                                  double gravity, SolverTelemetry* telemetry = nullptr) const;
+
+    const SolverSettings& get_settings() const;
 
 private:
+    template <typename Evaluate, typename EvaluateSensitivity>
+    AnalysisResult solve(Evaluate&& evaluate, EvaluateSensitivity&& evaluateSensitivity, const Flow& flow, double slope,
+                         double manningsCoefficient, double gravity, double depthEstimate, double maxDepth,
+                         SolverTelemetry* telemetry) const;
+
+    template <typename EvaluateDischarge>
+    AnalysisResult solve_by_bisection(EvaluateDischarge&& evaluateDischarge, double targetDischarge, double maxDepth,
+                                      SolverTelemetry* telemetry) const;
+
+    template <typename EvaluateResidual>
+    AnalysisResult solve_by_newton(EvaluateResidual&& evaluateResidual, double depthEstimate, double maxDepth,
+                                   SolverTelemetry* telemetry) const;
+
+    static void finish_solve(const AnalysisResult& result, SolveTimer& timer, SolverTelemetry* telemetry);
+
+    SolverSettings settings_;
 };
 
+// ============================================================================
+// TEMPLATE IMPLEMENTATION
+// ============================================================================
+
+template <typename Section>
+AnalysisResult Analyzer::solve_section(const Section& section, const Flow& flow, double slope, double manningsCoefficient, double gravity,
+                                       SolverTelemetry* telemetry) const
+{
+    double depthEstimate{0.0};
+
+    if (settings_.useDepthEstimates && flow.is_valid() && slope > 0.0)
+    {
+        double targetConveyance = flow.get_discharge() * flow.get_manning_n() / (manningsCoefficient * std::sqrt(slope));
+        depthEstimate = estimate_normal_depth(section, targetConveyance);
+    }
+
+    return solve([&section](double depth) { return section.evaluate(depth); },
+                 [&section](const SensitivityScalar& depth) { return make_sensitivity_section(section).evaluate(depth); },
+                 flow, slope, manningsCoefficient, gravity, depthEstimate, settings_.maxDepth, telemetry);
+}
+
+inline AnalysisResult Analyzer::solve_section(const ChannelSection& section, const Flow& flow, double slope, double manningsCoefficient, double gravity,
+                                              SolverTelemetry* telemetry) const
+{
+    return std::visit([&](const auto& concreteSection)
+                      { return solve_section(concreteSection, flow, slope, manningsCoefficient, gravity, telemetry); },
+                      section);
+}
+
+template <typename Section>
+AnalysisResult Analyzer::solve_section(const Section& section, const CompositeRoughness& roughness, double discharge, double slope,
+                                       double manningsCoefficient, double gravity, SolverTelemetry* telemetry) const
+{
+    SolveTimer timer{telemetry};
+
+    if (telemetry)
+        *telemetry = SolverTelemetry{};
+
+    if (!roughness.is_valid() || !(discharge > 0.0) || slope <= 0.0)
+    {
+        timer.finish(MetricSolver::NormalDepth, 1, 1, 0);
+        return AnalysisResult{};
+    }
+
+    // Conveyance including the roughness, Q / (k sqrt(S)).
+    double targetConveyance = discharge / (manningsCoefficient * std::sqrt(slope));
+    double logTargetConveyance = std::log(targetConveyance);
+
+    auto evaluateDischarge = [&](double depth)
+    {
+        SectionProperties properties = section.evaluate(depth);
+        double manningN = roughness.evaluate(depth, properties).manningN;
+        return calculate_manning_discharge(properties.area, properties.wettedPerimeter, manningN, slope, manningsCoefficient);
+    };
+
+    // g(y) = (5 ln A - 2 ln P) / 3 - ln n(y) - ln K_target.
+    auto evaluateResidual = [&](double depth, double& residual, double& derivative) -> bool
+    {
+        SectionProperties properties = section.evaluate(depth);
+        CompositeRoughnessProperties roughnessProperties = roughness.evaluate(depth, properties);
+
+        if (!(properties.area > 0.0 && properties.wettedPerimeter > 0.0 && roughnessProperties.manningN > 0.0))
+            return false;
+
+        residual = (5.0 * std::log(properties.area) - 2.0 * std::log(properties.wettedPerimeter)) / 3.0
+                   - std::log(roughnessProperties.manningN) - logTargetConveyance;
+        derivative = (5.0 * properties.topWidth / properties.area
+                      - 2.0 * properties.wettedPerimeterDerivative / properties.wettedPerimeter) / 3.0
+                     - roughnessProperties.manningNDerivative / roughnessProperties.manningN;
+        return std::isfinite(residual);
+    };
+
+    // Seed with the bed n, then re-estimate with the equivalent n there.
+    double depthEstimate{0.0};
+
+    if (settings_.useDepthEstimates)
+    {
+        double bedEstimate = estimate_normal_depth(section, targetConveyance * roughness.get_bed_n());
+
+        if (bedEstimate > 0.0)
+        {
+            double manningN = roughness.evaluate(bedEstimate, section.evaluate(bedEstimate)).manningN;
+            depthEstimate = estimate_normal_depth(section, targetConveyance * manningN);
+        }
+    }
+
+    AnalysisResult result = settings_.method == SolverMethod::Bisection
+                                ? solve_by_bisection(evaluateDischarge, discharge, settings_.maxDepth, telemetry)
+                                : solve_by_newton(evaluateResidual, depthEstimate, settings_.maxDepth, telemetry);
+
+    if (result.isValid)
+    {
+        SectionProperties properties = section.evaluate(result.normalDepth);
+        result.velocity = discharge / properties.area;
+
+        double hydraulicDepth = properties.area / properties.topWidth;
+        result.froudeNumber = result.velocity / std::sqrt(gravity * hydraulicDepth);
+        result.flowRegime = classify_flow_regime(result.froudeNumber);
+    }
+
+    finish_solve(result, timer, telemetry);
+    return result;
+}
+
+inline AnalysisResult Analyzer::solve_section(const ChannelSection& section, const CompositeRoughness& roughness, double discharge,
+                                              double slope, double manningsCoefficient, double gravity,
+                                              SolverTelemetry* telemetry) const
+{
+    return std::visit([&](const auto& concreteSection)
+                      { return solve_section(concreteSection, roughness, discharge, slope, manningsCoefficient, gravity, telemetry); },
+                      section);
+}
+
+// `evaluate` maps a depth to its SectionProperties; `evaluateSensitivity` is
+// its SensitivityScalar counterpart, only called when sensitivities are on.
+// The search covers [settings minDepth, maxDepth].
+template <typename Evaluate, typename EvaluateSensitivity>
+AnalysisResult Analyzer::solve(Evaluate&& evaluate, EvaluateSensitivity&& evaluateSensitivity, const Flow& flow, double slope,
+                               double manningsCoefficient, double gravity, double depthEstimate, double maxDepth,
+                               SolverTelemetry* telemetry) const
+{
+    SolveTimer timer{telemetry};
+
+    if (telemetry)
+        *telemetry = SolverTelemetry{};
+
+    if (!flow.is_valid() || slope <= 0.0)
+    {
+        timer.finish(MetricSolver::NormalDepth, 1, 1, 0);
+        return AnalysisResult{};
+    }
+
+    double manningN{flow.get_manning_n()};
+
+    auto evaluateDischarge = [&](double depth)
+    {
+        SectionProperties properties = evaluate(depth);
+        return calculate_manning_discharge(properties.area, properties.wettedPerimeter, manningN, slope, manningsCoefficient);
+    };
+
+    // g(y) = ln K(y) - ln K_target with K = A^(5/3) / P^(2/3), so
+    // g'(y) = (5 T / A - 2 P' / P) / 3 comes straight from the section
+    // derivatives.
+    double logTargetConveyance = std::log(flow.get_discharge() * manningN / (manningsCoefficient * std::sqrt(slope)));
+
+    auto evaluateResidual = [&](double depth, double& residual, double& derivative) -> bool
+    {
+        SectionProperties properties = evaluate(depth);
+
+        if (!(properties.area > 0.0 && properties.wettedPerimeter > 0.0))
+            return false;
+
+        residual = (5.0 * std::log(properties.area) - 2.0 * std::log(properties.wettedPerimeter)) / 3.0 - logTargetConveyance;
+        derivative = (5.0 * properties.topWidth / properties.area
+                      - 2.0 * properties.wettedPerimeterDerivative / properties.wettedPerimeter) / 3.0;
+        return std::isfinite(residual);
+    };
+
+    AnalysisResult result = settings_.method == SolverMethod::Bisection
+                                ? solve_by_bisection(evaluateDischarge, flow.get_discharge(), maxDepth, telemetry)
+                                : solve_by_newton(evaluateResidual, depthEstimate, maxDepth, telemetry);
+
+    if (result.isValid)
+    {
+        SectionProperties properties = evaluate(result.normalDepth);
+        result.velocity = flow.get_discharge() / properties.area;
+
+        double hydraulicDepth = properties.area / properties.topWidth;
+        result.froudeNumber = result.velocity / std::sqrt(gravity * hydraulicDepth);
+        result.flowRegime = classify_flow_regime(result.froudeNumber);
+
+        if (settings_.computeSensitivities)
+        {
+            result.sensitivities = calculate_normal_depth_sensitivities(evaluateSensitivity, result.normalDepth,
+                                                                        flow, slope, manningsCoefficient);
+        }
+    }
+
+    finish_solve(result, timer, telemetry);
+    return result;
+}
+
+// `evaluateDischarge` maps a depth to the discharge it carries.
+template <typename EvaluateDischarge>
+AnalysisResult Analyzer::solve_by_bisection(EvaluateDischarge&& evaluateDischarge, double targetDischarge, double maxDepth,
+                                            SolverTelemetry* telemetry) const
+{
+    AnalysisResult result;
+
+    double minDepth{settings_.minDepth};
+
+    for (int i = 0; i < settings_.maxIterations; ++i)
+    {
+        double midDepth = (minDepth + maxDepth) / 2.0;
+        double calculatedDischarge = evaluateDischarge(midDepth);
+
+        result.iterations = i + 1;
+        result.residual = std::abs(calculatedDischarge - targetDischarge) / targetDischarge;
+
+        if (telemetry)
+            telemetry->record_step(minDepth, maxDepth, midDepth, (calculatedDischarge - targetDischarge) / targetDischarge);
+
+        if (std::abs(calculatedDischarge - targetDischarge) < settings_.dischargeTolerance)
+        {
+            result.normalDepth = midDepth;
+            result.isValid = true;
+            return result;
+        }
+
+        if (calculatedDischarge < targetDischarge)
+            minDepth = midDepth;
+        else
+            maxDepth = midDepth;
+    }
+
+    return result;
+}
+
+// Newton iteration on the log-conveyance residual g(y) = ln K(y) - ln K_target.
+// `evaluateResidual(depth, residual, derivative)` sets g and g' and returns
+// false where the section cannot be evaluated. Every iterate shrinks the
+// bracket; a step that would leave it falls back to geometric bisection.
+//
+// A positive depthEstimate is tried first and only a narrow window around it
+// is probed for the bracket; the full [minDepth, maxDepth] range is checked
+// only on the side where that probe fails.
+template <typename EvaluateResidual>
+AnalysisResult Analyzer::solve_by_newton(EvaluateResidual&& evaluate_residual, double depthEstimate, double maxDepth,
+                                         SolverTelemetry* telemetry) const
+{
+    constexpr double ESTIMATE_WINDOW{0.02};
+
+    AnalysisResult result;
+
+    // The target must lie inside the depth range, otherwise no root exists.
+    auto is_low_bound = [&](double depth)
+    {
+        double residual{0.0};
+        double derivative{0.0};
+        return evaluate_residual(depth, residual, derivative) && residual <= 0.0;
+    };
+    auto is_high_bound = [&](double depth)
+    {
+        double residual{0.0};
+        double derivative{0.0};
+        return evaluate_residual(depth, residual, derivative) && residual >= 0.0;
+    };
+
+    double lowDepth{settings_.minDepth};
+    double highDepth{maxDepth};
+    double residual{0.0};
+    double derivative{0.0};
+    double depth{0.0};
+    int iteration{0};
+
+    bool hasEstimate = depthEstimate > lowDepth && depthEstimate < highDepth;
+
+    if (hasEstimate)
+    {
+        if (!evaluate_residual(depthEstimate, residual, derivative))
+            return result;
+
+        iteration = 1;
+        result.iterations = 1;
+        result.residual = std::abs(std::expm1(residual));
+
+        if (telemetry)
+            telemetry->record_step(lowDepth, highDepth, depthEstimate, std::expm1(residual));
+
+        if (result.residual < settings_.relativeTolerance)
+        {
+            result.normalDepth = depthEstimate;
+            result.isValid = true;
+            return result;
+        }
+
+        if (residual < 0.0)
+        {
+            double probe = std::min(highDepth, depthEstimate * (1.0 + ESTIMATE_WINDOW));
+            lowDepth = depthEstimate;
+            if (is_high_bound(probe))
+                highDepth = probe;
+            else if (!is_high_bound(highDepth))
+                return result;
+        }
+        else
+        {
+            double probe = std::max(lowDepth, depthEstimate * (1.0 - ESTIMATE_WINDOW));
+            highDepth = depthEstimate;
+            if (is_low_bound(probe))
+                lowDepth = probe;
+            else if (!is_low_bound(lowDepth))
+                return result;
+        }
+
+        depth = depthEstimate - residual / derivative;
+        if (!(derivative > 0.0) || !(depth > lowDepth && depth < highDepth))
+            depth = std::sqrt(lowDepth * highDepth);
+    }
+    else
+    {
+        if (!is_low_bound(lowDepth) || !is_high_bound(highDepth))
+            return result;
+
+        depth = std::sqrt(lowDepth * highDepth);
+    }
+
+    for (; iteration < settings_.maxIterations; ++iteration)
+    {
+        if (!evaluate_residual(depth, residual, derivative))
+            return result;
+
+        result.iterations = iteration + 1;
+        result.residual = std::abs(std::expm1(residual));
+
+        if (telemetry)
+            telemetry->record_step(lowDepth, highDepth, depth, std::expm1(residual));
+
+        if (result.residual < settings_.relativeTolerance)
+        {
+            result.normalDepth = depth;
+            result.isValid = true;
+            return result;
+        }
+
+        if (residual < 0.0)
+            lowDepth = depth;
+        else
+            highDepth = depth;
+
+        double nextDepth = depth - residual / derivative;
+
+        if (!(derivative > 0.0) || !(nextDepth > lowDepth && nextDepth < highDepth))
+            nextDepth = std::sqrt(lowDepth * highDepth);
+
+        depth = nextDepth;
+    }
+
+    return result;
+}
+
 #endif // ANALYZER_H
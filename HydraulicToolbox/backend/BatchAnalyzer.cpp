@@ -0,0 +1,491 @@
+#include "BatchAnalyzer.h"
+#include "UnitSystemConstants.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+constexpr double MIN_DEPTH{0.001};
+constexpr double MAX_DEPTH{1000.0};
+constexpr int BRACKET_ITERATIONS{24};
+constexpr int NEWTON_ITERATIONS{2};
+
+// Manning's equation is rearranged so that no std::pow is needed inside the
+// lane loops: Q = (k/n) A R^(2/3) sqrt(S) is equivalent to
+// A^5 = (Q / (k sqrt(S)))^3 n^3 P^2, and the sign of
+// F(y) = A^5 - c n^3 P^2 tells which side of the normal depth y is on.
+//
+// The roughness policies supply n^3 P^2 as a perimeter term h(P, W) and its
+// depth derivative, where W = sum P_i n_i^p is the roughness-weighted
+// perimeter. With a uniform n the constant n^3 is folded into c and
+// h = P^2. The composite power means n = (W / P)^(1/p) give
+// h = W^(3/p) P^(2 - 3/p), which for each method reduces to products, one
+// square root or one division.
+struct UniformRoughness
+{
+    static constexpr bool IS_COMPOSITE{false};
+
+    static double perimeter_term(double perimeter, double /*weightedPerimeter*/) { return perimeter * perimeter; }
+
+    static double perimeter_term_derivative(double perimeter, double perimeterDerivative,
+                                            double /*weightedPerimeter*/, double /*weightedPerimeterDerivative*/)
+    {
+        return 2.0 * perimeter * perimeterDerivative;
+    }
+};
+
+template <CompositeRoughnessMethod Method>
+struct CompositeRoughnessTerm;
+
+template <>
+struct CompositeRoughnessTerm<CompositeRoughnessMethod::HortonEinstein>
+{
+    static constexpr bool IS_COMPOSITE{true};
+
+    static double perimeter_term(double /*perimeter*/, double weightedPerimeter)
+    {
+        return weightedPerimeter * weightedPerimeter;
+    }
+
+    static double perimeter_term_derivative(double /*perimeter*/, double /*perimeterDerivative*/,
+                                            double weightedPerimeter, double weightedPerimeterDerivative)
+    {
+        return 2.0 * weightedPerimeter * weightedPerimeterDerivative;
+    }
+};
+
+template <>
+struct CompositeRoughnessTerm<CompositeRoughnessMethod::Pavlovskii>
+{
+    static constexpr bool IS_COMPOSITE{true};
+
+    static double perimeter_term(double perimeter, double weightedPerimeter)
+    {
+        return weightedPerimeter * std::sqrt(weightedPerimeter * perimeter);
+    }
+
+    static double perimeter_term_derivative(double perimeter, double perimeterDerivative,
+                                            double weightedPerimeter, double weightedPerimeterDerivative)
+    {
+        return perimeter_term(perimeter, weightedPerimeter)
+               * (1.5 * weightedPerimeterDerivative / weightedPerimeter + 0.5 * perimeterDerivative / perimeter);
+    }
+};
+
+template <>
+struct CompositeRoughnessTerm<CompositeRoughnessMethod::Lotter>
+{
+    static constexpr bool IS_COMPOSITE{true};
+
+    static double perimeter_term(double perimeter, double weightedPerimeter)
+    {
+        double ratio = perimeter / weightedPerimeter;
+        return ratio * ratio * ratio * perimeter * perimeter;
+    }
+
+    static double perimeter_term_derivative(double perimeter, double perimeterDerivative,
+                                            double weightedPerimeter, double weightedPerimeterDerivative)
+    {
+        return perimeter_term(perimeter, weightedPerimeter)
+               * (5.0 * perimeterDerivative / perimeter - 3.0 * weightedPerimeterDerivative / weightedPerimeter);
+    }
+};
+
+// The banks of a section with straight walls are wallFactor * y long in
+// total, so W = b w_bed + wallFactor y w_bank.
+template <typename Roughness>
+inline double conveyance_residual(double bottomWidth, double sideSlope, double wallFactor, double bedWeight,
+                                  double bankWeight, double cubedConveyance, double depth)
+{
+    double area = (bottomWidth + sideSlope * depth) * depth;
+    double perimeter = bottomWidth + wallFactor * depth;
+    double weightedPerimeter = bottomWidth * bedWeight + wallFactor * depth * bankWeight;
+    double areaSquared = area * area;
+    return areaSquared * areaSquared * area - cubedConveyance * Roughness::perimeter_term(perimeter, weightedPerimeter);
+}
+
+// Critical flow satisfies Q^2 T = g A^3, so G(y) = A^3 - (Q^2 / g) T is
+// negative below the critical depth and positive above it.
+inline double critical_residual(double bottomWidth, double sideSlope, double dischargeHead, double depth)
+{
+    double area = (bottomWidth + sideSlope * depth) * depth;
+    double topWidth = bottomWidth + 2.0 * sideSlope * depth;
+    return area * area * area - dischargeHead * topWidth;
+}
+
+std::uint64_t count_failures(const BatchStatus* status, std::size_t count)
+{
+    std::uint64_t failures{0};
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (status[i] != BatchStatus::Converged)
+            ++failures;
+    }
+
+    return failures;
+}
+}
+
+BatchAnalyzer::BatchAnalyzer(bool useUsCustomary)
+    : manningsCoefficient_{UnitSystemConstants::get_mannings_coefficient(useUsCustomary)}
+    , gravity_{UnitSystemConstants::get_gravity(useUsCustomary)}
+{
+}
+
+BatchAnalyzer::BatchAnalyzer(double manningsCoefficient, double gravity)
+    : manningsCoefficient_{manningsCoefficient}
+    , gravity_{gravity}
+{
+}
+
+void BatchAnalyzer::solve_for_depth(const BatchInputs& inputs, const BatchOutputs& outputs) const
+{
+    SolveTimer timer{nullptr};
+
+    for (std::size_t offset = 0; offset < inputs.count; offset += LANE_COUNT)
+    {
+        std::size_t laneCount = std::min(LANE_COUNT, inputs.count - offset);
+
+        if (!inputs.bankManningN)
+            solve_block<UniformRoughness>(inputs, outputs, offset, laneCount);
+        else if (inputs.roughnessMethod == CompositeRoughnessMethod::Lotter)
+            solve_block<CompositeRoughnessTerm<CompositeRoughnessMethod::Lotter>>(inputs, outputs, offset, laneCount);
+        else if (inputs.roughnessMethod == CompositeRoughnessMethod::Pavlovskii)
+            solve_block<CompositeRoughnessTerm<CompositeRoughnessMethod::Pavlovskii>>(inputs, outputs, offset, laneCount);
+        else
+            solve_block<CompositeRoughnessTerm<CompositeRoughnessMethod::HortonEinstein>>(inputs, outputs, offset, laneCount);
+    }
+
+    if (timer.is_active())
+    {
+        std::uint64_t iterationsPerScenario = BRACKET_ITERATIONS + NEWTON_ITERATIONS;
+        timer.finish(MetricSolver::BatchNormalDepth, inputs.count, count_failures(outputs.status, inputs.count),
+                     iterationsPerScenario * inputs.count);
+    }
+}
+
+void BatchAnalyzer::solve_critical_depth(const BatchInputs& inputs, const BatchCriticalOutputs& outputs) const
+{
+    SolveTimer timer{nullptr};
+
+    for (std::size_t offset = 0; offset < inputs.count; offset += LANE_COUNT)
+    {
+        std::size_t laneCount = std::min(LANE_COUNT, inputs.count - offset);
+        solve_critical_block(inputs, outputs, offset, laneCount);
+    }
+
+    if (timer.is_active())
+    {
+        std::uint64_t iterationsPerScenario = BRACKET_ITERATIONS + NEWTON_ITERATIONS;
+        timer.finish(MetricSolver::BatchCriticalDepth, inputs.count, count_failures(outputs.status, inputs.count),
+                     iterationsPerScenario * inputs.count);
+    }
+}
+
+void BatchAnalyzer::calculate_sensitivities(const BatchInputs& inputs, const double* normalDepth, const BatchStatus* status,
+                                            const BatchSensitivityOutputs& outputs) const
+{
+    auto store = [](double* output, std::size_t i, double value)
+    {
+        if (output)
+            output[i] = value;
+    };
+
+    for (std::size_t i = 0; i < inputs.count; ++i)
+    {
+        NormalDepthSensitivities sensitivities;
+
+        bool isUniform = !inputs.bankManningN || inputs.bankManningN[i] == inputs.manningN[i];
+
+        if (status[i] == BatchStatus::Converged && isUniform)
+        {
+            TrapezoidalSection section{inputs.bottomWidth[i], inputs.sideSlope[i]};
+            sensitivities = calculate_normal_depth_sensitivities(
+                [&section](const SensitivityScalar& depth) { return make_sensitivity_section(section).evaluate(depth); },
+                normalDepth[i], Flow{inputs.discharge[i], inputs.manningN[i]}, inputs.bedSlope[i], manningsCoefficient_);
+        }
+
+        if (!sensitivities.isValid)
+        {
+            double notANumber = std::numeric_limits<double>::quiet_NaN();
+            sensitivities = {notANumber, notANumber, notANumber, notANumber, notANumber, false, false};
+        }
+
+        store(outputs.manningN, i, sensitivities.manningN);
+        store(outputs.discharge, i, sensitivities.discharge);
+        store(outputs.bedSlope, i, sensitivities.bedSlope);
+        store(outputs.bottomWidth, i, sensitivities.width);
+        store(outputs.sideSlope, i, sensitivities.sideSlope);
+    }
+}
+
+template <typename Roughness>
+void BatchAnalyzer::solve_block(const BatchInputs& inputs, const BatchOutputs& outputs,
+                                std::size_t offset, std::size_t laneCount) const
+{
+    // Fixed-size lane arrays keep every loop below free of data-dependent
+    // control flow so the compiler can map them onto SIMD registers. Lanes
+    // past laneCount or with invalid inputs are solved on a harmless dummy
+    // scenario and masked out when the outputs are written.
+    double bottomWidth[LANE_COUNT];
+    double sideSlope[LANE_COUNT];
+    double discharge[LANE_COUNT];
+    double manningN[LANE_COUNT];
+    double bankManningN[LANE_COUNT];
+    double bedSlope[LANE_COUNT];
+    bool isValid[LANE_COUNT];
+
+    for (std::size_t lane = 0; lane < LANE_COUNT; ++lane)
+    {
+        bool inRange = lane < laneCount;
+        std::size_t index = offset + (inRange ? lane : 0);
+
+        double b = inputs.bottomWidth[index];
+        double z = inputs.sideSlope[index];
+        double q = inputs.discharge[index];
+        double n = inputs.manningN[index];
+        double bankN = Roughness::IS_COMPOSITE ? inputs.bankManningN[index] : n;
+        double s = inputs.bedSlope[index];
+
+        bool valid = inRange && q > 0.0 && n > 0.0 && bankN > 0.0 && s > 0.0 &&
+                     b >= 0.0 && z >= 0.0 && (b > 0.0 || z > 0.0);
+
+        isValid[lane] = valid;
+        bottomWidth[lane] = valid ? b : 1.0;
+        sideSlope[lane] = valid ? z : 0.0;
+        discharge[lane] = valid ? q : 1.0;
+        manningN[lane] = valid ? n : 1.0;
+        bankManningN[lane] = valid ? bankN : 1.0;
+        bedSlope[lane] = valid ? s : 1.0;
+    }
+
+    // The roughness enters either as the constant n in the conveyance or,
+    // for composite roughness, as the weights n_i^p of W.
+    double wallFactor[LANE_COUNT];
+    double bedWeight[LANE_COUNT];
+    double bankWeight[LANE_COUNT];
+    double cubedConveyance[LANE_COUNT];
+    double lower[LANE_COUNT];
+    double upper[LANE_COUNT];
+    bool isBracketed[LANE_COUNT];
+
+    double exponent = get_composite_roughness_exponent(inputs.roughnessMethod);
+
+    for (std::size_t lane = 0; lane < LANE_COUNT; ++lane)
+    {
+        wallFactor[lane] = 2.0 * std::sqrt(sideSlope[lane] * sideSlope[lane] + 1.0);
+
+        double conveyance = discharge[lane] / (manningsCoefficient_ * std::sqrt(bedSlope[lane]));
+
+        if constexpr (Roughness::IS_COMPOSITE)
+        {
+            bedWeight[lane] = std::pow(manningN[lane], exponent);
+            bankWeight[lane] = std::pow(bankManningN[lane], exponent);
+        }
+        else
+        {
+            conveyance *= manningN[lane];
+            bedWeight[lane] = 1.0;
+            bankWeight[lane] = 1.0;
+        }
+
+        cubedConveyance[lane] = conveyance * conveyance * conveyance;
+
+        double lowResidual = conveyance_residual<Roughness>(bottomWidth[lane], sideSlope[lane], wallFactor[lane],
+                                                            bedWeight[lane], bankWeight[lane], cubedConveyance[lane],
+                                                            MIN_DEPTH);
+        double highResidual = conveyance_residual<Roughness>(bottomWidth[lane], sideSlope[lane], wallFactor[lane],
+                                                             bedWeight[lane], bankWeight[lane], cubedConveyance[lane],
+                                                             MAX_DEPTH);
+        isBracketed[lane] = lowResidual < 0.0 && highResidual > 0.0;
+
+        lower[lane] = MIN_DEPTH;
+        upper[lane] = MAX_DEPTH;
+    }
+
+    // Bisect in log-depth so that tiny and huge depths get the same relative
+    // resolution; 24 halvings shrink the [0.001, 1000] bracket to a ratio
+    // of about 1 + 1e-6.
+    for (int i = 0; i < BRACKET_ITERATIONS; ++i)
+    {
+        for (std::size_t lane = 0; lane < LANE_COUNT; ++lane)
+        {
+            double midDepth = std::sqrt(lower[lane] * upper[lane]);
+            double residual = conveyance_residual<Roughness>(bottomWidth[lane], sideSlope[lane], wallFactor[lane],
+                                                             bedWeight[lane], bankWeight[lane], cubedConveyance[lane],
+                                                             midDepth);
+            bool isAbove = residual > 0.0;
+            upper[lane] = isAbove ? midDepth : upper[lane];
+            lower[lane] = isAbove ? lower[lane] : midDepth;
+        }
+    }
+
+    double depth[LANE_COUNT];
+
+    for (std::size_t lane = 0; lane < LANE_COUNT; ++lane)
+    {
+        depth[lane] = std::sqrt(lower[lane] * upper[lane]);
+    }
+
+    // Polish with Newton steps on F(y), clamped to the final bracket.
+    for (int i = 0; i < NEWTON_ITERATIONS; ++i)
+    {
+        for (std::size_t lane = 0; lane < LANE_COUNT; ++lane)
+        {
+            double y = depth[lane];
+            double b = bottomWidth[lane];
+            double z = sideSlope[lane];
+
+            double area = (b + z * y) * y;
+            double perimeter = b + wallFactor[lane] * y;
+            double topWidth = b + 2.0 * z * y;
+            double areaSquared = area * area;
+
+            double weightedPerimeterDerivative = wallFactor[lane] * bankWeight[lane];
+            double weightedPerimeter = b * bedWeight[lane] + weightedPerimeterDerivative * y;
+            double perimeterTerm = Roughness::perimeter_term(perimeter, weightedPerimeter);
+            double perimeterTermDerivative = Roughness::perimeter_term_derivative(perimeter, wallFactor[lane],
+                                                                                  weightedPerimeter,
+                                                                                  weightedPerimeterDerivative);
+
+            double residual = areaSquared * areaSquared * area - cubedConveyance[lane] * perimeterTerm;
+            double derivative = 5.0 * areaSquared * areaSquared * topWidth
+                                - cubedConveyance[lane] * perimeterTermDerivative;
+
+            double next = y - residual / derivative;
+            depth[lane] = std::min(std::max(next, lower[lane]), upper[lane]);
+        }
+    }
+
+    for (std::size_t lane = 0; lane < laneCount; ++lane)
+    {
+        std::size_t index = offset + lane;
+        double y = depth[lane];
+        double area = (bottomWidth[lane] + sideSlope[lane] * y) * y;
+        double topWidth = bottomWidth[lane] + 2.0 * sideSlope[lane] * y;
+        double velocity = discharge[lane] / area;
+        double froudeNumber = velocity / std::sqrt(gravity_ * area / topWidth);
+
+        bool isSolved = isValid[lane] && isBracketed[lane];
+
+        outputs.normalDepth[index] = isSolved ? y : 0.0;
+        outputs.velocity[index] = isSolved ? velocity : 0.0;
+        outputs.froudeNumber[index] = isSolved ? froudeNumber : 0.0;
+        outputs.flowRegime[index] = classify_flow_regime(outputs.froudeNumber[index]);
+
+        if (!isValid[lane])
+            outputs.status[index] = BatchStatus::InvalidInput;
+        else if (!isBracketed[lane])
+            outputs.status[index] = BatchStatus::NotConverged;
+        else
+            outputs.status[index] = BatchStatus::Converged;
+    }
+}
+
+void BatchAnalyzer::solve_critical_block(const BatchInputs& inputs, const BatchCriticalOutputs& outputs,
+                                         std::size_t offset, std::size_t laneCount) const
+{
+    // Same lane layout and masking as solve_block.
+    double bottomWidth[LANE_COUNT];
+    double sideSlope[LANE_COUNT];
+    double discharge[LANE_COUNT];
+    bool isValid[LANE_COUNT];
+
+    for (std::size_t lane = 0; lane < LANE_COUNT; ++lane)
+    {
+        bool inRange = lane < laneCount;
+        std::size_t index = offset + (inRange ? lane : 0);
+
+        double b = inputs.bottomWidth[index];
+        double z = inputs.sideSlope[index];
+        double q = inputs.discharge[index];
+
+        bool valid = inRange && q > 0.0 && b >= 0.0 && z >= 0.0 && (b > 0.0 || z > 0.0);
+
+        isValid[lane] = valid;
+        bottomWidth[lane] = valid ? b : 1.0;
+        sideSlope[lane] = valid ? z : 0.0;
+        discharge[lane] = valid ? q : 1.0;
+    }
+
+    double dischargeHead[LANE_COUNT];
+    double lower[LANE_COUNT];
+    double upper[LANE_COUNT];
+    bool isBracketed[LANE_COUNT];
+
+    for (std::size_t lane = 0; lane < LANE_COUNT; ++lane)
+    {
+        dischargeHead[lane] = discharge[lane] * discharge[lane] / gravity_;
+
+        double lowResidual = critical_residual(bottomWidth[lane], sideSlope[lane], dischargeHead[lane], MIN_DEPTH);
+        double highResidual = critical_residual(bottomWidth[lane], sideSlope[lane], dischargeHead[lane], MAX_DEPTH);
+        isBracketed[lane] = lowResidual < 0.0 && highResidual > 0.0;
+
+        lower[lane] = MIN_DEPTH;
+        upper[lane] = MAX_DEPTH;
+    }
+
+    for (int i = 0; i < BRACKET_ITERATIONS; ++i)
+    {
+        for (std::size_t lane = 0; lane < LANE_COUNT; ++lane)
+        {
+            double midDepth = std::sqrt(lower[lane] * upper[lane]);
+            double residual = critical_residual(bottomWidth[lane], sideSlope[lane], dischargeHead[lane], midDepth);
+            bool isAbove = residual > 0.0;
+            upper[lane] = isAbove ? midDepth : upper[lane];
+            lower[lane] = isAbove ? lower[lane] : midDepth;
+        }
+    }
+
+    double depth[LANE_COUNT];
+
+    for (std::size_t lane = 0; lane < LANE_COUNT; ++lane)
+    {
+        depth[lane] = std::sqrt(lower[lane] * upper[lane]);
+    }
+
+    // G'(y) = 3 A^2 T - (Q^2 / g) 2 z.
+    for (int i = 0; i < NEWTON_ITERATIONS; ++i)
+    {
+        for (std::size_t lane = 0; lane < LANE_COUNT; ++lane)
+        {
+            double y = depth[lane];
+            double b = bottomWidth[lane];
+            double z = sideSlope[lane];
+
+            double area = (b + z * y) * y;
+            double topWidth = b + 2.0 * z * y;
+
+            double residual = area * area * area - dischargeHead[lane] * topWidth;
+            double derivative = 3.0 * area * area * topWidth - 2.0 * dischargeHead[lane] * z;
+
+            double next = y - residual / derivative;
+            depth[lane] = std::min(std::max(next, lower[lane]), upper[lane]);
+        }
+    }
+
+    for (std::size_t lane = 0; lane < laneCount; ++lane)
+    {
+        std::size_t index = offset + lane;
+        double y = depth[lane];
+        double b = bottomWidth[lane];
+        double z = sideSlope[lane];
+        double area = (b + z * y) * y;
+        double firstMoment = (0.5 * b + z * y / 3.0) * y * y;
+
+        bool isSolved = isValid[lane] && isBracketed[lane];
+
+        outputs.criticalDepth[index] = isSolved ? y : 0.0;
+        outputs.minimumSpecificEnergy[index] = isSolved ? y + 0.5 * dischargeHead[lane] / (area * area) : 0.0;
+        outputs.minimumSpecificForce[index] = isSolved ? dischargeHead[lane] / area + firstMoment : 0.0;
+
+        if (!isValid[lane])
+            outputs.status[index] = BatchStatus::InvalidInput;
+        else if (!isBracketed[lane])
+            outputs.status[index] = BatchStatus::NotConverged;
+        else
+            outputs.status[index] = BatchStatus::Converged;
+    }
+}
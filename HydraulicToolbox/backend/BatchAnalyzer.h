@@ -0,0 +1,99 @@
+#ifndef BATCHANALYZER_H
+#define BATCHANALYZER_H
+
+#include "Analyzer.h"
+#include "CompositeRoughness.h"
+#include <cstddef>
+#include <cstdint>
+
+enum class BatchStatus : std::uint8_t
+{
+    Converged,
+    InvalidInput,
+    NotConverged
+};
+
+// Structure-of-arrays scenario inputs. Every section is described by the
+// trapezoidal parameters: rectangular channels use sideSlope = 0 and
+// triangular channels use bottomWidth = 0. All arrays hold `count` values.
+struct BatchInputs
+{
+    const double* bottomWidth{nullptr};
+    const double* sideSlope{nullptr};
+    const double* discharge{nullptr};
+    const double* manningN{nullptr};
+    const double* bedSlope{nullptr};
+    std::size_t count{0};
+
+    // Optional bank roughness. When set, manningN is the bed n, both banks
+    // use bankManningN, and the two are combined per depth by
+    // roughnessMethod. Sensitivities are not computed for scenarios whose
+    // bank and bed n differ.
+    const double* bankManningN{nullptr};
+    CompositeRoughnessMethod roughnessMethod{CompositeRoughnessMethod::HortonEinstein};
+};
+
+// Caller-owned output arrays, each sized to BatchInputs::count.
+struct BatchOutputs
+{
+    double* normalDepth{nullptr};
+    double* velocity{nullptr};
+    double* froudeNumber{nullptr};
+    FlowRegime* flowRegime{nullptr};
+    BatchStatus* status{nullptr};
+};
+
+// Caller-owned critical-flow output arrays, each sized to BatchInputs::count.
+struct BatchCriticalOutputs
+{
+    double* criticalDepth{nullptr};
+    double* minimumSpecificEnergy{nullptr};
+    double* minimumSpecificForce{nullptr};
+    BatchStatus* status{nullptr};
+};
+
+// Caller-owned normal-depth sensitivity arrays, each sized to
+// BatchInputs::count. Null arrays are skipped.
+struct BatchSensitivityOutputs
+{
+    double* manningN{nullptr};
+    double* discharge{nullptr};
+    double* bedSlope{nullptr};
+    double* bottomWidth{nullptr};
+    double* sideSlope{nullptr};
+};
+
+class BatchAnalyzer
+{
+public:
+    explicit BatchAnalyzer(bool useUsCustomary);
+    BatchAnalyzer(double manningsCoefficient, double gravity);
+
+    // Each call is recorded as one BatchNormalDepth sample in SolverMetrics.
+    void solve_for_depth(const BatchInputs& inputs, const BatchOutputs& outputs) const;
+
+    // Critical depth and the minima of the E-y and M-y curves. Only
+    // bottomWidth, sideSlope and discharge are read from the inputs.
+    void solve_critical_depth(const BatchInputs& inputs, const BatchCriticalOutputs& outputs) const;
+
+    // dy/dn, dy/dQ, dy/dS, dy/db and dy/dz at normal depths already computed
+    // by solve_for_depth. Scenarios that did not converge get NaN.
+    void calculate_sensitivities(const BatchInputs& inputs, const double* normalDepth, const BatchStatus* status,
+                                 const BatchSensitivityOutputs& outputs) const;
+
+    // Scenarios are processed in blocks of this many lanes, which matches one
+    // AVX-512 register (or two AVX2 registers) of doubles.
+    static constexpr std::size_t LANE_COUNT = 8;
+
+private:
+    template <typename Roughness>
+    void solve_block(const BatchInputs& inputs, const BatchOutputs& outputs,
+                     std::size_t offset, std::size_t laneCount) const;
+    void solve_critical_block(const BatchInputs& inputs, const BatchCriticalOutputs& outputs,
+                              std::size_t offset, std::size_t laneCount) const;
+
+    double manningsCoefficient_;
+    double gravity_;
+};
+
+#endif // BATCHANALYZER_H
@@ -0,0 +1,75 @@
+#include "BoxCulvertChannel.h"
+
+BoxCulvertChannel::BoxCulvertChannel(double width, double height, double depth)
+    : section_{width}
+    , height_{height}
+    , depth_{depth}
+{
+}
+
+double BoxCulvertChannel::calculate_area() const
+{
+    return section_.calculate_area(is_flowing_full() ? height_ : depth_);
+}
+
+double BoxCulvertChannel::calculate_wetted_perimeter() const
+{
+    if (is_flowing_full())
+        return 2.0 * (section_.width + height_);
+
+    return section_.calculate_wetted_perimeter(depth_);
+}
+
+bool BoxCulvertChannel::is_valid() const
+{
+    return section_.is_valid() && height_ > 0.0 && depth_ > 0.0;
+}
+
+void BoxCulvertChannel::set_depth(double depth)
+{
+    depth_ = depth;
+}
+
+double BoxCulvertChannel::calculate_top_width() const
+{
+    return is_flowing_full() ? 0.0 : section_.calculate_top_width(depth_);
+}
+
+double BoxCulvertChannel::calculate_wetted_perimeter_derivative() const
+{
+    return is_flowing_full() ? 0.0 : section_.calculate_wetted_perimeter_derivative(depth_);
+}
+
+// Full: about the hydraulic grade line at `depth` above the invert.
+double BoxCulvertChannel::calculate_first_moment_of_area() const
+{
+    if (is_flowing_full())
+        return section_.calculate_area(height_) * (depth_ - 0.5 * height_);
+
+    return section_.calculate_first_moment(depth_);
+}
+
+double BoxCulvertChannel::get_full_flow_depth() const
+{
+    return height_;
+}
+
+double BoxCulvertChannel::get_max_conveyance_depth() const
+{
+    return height_;
+}
+
+bool BoxCulvertChannel::is_flowing_full() const
+{
+    return depth_ > height_;
+}
+
+const RectangularSection& BoxCulvertChannel::get_section() const
+{
+    return section_;
+}
+
+double BoxCulvertChannel::get_height() const
+{
+    return height_;
+}
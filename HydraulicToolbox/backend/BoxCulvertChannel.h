@@ -0,0 +1,37 @@
+#ifndef BOXCULVERTCHANNEL_H
+#define BOXCULVERTCHANNEL_H
+
+#include "Channel.h"
+#include "ChannelGeometry.h"
+
+// Closed rectangular conduit of span b and rise H. Up to the crown it is an
+// open rectangular channel. Above it the barrel flows full, and the wetted
+// perimeter jumps by the soffit width. Conveyance is therefore largest just
+// as the water reaches the crown.
+class BoxCulvertChannel : public Channel
+{
+public:
+    BoxCulvertChannel(double width, double height, double depth);
+
+    double calculate_area() const override;
+    double calculate_wetted_perimeter() const override;
+    bool is_valid() const override;
+    void set_depth(double depth) override;
+    double calculate_top_width() const override;
+    double calculate_wetted_perimeter_derivative() const override;
+    double calculate_first_moment_of_area() const override;
+    double get_full_flow_depth() const override;
+    double get_max_conveyance_depth() const override;
+
+    bool is_flowing_full() const;
+
+    const RectangularSection& get_section() const;
+    double get_height() const;
+
+private:
+    RectangularSection section_;
+    double height_;
+    double depth_;
+};
+
+#endif // BOXCULVERTCHANNEL_H
@@ -0,0 +1,52 @@
+#ifndef CALCULATIONCONTROL_H
+#define CALCULATIONCONTROL_H
+
+#include <atomic>
+#include <functional>
+#include <utility>
+
+// Shared between the thread that requests a calculation and the threads
+// that run it. Long-running analyses poll is_cancelled() between work units
+// and report progress as a fraction in [0, 1]. The progress callback may be
+// called concurrently from several worker threads.
+class CalculationControl
+{
+public:
+    using ProgressCallback = std::function<void(double fraction)>;
+
+    CalculationControl() = default;
+    explicit CalculationControl(ProgressCallback progressCallback)
+        : progressCallback_{std::move(progressCallback)}
+    {
+    }
+
+    CalculationControl(const CalculationControl&) = delete;
+    CalculationControl& operator=(const CalculationControl&) = delete;
+
+    void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+    bool is_cancelled() const { return cancelled_.load(std::memory_order_relaxed); }
+
+    void report_progress(double fraction) const
+    {
+        if (progressCallback_)
+            progressCallback_(fraction);
+    }
+
+private:
+    std::atomic<bool> cancelled_{false};
+    ProgressCallback progressCallback_;
+};
+
+// Null-safe helpers for APIs that take an optional control.
+inline bool is_cancelled(const CalculationControl* control)
+{
+    return control && control->is_cancelled();
+}
+
+inline void report_progress(const CalculationControl* control, double fraction)
+{
+    if (control)
+        control->report_progress(fraction);
+}
+
+#endif // CALCULATIONCONTROL_H
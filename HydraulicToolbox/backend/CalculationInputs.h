@@ -0,0 +1,48 @@
+#ifndef CALCULATIONINPUTS_H
+#define CALCULATIONINPUTS_H
+
+#include "CompositeRoughness.h"
+#include <cstdint>
+
+enum class ChannelType : std::uint8_t
+{
+    None,
+    Rectangular,
+    Trapezoidal,
+    Triangular
+};
+
+struct GeometryData
+{
+    ChannelType channelType{ChannelType::None};
+    double bottomWidth{0.0};
+    double sideSlope{0.0};
+    double length{0.0};
+    double bedSlope{0.0};
+};
+
+struct HydraulicData
+{
+    double discharge{0.0};
+    double manningN{0.0};
+    double bankManningN{0.0};      // Banks lined differently from the bed; 0 when n is uniform
+    CompositeRoughnessMethod roughnessMethod{CompositeRoughnessMethod::HortonEinstein};
+};
+
+// Display name of the channel type; an empty string for None.
+inline const char* get_channel_type_name(ChannelType type)
+{
+    switch (type)
+    {
+    case ChannelType::Rectangular:
+        return "Rectangular";
+    case ChannelType::Trapezoidal:
+        return "Trapezoidal";
+    case ChannelType::Triangular:
+        return "Triangular";
+    default:
+        return "";
+    }
+}
+
+#endif // CALCULATIONINPUTS_H
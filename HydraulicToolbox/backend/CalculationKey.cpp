@@ -0,0 +1,89 @@
+#include "CalculationKey.h"
+#include <cstring>
+
+namespace
+{
+double canonical(double value)
+{
+    return value == 0.0 ? 0.0 : value;
+}
+
+std::uint64_t to_bits(double value)
+{
+    std::uint64_t bits{0};
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// SplitMix64 finalizer folded over the fields, so nearby doubles that differ
+// only in low mantissa bits still spread across buckets.
+std::uint64_t mix(std::uint64_t hash, std::uint64_t value)
+{
+    hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+    return hash ^ (hash >> 31);
+}
+}
+
+bool CalculationKey::operator==(const CalculationKey& other) const
+{
+    return shape == other.shape
+           && useUsCustomary == other.useUsCustomary
+           && to_bits(bottomWidth) == to_bits(other.bottomWidth)
+           && to_bits(sideSlope) == to_bits(other.sideSlope)
+           && to_bits(bedSlope) == to_bits(other.bedSlope)
+           && to_bits(discharge) == to_bits(other.discharge)
+           && to_bits(manningN) == to_bits(other.manningN)
+           && to_bits(bankManningN) == to_bits(other.bankManningN)
+           && roughnessMethod == other.roughnessMethod;
+}
+
+std::size_t CalculationKeyHash::operator()(const CalculationKey& key) const
+{
+    std::uint64_t hash = mix(0, (static_cast<std::uint64_t>(key.shape) << 1) | (key.useUsCustomary ? 1 : 0));
+    hash = mix(hash, to_bits(key.bottomWidth));
+    hash = mix(hash, to_bits(key.sideSlope));
+    hash = mix(hash, to_bits(key.bedSlope));
+    hash = mix(hash, to_bits(key.discharge));
+    hash = mix(hash, to_bits(key.manningN));
+    hash = mix(hash, (to_bits(key.bankManningN) << 2) ^ static_cast<std::uint64_t>(key.roughnessMethod));
+    return static_cast<std::size_t>(hash);
+}
+
+std::optional<CalculationKey> make_calculation_key(bool useUsCustomary,
+                                                   const GeometryData& geometryData,
+                                                   const HydraulicData& hydraulicData)
+{
+    CalculationKey key;
+    key.shape = geometryData.channelType;
+
+    switch (geometryData.channelType)
+    {
+    case ChannelType::Rectangular:
+        key.bottomWidth = canonical(geometryData.bottomWidth);
+        break;
+    case ChannelType::Trapezoidal:
+        key.bottomWidth = canonical(geometryData.bottomWidth);
+        key.sideSlope = canonical(geometryData.sideSlope);
+        break;
+    case ChannelType::Triangular:
+        key.sideSlope = canonical(geometryData.sideSlope);
+        break;
+    default:
+        return std::nullopt;
+    }
+
+    key.useUsCustomary = useUsCustomary;
+    key.bedSlope = canonical(geometryData.bedSlope);
+    key.discharge = canonical(hydraulicData.discharge);
+    key.manningN = canonical(hydraulicData.manningN);
+
+    if (hydraulicData.bankManningN > 0.0)
+    {
+        key.bankManningN = hydraulicData.bankManningN;
+        key.roughnessMethod = hydraulicData.roughnessMethod;
+    }
+
+    return key;
+}
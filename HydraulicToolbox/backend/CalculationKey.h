@@ -0,0 +1,40 @@
+#ifndef CALCULATIONKEY_H
+#define CALCULATIONKEY_H
+
+#include "CalculationInputs.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+// Canonical form of the inputs that HydraulicCalculator::calculate reads.
+// Dimensions the channel shape does not use are zeroed and -0.0 becomes
+// 0.0, so inputs that must produce the same results compare equal. The
+// project name, location and reach length do not affect the calculation
+// and are left out.
+struct CalculationKey
+{
+    ChannelType shape{ChannelType::None};
+    bool useUsCustomary{false};
+    double bottomWidth{0.0};
+    double sideSlope{0.0};
+    double bedSlope{0.0};
+    double discharge{0.0};
+    double manningN{0.0};
+    double bankManningN{0.0};      // Zero, with the default method, for uniform roughness
+    CompositeRoughnessMethod roughnessMethod{CompositeRoughnessMethod::HortonEinstein};
+
+    bool operator==(const CalculationKey& other) const;
+    bool operator!=(const CalculationKey& other) const { return !(*this == other); }
+};
+
+struct CalculationKeyHash
+{
+    std::size_t operator()(const CalculationKey& key) const;
+};
+
+// Returns nullopt for an unknown channel type; such inputs are not cached.
+std::optional<CalculationKey> make_calculation_key(bool useUsCustomary,
+                                                   const GeometryData& geometryData,
+                                                   const HydraulicData& hydraulicData);
+
+#endif // CALCULATIONKEY_H
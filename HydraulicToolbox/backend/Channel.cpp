@@ -1,4 +1,20 @@
 #include "Channel.h"
+#include <limits>
+
+double Channel::get_full_flow_depth() const
+{
+    return std::numeric_limits<double>::infinity();
+}
+
+double Channel::get_max_conveyance_depth() const
+{
+    return std::numeric_limits<double>::infinity();
+}
+
+std::optional<ChannelSection> Channel::get_channel_section() const
+{
+    return std::nullopt;
+}
 
 double Channel::calculate_hydraulic_radius() const
 {
@@ -1,6 +1,9 @@
 #ifndef CHANNEL_H
 #define CHANNEL_H
 
+#include "ChannelGeometry.h"
+#include <optional>
+
 class Channel
 {
 public:
@@ -12,6 +15,28 @@ public:
     virtual void set_depth(double depth) = 0;
     virtual double calculate_top_width() const = 0;
 
+    // dP/dy at the current depth. dA/dy is the top width.
+    virtual double calculate_wetted_perimeter_derivative() const = 0;
+
+    // First moment of the flow area about the water surface (A times the
+    // centroid depth), used by the specific-force function.
+    virtual double calculate_first_moment_of_area() const = 0;
+
+    // Depth at which a closed conduit flows full; above it the section is
+    // pressurized. Open sections never fill and return infinity.
+    virtual double get_full_flow_depth() const;
+
+    // Depth of maximum conveyance. Normal-depth solvers search below it:
+    // above it a closed conduit loses conveyance as the crown closes, so a
+    // discharge can have a second, upper root or none. Open sections
+    // return infinity.
+    virtual double get_max_conveyance_depth() const;
+
+    // The value-type section of a rectangular, trapezoidal or triangular
+    // channel, letting solvers take the inlined kernels that also seed the
+    // section dimensions. Other shapes return nullopt.
+    virtual std::optional<ChannelSection> get_channel_section() const;
+
     double calculate_hydraulic_radius() const;
 };
 
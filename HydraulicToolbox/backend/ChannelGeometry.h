@@ -0,0 +1,104 @@
+#ifndef CHANNELGEOMETRY_H
+#define CHANNELGEOMETRY_H
+
+#include <cmath>
+#include <variant>
+
+// Value-type cross-section kernels. Each section evaluates its geometry as a
+// function of depth without virtual dispatch, so templated solvers can inline
+// and fuse the area, perimeter and top width computations. The virtual
+// Channel classes wrap these structs.
+//
+// The kernels are written over a generic Scalar so the same formulas can be
+// evaluated with DualNumber to differentiate with respect to the depth and
+// the section dimensions. The double instantiations are the everyday types.
+
+template <typename Scalar>
+struct BasicSectionProperties
+{
+    Scalar area{0.0};
+    Scalar wettedPerimeter{0.0};
+    Scalar topWidth{0.0};
+    Scalar wettedPerimeterDerivative{0.0};
+};
+
+template <typename Scalar>
+struct BasicRectangularSection
+{
+    Scalar width{0.0};
+
+    Scalar calculate_area(const Scalar& depth) const { return width * depth; }
+    Scalar calculate_wetted_perimeter(const Scalar& depth) const { return width + 2.0 * depth; }
+    Scalar calculate_top_width(const Scalar& /*depth*/) const { return width; }
+    Scalar calculate_wetted_perimeter_derivative(const Scalar& /*depth*/) const { return Scalar{2.0}; }
+    Scalar calculate_first_moment(const Scalar& depth) const { return 0.5 * width * depth * depth; }
+    bool is_valid() const { return width > 0.0; }
+
+    BasicSectionProperties<Scalar> evaluate(const Scalar& depth) const
+    {
+        return {width * depth, width + 2.0 * depth, width, Scalar{2.0}};
+    }
+};
+
+template <typename Scalar>
+struct BasicTrapezoidalSection
+{
+    Scalar bottomWidth{0.0};
+    Scalar sideSlope{0.0};
+
+    Scalar wall_factor() const
+    {
+        using std::sqrt;
+        return 2.0 * sqrt(sideSlope * sideSlope + 1.0);
+    }
+
+    Scalar calculate_area(const Scalar& depth) const { return (bottomWidth + sideSlope * depth) * depth; }
+    Scalar calculate_wetted_perimeter(const Scalar& depth) const { return bottomWidth + wall_factor() * depth; }
+    Scalar calculate_top_width(const Scalar& depth) const { return bottomWidth + 2.0 * sideSlope * depth; }
+    Scalar calculate_wetted_perimeter_derivative(const Scalar& /*depth*/) const { return wall_factor(); }
+    Scalar calculate_first_moment(const Scalar& depth) const { return (0.5 * bottomWidth + sideSlope * depth / 3.0) * depth * depth; }
+    bool is_valid() const { return bottomWidth > 0.0 && sideSlope > 0.0; }
+
+    BasicSectionProperties<Scalar> evaluate(const Scalar& depth) const
+    {
+        Scalar wallFactor = wall_factor();
+        return {(bottomWidth + sideSlope * depth) * depth,
+                bottomWidth + wallFactor * depth,
+                bottomWidth + 2.0 * sideSlope * depth,
+                wallFactor};
+    }
+};
+
+template <typename Scalar>
+struct BasicTriangularSection
+{
+    Scalar sideSlope{0.0};
+
+    Scalar wall_factor() const
+    {
+        using std::sqrt;
+        return 2.0 * sqrt(sideSlope * sideSlope + 1.0);
+    }
+
+    Scalar calculate_area(const Scalar& depth) const { return sideSlope * depth * depth; }
+    Scalar calculate_wetted_perimeter(const Scalar& depth) const { return wall_factor() * depth; }
+    Scalar calculate_top_width(const Scalar& depth) const { return 2.0 * sideSlope * depth; }
+    Scalar calculate_wetted_perimeter_derivative(const Scalar& /*depth*/) const { return wall_factor(); }
+    Scalar calculate_first_moment(const Scalar& depth) const { return sideSlope * depth * depth * depth / 3.0; }
+    bool is_valid() const { return sideSlope > 0.0; }
+
+    BasicSectionProperties<Scalar> evaluate(const Scalar& depth) const
+    {
+        Scalar wallFactor = wall_factor();
+        return {sideSlope * depth * depth, wallFactor * depth, 2.0 * sideSlope * depth, wallFactor};
+    }
+};
+
+using SectionProperties = BasicSectionProperties<double>;
+using RectangularSection = BasicRectangularSection<double>;
+using TrapezoidalSection = BasicTrapezoidalSection<double>;
+using TriangularSection = BasicTriangularSection<double>;
+
+using ChannelSection = std::variant<RectangularSection, TrapezoidalSection, TriangularSection>;
+
+#endif // CHANNELGEOMETRY_H
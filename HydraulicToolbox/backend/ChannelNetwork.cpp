@@ -0,0 +1,153 @@
+#include "ChannelNetwork.h"
+
+namespace
+{
+bool is_valid_reach(const NetworkReach& reach)
+{
+    bool isSectionValid = std::visit([](const auto& section) { return section.is_valid(); }, reach.section);
+
+    return isSectionValid && reach.length > 0.0 && reach.bedSlope > 0.0 && reach.manningN > 0.0 &&
+           reach.lateralInflow >= 0.0 && reach.junctionDrop >= 0.0;
+}
+}
+
+const char* get_network_error_message(NetworkError error)
+{
+    switch (error)
+    {
+    case NetworkError::None:
+        return "";
+    case NetworkError::Empty:
+        return "Network has no reaches";
+    case NetworkError::InvalidReach:
+        return "Reach has invalid geometry, slope, roughness or inflow";
+    case NetworkError::InvalidDownstream:
+        return "Reach drains into a reach that does not exist";
+    case NetworkError::Cycle:
+        return "Reaches form a loop";
+    default:
+        return "Unknown error";
+    }
+}
+
+ChannelNetwork::ChannelNetwork(std::vector<NetworkReach> reaches)
+    : reaches_{std::move(reaches)}
+{
+    error_ = build();
+}
+
+NetworkError ChannelNetwork::build()
+{
+    std::size_t reachCount = reaches_.size();
+
+    if (reachCount == 0)
+        return NetworkError::Empty;
+
+    upstreamOffsets_.assign(reachCount + 1, 0);
+
+    for (std::size_t reach = 0; reach < reachCount; ++reach)
+    {
+        std::size_t downstream = reaches_[reach].downstream;
+
+        if (!is_valid_reach(reaches_[reach]))
+            return NetworkError::InvalidReach;
+
+        if (downstream == NO_REACH)
+            outlets_.push_back(reach);
+        else if (downstream >= reachCount || downstream == reach)
+            return NetworkError::InvalidDownstream;
+        else
+            ++upstreamOffsets_[downstream + 1];
+    }
+
+    for (std::size_t reach = 0; reach < reachCount; ++reach)
+        upstreamOffsets_[reach + 1] += upstreamOffsets_[reach];
+
+    upstreamReaches_.resize(upstreamOffsets_[reachCount]);
+    std::vector<std::size_t> fill(upstreamOffsets_.begin(), upstreamOffsets_.end() - 1);
+
+    for (std::size_t reach = 0; reach < reachCount; ++reach)
+    {
+        if (reaches_[reach].downstream != NO_REACH)
+            upstreamReaches_[fill[reaches_[reach].downstream]++] = reach;
+    }
+
+    // Kahn's algorithm from the headwaters; reaches on a loop never run out
+    // of unvisited upstream reaches and are left over.
+    std::vector<std::size_t> remaining(reachCount);
+    topologicalOrder_.reserve(reachCount);
+
+    for (std::size_t reach = 0; reach < reachCount; ++reach)
+    {
+        remaining[reach] = get_upstream_count(reach);
+
+        if (remaining[reach] == 0)
+        {
+            headwaters_.push_back(reach);
+            topologicalOrder_.push_back(reach);
+        }
+    }
+
+    for (std::size_t next = 0; next < topologicalOrder_.size(); ++next)
+    {
+        std::size_t downstream = reaches_[topologicalOrder_[next]].downstream;
+
+        if (downstream != NO_REACH && --remaining[downstream] == 0)
+            topologicalOrder_.push_back(downstream);
+    }
+
+    if (topologicalOrder_.size() != reachCount)
+        return NetworkError::Cycle;
+
+    return NetworkError::None;
+}
+
+bool ChannelNetwork::is_valid() const
+{
+    return error_ == NetworkError::None;
+}
+
+NetworkError ChannelNetwork::get_error() const
+{
+    return error_;
+}
+
+std::size_t ChannelNetwork::get_reach_count() const
+{
+    return reaches_.size();
+}
+
+const NetworkReach& ChannelNetwork::get_reach(std::size_t reach) const
+{
+    return reaches_[reach];
+}
+
+const std::size_t* ChannelNetwork::get_upstream_begin(std::size_t reach) const
+{
+    return upstreamReaches_.data() + upstreamOffsets_[reach];
+}
+
+const std::size_t* ChannelNetwork::get_upstream_end(std::size_t reach) const
+{
+    return upstreamReaches_.data() + upstreamOffsets_[reach + 1];
+}
+
+std::size_t ChannelNetwork::get_upstream_count(std::size_t reach) const
+{
+    return upstreamOffsets_[reach + 1] - upstreamOffsets_[reach];
+}
+
+const std::vector<std::size_t>& ChannelNetwork::get_headwaters() const
+{
+    return headwaters_;
+}
+
+const std::vector<std::size_t>& ChannelNetwork::get_outlets() const
+{
+    return outlets_;
+}
+
+const std::vector<std::size_t>& ChannelNetwork::get_topological_order() const
+{
+    return topologicalOrder_;
+}
@@ -0,0 +1,76 @@
+#ifndef CHANNELNETWORK_H
+#define CHANNELNETWORK_H
+
+#include "ChannelGeometry.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+constexpr std::size_t NO_REACH = static_cast<std::size_t>(-1);
+
+// One prismatic reach of a dendritic network. Water enters at the upstream
+// end (from the upstream reaches plus the lateral inflow) and leaves at the
+// downstream end into `downstream`; a reach without one is an outlet.
+struct NetworkReach
+{
+    ChannelSection section;
+    double length{0.0};
+    double bedSlope{0.0};
+    double manningN{0.0};
+    double lateralInflow{0.0};       // Inlet or catchment inflow at the upstream end
+    double junctionDrop{0.0};        // Invert drop from the downstream end into the downstream reach
+    std::size_t downstream{NO_REACH};
+};
+
+enum class NetworkError : std::uint8_t
+{
+    None,
+    Empty,
+    InvalidReach,           // Bad section, length, slope, n, inflow or drop
+    InvalidDownstream,      // Downstream index out of range or the reach itself
+    Cycle
+};
+
+const char* get_network_error_message(NetworkError error);
+
+// Validated tree of reaches. Construction checks every reach, builds the
+// upstream adjacency in compressed form and a topological order from the
+// headwaters to the outlets; a network with a loop or a dangling
+// downstream index is kept but reported invalid.
+class ChannelNetwork
+{
+public:
+    ChannelNetwork() = default;
+    explicit ChannelNetwork(std::vector<NetworkReach> reaches);
+
+    bool is_valid() const;
+    NetworkError get_error() const;
+
+    std::size_t get_reach_count() const;
+    const NetworkReach& get_reach(std::size_t reach) const;
+
+    // Reaches draining directly into `reach`, as [begin, end).
+    const std::size_t* get_upstream_begin(std::size_t reach) const;
+    const std::size_t* get_upstream_end(std::size_t reach) const;
+    std::size_t get_upstream_count(std::size_t reach) const;
+
+    // Reaches without upstream reaches, and reaches without a downstream one.
+    const std::vector<std::size_t>& get_headwaters() const;
+    const std::vector<std::size_t>& get_outlets() const;
+
+    // Every reach after all of its upstream reaches.
+    const std::vector<std::size_t>& get_topological_order() const;
+
+private:
+    NetworkError build();
+
+    std::vector<NetworkReach> reaches_;
+    std::vector<std::size_t> upstreamOffsets_;
+    std::vector<std::size_t> upstreamReaches_;
+    std::vector<std::size_t> headwaters_;
+    std::vector<std::size_t> outlets_;
+    std::vector<std::size_t> topologicalOrder_;
+    NetworkError error_{NetworkError::Empty};
+};
+
+#endif // CHANNELNETWORK_H
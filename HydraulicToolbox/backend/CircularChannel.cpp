@@ -0,0 +1,241 @@
+#include "CircularChannel.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace
+{
+constexpr double PI{3.14159265358979323846};
+
+// Uniform in y/D. The first and last EDGE_INTERVALS intervals are evaluated
+// exactly: dP/dy is unbounded at the invert and the crown, so a cubic would
+// lose accuracy there.
+constexpr std::size_t TABLE_INTERVALS{1024};
+constexpr std::size_t EDGE_INTERVALS{32};
+constexpr double TABLE_STEP{1.0 / static_cast<double>(TABLE_INTERVALS)};
+constexpr double EDGE_RATIO{static_cast<double>(EDGE_INTERVALS) * TABLE_STEP};
+
+// Section properties of the unit circle (D = 1) at depth ratio u.
+struct UnitProperties
+{
+    double area{0.0};
+    double wettedPerimeter{0.0};
+    double topWidth{0.0};
+    double wettedPerimeterDerivative{0.0};
+    double firstMoment{0.0};
+};
+
+// With the wetted central angle theta = 2 acos(1 - 2u): A = (theta - sin
+// theta) / 8, P = theta / 2, T = 2 sqrt(u (1 - u)) and M = (3 s - s^3 -
+// 3 (theta/2) c) / 24 with s, c the sine and cosine of theta/2.
+UnitProperties evaluate_exact(double ratio)
+{
+    UnitProperties properties;
+
+    double halfAngle = std::acos(1.0 - 2.0 * ratio);
+    double sine = std::sin(halfAngle);
+    double cosine = std::cos(halfAngle);
+    double rootProduct = std::sqrt(ratio * (1.0 - ratio));
+
+    properties.area = (halfAngle - sine * cosine) / 4.0;
+    properties.wettedPerimeter = halfAngle;
+    properties.topWidth = 2.0 * rootProduct;
+    properties.wettedPerimeterDerivative = rootProduct > 0.0 ? 1.0 / rootProduct : 0.0;
+    properties.firstMoment = (3.0 * sine - sine * sine * sine - 3.0 * halfAngle * cosine) / 24.0;
+    return properties;
+}
+
+struct TableNode
+{
+    double area{0.0};
+    double wettedPerimeter{0.0};
+    double firstMoment{0.0};
+    double topWidth{0.0};                    // dA/du
+    double wettedPerimeterDerivative{0.0};   // dP/du
+};
+
+class PartialFlowTable
+{
+public:
+    static const PartialFlowTable& instance()
+    {
+        static const PartialFlowTable table;
+        return table;
+    }
+
+    UnitProperties evaluate(double ratio) const
+    {
+        if (ratio < EDGE_RATIO || ratio > 1.0 - EDGE_RATIO)
+            return evaluate_exact(ratio);
+
+        double position = ratio * static_cast<double>(TABLE_INTERVALS);
+        std::size_t index = std::min(static_cast<std::size_t>(position), TABLE_INTERVALS - 1);
+        double s = position - static_cast<double>(index);
+
+        const TableNode& low = nodes_[index];
+        const TableNode& high = nodes_[index + 1];
+
+        // Cubic Hermite basis; slopes are scaled by the interval width.
+        double s2 = s * s;
+        double lowValue = (1.0 + 2.0 * s) * (1.0 - s) * (1.0 - s);
+        double lowSlope = s * (1.0 - s) * (1.0 - s) * TABLE_STEP;
+        double highValue = s2 * (3.0 - 2.0 * s);
+        double highSlope = s2 * (s - 1.0) * TABLE_STEP;
+
+        double rootProduct = std::sqrt(ratio * (1.0 - ratio));
+
+        UnitProperties properties;
+        properties.area = lowValue * low.area + lowSlope * low.topWidth
+                          + highValue * high.area + highSlope * high.topWidth;
+        properties.wettedPerimeter = lowValue * low.wettedPerimeter + lowSlope * low.wettedPerimeterDerivative
+                                     + highValue * high.wettedPerimeter + highSlope * high.wettedPerimeterDerivative;
+        properties.firstMoment = lowValue * low.firstMoment + lowSlope * low.area
+                                 + highValue * high.firstMoment + highSlope * high.area;
+        properties.topWidth = 2.0 * rootProduct;
+        properties.wettedPerimeterDerivative = 1.0 / rootProduct;
+        return properties;
+    }
+
+    double get_max_conveyance_ratio() const
+    {
+        return maxConveyanceRatio_;
+    }
+
+private:
+    PartialFlowTable()
+    {
+        for (std::size_t i = 0; i <= TABLE_INTERVALS; ++i)
+        {
+            UnitProperties exact = evaluate_exact(static_cast<double>(i) * TABLE_STEP);
+            nodes_[i] = TableNode{exact.area, exact.wettedPerimeter, exact.firstMoment,
+                                  exact.topWidth, exact.wettedPerimeterDerivative};
+        }
+
+        // Conveyance A^(5/3) / P^(2/3) peaks once, between half and full.
+        // Golden-section search on the exact formulas.
+        auto log_conveyance = [](double ratio)
+        {
+            UnitProperties properties = evaluate_exact(ratio);
+            return 5.0 * std::log(properties.area) - 2.0 * std::log(properties.wettedPerimeter);
+        };
+
+        const double goldenRatio = 0.5 * (std::sqrt(5.0) - 1.0);
+        double low{0.5};
+        double high{1.0};
+
+        while (high - low > 1e-13)
+        {
+            double left = high - goldenRatio * (high - low);
+            double right = low + goldenRatio * (high - low);
+
+            if (log_conveyance(left) < log_conveyance(right))
+                low = left;
+            else
+                high = right;
+        }
+
+        maxConveyanceRatio_ = 0.5 * (low + high);
+    }
+
+    std::array<TableNode, TABLE_INTERVALS + 1> nodes_{};
+    double maxConveyanceRatio_{0.0};
+};
+}
+
+double CircularChannel::get_max_conveyance_depth_ratio()
+{
+    return PartialFlowTable::instance().get_max_conveyance_ratio();
+}
+
+CircularChannel::CircularChannel(double diameter, double depth)
+    : diameter_{diameter}
+    , depth_{depth}
+    , properties_{}
+    , firstMoment_{0.0}
+{
+    set_depth(depth);
+}
+
+SectionProperties CircularChannel::evaluate(double depth, double& firstMoment) const
+{
+    firstMoment = 0.0;
+
+    if (!(diameter_ > 0.0) || !(depth > 0.0))
+        return SectionProperties{};
+
+    double diameterSquared = diameter_ * diameter_;
+
+    // Full: no free surface; the first moment is taken about the
+    // hydraulic grade line at `depth` above the invert.
+    if (depth >= diameter_)
+    {
+        double area = 0.25 * PI * diameterSquared;
+        firstMoment = area * (depth - 0.5 * diameter_);
+        return SectionProperties{area, PI * diameter_, 0.0, 0.0};
+    }
+
+    UnitProperties unit = PartialFlowTable::instance().evaluate(depth / diameter_);
+
+    firstMoment = unit.firstMoment * diameterSquared * diameter_;
+    return SectionProperties{unit.area * diameterSquared,
+                             unit.wettedPerimeter * diameter_,
+                             unit.topWidth * diameter_,
+                             unit.wettedPerimeterDerivative};
+}
+
+SectionProperties CircularChannel::evaluate(double depth) const
+{
+    double firstMoment{0.0};
+    return evaluate(depth, firstMoment);
+}
+
+double CircularChannel::calculate_area() const
+{
+    return properties_.area;
+}
+
+double CircularChannel::calculate_wetted_perimeter() const
+{
+    return properties_.wettedPerimeter;
+}
+
+bool CircularChannel::is_valid() const
+{
+    return diameter_ > 0.0 && depth_ > 0.0;
+}
+
+void CircularChannel::set_depth(double depth)
+{
+    depth_ = depth;
+    properties_ = evaluate(depth_, firstMoment_);
+}
+
+double CircularChannel::calculate_top_width() const
+{
+    return properties_.topWidth;
+}
+
+double CircularChannel::calculate_wetted_perimeter_derivative() const
+{
+    return properties_.wettedPerimeterDerivative;
+}
+
+double CircularChannel::calculate_first_moment_of_area() const
+{
+    return firstMoment_;
+}
+
+double CircularChannel::get_full_flow_depth() const
+{
+    return diameter_;
+}
+
+double CircularChannel::get_max_conveyance_depth() const
+{
+    return get_max_conveyance_depth_ratio() * diameter_;
+}
+
+double CircularChannel::get_diameter() const
+{
+    return diameter_;
+}
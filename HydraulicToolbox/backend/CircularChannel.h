@@ -0,0 +1,50 @@
+#ifndef CIRCULARCHANNEL_H
+#define CIRCULARCHANNEL_H
+
+#include "Channel.h"
+#include "ChannelGeometry.h"
+
+// Circular pipe or culvert of diameter D, flowing partly full below the
+// crown and full (pressurized) above it.
+//
+// Partial-flow geometry is read from one process-wide table of A/D^2, P/D
+// and the first moment M/D^3 against y/D, built on first use. Between nodes
+// the table is interpolated with cubic Hermite polynomials, using the exact
+// slopes T, dP/dy and A, so no trigonometry runs on most evaluations. The
+// top width and dP/dy need only a square root and are always exact. Near
+// the invert and the crown, where dP/dy is singular, the exact formulas are
+// used instead.
+class CircularChannel : public Channel
+{
+public:
+    // Depth ratio y/D of maximum conveyance, where a circular pipe carries
+    // about 7.6% more than flowing full.
+    static double get_max_conveyance_depth_ratio();
+
+    CircularChannel(double diameter, double depth);
+
+    double calculate_area() const override;
+    double calculate_wetted_perimeter() const override;
+    bool is_valid() const override;
+    void set_depth(double depth) override;
+    double calculate_top_width() const override;
+    double calculate_wetted_perimeter_derivative() const override;
+    double calculate_first_moment_of_area() const override;
+    double get_full_flow_depth() const override;
+    double get_max_conveyance_depth() const override;
+
+    // Properties at any depth without changing the channel's own depth.
+    SectionProperties evaluate(double depth) const;
+
+    double get_diameter() const;
+
+private:
+    SectionProperties evaluate(double depth, double& firstMoment) const;
+
+    double diameter_;
+    double depth_;
+    SectionProperties properties_;
+    double firstMoment_;
+};
+
+#endif // CIRCULARCHANNEL_H
@@ -0,0 +1,88 @@
+#include "CompositeRoughness.h"
+#include <cmath>
+
+const char* get_composite_roughness_method_name(CompositeRoughnessMethod method)
+{
+    switch (method)
+    {
+    case CompositeRoughnessMethod::HortonEinstein:
+        return "Horton-Einstein";
+    case CompositeRoughnessMethod::Lotter:
+        return "Lotter";
+    case CompositeRoughnessMethod::Pavlovskii:
+        return "Pavlovskii";
+    default:
+        return "Unknown";
+    }
+}
+
+double get_composite_roughness_exponent(CompositeRoughnessMethod method)
+{
+    switch (method)
+    {
+    case CompositeRoughnessMethod::Lotter:
+        return -1.0;
+    case CompositeRoughnessMethod::Pavlovskii:
+        return 2.0;
+    default:
+        return 1.5;
+    }
+}
+
+CompositeRoughness::CompositeRoughness(CompositeRoughnessMethod method, double bedN, double leftBankN, double rightBankN)
+    : method_{method}
+    , bedN_{bedN}
+    , leftBankN_{leftBankN}
+    , rightBankN_{rightBankN}
+    , exponent_{get_composite_roughness_exponent(method)}
+    , bedWeight_{std::pow(bedN, exponent_)}
+    , bankWeight_{0.5 * (std::pow(leftBankN, exponent_) + std::pow(rightBankN, exponent_))}
+    , inverseExponent_{1.0 / exponent_}
+{
+}
+
+// With W = sum P_i n_i^p = P_bed w_bed + y P' w_bank, where w_bank averages
+// the two banks, n = (W / P)^(1/p). The bed length is constant, so
+// W' = P' w_bank and dn/dy = (n / p) (W' / W - P' / P).
+CompositeRoughnessProperties CompositeRoughness::evaluate(double depth, const SectionProperties& properties) const
+{
+    CompositeRoughnessProperties roughness;
+
+    double bankLength = depth * properties.wettedPerimeterDerivative;
+    double bedLength = properties.wettedPerimeter - bankLength;
+    double weightedPerimeter = bedLength * bedWeight_ + bankLength * bankWeight_;
+
+    if (!(weightedPerimeter > 0.0 && properties.wettedPerimeter > 0.0))
+        return roughness;
+
+    roughness.manningN = std::pow(weightedPerimeter / properties.wettedPerimeter, inverseExponent_);
+    roughness.manningNDerivative = roughness.manningN * inverseExponent_
+                                   * properties.wettedPerimeterDerivative
+                                   * (bankWeight_ / weightedPerimeter - 1.0 / properties.wettedPerimeter);
+    return roughness;
+}
+
+bool CompositeRoughness::is_valid() const
+{
+    return bedN_ > 0.0 && leftBankN_ > 0.0 && rightBankN_ > 0.0;
+}
+
+CompositeRoughnessMethod CompositeRoughness::get_method() const
+{
+    return method_;
+}
+
+double CompositeRoughness::get_bed_n() const
+{
+    return bedN_;
+}
+
+double CompositeRoughness::get_left_bank_n() const
+{
+    return leftBankN_;
+}
+
+double CompositeRoughness::get_right_bank_n() const
+{
+    return rightBankN_;
+}
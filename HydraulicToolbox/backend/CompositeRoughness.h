@@ -0,0 +1,66 @@
+#ifndef COMPOSITEROUGHNESS_H
+#define COMPOSITEROUGHNESS_H
+
+#include "ChannelGeometry.h"
+#include <cstdint>
+
+// Ways of combining the roughness of perimeter segments into one equivalent
+// Manning's n. Each is a power mean of the segment n values weighted by
+// their wetted lengths,
+//     n = (sum P_i n_i^p / P)^(1/p),
+// with p = 3/2 (Horton-Einstein: equal mean velocity in every subarea),
+// p = 2 (Pavlovskii: shear forces add up) and p = -1 (Lotter: discharges
+// add up, with every subarea at the hydraulic radius of the whole section).
+enum class CompositeRoughnessMethod : std::uint8_t
+{
+    HortonEinstein,
+    Lotter,
+    Pavlovskii
+};
+
+const char* get_composite_roughness_method_name(CompositeRoughnessMethod method);
+
+// Exponent p of the power mean used by `method`.
+double get_composite_roughness_exponent(CompositeRoughnessMethod method);
+
+struct CompositeRoughnessProperties
+{
+    double manningN{0.0};
+    double manningNDerivative{0.0};   // dn/dy
+};
+
+// Bed and bank roughness of a prismatic section whose banks are straight
+// from the invert (the rectangular, trapezoidal and triangular sections).
+// For those, the bank length is y P' / 2 per side and the bed is the rest of
+// the perimeter, so the wetted segments follow from SectionProperties alone
+// and the equivalent n costs a few multiplications, one division and one
+// power per depth.
+class CompositeRoughness
+{
+public:
+    CompositeRoughness(CompositeRoughnessMethod method, double bedN, double leftBankN, double rightBankN);
+
+    // Equivalent n and its depth derivative for the section properties at
+    // `depth`.
+    CompositeRoughnessProperties evaluate(double depth, const SectionProperties& properties) const;
+
+    bool is_valid() const;
+    CompositeRoughnessMethod get_method() const;
+    double get_bed_n() const;
+    double get_left_bank_n() const;
+    double get_right_bank_n() const;
+
+private:
+    CompositeRoughnessMethod method_;
+    double bedN_;
+    double leftBankN_;
+    double rightBankN_;
+
+    // n_i^p for the bed and the summed banks, and 1 / p.
+    double exponent_;
+    double bedWeight_;
+    double bankWeight_;
+    double inverseExponent_;
+};
+
+#endif // COMPOSITEROUGHNESS_H
@@ -0,0 +1,126 @@
+#include "CompoundSection.h"
+#include "NormalDepthEstimator.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+bool is_valid_floodplain(const Floodplain& floodplain)
+{
+    bool isPresent = floodplain.width > 0.0 || floodplain.sideSlope > 0.0;
+
+    return floodplain.width >= 0.0 && floodplain.sideSlope >= 0.0 && std::isfinite(floodplain.width)
+           && std::isfinite(floodplain.sideSlope) && (!isPresent || floodplain.manningN > 0.0);
+}
+}
+
+CompoundSection::CompoundSection(double bottomWidth, double sideSlope, double bankHeight, double manningN,
+                                 const Floodplain& leftOverbank, const Floodplain& rightOverbank)
+    : baseHeights_{bankHeight, 0.0, bankHeight}
+    , capHeights_{std::numeric_limits<double>::infinity(), bankHeight, std::numeric_limits<double>::infinity()}
+    , bottomWidths_{leftOverbank.width, bottomWidth, rightOverbank.width}
+    , spreads_{leftOverbank.sideSlope, 2.0 * sideSlope, rightOverbank.sideSlope}
+    , wallFactors_{std::sqrt(1.0 + leftOverbank.sideSlope * leftOverbank.sideSlope),
+                   2.0 * std::sqrt(1.0 + sideSlope * sideSlope),
+                   std::sqrt(1.0 + rightOverbank.sideSlope * rightOverbank.sideSlope)}
+    , manningNs_{leftOverbank.manningN, manningN, rightOverbank.manningN}
+    , sideSlope_{sideSlope}
+    , isValid_{bottomWidth >= 0.0 && sideSlope >= 0.0 && (bottomWidth > 0.0 || sideSlope > 0.0)
+               && bankHeight > 0.0 && std::isfinite(bankHeight) && manningN > 0.0
+               && is_valid_floodplain(leftOverbank) && is_valid_floodplain(rightOverbank)}
+{
+}
+
+// For a subsection with local depth d above its base, slab depth
+// s = min(d, cap) and e = d - s above the cap:
+//   A = (b + c s / 2) s + (b + c s) e     P = b + w s     T = b + c s
+// where c is the spread and w the wall factor; P' = w only below the cap.
+CompoundSectionProperties CompoundSection::evaluate(double depth) const
+{
+    CompoundSectionProperties properties;
+
+    if (!isValid_ || !(depth > 0.0))
+        return properties;
+
+    double cubedConveyanceSum{0.0};   // Sum of K_i^3 / A_i^2
+
+    for (std::size_t i = 0; i < CompoundSubsection::COUNT; ++i)
+    {
+        double localDepth = depth - baseHeights_[i];
+        if (!(localDepth > 0.0))
+            continue;
+
+        double slabDepth = std::min(localDepth, capHeights_[i]);
+        double aboveCap = localDepth - slabDepth;
+        double topWidth = bottomWidths_[i] + spreads_[i] * slabDepth;
+
+        SectionProperties& subsection = properties.subsections[i];
+        subsection.area = (bottomWidths_[i] + 0.5 * spreads_[i] * slabDepth) * slabDepth + topWidth * aboveCap;
+        subsection.wettedPerimeter = bottomWidths_[i] + wallFactors_[i] * slabDepth;
+        subsection.topWidth = topWidth;
+        subsection.wettedPerimeterDerivative = aboveCap > 0.0 ? 0.0 : wallFactors_[i];
+
+        if (!(subsection.area > 0.0))
+            continue;
+
+        double hydraulicRadius = subsection.area / subsection.wettedPerimeter;
+        double conveyance = subsection.area * std::cbrt(hydraulicRadius * hydraulicRadius) / manningNs_[i];
+
+        properties.conveyances[i] = conveyance;
+        properties.area += subsection.area;
+        properties.topWidth += topWidth;
+        properties.conveyance += conveyance;
+        properties.conveyanceDerivative += conveyance * (5.0 * topWidth / subsection.area
+                                                         - 2.0 * subsection.wettedPerimeterDerivative
+                                                               / subsection.wettedPerimeter) / 3.0;
+        cubedConveyanceSum += conveyance * conveyance * conveyance / (subsection.area * subsection.area);
+    }
+
+    // alpha = (sum K_i^3 / A_i^2) / (K^3 / A^2)
+    if (properties.conveyance > 0.0)
+    {
+        double meanRatio = properties.area / properties.conveyance;
+        properties.velocityCoefficient = cubedConveyanceSum * meanRatio * meanRatio / properties.conveyance;
+    }
+
+    return properties;
+}
+
+bool CompoundSection::is_valid() const
+{
+    return isValid_;
+}
+
+double CompoundSection::get_bank_height() const
+{
+    return capHeights_[CompoundSubsection::MAIN_CHANNEL];
+}
+
+double CompoundSection::get_main_channel_manning_n() const
+{
+    return manningNs_[CompoundSubsection::MAIN_CHANNEL];
+}
+
+TrapezoidalSection CompoundSection::get_main_channel() const
+{
+    return TrapezoidalSection{bottomWidths_[CompoundSubsection::MAIN_CHANNEL], sideSlope_};
+}
+
+// Above the banks the added conveyance grows roughly like a set of wide
+// strips, dK ~ d^(5/3) over the bank height, so one probe at twice the
+// bank height fixes the scale of that power law.
+double estimate_normal_depth(const CompoundSection& section, double targetConveyance)
+{
+    if (!section.is_valid() || !(targetConveyance > 0.0))
+        return 0.0;
+
+    double bankHeight = section.get_bank_height();
+    double bankConveyance = section.evaluate(bankHeight).conveyance;
+
+    if (targetConveyance <= bankConveyance)
+        return estimate_normal_depth(section.get_main_channel(), targetConveyance * section.get_main_channel_manning_n());
+
+    double probeConveyance = section.evaluate(2.0 * bankHeight).conveyance - bankConveyance;
+    return bankHeight * (1.0 + std::pow((targetConveyance - bankConveyance) / probeConveyance, 0.6));
+}
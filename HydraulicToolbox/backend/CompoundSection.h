@@ -0,0 +1,82 @@
+#ifndef COMPOUNDSECTION_H
+#define COMPOUNDSECTION_H
+
+#include "ChannelGeometry.h"
+#include <array>
+#include <cstddef>
+
+// Subsection slots, ordered left to right across the section.
+namespace CompoundSubsection
+{
+constexpr std::size_t LEFT_OVERBANK = 0;
+constexpr std::size_t MAIN_CHANNEL = 1;
+constexpr std::size_t RIGHT_OVERBANK = 2;
+constexpr std::size_t COUNT = 3;
+}
+
+// Level floodplain at the top of a main-channel bank, bounded outside by a
+// sloped bank. A zero width with a zero side slope means no overbank.
+struct Floodplain
+{
+    double width{0.0};
+    double sideSlope{0.0};   // Outer bank, horizontal : vertical
+    double manningN{0.0};
+};
+
+// Properties of a compound section at one depth. Conveyances include the
+// subsection roughness, K_i = A_i R_i^(2/3) / n_i, so Q = k K sqrt(S).
+struct CompoundSectionProperties
+{
+    std::array<SectionProperties, CompoundSubsection::COUNT> subsections{};
+    std::array<double, CompoundSubsection::COUNT> conveyances{};
+    double area{0.0};
+    double topWidth{0.0};
+    double conveyance{0.0};
+    double conveyanceDerivative{0.0};   // dK/dy
+    double velocityCoefficient{1.0};    // Energy coefficient alpha
+};
+
+// Trapezoidal main channel with a floodplain on either bank, each with its
+// own Manning's n. Depth is measured from the main-channel invert; the
+// floodplains start at the bank height. Subsections are separated by
+// vertical lines at the bank tops that are not part of any wetted
+// perimeter (divided-channel method), so above the banks the main channel
+// only gains area.
+//
+// Every subsection is stored as the same shape: a sloped-wall slab from its
+// base height, capped for the main channel at the bank height, with a
+// rectangle of constant width above the cap. evaluate() therefore computes
+// all three subsections in one loop over the same parameter arrays.
+class CompoundSection
+{
+public:
+    CompoundSection(double bottomWidth, double sideSlope, double bankHeight, double manningN,
+                    const Floodplain& leftOverbank, const Floodplain& rightOverbank);
+
+    CompoundSectionProperties evaluate(double depth) const;
+
+    bool is_valid() const;
+    double get_bank_height() const;
+    double get_main_channel_manning_n() const;
+
+    // Main channel alone, for seeding the normal-depth solver.
+    TrapezoidalSection get_main_channel() const;
+
+private:
+    std::array<double, CompoundSubsection::COUNT> baseHeights_;
+    std::array<double, CompoundSubsection::COUNT> capHeights_;
+    std::array<double, CompoundSubsection::COUNT> bottomWidths_;
+    std::array<double, CompoundSubsection::COUNT> spreads_;        // dT/dy below the cap
+    std::array<double, CompoundSubsection::COUNT> wallFactors_;    // dP/dy below the cap
+    std::array<double, CompoundSubsection::COUNT> manningNs_;
+
+    double sideSlope_;
+    bool isValid_;
+};
+
+// Normal-depth estimate. In bank it is the main-channel trapezoid estimate;
+// over the banks it fits a power law to the conveyance added above them.
+// `targetConveyance` is Q / (k sqrt(S)).
+double estimate_normal_depth(const CompoundSection& section, double targetConveyance);
+
+#endif // COMPOUNDSECTION_H
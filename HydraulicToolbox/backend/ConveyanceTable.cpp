@@ -0,0 +1,217 @@
+#include "ConveyanceTable.h"
+#include "Channel.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+constexpr int INITIAL_INTERVALS{16};
+constexpr int MAX_REFINEMENT_LEVEL{24};
+
+double hermite(double t, double h, double v0, double v1, double m0, double m1)
+{
+    double t2 = t * t;
+    double t3 = t2 * t;
+    return (2.0 * t3 - 3.0 * t2 + 1.0) * v0
+           + (t3 - 2.0 * t2 + t) * h * m0
+           + (-2.0 * t3 + 3.0 * t2) * v1
+           + (t3 - t2) * h * m1;
+}
+}
+
+ConveyanceTable::ConveyanceTable(const ChannelSection& section, double minDepth, double maxDepth, double relativeTolerance)
+    : section_{section}
+    , relativeTolerance_{relativeTolerance}
+    , isValid_{false}
+{
+    build(minDepth, maxDepth);
+}
+
+ConveyanceTable::ConveyanceTable(const Channel& channel, double minDepth, double maxDepth, double relativeTolerance)
+    : section_{channel.get_channel_section()}
+    , relativeTolerance_{relativeTolerance}
+    , isValid_{false}
+{
+    build(minDepth, maxDepth);
+}
+
+void ConveyanceTable::build(double minDepth, double maxDepth)
+{
+    if (!section_ || !(minDepth > 0.0 && maxDepth > minDepth))
+        return;
+
+    double logMin = std::log(minDepth);
+    double step = (std::log(maxDepth) - logMin) / INITIAL_INTERVALS;
+
+    Sample low;
+    if (!sample(logMin, low))
+        return;
+
+    samples_.push_back(low);
+
+    for (int i = 1; i <= INITIAL_INTERVALS; ++i)
+    {
+        Sample high;
+        if (!sample(logMin + i * step, high))
+        {
+            samples_.clear();
+            return;
+        }
+
+        refine(low, high, 0);
+        low = high;
+    }
+
+    for (std::size_t i = 1; i < samples_.size(); ++i)
+    {
+        if (!(samples_[i].logConveyance > samples_[i - 1].logConveyance))
+        {
+            samples_.clear();
+            return;
+        }
+    }
+
+    for (const Sample& entry : samples_)
+    {
+        logConveyances_.push_back(entry.logConveyance);
+        inverseSlopes_.push_back(1.0 / entry.logSlope);
+    }
+
+    limit_slopes();
+    isValid_ = true;
+}
+
+bool ConveyanceTable::is_valid() const
+{
+    return isValid_;
+}
+
+std::size_t ConveyanceTable::size() const
+{
+    return samples_.size();
+}
+
+bool ConveyanceTable::sample(double logDepth, Sample& sample) const
+{
+    double depth = std::exp(logDepth);
+    SectionProperties properties = std::visit([depth](const auto& section) { return section.evaluate(depth); }, *section_);
+
+    double area{properties.area};
+    double perimeter{properties.wettedPerimeter};
+
+    if (!(area > 0.0 && perimeter > 0.0))
+        return false;
+
+    sample.logDepth = logDepth;
+    sample.logConveyance = (5.0 * std::log(area) - 2.0 * std::log(perimeter)) / 3.0;
+    sample.logSlope = depth * (5.0 * properties.topWidth / area
+                               - 2.0 * properties.wettedPerimeterDerivative / perimeter) / 3.0;
+
+    return std::isfinite(sample.logConveyance) && sample.logSlope > 0.0;
+}
+
+// Appends the samples needed between `low` (already stored) and `high` so
+// that the inverse interpolant reproduces the midpoint depth to within the
+// relative tolerance.
+void ConveyanceTable::refine(const Sample& low, const Sample& high, int level)
+{
+    Sample mid;
+    bool hasMid = level < MAX_REFINEMENT_LEVEL && sample(0.5 * (low.logDepth + high.logDepth), mid);
+
+    if (hasMid && std::abs(interpolate_log_depth(low, high, mid.logConveyance) - mid.logDepth) > relativeTolerance_)
+    {
+        refine(low, mid, level + 1);
+        refine(mid, high, level + 1);
+        return;
+    }
+
+    samples_.push_back(high);
+}
+
+double ConveyanceTable::interpolate_log_depth(const Sample& low, const Sample& high, double logConveyance) const
+{
+    double h = high.logConveyance - low.logConveyance;
+    double t = (logConveyance - low.logConveyance) / h;
+    return hermite(t, h, low.logDepth, high.logDepth, 1.0 / low.logSlope, 1.0 / high.logSlope);
+}
+
+// Fritsch-Carlson limiter: keeps each cubic segment monotone.
+void ConveyanceTable::limit_slopes()
+{
+    for (std::size_t i = 0; i + 1 < samples_.size(); ++i)
+    {
+        double secant = (samples_[i + 1].logDepth - samples_[i].logDepth)
+                        / (logConveyances_[i + 1] - logConveyances_[i]);
+        double alpha = inverseSlopes_[i] / secant;
+        double beta = inverseSlopes_[i + 1] / secant;
+        double magnitude = alpha * alpha + beta * beta;
+
+        if (magnitude > 9.0)
+        {
+            double tau = 3.0 / std::sqrt(magnitude);
+            inverseSlopes_[i] = tau * alpha * secant;
+            inverseSlopes_[i + 1] = tau * beta * secant;
+        }
+    }
+}
+
+double ConveyanceTable::interpolate_depth(double conveyance) const
+{
+    if (!isValid_ || !(conveyance > 0.0))
+        return 0.0;
+
+    double logConveyance = std::log(conveyance);
+
+    if (logConveyance < logConveyances_.front() || logConveyance > logConveyances_.back())
+        return 0.0;
+
+    auto upper = std::upper_bound(logConveyances_.begin(), logConveyances_.end(), logConveyance);
+    std::size_t index = static_cast<std::size_t>(upper - logConveyances_.begin());
+    index = std::clamp<std::size_t>(index, 1, logConveyances_.size() - 1) - 1;
+
+    double h = logConveyances_[index + 1] - logConveyances_[index];
+    double t = (logConveyance - logConveyances_[index]) / h;
+
+    return std::exp(hermite(t, h, samples_[index].logDepth, samples_[index + 1].logDepth,
+                            inverseSlopes_[index], inverseSlopes_[index + 1]));
+}
+
+AnalysisResult ConveyanceTable::solve_for_depth(const Flow& flow, double slope, double manningsCoefficient, double gravity) const
+{
+    AnalysisResult result;
+
+    if (!isValid_ || !flow.is_valid() || slope <= 0.0)
+        return result;
+
+    double targetDischarge{flow.get_discharge()};
+    double targetConveyance = targetDischarge * flow.get_manning_n() / (manningsCoefficient * std::sqrt(slope));
+
+    double tableDepth = interpolate_depth(targetConveyance);
+    if (tableDepth <= 0.0)
+        return result;
+
+    // One Newton step in ln y polishes the interpolated depth.
+    double logTarget = std::log(targetConveyance);
+    Sample estimate;
+    if (!sample(std::log(tableDepth), estimate))
+        return result;
+
+    double depth = std::exp(estimate.logDepth - (estimate.logConveyance - logTarget) / estimate.logSlope);
+
+    SectionProperties properties = std::visit([depth](const auto& section) { return section.evaluate(depth); }, *section_);
+    double area{properties.area};
+    double perimeter{properties.wettedPerimeter};
+    double topWidth{properties.topWidth};
+
+    double logConveyance = (5.0 * std::log(area) - 2.0 * std::log(perimeter)) / 3.0;
+
+    result.normalDepth = depth;
+    result.iterations = 1;
+    result.residual = std::abs(std::expm1(logConveyance - logTarget));
+    result.velocity = targetDischarge / area;
+    result.froudeNumber = result.velocity / std::sqrt(gravity * area / topWidth);
+    result.flowRegime = classify_flow_regime(result.froudeNumber);
+    result.isValid = std::isfinite(depth);
+
+    return result;
+}
@@ -0,0 +1,61 @@
+#ifndef CONVEYANCETABLE_H
+#define CONVEYANCETABLE_H
+
+#include "Analyzer.h"
+#include "ChannelGeometry.h"
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+class Channel;
+
+// Precomputed geometric conveyance K(y) = A R^(2/3) of one cross-section
+// (Manning's n is applied per query). K is monotone in depth, so normal
+// depth for any Q, n and S is found by binary search on the table followed
+// by one Newton polish step on the section itself.
+//
+// The table keeps its own copy of the section geometry, so queries leave the
+// source channel untouched and may run concurrently. Channels without a
+// value-type section (circular, box culvert, irregular) give an invalid table.
+class ConveyanceTable
+{
+public:
+    explicit ConveyanceTable(const ChannelSection& section,
+                             double minDepth = 0.001,
+                             double maxDepth = 1000.0,
+                             double relativeTolerance = 1e-6);
+    explicit ConveyanceTable(const Channel& channel,
+                             double minDepth = 0.001,
+                             double maxDepth = 1000.0,
+                             double relativeTolerance = 1e-6);
+
+    bool is_valid() const;
+    std::size_t size() const;
+
+    double interpolate_depth(double conveyance) const;
+
+    AnalysisResult solve_for_depth(const Flow& flow, double slope, double manningsCoefficient, double gravity) const;
+
+private:
+    struct Sample
+    {
+        double logDepth{0.0};
+        double logConveyance{0.0};
+        double logSlope{0.0};   // d ln K / d ln y
+    };
+
+    void build(double minDepth, double maxDepth);
+    bool sample(double logDepth, Sample& sample) const;
+    void refine(const Sample& low, const Sample& high, int level);
+    double interpolate_log_depth(const Sample& low, const Sample& high, double logConveyance) const;
+    void limit_slopes();
+
+    std::optional<ChannelSection> section_;
+    double relativeTolerance_;
+    std::vector<Sample> samples_;
+    std::vector<double> logConveyances_;
+    std::vector<double> inverseSlopes_;   // d ln y / d ln K, monotonicity-limited
+    bool isValid_;
+};
+
+#endif // CONVEYANCETABLE_H
@@ -0,0 +1,32 @@
+#ifndef COUNTERRANDOM_H
+#define COUNTERRANDOM_H
+
+#include <cstdint>
+
+// Counter-based random numbers: each value is a hash of (seed, counter,
+// stream), so sample i draws the same numbers no matter which thread
+// computes it or in what order. The stream index separates the independent
+// variables drawn for one sample.
+
+inline std::uint64_t mix_bits(std::uint64_t value)
+{
+    // SplitMix64 finalizer.
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+inline std::uint64_t counter_random_bits(std::uint64_t seed, std::uint64_t counter, std::uint32_t stream)
+{
+    return mix_bits(mix_bits(mix_bits(seed) ^ counter) ^ stream);
+}
+
+// Uniform on the open interval (0, 1), safe to pass to std::log.
+inline double counter_uniform(std::uint64_t seed, std::uint64_t counter, std::uint32_t stream)
+{
+    constexpr double INVERSE_2_POW_53{1.0 / 9007199254740992.0};
+    return (static_cast<double>(counter_random_bits(seed, counter, stream) >> 11) + 0.5) * INVERSE_2_POW_53;
+}
+
+#endif // COUNTERRANDOM_H
@@ -0,0 +1,93 @@
+#include "CriticalFlowAnalyzer.h"
+#include "Channel.h"
+
+// q = Q / b and A = b y give y_c = (q^2 / g)^(1/3).
+double calculate_exact_critical_depth(const RectangularSection& section, double discharge, double gravity)
+{
+    if (!section.is_valid() || !(discharge > 0.0) || !(gravity > 0.0))
+        return 0.0;
+
+    double unitDischarge = discharge / section.width;
+    return std::cbrt(unitDischarge * unitDischarge / gravity);
+}
+
+// Only the zero-bottom-width limit has a closed form; otherwise the quintic
+// Q^2 (b + 2 z y) = g ((b + z y) y)^3 is solved numerically.
+double calculate_exact_critical_depth(const TrapezoidalSection& section, double discharge, double gravity)
+{
+    if (section.bottomWidth <= 0.0)
+        return calculate_exact_critical_depth(TriangularSection{section.sideSlope}, discharge, gravity);
+
+    return 0.0;
+}
+
+// A = z y^2 and T = 2 z y give y_c = (2 Q^2 / (g z^2))^(1/5).
+double calculate_exact_critical_depth(const TriangularSection& section, double discharge, double gravity)
+{
+    if (!section.is_valid() || !(discharge > 0.0) || !(gravity > 0.0))
+        return 0.0;
+
+    return std::pow(2.0 * discharge * discharge / (gravity * section.sideSlope * section.sideSlope), 0.2);
+}
+
+CriticalFlowAnalyzer::CriticalFlowAnalyzer(const SolverSettings& settings)
+    : settings_{settings}
+{
+}
+
+const SolverSettings& CriticalFlowAnalyzer::get_settings() const
+{
+    return settings_;
+}
+
+CriticalFlowResult CriticalFlowAnalyzer::solve_critical_depth(Channel& channel, double discharge, double gravity) const
+{
+    SolveTimer timer{nullptr};
+
+    if (!(discharge > 0.0) || !(gravity > 0.0))
+    {
+        timer.finish(MetricSolver::CriticalDepth, 1, 1, 0);
+        return CriticalFlowResult{};
+    }
+
+    auto evaluate = [&channel](double depth)
+    {
+        channel.set_depth(depth);
+        return SectionProperties{channel.calculate_area(),
+                                 channel.calculate_wetted_perimeter(),
+                                 channel.calculate_top_width(),
+                                 channel.calculate_wetted_perimeter_derivative()};
+    };
+
+    // A closed conduit is searched up to just below its crown, where the top
+    // width of a circular section vanishes and the residual is still finite.
+    double maxDepth{settings_.maxDepth};
+    double fullFlowDepth = channel.get_full_flow_depth();
+
+    if (fullFlowDepth < maxDepth)
+        maxDepth = std::nextafter(fullFlowDepth, 0.0);
+
+    CriticalFlowResult result = solve(evaluate, discharge, gravity, maxDepth);
+
+    if (result.isValid)
+    {
+        result.minimumSpecificEnergy = calculate_specific_energy(channel, result.criticalDepth, discharge, gravity);
+        result.minimumSpecificForce = calculate_specific_force(channel, result.criticalDepth, discharge, gravity);
+        result.criticalVelocity = discharge / channel.calculate_area();
+    }
+
+    timer.finish(MetricSolver::CriticalDepth, 1, result.isValid ? 0 : 1, static_cast<std::uint64_t>(result.iterations));
+    return result;
+}
+
+double CriticalFlowAnalyzer::calculate_specific_energy(Channel& channel, double depth, double discharge, double gravity) const
+{
+    channel.set_depth(depth);
+    return ::calculate_specific_energy(depth, channel.calculate_area(), discharge, gravity);
+}
+
+double CriticalFlowAnalyzer::calculate_specific_force(Channel& channel, double depth, double discharge, double gravity) const
+{
+    channel.set_depth(depth);
+    return ::calculate_specific_force(channel.calculate_area(), channel.calculate_first_moment_of_area(), discharge, gravity);
+}
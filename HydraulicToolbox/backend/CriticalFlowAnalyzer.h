@@ -0,0 +1,204 @@
+#ifndef CRITICALFLOWANALYZER_H
+#define CRITICALFLOWANALYZER_H
+
+#include "Analyzer.h"
+#include "ChannelGeometry.h"
+#include "RootFinding.h"
+#include <cmath>
+#include <cstddef>
+#include <variant>
+
+class Channel;
+
+struct CriticalFlowResult
+{
+    double criticalDepth{0.0};
+    double criticalVelocity{0.0};
+    double minimumSpecificEnergy{0.0};   // E at critical depth
+    double minimumSpecificForce{0.0};    // M at critical depth
+    bool isValid{false};
+    int iterations{0};                   // 0 when a closed form applies
+};
+
+// Specific energy E = y + Q^2 / (2 g A^2), in length units.
+inline double calculate_specific_energy(double depth, double area, double discharge, double gravity)
+{
+    return depth + discharge * discharge / (2.0 * gravity * area * area);
+}
+
+// Specific force (momentum function) M = Q^2 / (g A) + A * ybar, in length^3.
+inline double calculate_specific_force(double area, double firstMoment, double discharge, double gravity)
+{
+    return discharge * discharge / (gravity * area) + firstMoment;
+}
+
+// Exact critical depths where Q^2 T / (g A^3) = 1 inverts in closed form.
+// They return 0 when no closed form applies and the depth is solved for.
+double calculate_exact_critical_depth(const RectangularSection& section, double discharge, double gravity);
+double calculate_exact_critical_depth(const TrapezoidalSection& section, double discharge, double gravity);
+double calculate_exact_critical_depth(const TriangularSection& section, double discharge, double gravity);
+
+template <typename Section>
+double calculate_exact_critical_depth(const Section& /*section*/, double /*discharge*/, double /*gravity*/)
+{
+    return 0.0;
+}
+
+// Critical depth and the specific-energy (E-y) and specific-force (M-y)
+// curves. Like Analyzer, it has a virtual-dispatch path for any Channel and
+// a devirtualized path per section type; the curve evaluators fill
+// contiguous arrays so the loop over depths vectorizes.
+class CriticalFlowAnalyzer
+{
+public:
+    CriticalFlowAnalyzer() = default;
+    explicit CriticalFlowAnalyzer(const SolverSettings& settings);
+
+    // Virtual-dispatch path for any Channel subtype.
+    CriticalFlowResult solve_critical_depth(Channel& channel, double discharge, double gravity) const;
+
+    // Devirtualized path, instantiated per section type.
+
+    template <typename Section>
+    CriticalFlowResult solve_section(const Section& section, double discharge, double gravity) const;
+
+    CriticalFlowResult solve_section(const ChannelSection& section, double discharge, double gravity) const;
+
+    // Both set the channel to `depth` before evaluating.
+    double calculate_specific_energy(Channel& channel, double depth, double discharge, double gravity) const;
+    double calculate_specific_force(Channel& channel, double depth, double discharge, double gravity) const;
+
+    // E(y) and M(y) for depths[0..count). Either output may be null.
+    template <typename Section>
+    void evaluate_curves(const Section& section, double discharge, double gravity,
+                         const double* depths, double* specificEnergy, double* specificForce, std::size_t count) const;
+
+    void evaluate_curves(const ChannelSection& section, double discharge, double gravity,
+                         const double* depths, double* specificEnergy, double* specificForce, std::size_t count) const;
+
+    const SolverSettings& get_settings() const;
+
+private:
+    template <typename Evaluate>
+    CriticalFlowResult solve(Evaluate&& evaluate, double discharge, double gravity, double maxDepth) const;
+
+    SolverSettings settings_;
+};
+
+// ============================================================================
+// TEMPLATE IMPLEMENTATION
+// ============================================================================
+
+template <typename Section>
+CriticalFlowResult CriticalFlowAnalyzer::solve_section(const Section& section, double discharge, double gravity) const
+{
+    SolveTimer timer{nullptr};
+    CriticalFlowResult result;
+
+    if (!section.is_valid() || !(discharge > 0.0) || !(gravity > 0.0))
+    {
+        timer.finish(MetricSolver::CriticalDepth, 1, 1, 0);
+        return result;
+    }
+
+    double exactDepth = calculate_exact_critical_depth(section, discharge, gravity);
+
+    if (exactDepth > 0.0)
+    {
+        result.criticalDepth = exactDepth;
+        result.isValid = true;
+    }
+    else
+    {
+        result = solve([&section](double depth) { return section.evaluate(depth); }, discharge, gravity, settings_.maxDepth);
+    }
+
+    if (result.isValid)
+    {
+        double depth{result.criticalDepth};
+        double area = section.calculate_area(depth);
+
+        result.criticalVelocity = discharge / area;
+        result.minimumSpecificEnergy = ::calculate_specific_energy(depth, area, discharge, gravity);
+        result.minimumSpecificForce = ::calculate_specific_force(area, section.calculate_first_moment(depth), discharge, gravity);
+    }
+
+    timer.finish(MetricSolver::CriticalDepth, 1, result.isValid ? 0 : 1, static_cast<std::uint64_t>(result.iterations));
+    return result;
+}
+
+inline CriticalFlowResult CriticalFlowAnalyzer::solve_section(const ChannelSection& section, double discharge, double gravity) const
+{
+    return std::visit([&](const auto& concreteSection)
+                      { return solve_section(concreteSection, discharge, gravity); },
+                      section);
+}
+
+template <typename Section>
+void CriticalFlowAnalyzer::evaluate_curves(const Section& section, double discharge, double gravity,
+                                           const double* depths, double* specificEnergy, double* specificForce,
+                                           std::size_t count) const
+{
+    double velocityHeadFactor = discharge * discharge / (2.0 * gravity);
+    double momentumFactor = discharge * discharge / gravity;
+
+    if (specificEnergy)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            double area = section.calculate_area(depths[i]);
+            specificEnergy[i] = depths[i] + velocityHeadFactor / (area * area);
+        }
+    }
+
+    if (specificForce)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            double area = section.calculate_area(depths[i]);
+            specificForce[i] = momentumFactor / area + section.calculate_first_moment(depths[i]);
+        }
+    }
+}
+
+inline void CriticalFlowAnalyzer::evaluate_curves(const ChannelSection& section, double discharge, double gravity,
+                                                  const double* depths, double* specificEnergy, double* specificForce,
+                                                  std::size_t count) const
+{
+    std::visit([&](const auto& concreteSection)
+               { evaluate_curves(concreteSection, discharge, gravity, depths, specificEnergy, specificForce, count); },
+               section);
+}
+
+// Brent's method on h(s) = 3 ln A - ln T - ln(Q^2 / g) with s = ln y. h is
+// increasing for every prismatic section here, so the root is bracketed by
+// [ln minDepth, ln maxDepth] whenever one exists. Only A and T are needed,
+// so the Channel path works without extra derivatives.
+template <typename Evaluate>
+CriticalFlowResult CriticalFlowAnalyzer::solve(Evaluate&& evaluate, double discharge, double gravity, double maxDepth) const
+{
+    CriticalFlowResult result;
+
+    double logTarget = std::log(discharge * discharge / gravity);
+
+    auto residual = [&](double logDepth)
+    {
+        SectionProperties properties = evaluate(std::exp(logDepth));
+        return 3.0 * std::log(properties.area) - std::log(properties.topWidth) - logTarget;
+    };
+
+    RootResult root = find_root_brent(residual, std::log(settings_.minDepth), std::log(maxDepth),
+                                      settings_.relativeTolerance, settings_.maxIterations);
+
+    result.iterations = root.iterations;
+
+    if (root.converged)
+    {
+        result.criticalDepth = std::exp(root.root);
+        result.isValid = true;
+    }
+
+    return result;
+}
+
+#endif // CRITICALFLOWANALYZER_H
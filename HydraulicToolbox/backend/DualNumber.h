@@ -0,0 +1,173 @@
+#ifndef DUALNUMBER_H
+#define DUALNUMBER_H
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+// Forward-mode automatic differentiation scalar: a value and its gradient
+// with respect to N independent variables. Arithmetic applies the chain rule
+// to every gradient slot, so any formula written generically over the scalar
+// type yields exact first derivatives alongside its value.
+template <std::size_t N>
+struct DualNumber
+{
+    double value{0.0};
+    std::array<double, N> gradient{};
+
+    DualNumber() = default;
+    DualNumber(double constant) : value{constant} {}
+
+    // Independent variable seeded in the given gradient slot.
+    static DualNumber variable(double value, std::size_t index)
+    {
+        DualNumber result{value};
+        result.gradient[index] = 1.0;
+        return result;
+    }
+
+    // f(argument) given f and f' at argument.value.
+    static DualNumber compose(double value, double derivative, const DualNumber& argument)
+    {
+        DualNumber result{value};
+        for (std::size_t i = 0; i < N; ++i)
+            result.gradient[i] = derivative * argument.gradient[i];
+        return result;
+    }
+
+    DualNumber& operator+=(const DualNumber& other)
+    {
+        value += other.value;
+        for (std::size_t i = 0; i < N; ++i)
+            gradient[i] += other.gradient[i];
+        return *this;
+    }
+
+    DualNumber& operator-=(const DualNumber& other)
+    {
+        value -= other.value;
+        for (std::size_t i = 0; i < N; ++i)
+            gradient[i] -= other.gradient[i];
+        return *this;
+    }
+
+    DualNumber& operator*=(const DualNumber& other)
+    {
+        for (std::size_t i = 0; i < N; ++i)
+            gradient[i] = gradient[i] * other.value + value * other.gradient[i];
+        value *= other.value;
+        return *this;
+    }
+
+    DualNumber& operator/=(const DualNumber& other)
+    {
+        double inverse = 1.0 / other.value;
+        value *= inverse;
+        for (std::size_t i = 0; i < N; ++i)
+            gradient[i] = (gradient[i] - value * other.gradient[i]) * inverse;
+        return *this;
+    }
+};
+
+template <std::size_t N>
+DualNumber<N> operator-(const DualNumber<N>& operand)
+{
+    DualNumber<N> result{-operand.value};
+    for (std::size_t i = 0; i < N; ++i)
+        result.gradient[i] = -operand.gradient[i];
+    return result;
+}
+
+template <std::size_t N>
+DualNumber<N> operator+(DualNumber<N> left, const DualNumber<N>& right) { return left += right; }
+template <std::size_t N>
+DualNumber<N> operator+(DualNumber<N> left, double right) { return left += DualNumber<N>{right}; }
+template <std::size_t N>
+DualNumber<N> operator+(double left, DualNumber<N> right) { return right += DualNumber<N>{left}; }
+
+template <std::size_t N>
+DualNumber<N> operator-(DualNumber<N> left, const DualNumber<N>& right) { return left -= right; }
+template <std::size_t N>
+DualNumber<N> operator-(DualNumber<N> left, double right) { return left -= DualNumber<N>{right}; }
+template <std::size_t N>
+DualNumber<N> operator-(double left, const DualNumber<N>& right) { return DualNumber<N>{left} -= right; }
+
+template <std::size_t N>
+DualNumber<N> operator*(DualNumber<N> left, const DualNumber<N>& right) { return left *= right; }
+
+template <std::size_t N>
+DualNumber<N> operator*(DualNumber<N> left, double right)
+{
+    left.value *= right;
+    for (std::size_t i = 0; i < N; ++i)
+        left.gradient[i] *= right;
+    return left;
+}
+
+template <std::size_t N>
+DualNumber<N> operator*(double left, const DualNumber<N>& right) { return right * left; }
+
+template <std::size_t N>
+DualNumber<N> operator/(DualNumber<N> left, const DualNumber<N>& right) { return left /= right; }
+template <std::size_t N>
+DualNumber<N> operator/(const DualNumber<N>& left, double right) { return left * (1.0 / right); }
+template <std::size_t N>
+DualNumber<N> operator/(double left, const DualNumber<N>& right) { return DualNumber<N>{left} /= right; }
+
+// Comparisons look at the value only.
+template <std::size_t N>
+bool operator<(const DualNumber<N>& left, const DualNumber<N>& right) { return left.value < right.value; }
+template <std::size_t N>
+bool operator>(const DualNumber<N>& left, const DualNumber<N>& right) { return left.value > right.value; }
+template <std::size_t N>
+bool operator<=(const DualNumber<N>& left, const DualNumber<N>& right) { return left.value <= right.value; }
+template <std::size_t N>
+bool operator>=(const DualNumber<N>& left, const DualNumber<N>& right) { return left.value >= right.value; }
+
+template <std::size_t N>
+bool operator<(const DualNumber<N>& left, double right) { return left.value < right; }
+template <std::size_t N>
+bool operator>(const DualNumber<N>& left, double right) { return left.value > right; }
+template <std::size_t N>
+bool operator<=(const DualNumber<N>& left, double right) { return left.value <= right; }
+template <std::size_t N>
+bool operator>=(const DualNumber<N>& left, double right) { return left.value >= right; }
+
+template <std::size_t N>
+DualNumber<N> sqrt(const DualNumber<N>& x)
+{
+    double root = std::sqrt(x.value);
+    return DualNumber<N>::compose(root, 0.5 / root, x);
+}
+
+template <std::size_t N>
+DualNumber<N> pow(const DualNumber<N>& x, double exponent)
+{
+    return DualNumber<N>::compose(std::pow(x.value, exponent), exponent * std::pow(x.value, exponent - 1.0), x);
+}
+
+template <std::size_t N>
+DualNumber<N> log(const DualNumber<N>& x)
+{
+    return DualNumber<N>::compose(std::log(x.value), 1.0 / x.value, x);
+}
+
+template <std::size_t N>
+DualNumber<N> exp(const DualNumber<N>& x)
+{
+    double power = std::exp(x.value);
+    return DualNumber<N>::compose(power, power, x);
+}
+
+template <std::size_t N>
+DualNumber<N> abs(const DualNumber<N>& x)
+{
+    return x.value < 0.0 ? -x : x;
+}
+
+inline double value_of(double x) { return x; }
+
+template <std::size_t N>
+double value_of(const DualNumber<N>& x) { return x.value; }
+
+#endif // DUALNUMBER_H
@@ -0,0 +1,544 @@
+#include "DynamicWaveSolver.h"
+#include "DualNumber.h"
+#include "SectionTable.h"
+#include "UnitSystemConstants.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+using NodeScalar = DualNumber<2>;   // d/dQ, d/dy at one node
+using CellScalar = DualNumber<4>;   // d/dQ, d/dy at the upstream then the downstream node of a cell
+
+// Square system with two sub- and two superdiagonals, factored by Gaussian
+// elimination with partial pivoting. Row swaps fill in up to two more
+// superdiagonals, so each row stores seven entries.
+class BandedSystem
+{
+public:
+    explicit BandedSystem(std::size_t size)
+        : size_{size}
+        , coefficients_(size * WIDTH)
+        , rightHandSide_(size)
+    {
+    }
+
+    void clear()
+    {
+        std::fill(coefficients_.begin(), coefficients_.end(), 0.0);
+    }
+
+    double& at(std::size_t row, std::size_t column) { return coefficients_[row * WIDTH + column + LOWER - row]; }
+    double& rhs(std::size_t row) { return rightHandSide_[row]; }
+
+    // Overwrites the right-hand side with the solution. Returns false on a
+    // zero pivot.
+    bool solve()
+    {
+        for (std::size_t k = 0; k < size_; ++k)
+        {
+            std::size_t lastRow = std::min(size_ - 1, k + LOWER);
+            std::size_t lastColumn = std::min(size_ - 1, k + LOWER + UPPER);
+
+            std::size_t pivot{k};
+            for (std::size_t row = k + 1; row <= lastRow; ++row)
+            {
+                if (std::abs(at(row, k)) > std::abs(at(pivot, k)))
+                    pivot = row;
+            }
+
+            if (at(pivot, k) == 0.0)
+                return false;
+
+            if (pivot != k)
+            {
+                for (std::size_t column = k; column <= lastColumn; ++column)
+                    std::swap(at(k, column), at(pivot, column));
+                std::swap(rightHandSide_[k], rightHandSide_[pivot]);
+            }
+
+            for (std::size_t row = k + 1; row <= lastRow; ++row)
+            {
+                double factor = at(row, k) / at(k, k);
+                if (factor == 0.0)
+                    continue;
+
+                for (std::size_t column = k + 1; column <= lastColumn; ++column)
+                    at(row, column) -= factor * at(k, column);
+                rightHandSide_[row] -= factor * rightHandSide_[k];
+            }
+        }
+
+        for (std::size_t k = size_; k-- > 0;)
+        {
+            std::size_t lastColumn = std::min(size_ - 1, k + LOWER + UPPER);
+            double sum = rightHandSide_[k];
+
+            for (std::size_t column = k + 1; column <= lastColumn; ++column)
+                sum -= at(k, column) * rightHandSide_[column];
+
+            rightHandSide_[k] = sum / at(k, k);
+        }
+
+        return true;
+    }
+
+    const std::vector<double>& get_solution() const { return rightHandSide_; }
+
+    std::size_t get_memory_footprint() const
+    {
+        return (coefficients_.capacity() + rightHandSide_.capacity()) * sizeof(double);
+    }
+
+private:
+    static constexpr std::size_t LOWER{2};
+    static constexpr std::size_t UPPER{2};
+    static constexpr std::size_t WIDTH{2 * LOWER + UPPER + 1};
+
+    std::size_t size_;
+    std::vector<double> coefficients_;
+    std::vector<double> rightHandSide_;
+};
+
+template <typename T>
+std::size_t get_vector_footprint(const std::vector<T>& values)
+{
+    return values.capacity() * sizeof(T);
+}
+
+double compose(double value, double /*derivative*/, double /*argument*/)
+{
+    return value;
+}
+
+template <std::size_t N>
+DualNumber<N> compose(double value, double derivative, const DualNumber<N>& argument)
+{
+    return DualNumber<N>::compose(value, derivative, argument);
+}
+
+template <typename Scalar>
+struct NodeTerms
+{
+    Scalar area;
+    Scalar momentumFlux;    // Q^2 / A
+    Scalar friction;        // A (Sf - S0)
+};
+
+template <typename Scalar>
+NodeTerms<Scalar> evaluate_node(const SectionTable& table, const Scalar& discharge, const Scalar& depth,
+                                double conveyanceFactor, double bedSlope)
+{
+    using std::abs;
+
+    SectionTableEntry entry = table.lookup(value_of(depth));
+    Scalar area = compose(entry.area, entry.topWidth, depth);
+    Scalar conveyance = compose(conveyanceFactor * entry.conveyance, conveyanceFactor * entry.conveyanceDerivative, depth);
+
+    return {area, discharge * discharge / area, area * (discharge * abs(discharge) / (conveyance * conveyance) - bedSlope)};
+}
+
+// Node terms with gradient slots (Q, y) moved to (offset, offset + 1).
+NodeTerms<CellScalar> widen(const NodeTerms<NodeScalar>& terms, std::size_t offset)
+{
+    auto widen_scalar = [offset](const NodeScalar& scalar)
+    {
+        CellScalar result{scalar.value};
+        result.gradient[offset] = scalar.gradient[0];
+        result.gradient[offset + 1] = scalar.gradient[1];
+        return result;
+    };
+
+    return {widen_scalar(terms.area), widen_scalar(terms.momentumFlux), widen_scalar(terms.friction)};
+}
+
+void add_row(BandedSystem& system, std::size_t row, std::size_t firstColumn, const CellScalar& residual)
+{
+    for (std::size_t k = 0; k < 4; ++k)
+        system.at(row, firstColumn + k) = residual.gradient[k];
+    system.rhs(row) = -residual.value;
+}
+
+bool is_depth_in_table(const SectionTable& table, double depth)
+{
+    return depth > 0.0 && depth < table.get_max_depth();
+}
+
+bool is_area_in_table(const SectionTable& table, double area)
+{
+    return area > 0.0 && area < table.get_max_area();
+}
+
+double interpolate(const std::vector<double>& series, std::size_t step, double fraction)
+{
+    return series[step - 1] + fraction * (series[step] - series[step - 1]);
+}
+
+void record_step(DynamicWaveResult& result)
+{
+    result.outflow.push_back(result.discharge.back());
+    result.upstreamDepth.push_back(result.depth.front());
+}
+}
+
+const char* get_dynamic_wave_scheme_name(DynamicWaveScheme scheme)
+{
+    switch (scheme)
+    {
+    case DynamicWaveScheme::Preissmann:
+        return "Preissmann";
+    case DynamicWaveScheme::MacCormack:
+        return "MacCormack";
+    default:
+        return "Unknown";
+    }
+}
+
+const char* get_dynamic_wave_status_message(DynamicWaveStatus status)
+{
+    switch (status)
+    {
+    case DynamicWaveStatus::Completed:
+        return "Completed";
+    case DynamicWaveStatus::InvalidInput:
+        return "Invalid reach, boundary series or settings";
+    case DynamicWaveStatus::NotConverged:
+        return "Newton iteration did not converge";
+    case DynamicWaveStatus::DepthOutOfRange:
+        return "Depth left the section table (dry or overtopped)";
+    default:
+        return "Unknown";
+    }
+}
+
+DynamicWaveSolver::DynamicWaveSolver(bool useUsCustomary)
+    : DynamicWaveSolver(UnitSystemConstants::get_mannings_coefficient(useUsCustomary),
+                        UnitSystemConstants::get_gravity(useUsCustomary))
+{
+}
+
+DynamicWaveSolver::DynamicWaveSolver(double manningsCoefficient, double gravity)
+    : manningsCoefficient_{manningsCoefficient}
+    , gravity_{gravity}
+{
+}
+
+DynamicWaveResult DynamicWaveSolver::solve(const SectionTable& table, const DynamicWaveReach& reach,
+                                           const DynamicWaveBoundary& boundary, const DynamicWaveSettings& settings) const
+{
+    DynamicWaveResult result;
+    const std::vector<double>& inflow = boundary.upstreamDischarge;
+    const std::vector<double>& outletDepth = boundary.downstreamDepth;
+    bool hasOutletDepth = !outletDepth.empty();
+
+    if (!table.is_valid() || !(reach.length > 0.0) || !(reach.bedSlope >= 0.0) || !std::isfinite(reach.bedSlope) ||
+        !(reach.manningN > 0.0) || !(boundary.timeStep > 0.0) || inflow.empty() ||
+        (hasOutletDepth && outletDepth.size() != inflow.size()) || (!hasOutletDepth && reach.bedSlope == 0.0) ||
+        settings.cellCount == 0 || !(settings.theta >= 0.5 && settings.theta <= 1.0) ||
+        !(settings.courantNumber > 0.0 && settings.courantNumber <= 1.0) || settings.maxIterations < 1)
+        return result;
+
+    if (!std::all_of(inflow.begin(), inflow.end(), [](double value) { return std::isfinite(value); }) ||
+        !std::all_of(outletDepth.begin(), outletDepth.end(), [&](double value) { return is_depth_in_table(table, value); }))
+        return result;
+
+    std::size_t nodeCount = settings.cellCount + 1;
+    double spaceStep = reach.length / static_cast<double>(settings.cellCount);
+
+    double normalDepth{0.0};
+    if (reach.bedSlope > 0.0)
+        normalDepth = table.calculate_depth_for_conveyance(std::abs(inflow[0]) * reach.manningN /
+                                                           (manningsCoefficient_ * std::sqrt(reach.bedSlope)));
+
+    result.cellCount = settings.cellCount;
+    result.discharge.assign(nodeCount, inflow[0]);
+    result.depth.resize(nodeCount);
+
+    for (std::size_t node = 0; node < nodeCount; ++node)
+    {
+        double levelPoolDepth = hasOutletDepth ? outletDepth[0] - reach.bedSlope * (reach.length - spaceStep * static_cast<double>(node))
+                                               : 0.0;
+        result.depth[node] = std::max(normalDepth, levelPoolDepth);
+    }
+
+    if (!std::all_of(result.depth.begin(), result.depth.end(), [&](double depth) { return is_depth_in_table(table, depth); }))
+    {
+        result.status = DynamicWaveStatus::DepthOutOfRange;
+        return result;
+    }
+
+    result.outflow.reserve(inflow.size());
+    result.upstreamDepth.reserve(inflow.size());
+    record_step(result);
+    result.status = DynamicWaveStatus::Completed;
+
+    if (settings.scheme == DynamicWaveScheme::Preissmann)
+        solve_preissmann(table, reach, boundary, settings, result);
+    else
+        solve_maccormack(table, reach, boundary, settings, result);
+
+    result.isValid = result.status == DynamicWaveStatus::Completed;
+    return result;
+}
+
+// Box scheme on cell (j, j+1): time derivatives average the two nodes,
+// space derivatives and the other terms weight the new level by theta.
+// Unknowns are ordered Q0, y0, Q1, y1, ...; rows are the inlet condition,
+// then continuity and momentum for each cell, then the outlet condition,
+// which keeps every nonzero within two places of the diagonal.
+void DynamicWaveSolver::solve_preissmann(const SectionTable& table, const DynamicWaveReach& reach,
+                                         const DynamicWaveBoundary& boundary, const DynamicWaveSettings& settings,
+                                         DynamicWaveResult& result) const
+{
+    const std::vector<double>& inflow = boundary.upstreamDischarge;
+    const std::vector<double>& outletDepth = boundary.downstreamDepth;
+    std::vector<double>& discharge = result.discharge;
+    std::vector<double>& depth = result.depth;
+
+    std::size_t nodeCount = discharge.size();
+    std::size_t outletRow = 2 * nodeCount - 1;
+    double spaceStep = reach.length / static_cast<double>(nodeCount - 1);
+    double timeStep{boundary.timeStep};
+    double theta{settings.theta};
+    double conveyanceFactor = manningsCoefficient_ / reach.manningN;
+    double rootSlope = std::sqrt(reach.bedSlope);
+
+    std::vector<double> previousDischarge(nodeCount);
+    std::vector<double> previousDepth(nodeCount);
+    std::vector<NodeTerms<double>> previous(nodeCount);
+    std::vector<NodeTerms<NodeScalar>> current(nodeCount);
+    BandedSystem system{2 * nodeCount};
+
+    result.memoryFootprint = table.get_memory_footprint() + get_vector_footprint(discharge) + get_vector_footprint(depth)
+                             + get_vector_footprint(previousDischarge) + get_vector_footprint(previousDepth)
+                             + get_vector_footprint(previous) + get_vector_footprint(current) + system.get_memory_footprint();
+
+    for (std::size_t step = 1; step < inflow.size(); ++step)
+    {
+        previousDischarge = discharge;
+        previousDepth = depth;
+
+        for (std::size_t node = 0; node < nodeCount; ++node)
+            previous[node] = evaluate_node(table, discharge[node], depth[node], conveyanceFactor, reach.bedSlope);
+
+        bool isConverged{false};
+
+        for (int iteration = 0; iteration < settings.maxIterations && !isConverged; ++iteration)
+        {
+            for (std::size_t node = 0; node < nodeCount; ++node)
+                current[node] = evaluate_node(table, NodeScalar::variable(discharge[node], 0), NodeScalar::variable(depth[node], 1),
+                                              conveyanceFactor, reach.bedSlope);
+
+            system.clear();
+            system.at(0, 0) = 1.0;
+            system.rhs(0) = inflow[step] - discharge[0];
+
+            for (std::size_t cell = 0; cell + 1 < nodeCount; ++cell)
+            {
+                std::size_t next = cell + 1;
+                NodeTerms<CellScalar> upstream = widen(current[cell], 0);
+                NodeTerms<CellScalar> downstream = widen(current[next], 2);
+                const NodeTerms<double>& upstreamOld = previous[cell];
+                const NodeTerms<double>& downstreamOld = previous[next];
+
+                CellScalar upstreamDischarge = CellScalar::variable(discharge[cell], 0);
+                CellScalar upstreamDepth = CellScalar::variable(depth[cell], 1);
+                CellScalar downstreamDischarge = CellScalar::variable(discharge[next], 2);
+                CellScalar downstreamDepth = CellScalar::variable(depth[next], 3);
+
+                CellScalar continuity = 0.5 * (upstream.area - upstreamOld.area + downstream.area - downstreamOld.area) / timeStep
+                                        + (theta * (downstreamDischarge - upstreamDischarge)
+                                           + (1.0 - theta) * (previousDischarge[next] - previousDischarge[cell])) / spaceStep;
+
+                CellScalar averageArea = 0.5 * (theta * (upstream.area + downstream.area)
+                                                + (1.0 - theta) * (upstreamOld.area + downstreamOld.area));
+                CellScalar depthGradient = (theta * (downstreamDepth - upstreamDepth)
+                                            + (1.0 - theta) * (previousDepth[next] - previousDepth[cell])) / spaceStep;
+
+                CellScalar momentum = 0.5 * (upstreamDischarge - previousDischarge[cell] + downstreamDischarge - previousDischarge[next]) / timeStep
+                                      + (theta * (downstream.momentumFlux - upstream.momentumFlux)
+                                         + (1.0 - theta) * (downstreamOld.momentumFlux - upstreamOld.momentumFlux)) / spaceStep
+                                      + gravity_ * averageArea * depthGradient
+                                      + 0.5 * gravity_ * (theta * (upstream.friction + downstream.friction)
+                                                          + (1.0 - theta) * (upstreamOld.friction + downstreamOld.friction));
+
+                add_row(system, 2 * cell + 1, 2 * cell, continuity);
+                add_row(system, 2 * cell + 2, 2 * cell, momentum);
+            }
+
+            if (!outletDepth.empty())
+            {
+                system.at(outletRow, outletRow) = 1.0;
+                system.rhs(outletRow) = outletDepth[step] - depth.back();
+            }
+            else
+            {
+                SectionTableEntry entry = table.lookup(depth.back());
+                system.at(outletRow, outletRow - 1) = 1.0;
+                system.at(outletRow, outletRow) = -conveyanceFactor * entry.conveyanceDerivative * rootSlope;
+                system.rhs(outletRow) = conveyanceFactor * entry.conveyance * rootSlope - discharge.back();
+            }
+
+            if (!system.solve())
+            {
+                result.status = DynamicWaveStatus::NotConverged;
+                return;
+            }
+
+            const std::vector<double>& correction = system.get_solution();
+            double maxDepthCorrection{0.0};
+
+            for (std::size_t node = 0; node < nodeCount; ++node)
+            {
+                discharge[node] += correction[2 * node];
+                depth[node] += correction[2 * node + 1];
+                maxDepthCorrection = std::max(maxDepthCorrection, std::abs(correction[2 * node + 1]));
+
+                if (!is_depth_in_table(table, depth[node]))
+                {
+                    result.status = DynamicWaveStatus::DepthOutOfRange;
+                    return;
+                }
+            }
+
+            ++result.iterationCount;
+            isConverged = maxDepthCorrection <= settings.depthTolerance;
+        }
+
+        if (!isConverged)
+        {
+            result.status = DynamicWaveStatus::NotConverged;
+            return;
+        }
+
+        ++result.timeStepCount;
+        record_step(result);
+    }
+}
+
+// Conservative form with U = (A, Q), F = (Q, Q^2/A + g I1) and
+// S = (0, g A (S0 - Sf)): a forward-difference predictor and a
+// backward-difference corrector at the interior nodes. The inlet area and,
+// under a rating, the outlet area come from one-sided continuity. Each
+// boundary interval is split into equal substeps under the Courant limit of
+// the state at its start.
+void DynamicWaveSolver::solve_maccormack(const SectionTable& table, const DynamicWaveReach& reach,
+                                         const DynamicWaveBoundary& boundary, const DynamicWaveSettings& settings,
+                                         DynamicWaveResult& result) const
+{
+    const std::vector<double>& inflow = boundary.upstreamDischarge;
+    const std::vector<double>& outletDepth = boundary.downstreamDepth;
+    std::vector<double>& discharge = result.discharge;
+    std::vector<double>& depth = result.depth;
+
+    std::size_t nodeCount = discharge.size();
+    std::size_t last = nodeCount - 1;
+    double spaceStep = reach.length / static_cast<double>(last);
+    double conveyanceFactor = manningsCoefficient_ / reach.manningN;
+    double rootSlope = std::sqrt(reach.bedSlope);
+
+    std::vector<double> area(nodeCount);
+    std::vector<double> momentumFlux(nodeCount);
+    std::vector<double> source(nodeCount);
+    std::vector<double> predictedArea(nodeCount);
+    std::vector<double> predictedDischarge(nodeCount);
+
+    result.memoryFootprint = table.get_memory_footprint() + get_vector_footprint(discharge) + get_vector_footprint(depth)
+                             + get_vector_footprint(area) + get_vector_footprint(momentumFlux) + get_vector_footprint(source)
+                             + get_vector_footprint(predictedArea) + get_vector_footprint(predictedDischarge);
+
+    for (std::size_t node = 0; node < nodeCount; ++node)
+        area[node] = table.lookup(depth[node]).area;
+
+    auto evaluate_fluxes = [&](const std::vector<double>& nodeArea, const std::vector<double>& nodeDischarge, std::size_t count)
+    {
+        for (std::size_t node = 0; node < count; ++node)
+        {
+            double nodeAreaValue = nodeArea[node];
+            if (!is_area_in_table(table, nodeAreaValue))
+                return false;
+
+            double flow = nodeDischarge[node];
+            SectionTableEntry entry = table.lookup(table.calculate_depth_for_area(nodeAreaValue));
+            double conveyance = conveyanceFactor * entry.conveyance;
+
+            momentumFlux[node] = flow * flow / nodeAreaValue + gravity_ * entry.firstMoment;
+            source[node] = gravity_ * nodeAreaValue * (reach.bedSlope - flow * std::abs(flow) / (conveyance * conveyance));
+        }
+
+        return true;
+    };
+
+    for (std::size_t step = 1; step < inflow.size(); ++step)
+    {
+        double maxSpeed{0.0};
+        for (std::size_t node = 0; node < nodeCount; ++node)
+        {
+            SectionTableEntry entry = table.lookup(depth[node]);
+            maxSpeed = std::max(maxSpeed, std::abs(discharge[node] / area[node]) + std::sqrt(gravity_ * area[node] / entry.topWidth));
+        }
+
+        double substeps = std::max(1.0, std::ceil(boundary.timeStep * maxSpeed / (settings.courantNumber * spaceStep)));
+        double timeStep = boundary.timeStep / substeps;
+        double ratio = timeStep / spaceStep;
+
+        for (double substep = 1.0; substep <= substeps; substep += 1.0)
+        {
+            if (!evaluate_fluxes(area, discharge, nodeCount))
+            {
+                result.status = DynamicWaveStatus::DepthOutOfRange;
+                return;
+            }
+
+            for (std::size_t node = 0; node < last; ++node)
+            {
+                predictedArea[node] = area[node] - ratio * (discharge[node + 1] - discharge[node]);
+                predictedDischarge[node] = discharge[node] - ratio * (momentumFlux[node + 1] - momentumFlux[node]) + timeStep * source[node];
+            }
+
+            double inletArea = area[0] - ratio * (discharge[1] - discharge[0]);
+            double outletArea = area[last] - ratio * (discharge[last] - discharge[last - 1]);
+
+            if (!evaluate_fluxes(predictedArea, predictedDischarge, last))
+            {
+                result.status = DynamicWaveStatus::DepthOutOfRange;
+                return;
+            }
+
+            for (std::size_t node = 1; node < last; ++node)
+            {
+                area[node] = 0.5 * (area[node] + predictedArea[node] - ratio * (predictedDischarge[node] - predictedDischarge[node - 1]));
+                discharge[node] = 0.5 * (discharge[node] + predictedDischarge[node]
+                                         - ratio * (momentumFlux[node] - momentumFlux[node - 1]) + timeStep * source[node]);
+            }
+
+            double fraction = substep / substeps;
+            area[0] = inletArea;
+            discharge[0] = interpolate(inflow, step, fraction);
+
+            if (!outletDepth.empty())
+            {
+                area[last] = table.lookup(interpolate(outletDepth, step, fraction)).area;
+                discharge[last] = discharge[last - 1];
+            }
+            else
+            {
+                area[last] = outletArea;
+                discharge[last] = conveyanceFactor * table.lookup(table.calculate_depth_for_area(outletArea)).conveyance * rootSlope;
+            }
+
+            if (!is_area_in_table(table, area[0]) || !is_area_in_table(table, area[last]))
+            {
+                result.status = DynamicWaveStatus::DepthOutOfRange;
+                return;
+            }
+
+            ++result.timeStepCount;
+        }
+
+        for (std::size_t node = 0; node < nodeCount; ++node)
+            depth[node] = table.calculate_depth_for_area(area[node]);
+
+        record_step(result);
+    }
+}
@@ -0,0 +1,110 @@
+#ifndef DYNAMICWAVESOLVER_H
+#define DYNAMICWAVESOLVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class SectionTable;
+
+enum class DynamicWaveScheme : std::uint8_t
+{
+    Preissmann,     // Implicit four-point box scheme, Newton iteration on a banded system
+    MacCormack      // Explicit predictor-corrector, Courant-limited substeps
+};
+
+const char* get_dynamic_wave_scheme_name(DynamicWaveScheme scheme);
+
+enum class DynamicWaveStatus : std::uint8_t
+{
+    Completed,
+    InvalidInput,
+    NotConverged,       // Preissmann Newton iteration ran out of iterations
+    DepthOutOfRange     // A node ran dry or rose above the section table
+};
+
+const char* get_dynamic_wave_status_message(DynamicWaveStatus status);
+
+// Prismatic reach; the cross-section comes from the SectionTable.
+struct DynamicWaveReach
+{
+    double length{0.0};
+    double bedSlope{0.0};           // May be zero when the outlet depth is given
+    double manningN{0.0};
+};
+
+// Boundary series on a shared time step, starting at t = 0.
+struct DynamicWaveBoundary
+{
+    double timeStep{0.0};                   // Seconds
+    std::vector<double> upstreamDischarge;
+
+    // Depth at the outlet, e.g. a tide; empty for a normal-depth rating.
+    std::vector<double> downstreamDepth;
+};
+
+struct DynamicWaveSettings
+{
+    DynamicWaveScheme scheme{DynamicWaveScheme::Preissmann};
+    std::size_t cellCount{100};
+    double theta{0.6};              // Preissmann time weighting, 0.5 (centred) to 1 (implicit)
+    double courantNumber{0.9};      // MacCormack time step over the stability limit
+    int maxIterations{20};
+    double depthTolerance{1e-8};    // Preissmann convergence on the largest depth correction
+};
+
+struct DynamicWaveResult
+{
+    std::vector<double> outflow;            // Discharge at the outlet, one per boundary step
+    std::vector<double> upstreamDepth;      // Depth at the inlet, one per boundary step
+    std::vector<double> discharge;          // Node state at the end of the run, inlet to outlet
+    std::vector<double> depth;
+    DynamicWaveStatus status{DynamicWaveStatus::InvalidInput};
+    std::size_t cellCount{0};
+    std::size_t timeStepCount{0};           // Computational steps, including MacCormack substeps
+    std::size_t iterationCount{0};          // Newton iterations over the run (Preissmann)
+    std::size_t memoryFootprint{0};         // Bytes of solver state and section table, without the output series
+    bool isValid{false};
+};
+
+// One-dimensional Saint-Venant equations for a prismatic reach,
+//
+//     dA/dt + dQ/dx = 0
+//     dQ/dt + d(Q^2/A)/dx + g A dy/dx + g A (Sf - S0) = 0,
+//
+// with the discharge given at the inlet and a depth series or normal-depth
+// rating at the outlet. The reach starts from uniform flow at the first
+// inflow, raised to the level pool of the first outlet depth where that is
+// higher, and then settles on its own.
+//
+// Preissmann solves each time step for all node depths and discharges at
+// once: the box-scheme residuals are differentiated exactly with
+// DualNumber, and each Newton step is a pentadiagonal solve by banded LU
+// with partial pivoting, O(cells) in time and memory. It is unconditionally
+// stable, so the boundary time step is used directly. MacCormack marches
+// the conservative form explicitly with substeps under the Courant limit
+// and suits short, smooth, fast waves; it adds no artificial viscosity, so
+// it is not for bores or hydraulic jumps.
+//
+// All geometry comes from the SectionTable; nothing in the time loop makes
+// a virtual call or solves Manning's equation.
+class DynamicWaveSolver
+{
+public:
+    explicit DynamicWaveSolver(bool useUsCustomary);
+    DynamicWaveSolver(double manningsCoefficient, double gravity);
+
+    DynamicWaveResult solve(const SectionTable& table, const DynamicWaveReach& reach,
+                            const DynamicWaveBoundary& boundary, const DynamicWaveSettings& settings) const;
+
+private:
+    void solve_preissmann(const SectionTable& table, const DynamicWaveReach& reach, const DynamicWaveBoundary& boundary,
+                          const DynamicWaveSettings& settings, DynamicWaveResult& result) const;
+    void solve_maccormack(const SectionTable& table, const DynamicWaveReach& reach, const DynamicWaveBoundary& boundary,
+                          const DynamicWaveSettings& settings, DynamicWaveResult& result) const;
+
+    double manningsCoefficient_;
+    double gravity_;
+};
+
+#endif // DYNAMICWAVESOLVER_H
@@ -0,0 +1,41 @@
+#include "GradualFlowAnalyzer.h"
+
+ProfileType classify_profile(double depth, double normalDepth, double criticalDepth)
+{
+    constexpr double CRITICAL_SLOPE_TOLERANCE{1e-3};
+    constexpr double UNIFORM_TOLERANCE{1e-6};
+
+    if (std::abs(depth - normalDepth) <= UNIFORM_TOLERANCE * normalDepth)
+        return ProfileType::Uniform;
+
+    if (std::abs(normalDepth - criticalDepth) <= CRITICAL_SLOPE_TOLERANCE * criticalDepth)
+        return depth > criticalDepth ? ProfileType::C1 : ProfileType::C3;
+
+    if (normalDepth > criticalDepth)
+    {
+        if (depth > normalDepth)
+            return ProfileType::M1;
+        else if (depth > criticalDepth)
+            return ProfileType::M2;
+
+        return ProfileType::M3;
+    }
+
+    if (depth > criticalDepth)
+        return ProfileType::S1;
+    else if (depth > normalDepth)
+        return ProfileType::S2;
+
+    return ProfileType::S3;
+}
+
+GradualFlowAnalyzer::GradualFlowAnalyzer(const GradualFlowSettings& settings, const SolverSettings& solverSettings)
+    : settings_{settings}
+    , solverSettings_{solverSettings}
+{
+}
+
+const GradualFlowSettings& GradualFlowAnalyzer::get_settings() const
+{
+    return settings_;
+}
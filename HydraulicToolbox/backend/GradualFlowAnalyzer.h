@@ -0,0 +1,368 @@
+#ifndef GRADUALFLOWANALYZER_H
+#define GRADUALFLOWANALYZER_H
+
+#include "Analyzer.h"
+#include "Channel.h"
+#include "ChannelGeometry.h"
+#include "CriticalFlowAnalyzer.h"
+#include "Flow.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <variant>
+
+// Chow's classification of gradually varied flow profiles on a positive bed
+// slope: the letter is the slope class (Mild, Steep, Critical) and the digit
+// the zone (1 above both yn and yc, 2 between them, 3 below both).
+enum class ProfileType
+{
+    M1,
+    M2,
+    M3,
+    S1,
+    S2,
+    S3,
+    C1,
+    C3,
+    Uniform
+};
+
+ProfileType classify_profile(double depth, double normalDepth, double criticalDepth);
+
+enum class ProfileStatus
+{
+    Completed,
+    InvalidInput,
+    ReachedCriticalDepth,   // Profile hit yc before the end of the reach (jump or choke)
+    StepSizeUnderflow,
+    ExceededMaxSteps
+};
+
+struct GradualFlowSettings
+{
+    double depthTolerance{1e-6};   // Local error per step, in depth units
+    double initialStep{1.0};
+    double minStep{1e-6};
+    double maxStep{500.0};
+    double outputInterval{0.0};    // Station spacing; 0 reports every integration step
+    std::size_t maxSteps{10000000};
+};
+
+// One computed cross-section. Stations run from 0 at the upstream end of the
+// reach to the reach length at the downstream end.
+struct ProfileStation
+{
+    double station{0.0};
+    double depth{0.0};
+    double velocity{0.0};
+    double froudeNumber{0.0};
+    double frictionSlope{0.0};
+    double specificEnergy{0.0};
+};
+
+struct ProfileSummary
+{
+    ProfileType profileType{ProfileType::Uniform};
+    ProfileStatus status{ProfileStatus::InvalidInput};
+    double normalDepth{0.0};
+    double criticalDepth{0.0};
+    double endStation{0.0};
+    double endDepth{0.0};
+    std::size_t stationCount{0};
+    std::size_t stepCount{0};
+    std::size_t rejectedStepCount{0};
+};
+
+// Water-surface profiles from dy/dx = (S0 - Sf) / (1 - Fr^2), integrated with
+// the adaptive Bogacki-Shampine 3(2) pair. Subcritical profiles are computed
+// upstream from a downstream control, supercritical ones downstream from an
+// upstream control. Stations are handed to `consumer` as they are produced
+// (at every step, or at outputInterval using cubic Hermite interpolation
+// between steps), so the profile is never held in memory.
+class GradualFlowAnalyzer
+{
+public:
+    GradualFlowAnalyzer() = default;
+    explicit GradualFlowAnalyzer(const GradualFlowSettings& settings,
+                                 const SolverSettings& solverSettings = SolverSettings{});
+
+    // Virtual-dispatch path for any Channel subtype.
+    template <typename Consumer>
+    ProfileSummary compute_profile(Channel& channel, const Flow& flow, double slope, double reachLength,
+                                   double controlDepth, double manningsCoefficient, double gravity,
+                                   Consumer&& consumer) const;
+
+    // Devirtualized path, instantiated per section type.
+    template <typename Section, typename Consumer>
+    ProfileSummary compute_section_profile(const Section& section, const Flow& flow, double slope, double reachLength,
+                                           double controlDepth, double manningsCoefficient, double gravity,
+                                           Consumer&& consumer) const;
+
+    template <typename Consumer>
+    ProfileSummary compute_section_profile(const ChannelSection& section, const Flow& flow, double slope,
+                                           double reachLength, double controlDepth, double manningsCoefficient,
+                                           double gravity, Consumer&& consumer) const;
+
+    const GradualFlowSettings& get_settings() const;
+
+private:
+    template <typename Evaluate, typename Consumer>
+    ProfileSummary integrate(Evaluate&& evaluate, const Flow& flow, double slope, double reachLength,
+                             double controlDepth, double manningsCoefficient, double gravity,
+                             double normalDepth, double criticalDepth, Consumer&& consumer) const;
+
+    GradualFlowSettings settings_;
+    SolverSettings solverSettings_;
+};
+
+// ============================================================================
+// TEMPLATE IMPLEMENTATION
+// ============================================================================
+
+template <typename Consumer>
+ProfileSummary GradualFlowAnalyzer::compute_profile(Channel& channel, const Flow& flow, double slope, double reachLength,
+                                                    double controlDepth, double manningsCoefficient, double gravity,
+                                                    Consumer&& consumer) const
+{
+    Analyzer analyzer{solverSettings_};
+    CriticalFlowAnalyzer criticalAnalyzer{solverSettings_};
+
+    AnalysisResult normal = analyzer.solve_for_depth(channel, flow, slope, manningsCoefficient, gravity);
+    CriticalFlowResult critical = criticalAnalyzer.solve_critical_depth(channel, flow.get_discharge(), gravity);
+
+    if (!normal.isValid || !critical.isValid)
+        return ProfileSummary{};
+
+    auto evaluate = [&channel](double depth)
+    {
+        channel.set_depth(depth);
+        return SectionProperties{channel.calculate_area(),
+                                 channel.calculate_wetted_perimeter(),
+                                 channel.calculate_top_width(),
+                                 channel.calculate_wetted_perimeter_derivative()};
+    };
+
+    return integrate(evaluate, flow, slope, reachLength, controlDepth, manningsCoefficient, gravity,
+                     normal.normalDepth, critical.criticalDepth, consumer);
+}
+
+template <typename Section, typename Consumer>
+ProfileSummary GradualFlowAnalyzer::compute_section_profile(const Section& section, const Flow& flow, double slope,
+                                                            double reachLength, double controlDepth,
+                                                            double manningsCoefficient, double gravity,
+                                                            Consumer&& consumer) const
+{
+    Analyzer analyzer{solverSettings_};
+    CriticalFlowAnalyzer criticalAnalyzer{solverSettings_};
+
+    AnalysisResult normal = analyzer.solve_section(section, flow, slope, manningsCoefficient, gravity);
+    CriticalFlowResult critical = criticalAnalyzer.solve_section(section, flow.get_discharge(), gravity);
+
+    if (!normal.isValid || !critical.isValid)
+        return ProfileSummary{};
+
+    return integrate([&section](double depth) { return section.evaluate(depth); },
+                     flow, slope, reachLength, controlDepth, manningsCoefficient, gravity,
+                     normal.normalDepth, critical.criticalDepth, consumer);
+}
+
+template <typename Consumer>
+ProfileSummary GradualFlowAnalyzer::compute_section_profile(const ChannelSection& section, const Flow& flow,
+                                                            double slope, double reachLength, double controlDepth,
+                                                            double manningsCoefficient, double gravity,
+                                                            Consumer&& consumer) const
+{
+    return std::visit([&](const auto& concreteSection)
+                      {
+                          return compute_section_profile(concreteSection, flow, slope, reachLength, controlDepth,
+                                                         manningsCoefficient, gravity, consumer);
+                      },
+                      section);
+}
+
+// The profile is integrated in s, the distance travelled from the control,
+// with station x = control station + direction * s. A stage whose depth
+// crosses to the other side of critical (|1 - Fr^2| below
+// MIN_FROUDE_MARGIN) counts as a failed step and halves the step size, so
+// a profile running into yc ends with ReachedCriticalDepth instead of
+// stepping across the singularity.
+template <typename Evaluate, typename Consumer>
+ProfileSummary GradualFlowAnalyzer::integrate(Evaluate&& evaluate, const Flow& flow, double slope, double reachLength,
+                                              double controlDepth, double manningsCoefficient, double gravity,
+                                              double normalDepth, double criticalDepth, Consumer&& consumer) const
+{
+    constexpr double MIN_FROUDE_MARGIN{1e-3};
+    constexpr double CRITICAL_DEPTH_OFFSET{0.01};
+
+    ProfileSummary summary;
+    summary.normalDepth = normalDepth;
+    summary.criticalDepth = criticalDepth;
+
+    if (!(reachLength > 0.0) || !(controlDepth > 0.0) || !(slope > 0.0))
+        return summary;
+
+    double discharge{flow.get_discharge()};
+    double dischargeSquared = discharge * discharge;
+    double conveyanceFactor = discharge * flow.get_manning_n() / manningsCoefficient;
+    double frictionFactor = conveyanceFactor * conveyanceFactor;
+
+    // A control at critical depth (free overfall, steep inlet) belongs to the
+    // subcritical side on a mild slope and the supercritical side on a steep
+    // one, and the profile starts just off yc on that side.
+    bool isNearCritical = std::abs(controlDepth - criticalDepth) <= CRITICAL_DEPTH_OFFSET * criticalDepth;
+    bool isSubcritical = isNearCritical ? normalDepth > criticalDepth : controlDepth > criticalDepth;
+    double side = isSubcritical ? 1.0 : -1.0;
+    double direction = isSubcritical ? -1.0 : 1.0;
+    double controlStation = isSubcritical ? reachLength : 0.0;
+
+    // Sf = (Q n / k)^2 / (A^2 R^(4/3)) and Fr^2 = Q^2 T / (g A^3).
+    auto friction_slope = [frictionFactor](const SectionProperties& properties)
+    {
+        double hydraulicRadius = properties.area / properties.wettedPerimeter;
+        double radiusSquared = hydraulicRadius * hydraulicRadius;
+        return frictionFactor / (properties.area * properties.area * std::cbrt(radiusSquared * radiusSquared));
+    };
+
+    auto evaluate_derivative = [&](double depth, double& derivative) -> bool
+    {
+        if (!(depth > 0.0))
+            return false;
+
+        SectionProperties properties = evaluate(depth);
+        double area{properties.area};
+        double froudeSquared = dischargeSquared * properties.topWidth / (gravity * area * area * area);
+        double denominator = 1.0 - froudeSquared;
+
+        if (!(side * denominator > MIN_FROUDE_MARGIN))
+            return false;
+
+        derivative = direction * (slope - friction_slope(properties)) / denominator;
+        return std::isfinite(derivative);
+    };
+
+    auto emit_station = [&](double distance, double depth)
+    {
+        SectionProperties properties = evaluate(depth);
+        double area{properties.area};
+
+        ProfileStation station;
+        station.station = controlStation + direction * distance;
+        station.depth = depth;
+        station.velocity = discharge / area;
+        station.froudeNumber = station.velocity / std::sqrt(gravity * area / properties.topWidth);
+        station.frictionSlope = friction_slope(properties);
+        station.specificEnergy = depth + station.velocity * station.velocity / (2.0 * gravity);
+
+        consumer(station);
+        ++summary.stationCount;
+    };
+
+    double depth = isNearCritical ? criticalDepth * (1.0 + side * CRITICAL_DEPTH_OFFSET) : controlDepth;
+    double derivative{0.0};
+
+    if (!evaluate_derivative(depth, derivative))
+    {
+        summary.status = ProfileStatus::ReachedCriticalDepth;
+        return summary;
+    }
+
+    summary.profileType = classify_profile(depth, normalDepth, criticalDepth);
+    emit_station(0.0, depth);
+
+    double tolerance{settings_.depthTolerance};
+    double outputInterval{settings_.outputInterval};
+    double distance{0.0};
+    double lastEmitted{0.0};
+    double step = std::min(settings_.initialStep, reachLength);
+    std::size_t outputIndex{1};
+
+    summary.status = ProfileStatus::Completed;
+
+    while (distance < reachLength)
+    {
+        if (summary.stepCount >= settings_.maxSteps)
+        {
+            summary.status = ProfileStatus::ExceededMaxSteps;
+            break;
+        }
+
+        bool isFinalStep = step >= reachLength - distance;
+        if (isFinalStep)
+            step = reachLength - distance;
+
+        double k1{derivative};
+        double k2{0.0};
+        double k3{0.0};
+        double k4{0.0};
+        double nextDepth{0.0};
+        double error{0.0};
+
+        bool isEvaluated = evaluate_derivative(depth + 0.5 * step * k1, k2)
+                           && evaluate_derivative(depth + 0.75 * step * k2, k3);
+
+        if (isEvaluated)
+        {
+            nextDepth = depth + step * (2.0 / 9.0 * k1 + 1.0 / 3.0 * k2 + 4.0 / 9.0 * k3);
+            isEvaluated = evaluate_derivative(nextDepth, k4);
+        }
+
+        if (isEvaluated)
+            error = std::abs(step * (-5.0 / 72.0 * k1 + 1.0 / 12.0 * k2 + 1.0 / 9.0 * k3 - 1.0 / 8.0 * k4));
+
+        if (!isEvaluated || error > tolerance)
+        {
+            ++summary.rejectedStepCount;
+            step *= isEvaluated ? std::max(0.2, 0.9 * std::cbrt(tolerance / error)) : 0.5;
+
+            if (step < settings_.minStep)
+            {
+                summary.status = isEvaluated ? ProfileStatus::StepSizeUnderflow : ProfileStatus::ReachedCriticalDepth;
+                break;
+            }
+            continue;
+        }
+
+        double nextDistance = isFinalStep ? reachLength : distance + step;
+
+        if (outputInterval > 0.0)
+        {
+            // Cubic Hermite dense output between the step end points.
+            for (double outputDistance = outputIndex * outputInterval;
+                 outputDistance <= nextDistance && outputDistance < reachLength;
+                 outputDistance = ++outputIndex * outputInterval)
+            {
+                double theta = (outputDistance - distance) / step;
+                double theta2 = theta * theta;
+                double theta3 = theta2 * theta;
+
+                double interpolated = (2.0 * theta3 - 3.0 * theta2 + 1.0) * depth
+                                      + (theta3 - 2.0 * theta2 + theta) * step * k1
+                                      + (-2.0 * theta3 + 3.0 * theta2) * nextDepth
+                                      + (theta3 - theta2) * step * k4;
+
+                emit_station(outputDistance, interpolated);
+                lastEmitted = outputDistance;
+            }
+        }
+
+        distance = nextDistance;
+        depth = nextDepth;
+        derivative = k4;
+        ++summary.stepCount;
+
+        if (outputInterval <= 0.0 || (isFinalStep && lastEmitted < reachLength))
+        {
+            emit_station(distance, depth);
+            lastEmitted = distance;
+        }
+
+        double growth = error > 0.0 ? 0.9 * std::cbrt(tolerance / error) : 5.0;
+        step = std::min(step * std::min(5.0, growth), settings_.maxStep);
+    }
+
+    summary.endStation = controlStation + direction * distance;
+    summary.endDepth = depth;
+    return summary;
+}
+
+#endif // GRADUALFLOWANALYZER_H
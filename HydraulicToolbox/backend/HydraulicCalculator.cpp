@@ -1,10 +1,41 @@
 #include "HydraulicCalculator.h"
-#include "RectangularChannel.h"
-#include "TrapezoidalChannel.h"
-#include "TriangularChannel.h"
+#include "CalculationControl.h"
+#include "ThreadPool.h"
 #include "UnitSystemConstants.h"
 
+const char* get_error_message(CalculationError error)
+{
+    switch(error)
+    {
+    case CalculationError::None:
+        return "";
+    case CalculationError::InvalidBedSlope:
+        return "Bed slope must be greater than zero.";
+    case CalculationError::BedSlopeTooSteep:
+        return "Bed slope must be less than 1.0 (invalid slope).";
+    case CalculationError::InvalidDischarge:
+        return "Discharge must be greater than zero.";
+    case CalculationError::InvalidManningN:
+        return "Manning's n must be between 0 and 0.2.";
+    case CalculationError::InvalidBottomWidth:
+        return "Bottom width must be greater than zero.";
+    case CalculationError::InvalidSideSlope:
+        return "Side slope must be greater than zero.";
+    case CalculationError::InvalidChannelType:
+        return "Invalid channel type selected.";
+    case CalculationError::NotConverged:
+        return "Calculation failed to converge. Try adjusting input parameters.";
+    case CalculationError::Cancelled:
+        return "Calculation cancelled.";
+    case CalculationError::ComputationFailed:
+        return "Calculation error: the solver could not evaluate these inputs.";
+    }
+
+    return "Unknown error.";
+}
+
 HydraulicCalculator::HydraulicCalculator()
+    : cache_{DEFAULT_CACHE_CAPACITY}
 {
 }
 
@@ -12,13 +43,40 @@ HydraulicCalculator::~HydraulicCalculator()
 {
 }
 
-CalculationResults HydraulicCalculator::calculate(const ProjectData& projectData,
+CalculationResults HydraulicCalculator::calculate(bool useUsCustomary,
                                                   const GeometryData& geometryData,
-                                                  const HydraulicData& hydraulicData)
+                                                  const HydraulicData& hydraulicData,
+                                                  const CalculationControl* control)
+{
+    std::optional<CalculationKey> key = make_calculation_key(useUsCustomary, geometryData, hydraulicData);
+
+    if(key)
+    {
+        if(std::optional<CalculationResults> cached = cache_.find(*key))
+        {
+            return *cached;
+        }
+    }
+
+    CalculationResults results = calculate_uncached(useUsCustomary, geometryData, hydraulicData, control);
+
+    if(key && !is_cancelled(control))
+    {
+        cache_.insert(*key, results);
+    }
+
+    return results;
+}
+
+CalculationResults HydraulicCalculator::calculate_uncached(bool useUsCustomary,
+                                                           const GeometryData& geometryData,
+                                                           const HydraulicData& hydraulicData,
+                                                           const CalculationControl* control)
 {
     CalculationResults results;
+    results.error = validate_inputs(geometryData, hydraulicData);
 
-    if(!validate_inputs(geometryData, hydraulicData, results.errorMessage))
+    if(results.error != CalculationError::None)
     {
         results.isValid = false;
         return results;
@@ -26,62 +84,215 @@ CalculationResults HydraulicCalculator::calculate(const ProjectData& projectData
 
     try
     {
-        std::unique_ptr<Channel> channel = create_channel(geometryData);
+        std::optional<ChannelSection> section = create_section(geometryData);
 
-        if(!channel)
+        if(!section)
         {
             results.isValid = false;
-            results.errorMessage = "Invalid channel type selected.";
+            results.error = CalculationError::InvalidChannelType;
             return results;
         }
 
         Flow flow = create_flow(hydraulicData);
 
         // Get correct constants based on unit system
-        double manningsCoefficient = UnitSystemConstants::get_mannings_coefficient(projectData.useUsCustomary);
-        double gravity = UnitSystemConstants::get_gravity(projectData.useUsCustomary);
+        double manningsCoefficient = UnitSystemConstants::get_mannings_coefficient(useUsCustomary);
+        double gravity = UnitSystemConstants::get_gravity(useUsCustomary);
+
+        SolverSettings settings{solverSettings_};
+        settings.computeSensitivities = true;
 
-        Analyzer analyzer;
-        AnalysisResult backendResult = analyzer.solve_for_depth(*channel, flow, geometryData.bedSlope, manningsCoefficient, gravity);
+        Analyzer analyzer{settings};
+        AnalysisResult backendResult = solve_normal_depth(analyzer, *section, geometryData, hydraulicData,
+                                                          manningsCoefficient, gravity, results.manningN);
 
         results.normalDepth = backendResult.normalDepth;
         results.velocity = backendResult.velocity;
         results.froudeNumber = backendResult.froudeNumber;
-        results.flowRegime = determine_flow_regime(backendResult.flowRegime);
+        results.flowRegime = backendResult.flowRegime;
+        results.sensitivities = backendResult.sensitivities;
         results.isValid = backendResult.isValid;
 
         if(!results.isValid)
         {
-            results.errorMessage = "Calculation failed to converge. Try adjusting input parameters.";
+            results.error = CalculationError::NotConverged;
+            return results;
+        }
+
+        CriticalFlowAnalyzer criticalAnalyzer{solverSettings_};
+        CriticalFlowResult criticalResult = criticalAnalyzer.solve_section(*section, flow.get_discharge(), gravity);
+
+        // Normal-depth results stand on their own; only the critical fields
+        // are marked unavailable when the critical solve fails.
+        results.hasCriticalDepth = criticalResult.isValid;
+
+        // With both depths known the regime follows from comparing them; the
+        // solver's Froude band remains the fallback without a critical depth.
+        if(criticalResult.isValid)
+        {
+            results.criticalDepth = criticalResult.criticalDepth;
+            results.minimumSpecificEnergy = criticalResult.minimumSpecificEnergy;
+            results.flowRegime = classify_flow_regime_by_depth(results.normalDepth, results.criticalDepth);
+        }
+
+        criticalAnalyzer.evaluate_curves(*section, flow.get_discharge(), gravity, &results.normalDepth,
+                                         &results.specificEnergy, &results.specificForce, 1);
+
+        if(is_cancelled(control))
+        {
+            results.isValid = false;
+            results.error = CalculationError::Cancelled;
+            return results;
         }
+
+        report_progress(control, 1.0);
     }
-    catch(const std::exception& e)
+    catch(const std::exception&)
     {
         results.isValid = false;
-        results.errorMessage = QString("Calculation error: %1").arg(e.what());
+        results.error = CalculationError::ComputationFailed;
     }
 
     return results;
 }
 
-std::unique_ptr<Channel> HydraulicCalculator::create_channel(const GeometryData& geometryData)
+ProfileSummary HydraulicCalculator::calculate_profile(bool useUsCustomary,
+                                                     const GeometryData& geometryData,
+                                                     const HydraulicData& hydraulicData,
+                                                     double controlDepth,
+                                                     const std::function<void(const ProfileStation&)>& consumer)
 {
-    double initialDepth = 1.0;
+    if(validate_inputs(geometryData, hydraulicData) != CalculationError::None || geometryData.length <= 0.0)
+    {
+        return ProfileSummary{};
+    }
 
-    if(geometryData.channelType == "Rectangular")
+    std::optional<ChannelSection> section = create_section(geometryData);
+
+    if(!section)
     {
-        return std::make_unique<RectangularChannel>(geometryData.bottomWidth, initialDepth);
+        return ProfileSummary{};
     }
-    else if(geometryData.channelType == "Trapezoidal")
+
+    Flow flow = create_flow(hydraulicData);
+    double manningsCoefficient = UnitSystemConstants::get_mannings_coefficient(useUsCustomary);
+    double gravity = UnitSystemConstants::get_gravity(useUsCustomary);
+
+    // The profile carries one n; with composite roughness it uses the
+    // equivalent n at normal depth, which changes little over the depths a
+    // profile spans.
+    if(hydraulicData.bankManningN > 0.0)
     {
-        return std::make_unique<TrapezoidalChannel>(geometryData.bottomWidth, geometryData.sideSlope, initialDepth);
+        double manningN{0.0};
+        AnalysisResult normal = solve_normal_depth(Analyzer{solverSettings_}, *section, geometryData, hydraulicData,
+                                                   manningsCoefficient, gravity, manningN);
+
+        if(!normal.isValid)
+        {
+            return ProfileSummary{};
+        }
+
+        flow = Flow(hydraulicData.discharge, manningN);
     }
-    else if(geometryData.channelType == "Triangular")
+
+    GradualFlowAnalyzer profileAnalyzer{profileSettings_, solverSettings_};
+    return profileAnalyzer.compute_section_profile(*section, flow, geometryData.bedSlope, geometryData.length,
+                                                   controlDepth, manningsCoefficient, gravity, consumer);
+}
+
+void HydraulicCalculator::set_profile_settings(const GradualFlowSettings& settings)
+{
+    profileSettings_ = settings;
+}
+
+const GradualFlowSettings& HydraulicCalculator::get_profile_settings() const
+{
+    return profileSettings_;
+}
+
+UncertaintyResult HydraulicCalculator::calculate_uncertainty(bool useUsCustomary,
+                                                             const GeometryData& geometryData,
+                                                             const Distribution& manningN,
+                                                             const Distribution& discharge,
+                                                             const Distribution& bedSlope,
+                                                             const CalculationControl* control)
+{
+    std::optional<ChannelSection> section = create_section(geometryData);
+
+    // n, Q and S come from the distributions, so only the shape is checked.
+    if(!section || validate_geometry(geometryData) != CalculationError::None)
     {
-        return std::make_unique<TriangularChannel>(geometryData.sideSlope, initialDepth);
+        return UncertaintyResult{};
     }
 
-    return nullptr;
+    UncertaintySettings settings{uncertaintySettings_};
+    settings.solverSettings = solverSettings_;
+
+    UncertaintyAnalyzer uncertaintyAnalyzer{get_thread_pool(),
+                                            UnitSystemConstants::get_mannings_coefficient(useUsCustomary),
+                                            UnitSystemConstants::get_gravity(useUsCustomary)};
+    return uncertaintyAnalyzer.run(UncertaintyInputs{*section, manningN, discharge, bedSlope}, settings, control);
+}
+
+void HydraulicCalculator::set_uncertainty_settings(const UncertaintySettings& settings)
+{
+    uncertaintySettings_ = settings;
+}
+
+const UncertaintySettings& HydraulicCalculator::get_uncertainty_settings() const
+{
+    return uncertaintySettings_;
+}
+
+ThreadPool& HydraulicCalculator::get_thread_pool()
+{
+    std::call_once(threadPoolCreated_, [this]()
+    {
+        threadPool_ = std::make_unique<ThreadPool>();
+    });
+
+    return *threadPool_;
+}
+
+void HydraulicCalculator::set_solver_settings(const SolverSettings& settings)
+{
+    solverSettings_ = settings;
+    cache_.clear();
+}
+
+const SolverSettings& HydraulicCalculator::get_solver_settings() const
+{
+    return solverSettings_;
+}
+
+void HydraulicCalculator::set_cache_capacity(std::size_t capacity)
+{
+    cache_.set_capacity(capacity);
+}
+
+CacheStatistics HydraulicCalculator::get_cache_statistics() const
+{
+    return cache_.get_statistics();
+}
+
+void HydraulicCalculator::clear_cache()
+{
+    cache_.clear();
+}
+
+std::optional<ChannelSection> HydraulicCalculator::create_section(const GeometryData& geometryData)
+{
+    switch(geometryData.channelType)
+    {
+    case ChannelType::Rectangular:
+        return RectangularSection{geometryData.bottomWidth};
+    case ChannelType::Trapezoidal:
+        return TrapezoidalSection{geometryData.bottomWidth, geometryData.sideSlope};
+    case ChannelType::Triangular:
+        return TriangularSection{geometryData.sideSlope};
+    default:
+        return std::nullopt;
+    }
 }
 
 Flow HydraulicCalculator::create_flow(const HydraulicData& hydraulicData)
@@ -89,78 +300,93 @@ Flow HydraulicCalculator::create_flow(const HydraulicData& hydraulicData)
     return Flow(hydraulicData.discharge, hydraulicData.manningN);
 }
 
-QString HydraulicCalculator::determine_flow_regime(FlowRegime regime) const
+// manningN is the bed n; both banks use the bank n.
+CompositeRoughness HydraulicCalculator::create_roughness(const HydraulicData& hydraulicData)
+{
+    return CompositeRoughness(hydraulicData.roughnessMethod, hydraulicData.manningN,
+                              hydraulicData.bankManningN, hydraulicData.bankManningN);
+}
+
+// Uniform or composite normal depth. `manningN` receives the n in effect at
+// the normal depth.
+AnalysisResult HydraulicCalculator::solve_normal_depth(const Analyzer& analyzer,
+                                                       const ChannelSection& section,
+                                                       const GeometryData& geometryData,
+                                                       const HydraulicData& hydraulicData,
+                                                       double manningsCoefficient,
+                                                       double gravity,
+                                                       double& manningN)
 {
-    switch(regime)
+    if(hydraulicData.bankManningN <= 0.0)
     {
-    case FlowRegime::Subcritical:
-        return "Subcritical";
-    case FlowRegime::Critical:
-        return "Critical";
-    case FlowRegime::Supercritical:
-        return "Supercritical";
-    default:
-        return "Unknown";
+        manningN = hydraulicData.manningN;
+        return analyzer.solve_section(section, create_flow(hydraulicData), geometryData.bedSlope, manningsCoefficient, gravity);
     }
+
+    CompositeRoughness roughness = create_roughness(hydraulicData);
+    AnalysisResult result = analyzer.solve_section(section, roughness, hydraulicData.discharge, geometryData.bedSlope,
+                                                   manningsCoefficient, gravity);
+
+    manningN = std::visit([&](const auto& concreteSection)
+                          { return roughness.evaluate(result.normalDepth, concreteSection.evaluate(result.normalDepth)).manningN; },
+                          section);
+    return result;
 }
 
-bool HydraulicCalculator::validate_inputs(const GeometryData& geometryData,
-                                          const HydraulicData& hydraulicData,
-                                          QString& errorMessage)
+CalculationError HydraulicCalculator::validate_inputs(const GeometryData& geometryData,
+                                                      const HydraulicData& hydraulicData)
 {
     if(geometryData.bedSlope <= 0.0)
     {
-        errorMessage = "Bed slope must be greater than zero.";
-        return false;
+        return CalculationError::InvalidBedSlope;
     }
 
     if(geometryData.bedSlope > 1.0)
     {
-        errorMessage = "Bed slope must be less than 1.0 (invalid slope).";
-        return false;
+        return CalculationError::BedSlopeTooSteep;
     }
 
     if(hydraulicData.discharge <= 0.0)
     {
-        errorMessage = "Discharge must be greater than zero.";
-        return false;
+        return CalculationError::InvalidDischarge;
     }
 
-    if(hydraulicData.manningN <= 0.0 || hydraulicData.manningN > 0.2)
+    if(hydraulicData.manningN <= 0.0 || hydraulicData.manningN > 0.2 ||
+       hydraulicData.bankManningN < 0.0 || hydraulicData.bankManningN > 0.2)
     {
-        errorMessage = "Manning's n must be between 0 and 0.2.";
-        return false;
+        return CalculationError::InvalidManningN;
     }
 
-    if(geometryData.channelType == "Rectangular")
+    return validate_geometry(geometryData);
+}
+
+CalculationError HydraulicCalculator::validate_geometry(const GeometryData& geometryData)
+{
+    if(geometryData.channelType == ChannelType::Rectangular)
     {
         if(geometryData.bottomWidth <= 0.0)
         {
-            errorMessage = "Bottom width must be greater than zero.";
-            return false;
+            return CalculationError::InvalidBottomWidth;
         }
     }
-    else if(geometryData.channelType == "Trapezoidal")
+    else if(geometryData.channelType == ChannelType::Trapezoidal)
     {
         if(geometryData.bottomWidth <= 0.0)
         {
-            errorMessage = "Bottom width must be greater than zero.";
-            return false;
+            return CalculationError::InvalidBottomWidth;
         }
         if(geometryData.sideSlope <= 0.0)
         {
-            errorMessage = "Side slope must be greater than zero.";
-            return false;
+            return CalculationError::InvalidSideSlope;
         }
     }
-    else if(geometryData.channelType == "Triangular")
+    else if(geometryData.channelType == ChannelType::Triangular)
     {
         if(geometryData.sideSlope <= 0.0)
         {
-            errorMessage = "Side slope must be greater than zero.";
-            return false;
+            return CalculationError::InvalidSideSlope;
         }
     }
 
-    return true;
+    return CalculationError::None;
 }
@@ -1,40 +1,145 @@
 #ifndef HYDRAULICCALCULATOR_H
 #define HYDRAULICCALCULATOR_H
 
-#include "Channel.h"
+#include "CalculationInputs.h"
+#include "CalculationKey.h"
+#include "ChannelGeometry.h"
 #include "Flow.h"
 #include "Analyzer.h"
-#include "ProjectDataStructures.h"
+#include "CriticalFlowAnalyzer.h"
+#include "GradualFlowAnalyzer.h"
+#include "LruCache.h"
+#include "UncertaintyAnalyzer.h"
+#include <cstdint>
+#include <functional>
 #include <memory>
-#include <QString>
+#include <mutex>
+#include <optional>
 
+enum class CalculationError : std::uint8_t
+{
+    None,
+    InvalidBedSlope,
+    BedSlopeTooSteep,
+    InvalidDischarge,
+    InvalidManningN,
+    InvalidBottomWidth,
+    InvalidSideSlope,
+    InvalidChannelType,
+    NotConverged,
+    Cancelled,
+    ComputationFailed
+};
+
+// User-facing message for the error; an empty string for None.
+const char* get_error_message(CalculationError error);
+
+// Plain values only, so results are copied and cached without allocating.
 struct CalculationResults
 {
     double normalDepth{0.0};
     double velocity{0.0};
     double froudeNumber{0.0};
-    QString flowRegime;
+    double manningN{0.0};                 // Equivalent n at normal depth for composite roughness
+    double criticalDepth{0.0};
+    double specificEnergy{0.0};           // At normal depth
+    double minimumSpecificEnergy{0.0};    // At critical depth
+    bool hasCriticalDepth{false};         // False when the critical solve failed; both fields above are then 0
+    double specificForce{0.0};            // At normal depth
+    bool hasUncertainty{false};           // Set by callers that also ran calculate_uncertainty()
+    double normalDepthLower{0.0};         // 5th percentile
+    double normalDepthMedian{0.0};
+    double normalDepthUpper{0.0};         // 95th percentile
+    NormalDepthSensitivities sensitivities;
+    FlowRegime flowRegime{FlowRegime::Subcritical};
     bool isValid{false};
-    QString errorMessage;
+    CalculationError error{CalculationError::None};
 };
 
+class CalculationControl;
+class ThreadPool;
+
 class HydraulicCalculator
 {
 public:
     HydraulicCalculator();
     ~HydraulicCalculator();
 
-    CalculationResults calculate(const ProjectData& projectData,
+    // Results are memoized on the canonicalized inputs, so repeating a
+    // calculation costs one hash lookup. Changing the solver settings clears
+    // the cache.
+    //
+    // `control` lets another thread cancel the calculation and receive
+    // progress. Concurrent calls are safe as long as the settings are not
+    // changed while a calculation is in flight. Cancelled results are not
+    // cached.
+    CalculationResults calculate(bool useUsCustomary,
                                  const GeometryData& geometryData,
-                                 const HydraulicData& hydraulicData);
+                                 const HydraulicData& hydraulicData,
+                                 const CalculationControl* control = nullptr);
+
+    // Water-surface profile over geometryData.length from a control depth
+    // (downstream for subcritical, upstream for supercritical control).
+    // Stations are passed to `consumer` as they are computed.
+    ProfileSummary calculate_profile(bool useUsCustomary,
+                                     const GeometryData& geometryData,
+                                     const HydraulicData& hydraulicData,
+                                     double controlDepth,
+                                     const std::function<void(const ProfileStation&)>& consumer);
+
+    void set_profile_settings(const GradualFlowSettings& settings);
+    const GradualFlowSettings& get_profile_settings() const;
+
+    // Opt-in Monte Carlo band for normal depth: n, Q and S are drawn from the
+    // given distributions and the channel comes from geometryData. One run
+    // costs sampleCount normal-depth solves, so calculate() never starts one;
+    // callers request it explicitly. Results are not cached, and a cancelled
+    // run returns an invalid result.
+    UncertaintyResult calculate_uncertainty(bool useUsCustomary,
+                                            const GeometryData& geometryData,
+                                            const Distribution& manningN,
+                                            const Distribution& discharge,
+                                            const Distribution& bedSlope,
+                                            const CalculationControl* control = nullptr);
+
+    void set_uncertainty_settings(const UncertaintySettings& settings);
+    const UncertaintySettings& get_uncertainty_settings() const;
+
+    void set_solver_settings(const SolverSettings& settings);
+    const SolverSettings& get_solver_settings() const;
+
+    void set_cache_capacity(std::size_t capacity);
+    CacheStatistics get_cache_statistics() const;
+    void clear_cache();
+
+    static constexpr std::size_t DEFAULT_CACHE_CAPACITY = 256;
 
 private:
-    std::unique_ptr<Channel> create_channel(const GeometryData& geometryData);
+    CalculationResults calculate_uncached(bool useUsCustomary,
+                                          const GeometryData& geometryData,
+                                          const HydraulicData& hydraulicData,
+                                          const CalculationControl* control);
+    std::optional<ChannelSection> create_section(const GeometryData& geometryData);
     Flow create_flow(const HydraulicData& hydraulicData);
-    QString determine_flow_regime(FlowRegime regime) const;
-    bool validate_inputs(const GeometryData& geometryData,
-                         const HydraulicData& hydraulicData,
-                         QString& errorMessage);
+    CompositeRoughness create_roughness(const HydraulicData& hydraulicData);
+    AnalysisResult solve_normal_depth(const Analyzer& analyzer,
+                                      const ChannelSection& section,
+                                      const GeometryData& geometryData,
+                                      const HydraulicData& hydraulicData,
+                                      double manningsCoefficient,
+                                      double gravity,
+                                      double& manningN);
+    CalculationError validate_inputs(const GeometryData& geometryData,
+                                     const HydraulicData& hydraulicData);
+    CalculationError validate_geometry(const GeometryData& geometryData);
+    ThreadPool& get_thread_pool();
+
+    SolverSettings solverSettings_;
+    GradualFlowSettings profileSettings_;
+    UncertaintySettings uncertaintySettings_;
+    std::unique_ptr<ThreadPool> threadPool_;   // Created on first use
+    std::once_flag threadPoolCreated_;
+    LruCache<CalculationKey, CalculationResults, CalculationKeyHash> cache_;
 };
 
 #endif // HYDRAULICCALCULATOR_H
@@ -0,0 +1,290 @@
+#include "HydrographRouter.h"
+#include "Analyzer.h"
+#include "ThreadPool.h"
+#include "UnitSystemConstants.h"
+#include <algorithm>
+#include <cmath>
+#include <variant>
+
+namespace
+{
+constexpr double TABLE_RANGE_FACTOR{2.0};       // Table top over the reference discharge
+constexpr double TABLE_MIN_FRACTION{1e-6};      // Table bottom over the table top
+constexpr int MAX_NEWTON_ITERATIONS{20};
+constexpr double NEWTON_TOLERANCE{1e-10};
+
+struct UniformFlowEntry
+{
+    double area{0.0};
+    double topWidth{0.0};
+    double celerity{0.0};   // dQ/dA at uniform flow
+};
+
+// Uniform-flow area, top width and celerity on an even grid in ln Q.
+// Below the grid the area falls linearly to zero with the other values held;
+// above it everything is held.
+class UniformFlowTable
+{
+public:
+    UniformFlowTable(const RoutingReach& reach, double manningsCoefficient, double gravity,
+                     double maxDischarge, std::size_t size)
+        : minDischarge_{TABLE_MIN_FRACTION * maxDischarge}
+        , logMinDischarge_{std::log(minDischarge_)}
+        , inverseSpacing_{static_cast<double>(size - 1) / std::log(1.0 / TABLE_MIN_FRACTION)}
+        , isValid_{true}
+    {
+        // The default depth floor is too coarse for the bottom of the table.
+        SolverSettings settings;
+        settings.minDepth = 1e-9;
+        Analyzer analyzer{settings};
+        entries_.reserve(size);
+
+        for (std::size_t i = 0; i < size && isValid_; ++i)
+        {
+            double discharge = std::exp(logMinDischarge_ + static_cast<double>(i) / inverseSpacing_);
+            AnalysisResult normal = analyzer.solve_section(reach.section, Flow{discharge, reach.manningN}, reach.bedSlope,
+                                                           manningsCoefficient, gravity);
+
+            if (!normal.isValid)
+            {
+                isValid_ = false;
+                break;
+            }
+
+            // Q ~ A^(5/3) P^(-2/3), so dQ/dy = Q (5 T / A - 2 P' / P) / 3.
+            SectionProperties properties = std::visit([&](const auto& section) { return section.evaluate(normal.normalDepth); },
+                                                      reach.section);
+            double dischargeDerivative = discharge * (5.0 * properties.topWidth / properties.area
+                                                      - 2.0 * properties.wettedPerimeterDerivative / properties.wettedPerimeter) / 3.0;
+
+            entries_.push_back({properties.area, properties.topWidth, dischargeDerivative / properties.topWidth});
+        }
+    }
+
+    bool is_valid() const { return isValid_; }
+
+    UniformFlowEntry lookup(double discharge) const
+    {
+        if (!(discharge > minDischarge_))
+        {
+            UniformFlowEntry entry = entries_.front();
+            entry.area *= std::max(discharge, 0.0) / minDischarge_;
+            return entry;
+        }
+
+        double position = (std::log(discharge) - logMinDischarge_) * inverseSpacing_;
+        std::size_t lastIndex = entries_.size() - 1;
+
+        if (position >= static_cast<double>(lastIndex))
+            return entries_.back();
+
+        std::size_t index = static_cast<std::size_t>(position);
+        double fraction = position - static_cast<double>(index);
+        const UniformFlowEntry& low = entries_[index];
+        const UniformFlowEntry& high = entries_[index + 1];
+
+        return {low.area + fraction * (high.area - low.area),
+                low.topWidth + fraction * (high.topWidth - low.topWidth),
+                low.celerity + fraction * (high.celerity - low.celerity)};
+    }
+
+private:
+    std::vector<UniformFlowEntry> entries_;
+    double minDischarge_;
+    double logMinDischarge_;
+    double inverseSpacing_;
+    bool isValid_;
+};
+
+bool is_valid_reach(const RoutingReach& reach)
+{
+    bool isSectionValid = std::visit([](const auto& section) { return section.is_valid(); }, reach.section);
+    return isSectionValid && reach.length > 0.0 && reach.bedSlope > 0.0 && reach.manningN > 0.0 && reach.lateralInflow >= 0.0;
+}
+
+// Q(j+1, n+1) from Q(j, n+1), Q(j, n) and Q(j+1, n), with C and D taken at
+// the average of the three.
+void sweep_muskingum_cunge(const UniformFlowTable& table, double upstreamInflow, double lateralInflow,
+                           double bedSlope, double timeStep, double spaceStep, std::vector<double>& discharge)
+{
+    double upstreamOld = discharge[0];
+    discharge[0] = upstreamInflow;
+
+    for (std::size_t node = 1; node < discharge.size(); ++node)
+    {
+        double old = discharge[node];
+        double reference = (upstreamOld + old + discharge[node - 1]) / 3.0;
+        UniformFlowEntry entry = table.lookup(reference);
+
+        double courant = entry.celerity * timeStep / spaceStep;
+        double cellReynolds = reference / (entry.topWidth * bedSlope * entry.celerity * spaceStep);
+        double inverseDenominator = 1.0 / (1.0 + courant + cellReynolds);
+
+        double value = ((courant + cellReynolds - 1.0) * discharge[node - 1]
+                        + (1.0 + courant - cellReynolds) * upstreamOld
+                        + (1.0 - courant + cellReynolds) * old
+                        + 2.0 * courant * lateralInflow * spaceStep) * inverseDenominator;
+
+        discharge[node] = std::max(value, 0.0);
+        upstreamOld = old;
+    }
+}
+
+// Backward-difference continuity, (dt/dx) Q + A(Q) = (dt/dx) Q(j, n+1) +
+// A(j+1, n) + q dt, solved per node by Newton with dA/dQ = 1 / c.
+void sweep_kinematic_wave(const UniformFlowTable& table, double upstreamInflow, double lateralInflow,
+                          double timeStep, double spaceStep, std::vector<double>& discharge, std::vector<double>& area)
+{
+    double courantRatio = timeStep / spaceStep;
+    discharge[0] = upstreamInflow;
+
+    for (std::size_t node = 1; node < discharge.size(); ++node)
+    {
+        double target = courantRatio * discharge[node - 1] + area[node] + timeStep * lateralInflow;
+        double value = discharge[node];
+        UniformFlowEntry entry = table.lookup(value);
+
+        for (int iteration = 0; iteration < MAX_NEWTON_ITERATIONS; ++iteration)
+        {
+            double residual = courantRatio * value + entry.area - target;
+            double step = residual / (courantRatio + 1.0 / entry.celerity);
+            value = std::max(value - step, 0.0);
+            entry = table.lookup(value);
+
+            if (std::abs(step) <= NEWTON_TOLERANCE * (value + 1e-12))
+                break;
+        }
+
+        discharge[node] = value;
+        area[node] = entry.area;
+    }
+}
+}
+
+const char* get_routing_method_name(RoutingMethod method)
+{
+    switch (method)
+    {
+    case RoutingMethod::KinematicWave:
+        return "Kinematic wave";
+    case RoutingMethod::MuskingumCunge:
+        return "Muskingum-Cunge";
+    default:
+        return "Unknown";
+    }
+}
+
+HydrographRouter::HydrographRouter(ThreadPool& threadPool, bool useUsCustomary)
+    : HydrographRouter(threadPool,
+                       UnitSystemConstants::get_mannings_coefficient(useUsCustomary),
+                       UnitSystemConstants::get_gravity(useUsCustomary))
+{
+}
+
+HydrographRouter::HydrographRouter(ThreadPool& threadPool, double manningsCoefficient, double gravity)
+    : threadPool_{threadPool}
+    , manningsCoefficient_{manningsCoefficient}
+    , gravity_{gravity}
+{
+}
+
+RoutingResult HydrographRouter::route(const RoutingReach& reach, const Hydrograph& inflow, const RoutingSettings& settings) const
+{
+    RoutingResult result;
+    const std::vector<double>& inflowDischarge = inflow.discharge;
+
+    if (!is_valid_reach(reach) || !(inflow.timeStep > 0.0) || inflowDischarge.empty() || settings.tableSize < 2 ||
+        settings.maxSegments == 0)
+        return result;
+
+    double peakInflow{0.0};
+    for (double discharge : inflowDischarge)
+    {
+        if (!(discharge >= 0.0) || !std::isfinite(discharge))
+            return result;
+
+        peakInflow = std::max(peakInflow, discharge);
+    }
+
+    std::size_t stepCount = inflowDischarge.size();
+    double referenceDischarge = peakInflow + reach.lateralInflow * reach.length;
+
+    if (referenceDischarge <= 0.0)
+    {
+        result.outflow.assign(stepCount, 0.0);
+        result.segmentCount = 1;
+        result.spaceStep = reach.length;
+        result.isValid = true;
+        return result;
+    }
+
+    UniformFlowTable table{reach, manningsCoefficient_, gravity_, TABLE_RANGE_FACTOR * referenceDischarge, settings.tableSize};
+
+    if (!table.is_valid())
+        return result;
+
+    double timeStep{inflow.timeStep};
+    double spaceStep{settings.spaceStep};
+
+    if (!(spaceStep > 0.0))
+    {
+        UniformFlowEntry peak = table.lookup(referenceDischarge);
+        spaceStep = 0.5 * (peak.celerity * timeStep + referenceDischarge / (peak.topWidth * reach.bedSlope * peak.celerity));
+    }
+
+    double segments = std::ceil(reach.length / spaceStep);
+    result.segmentCount = static_cast<std::size_t>(std::min(std::max(segments, 1.0), static_cast<double>(settings.maxSegments)));
+    result.spaceStep = reach.length / static_cast<double>(result.segmentCount);
+    spaceStep = result.spaceStep;
+
+    // Steady initial state: the first inflow plus the lateral inflow so far.
+    std::vector<double> discharge(result.segmentCount + 1);
+    std::vector<double> area;
+
+    for (std::size_t node = 0; node < discharge.size(); ++node)
+        discharge[node] = inflowDischarge[0] + reach.lateralInflow * spaceStep * static_cast<double>(node);
+
+    if (settings.method == RoutingMethod::KinematicWave)
+    {
+        area.resize(discharge.size());
+        for (std::size_t node = 0; node < discharge.size(); ++node)
+            area[node] = table.lookup(discharge[node]).area;
+    }
+
+    result.outflow.resize(stepCount);
+    result.outflow[0] = discharge.back();
+
+    for (std::size_t step = 1; step < stepCount; ++step)
+    {
+        if (settings.method == RoutingMethod::KinematicWave)
+            sweep_kinematic_wave(table, inflowDischarge[step], reach.lateralInflow, timeStep, spaceStep, discharge, area);
+        else
+            sweep_muskingum_cunge(table, inflowDischarge[step], reach.lateralInflow, reach.bedSlope, timeStep, spaceStep, discharge);
+
+        result.outflow[step] = discharge.back();
+    }
+
+    auto peak = std::max_element(result.outflow.begin(), result.outflow.end());
+    result.peakOutflow = *peak;
+    result.peakOutflowTime = timeStep * static_cast<double>(peak - result.outflow.begin());
+    result.isValid = true;
+    return result;
+}
+
+std::vector<RoutingResult> HydrographRouter::route_all(const std::vector<RoutingReach>& reaches,
+                                                       const std::vector<Hydrograph>& inflows,
+                                                       const RoutingSettings& settings) const
+{
+    std::vector<RoutingResult> results(reaches.size());
+
+    if (reaches.size() != inflows.size())
+        return results;
+
+    threadPool_.parallel_for(reaches.size(), 1, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+            results[i] = route(reaches[i], inflows[i], settings);
+    });
+
+    return results;
+}
@@ -0,0 +1,228 @@
+#include "IrregularChannel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+// Segments are summed into independent accumulators, one per lane, so the
+// compiler can vectorize the sums without reassociating additions. Eight
+// lanes fill an AVX-512 register and two AVX2 registers.
+constexpr std::size_t LANE_COUNT{8};
+
+bool is_valid_polyline(const std::vector<double>& stations, const std::vector<double>& elevations)
+{
+    if (stations.size() < 2 || stations.size() != elevations.size())
+        return false;
+
+    for (std::size_t i = 0; i < stations.size(); ++i)
+    {
+        if (!std::isfinite(stations[i]) || !std::isfinite(elevations[i]))
+            return false;
+
+        if (i > 0 && stations[i] < stations[i - 1])
+            return false;
+    }
+
+    return stations.back() > stations.front();
+}
+}
+
+IrregularChannel::IrregularChannel(const std::vector<double>& stations, const std::vector<double>& elevations, double depth)
+    : startHeights_{}
+    , endHeights_{}
+    , widths_{}
+    , lengths_{}
+    , inverseRises_{}
+    , lengthsPerRise_{}
+    , isGeometryValid_{is_valid_polyline(stations, elevations)}
+    , depth_{depth}
+    , properties_{}
+    , firstMoment_{0.0}
+{
+    if (isGeometryValid_)
+    {
+        double invert = *std::min_element(elevations.begin(), elevations.end());
+        std::size_t segmentCount = stations.size() - 1;
+
+        startHeights_.resize(segmentCount);
+        endHeights_.resize(segmentCount);
+        widths_.resize(segmentCount);
+        lengths_.resize(segmentCount);
+        inverseRises_.resize(segmentCount);
+        lengthsPerRise_.resize(segmentCount);
+
+        for (std::size_t i = 0; i < segmentCount; ++i)
+        {
+            startHeights_[i] = elevations[i] - invert;
+            endHeights_[i] = elevations[i + 1] - invert;
+            widths_[i] = stations[i + 1] - stations[i];
+            double rise = std::abs(endHeights_[i] - startHeights_[i]);
+            lengths_[i] = std::hypot(widths_[i], rise);
+
+            // Partly wet segments, the only ones using lengthsPerRise_, are
+            // never level.
+            inverseRises_[i] = rise > 0.0 ? 1.0 / rise : std::numeric_limits<double>::infinity();
+            lengthsPerRise_[i] = rise > 0.0 ? lengths_[i] / rise : 0.0;
+        }
+    }
+
+    set_depth(depth);
+}
+
+SectionProperties IrregularChannel::evaluate(double depth, double& firstMoment) const
+{
+    firstMoment = 0.0;
+
+    if (!isGeometryValid_ || !(depth > 0.0))
+        return SectionProperties{};
+
+    const double* startHeights = startHeights_.data();
+    const double* endHeights = endHeights_.data();
+    const double* widths = widths_.data();
+    const double* lengths = lengths_.data();
+    const double* inverseRises = inverseRises_.data();
+    const double* lengthsPerRise = lengthsPerRise_.data();
+    std::size_t segmentCount = startHeights_.size();
+
+    double area[LANE_COUNT]{};
+    double wettedPerimeter[LANE_COUNT]{};
+    double topWidth[LANE_COUNT]{};
+    double wettedPerimeterDerivative[LANE_COUNT]{};
+    double firstMomentSum[LANE_COUNT]{};
+
+    // Clips segment i at the water surface. The water depths over its end
+    // points are lowDepth <= highDepth, negative above the water. The wetted
+    // fraction highDepth / (highDepth - lowDepth) clamped to [0, 1] also
+    // covers fully wet (> 1) and dry (<= 0) segments. A level segment has an
+    // infinite inverse rise: it is fully wet below the surface, dry above
+    // it, and dry on it (NaN, clamped to 0). Every branch is a select, so
+    // the loop vectorizes; keep divisions and conditional loads out of it.
+    auto accumulate_segment = [&](std::size_t i, std::size_t lane)
+    {
+        double startDepth = depth - startHeights[i];
+        double endDepth = depth - endHeights[i];
+        double lowDepth = std::min(startDepth, endDepth);
+        double highDepth = std::max(startDepth, endDepth);
+
+        double wettedFraction = std::min(1.0, std::max(0.0, highDepth * inverseRises[i]));
+        double wetLowDepth = std::max(lowDepth, 0.0);
+        double wetWidth = wettedFraction * widths[i];
+        double partlyWet = highDepth > 0.0 && lowDepth < 0.0 ? 1.0 : 0.0;
+
+        area[lane] += wetWidth * (wetLowDepth + highDepth);
+        wettedPerimeter[lane] += wettedFraction * lengths[i];
+        topWidth[lane] += wetWidth;
+        wettedPerimeterDerivative[lane] += partlyWet * lengthsPerRise[i];
+        firstMomentSum[lane] += wetWidth * (highDepth * highDepth + wetLowDepth * (wetLowDepth + highDepth));
+    };
+
+    std::size_t i{0};
+
+    for (; i + LANE_COUNT <= segmentCount; i += LANE_COUNT)
+    {
+        for (std::size_t lane = 0; lane < LANE_COUNT; ++lane)
+            accumulate_segment(i + lane, lane);
+    }
+
+    for (; i < segmentCount; ++i)
+        accumulate_segment(i, 0);
+
+    for (std::size_t lane = 1; lane < LANE_COUNT; ++lane)
+    {
+        area[0] += area[lane];
+        wettedPerimeter[0] += wettedPerimeter[lane];
+        topWidth[0] += topWidth[lane];
+        wettedPerimeterDerivative[0] += wettedPerimeterDerivative[lane];
+        firstMomentSum[0] += firstMomentSum[lane];
+    }
+
+    // Vertical walls above the end points.
+    double leftWall = std::max(depth - startHeights_.front(), 0.0);
+    double rightWall = std::max(depth - endHeights_.back(), 0.0);
+
+    SectionProperties properties;
+    properties.area = 0.5 * area[0];
+    properties.wettedPerimeter = wettedPerimeter[0] + leftWall + rightWall;
+    properties.topWidth = topWidth[0];
+    properties.wettedPerimeterDerivative = wettedPerimeterDerivative[0]
+                                           + (leftWall > 0.0 ? 1.0 : 0.0) + (rightWall > 0.0 ? 1.0 : 0.0);
+
+    firstMoment = firstMomentSum[0] / 6.0;
+    return properties;
+}
+
+SectionProperties IrregularChannel::evaluate(double depth) const
+{
+    double firstMoment{0.0};
+    return evaluate(depth, firstMoment);
+}
+
+double IrregularChannel::calculate_area() const
+{
+    return properties_.area;
+}
+
+double IrregularChannel::calculate_wetted_perimeter() const
+{
+    return properties_.wettedPerimeter;
+}
+
+bool IrregularChannel::is_valid() const
+{
+    return isGeometryValid_ && depth_ > 0.0;
+}
+
+void IrregularChannel::set_depth(double depth)
+{
+    depth_ = depth;
+    properties_ = evaluate(depth_, firstMoment_);
+}
+
+double IrregularChannel::calculate_top_width() const
+{
+    return properties_.topWidth;
+}
+
+double IrregularChannel::calculate_wetted_perimeter_derivative() const
+{
+    return properties_.wettedPerimeterDerivative;
+}
+
+double IrregularChannel::calculate_first_moment_of_area() const
+{
+    return firstMoment_;
+}
+
+std::size_t IrregularChannel::count_wetted_regions() const
+{
+    std::size_t regionCount{0};
+    bool isPreviousWet{false};
+
+    for (std::size_t i = 0; i < startHeights_.size(); ++i)
+    {
+        bool isWet = std::min(startHeights_[i], endHeights_[i]) < depth_;
+
+        // Two wet segments belong to one region only if the point they share
+        // is below the surface; a point touching it separates them.
+        if (isWet && !(isPreviousWet && startHeights_[i] < depth_))
+            ++regionCount;
+
+        isPreviousWet = isWet;
+    }
+
+    return regionCount;
+}
+
+double IrregularChannel::get_bank_full_depth() const
+{
+    if (!isGeometryValid_)
+        return 0.0;
+
+    return std::min(startHeights_.front(), endHeights_.back());
+}
+
+std::size_t IrregularChannel::get_segment_count() const
+{
+    return startHeights_.size();
+}
@@ -0,0 +1,63 @@
+#ifndef IRREGULARCHANNEL_H
+#define IRREGULARCHANNEL_H
+
+#include "Channel.h"
+#include "ChannelGeometry.h"
+#include <cstddef>
+#include <vector>
+
+// Surveyed cross-section given as a station/elevation polyline, ordered left
+// to right. The depth is measured from the lowest point of the section, and
+// the water surface is level across it, so every part of the polyline below
+// that level is wetted, including low areas separated by islands.
+// Above the end points, the section continues as vertical walls.
+//
+// The polyline is stored as structure-of-arrays segment data. set_depth
+// evaluates every property in one branch-free pass over the segments and
+// caches the results. A solver iteration therefore costs one sweep, not one
+// per getter.
+class IrregularChannel : public Channel
+{
+public:
+    IrregularChannel(const std::vector<double>& stations, const std::vector<double>& elevations, double depth);
+
+    double calculate_area() const override;
+    double calculate_wetted_perimeter() const override;
+    bool is_valid() const override;
+    void set_depth(double depth) override;
+    double calculate_top_width() const override;
+    double calculate_wetted_perimeter_derivative() const override;
+    double calculate_first_moment_of_area() const override;
+
+    // Properties at any depth without changing the channel's own depth.
+    SectionProperties evaluate(double depth) const;
+
+    // Number of separate wetted sub-areas at the current depth.
+    std::size_t count_wetted_regions() const;
+
+    // Depth at which the lower of the two end points is overtopped.
+    double get_bank_full_depth() const;
+
+    std::size_t get_segment_count() const;
+
+private:
+    SectionProperties evaluate(double depth, double& firstMoment) const;
+
+    // Heights of each segment's end points above the lowest point, its
+    // horizontal and sloped lengths, the inverse of its rise, and its sloped
+    // length per unit rise (how fast its wetted length grows while it is
+    // partly submerged).
+    std::vector<double> startHeights_;
+    std::vector<double> endHeights_;
+    std::vector<double> widths_;
+    std::vector<double> lengths_;
+    std::vector<double> inverseRises_;
+    std::vector<double> lengthsPerRise_;
+
+    bool isGeometryValid_;
+    double depth_;
+    SectionProperties properties_;
+    double firstMoment_;
+};
+
+#endif // IRREGULARCHANNEL_H
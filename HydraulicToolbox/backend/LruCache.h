@@ -0,0 +1,158 @@
+#ifndef LRUCACHE_H
+#define LRUCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+struct CacheStatistics
+{
+    std::uint64_t hitCount{0};
+    std::uint64_t missCount{0};
+    std::uint64_t evictionCount{0};
+    std::size_t size{0};
+    std::size_t capacity{0};
+};
+
+// Bounded least-recently-used map. Entries live in a list ordered from most
+// to least recently used, and a hash map points into the list, so lookup,
+// insertion and eviction are O(1). All members lock one mutex, which keeps
+// the cache safe to share between threads; values are returned by copy.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache
+{
+public:
+    explicit LruCache(std::size_t capacity);
+
+    LruCache(const LruCache&) = delete;
+    LruCache& operator=(const LruCache&) = delete;
+
+    // Returns the value and marks it most recently used. Counts a hit or miss.
+    std::optional<Value> find(const Key& key);
+
+    // Inserts or replaces the value, evicting the least recently used entry
+    // when the cache is full.
+    void insert(const Key& key, Value value);
+
+    void clear();
+
+    // Shrinking the capacity evicts entries immediately. A capacity of zero
+    // disables caching.
+    void set_capacity(std::size_t capacity);
+
+    CacheStatistics get_statistics() const;
+    void reset_statistics();
+
+private:
+    using Entry = std::pair<Key, Value>;
+    using EntryList = std::list<Entry>;
+
+    void evict_to(std::size_t size);
+
+    mutable std::mutex mutex_;
+    std::size_t capacity_;
+    EntryList entries_;
+    std::unordered_map<Key, typename EntryList::iterator, Hash> index_;
+    std::uint64_t hitCount_{0};
+    std::uint64_t missCount_{0};
+    std::uint64_t evictionCount_{0};
+};
+
+// ============================================================================
+// TEMPLATE IMPLEMENTATION
+// ============================================================================
+
+template <typename Key, typename Value, typename Hash>
+LruCache<Key, Value, Hash>::LruCache(std::size_t capacity)
+    : capacity_{capacity}
+{
+}
+
+template <typename Key, typename Value, typename Hash>
+std::optional<Value> LruCache<Key, Value, Hash>::find(const Key& key)
+{
+    std::lock_guard<std::mutex> lock{mutex_};
+
+    auto position = index_.find(key);
+    if (position == index_.end())
+    {
+        ++missCount_;
+        return std::nullopt;
+    }
+
+    ++hitCount_;
+    entries_.splice(entries_.begin(), entries_, position->second);
+    return position->second->second;
+}
+
+template <typename Key, typename Value, typename Hash>
+void LruCache<Key, Value, Hash>::insert(const Key& key, Value value)
+{
+    std::lock_guard<std::mutex> lock{mutex_};
+
+    if (capacity_ == 0)
+        return;
+
+    auto position = index_.find(key);
+    if (position != index_.end())
+    {
+        position->second->second = std::move(value);
+        entries_.splice(entries_.begin(), entries_, position->second);
+        return;
+    }
+
+    evict_to(capacity_ - 1);
+    entries_.emplace_front(key, std::move(value));
+    index_.emplace(key, entries_.begin());
+}
+
+template <typename Key, typename Value, typename Hash>
+void LruCache<Key, Value, Hash>::clear()
+{
+    std::lock_guard<std::mutex> lock{mutex_};
+    index_.clear();
+    entries_.clear();
+}
+
+template <typename Key, typename Value, typename Hash>
+void LruCache<Key, Value, Hash>::set_capacity(std::size_t capacity)
+{
+    std::lock_guard<std::mutex> lock{mutex_};
+    capacity_ = capacity;
+    evict_to(capacity_);
+}
+
+template <typename Key, typename Value, typename Hash>
+CacheStatistics LruCache<Key, Value, Hash>::get_statistics() const
+{
+    std::lock_guard<std::mutex> lock{mutex_};
+    return CacheStatistics{hitCount_, missCount_, evictionCount_, entries_.size(), capacity_};
+}
+
+template <typename Key, typename Value, typename Hash>
+void LruCache<Key, Value, Hash>::reset_statistics()
+{
+    std::lock_guard<std::mutex> lock{mutex_};
+    hitCount_ = 0;
+    missCount_ = 0;
+    evictionCount_ = 0;
+}
+
+// Caller holds the mutex.
+template <typename Key, typename Value, typename Hash>
+void LruCache<Key, Value, Hash>::evict_to(std::size_t size)
+{
+    while (entries_.size() > size)
+    {
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+        ++evictionCount_;
+    }
+}
+
+#endif // LRUCACHE_H
@@ -0,0 +1,172 @@
+#include "NetworkAnalyzer.h"
+#include "CriticalFlowAnalyzer.h"
+#include "UnitSystemConstants.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+
+NetworkAnalyzer::NetworkAnalyzer(WorkStealingPool& pool, bool useUsCustomary,
+                                 const GradualFlowSettings& profileSettings, const SolverSettings& solverSettings)
+    : NetworkAnalyzer(pool,
+                      UnitSystemConstants::get_mannings_coefficient(useUsCustomary),
+                      UnitSystemConstants::get_gravity(useUsCustomary),
+                      profileSettings,
+                      solverSettings)
+{
+}
+
+NetworkAnalyzer::NetworkAnalyzer(WorkStealingPool& pool, double manningsCoefficient, double gravity,
+                                 const GradualFlowSettings& profileSettings, const SolverSettings& solverSettings)
+    : pool_{pool}
+    , manningsCoefficient_{manningsCoefficient}
+    , gravity_{gravity}
+    , profileSettings_{profileSettings}
+    , solverSettings_{solverSettings}
+{
+}
+
+NetworkResult NetworkAnalyzer::solve(const ChannelNetwork& network, double outletDepth) const
+{
+    NetworkResult result;
+    result.error = network.get_error();
+
+    if (!network.is_valid())
+        return result;
+
+    std::size_t reachCount = network.get_reach_count();
+    result.reaches.assign(reachCount, NetworkReachResult{});
+
+    std::vector<std::atomic<std::size_t>> remainingUpstream(reachCount);
+    for (std::size_t reach = 0; reach < reachCount; ++reach)
+        remainingUpstream[reach].store(network.get_upstream_count(reach), std::memory_order_relaxed);
+
+    for (std::size_t headwater : network.get_headwaters())
+        pool_.spawn([this, &network, &result, &remainingUpstream, headwater]
+                    { accumulate_reach(network, headwater, result, remainingUpstream); });
+
+    pool_.wait();
+
+    for (std::size_t outlet : network.get_outlets())
+        pool_.spawn([this, &network, &result, outlet, outletDepth]
+                    { propagate_reach(network, outlet, outletDepth, result); });
+
+    pool_.wait();
+
+    for (const NetworkReachResult& reachResult : result.reaches)
+    {
+        if (!reachResult.isValid)
+            ++result.failedReachCount;
+    }
+
+    result.isValid = result.failedReachCount == 0;
+    return result;
+}
+
+// The upstream results a reach reads were written before the counter
+// decrements that released it, and the acquire-release decrement makes
+// them visible to whichever thread takes the reach on.
+void NetworkAnalyzer::accumulate_reach(const ChannelNetwork& network, std::size_t reach, NetworkResult& result,
+                                       std::vector<std::atomic<std::size_t>>& remainingUpstream) const
+{
+    for (;;)
+    {
+        const NetworkReach& networkReach = network.get_reach(reach);
+        NetworkReachResult& reachResult = result.reaches[reach];
+
+        double discharge{networkReach.lateralInflow};
+        for (const std::size_t* upstream = network.get_upstream_begin(reach); upstream != network.get_upstream_end(reach); ++upstream)
+            discharge += result.reaches[*upstream].discharge;
+
+        reachResult.discharge = discharge;
+        solve_reach_depths(networkReach, reachResult);
+
+        std::size_t downstream = networkReach.downstream;
+        if (downstream == NO_REACH || remainingUpstream[downstream].fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+
+        reach = downstream;
+    }
+}
+
+// The first upstream reach is continued on this task; the others are
+// spawned onto this worker's deque for idle workers to steal.
+void NetworkAnalyzer::propagate_reach(const ChannelNetwork& network, std::size_t reach, double boundaryDepth,
+                                      NetworkResult& result) const
+{
+    for (;;)
+    {
+        NetworkReachResult& reachResult = result.reaches[reach];
+        solve_reach_profile(network.get_reach(reach), boundaryDepth, reachResult);
+
+        const std::size_t* begin = network.get_upstream_begin(reach);
+        const std::size_t* end = network.get_upstream_end(reach);
+
+        if (begin == end)
+            return;
+
+        // 0 tells the upstream reach to start from its normal depth.
+        auto junction_depth = [&](std::size_t upstream)
+        {
+            double depth = reachResult.upstreamDepth - network.get_reach(upstream).junctionDrop;
+            return reachResult.isValid && depth > 0.0 ? depth : 0.0;
+        };
+
+        for (const std::size_t* upstream = begin + 1; upstream != end; ++upstream)
+        {
+            std::size_t upstreamReach = *upstream;
+            double upstreamBoundary = junction_depth(upstreamReach);
+            pool_.spawn([this, &network, &result, upstreamReach, upstreamBoundary]
+                        { propagate_reach(network, upstreamReach, upstreamBoundary, result); });
+        }
+
+        boundaryDepth = junction_depth(*begin);
+        reach = *begin;
+    }
+}
+
+void NetworkAnalyzer::solve_reach_depths(const NetworkReach& reach, NetworkReachResult& reachResult) const
+{
+    if (reachResult.discharge <= 0.0)
+    {
+        reachResult.profileStatus = ProfileStatus::Completed;
+        reachResult.isValid = true;
+        return;
+    }
+
+    Analyzer analyzer{solverSettings_};
+    CriticalFlowAnalyzer criticalAnalyzer{solverSettings_};
+
+    AnalysisResult normal = analyzer.solve_section(reach.section, Flow{reachResult.discharge, reach.manningN},
+                                                   reach.bedSlope, manningsCoefficient_, gravity_);
+    CriticalFlowResult critical = criticalAnalyzer.solve_section(reach.section, reachResult.discharge, gravity_);
+
+    reachResult.normalDepth = normal.normalDepth;
+    reachResult.criticalDepth = critical.criticalDepth;
+    reachResult.isValid = normal.isValid && critical.isValid;
+}
+
+void NetworkAnalyzer::solve_reach_profile(const NetworkReach& reach, double boundaryDepth,
+                                          NetworkReachResult& reachResult) const
+{
+    if (!reachResult.isValid || reachResult.discharge <= 0.0)
+        return;
+
+    double normalDepth{reachResult.normalDepth};
+    double criticalDepth{reachResult.criticalDepth};
+    bool isSteep = normalDepth < criticalDepth;
+
+    double controlDepth{criticalDepth};
+    if (!isSteep)
+        controlDepth = boundaryDepth > 0.0 ? std::max(boundaryDepth, criticalDepth) : normalDepth;
+
+    GradualFlowAnalyzer profileAnalyzer{profileSettings_, solverSettings_};
+    ProfileSummary summary = profileAnalyzer.compute_section_profile(reach.section, Flow{reachResult.discharge, reach.manningN},
+                                                                     reach.bedSlope, reach.length, controlDepth,
+                                                                     manningsCoefficient_, gravity_,
+                                                                     [](const ProfileStation&) {});
+
+    reachResult.profileType = summary.profileType;
+    reachResult.profileStatus = summary.status;
+    reachResult.upstreamDepth = isSteep ? controlDepth : summary.endDepth;
+    reachResult.downstreamDepth = isSteep ? summary.endDepth : controlDepth;
+    reachResult.isValid = summary.status == ProfileStatus::Completed;
+}
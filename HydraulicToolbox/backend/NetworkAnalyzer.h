@@ -0,0 +1,81 @@
+#ifndef NETWORKANALYZER_H
+#define NETWORKANALYZER_H
+
+#include "Analyzer.h"
+#include "ChannelNetwork.h"
+#include "GradualFlowAnalyzer.h"
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+class WorkStealingPool;
+
+struct NetworkReachResult
+{
+    double discharge{0.0};
+    double normalDepth{0.0};
+    double criticalDepth{0.0};
+    double upstreamDepth{0.0};       // Depth at the upstream end of the reach
+    double downstreamDepth{0.0};
+    ProfileType profileType{ProfileType::Uniform};
+    ProfileStatus profileStatus{ProfileStatus::InvalidInput};
+    bool isValid{false};             // Dry reaches (no discharge) are valid with zero depths
+};
+
+struct NetworkResult
+{
+    std::vector<NetworkReachResult> reaches;   // Indexed like the network's reaches
+    std::size_t failedReachCount{0};
+    NetworkError error{NetworkError::Empty};
+    bool isValid{false};                       // Valid network and every reach solved
+};
+
+// Steady flow through a dendritic channel network in two passes, both run
+// as task graphs on a work-stealing pool:
+//
+// 1. Headwaters to outlets: a reach's discharge is its lateral inflow plus
+//    the discharge of its upstream reaches, then its normal and critical
+//    depths are solved. A reach becomes ready when its last upstream reach
+//    finishes, and that task carries on with it instead of spawning.
+// 2. Outlets to headwaters: each reach's profile is integrated from its
+//    control, then its upstream reaches are released. On a mild reach the
+//    control is the junction water level at the downstream end (the
+//    downstream reach's upstream depth less the junction drop), or critical
+//    depth where the water surface falls below it. A steep reach is
+//    controlled by critical depth at its upstream end.
+//
+// Junction losses are neglected, the water level is continuous across a
+// junction, and a hydraulic jump inside a reach is not located. Every reach
+// is solved the same way whatever the thread count, so results are
+// identical across pool sizes.
+class NetworkAnalyzer
+{
+public:
+    NetworkAnalyzer(WorkStealingPool& pool, bool useUsCustomary,
+                    const GradualFlowSettings& profileSettings = GradualFlowSettings{},
+                    const SolverSettings& solverSettings = SolverSettings{});
+    NetworkAnalyzer(WorkStealingPool& pool, double manningsCoefficient, double gravity,
+                    const GradualFlowSettings& profileSettings = GradualFlowSettings{},
+                    const SolverSettings& solverSettings = SolverSettings{});
+
+    // outletDepth is the tailwater depth at every outlet; 0 starts each
+    // outlet at its normal depth.
+    NetworkResult solve(const ChannelNetwork& network, double outletDepth = 0.0) const;
+
+private:
+    void accumulate_reach(const ChannelNetwork& network, std::size_t reach, NetworkResult& result,
+                          std::vector<std::atomic<std::size_t>>& remainingUpstream) const;
+    void propagate_reach(const ChannelNetwork& network, std::size_t reach, double boundaryDepth,
+                         NetworkResult& result) const;
+
+    void solve_reach_depths(const NetworkReach& reach, NetworkReachResult& reachResult) const;
+    void solve_reach_profile(const NetworkReach& reach, double boundaryDepth, NetworkReachResult& reachResult) const;
+
+    WorkStealingPool& pool_;
+    double manningsCoefficient_;
+    double gravity_;
+    GradualFlowSettings profileSettings_;
+    SolverSettings solverSettings_;
+};
+
+#endif // NETWORKANALYZER_H
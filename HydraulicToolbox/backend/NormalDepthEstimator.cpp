@@ -0,0 +1,126 @@
+#include "NormalDepthEstimator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+constexpr double LOG_CONVEYANCE_MIN{-16.0};
+constexpr double LOG_CONVEYANCE_STEP{0.125};
+constexpr int LOG_CONVEYANCE_COUNT{369};   // ln Phi in [-16, 30]
+constexpr double SIDE_SLOPE_STEP{0.25};
+constexpr int SIDE_SLOPE_COUNT{33};        // z in [0, 8]
+
+// ln Phi and d ln Phi / d ln(y/b) for a unit-width section at y/b = exp(s).
+void dimensionless_conveyance(double s, double sideSlope, double& logConveyance, double& derivative)
+{
+    double eta = std::exp(s);
+    double wallFactor = 2.0 * std::sqrt(sideSlope * sideSlope + 1.0);
+    double area = (1.0 + sideSlope * eta) * eta;
+    double perimeter = 1.0 + wallFactor * eta;
+
+    logConveyance = (5.0 * std::log(area) - 2.0 * std::log(perimeter)) / 3.0;
+    derivative = eta * (5.0 * (1.0 + 2.0 * sideSlope * eta) / area - 2.0 * wallFactor / perimeter) / 3.0;
+}
+
+double solve_log_relative_depth(double logConveyance, double sideSlope)
+{
+    double low{-40.0};
+    double high{40.0};
+    double s = 0.6 * logConveyance;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        double value{0.0};
+        double derivative{0.0};
+        dimensionless_conveyance(s, sideSlope, value, derivative);
+
+        double residual = value - logConveyance;
+        if (std::abs(residual) < 1e-13)
+            break;
+
+        if (residual < 0.0)
+            low = s;
+        else
+            high = s;
+
+        double next = s - residual / derivative;
+        s = (next > low && next < high) ? next : 0.5 * (low + high);
+    }
+
+    return s;
+}
+}
+
+const DimensionlessDepthTable& DimensionlessDepthTable::instance()
+{
+    static const DimensionlessDepthTable table;
+    return table;
+}
+
+DimensionlessDepthTable::DimensionlessDepthTable()
+    : logRelativeDepths_(static_cast<std::size_t>(SIDE_SLOPE_COUNT * LOG_CONVEYANCE_COUNT))
+{
+    for (int j = 0; j < SIDE_SLOPE_COUNT; ++j)
+    {
+        for (int i = 0; i < LOG_CONVEYANCE_COUNT; ++i)
+        {
+            logRelativeDepths_[static_cast<std::size_t>(j * LOG_CONVEYANCE_COUNT + i)] =
+                solve_log_relative_depth(LOG_CONVEYANCE_MIN + i * LOG_CONVEYANCE_STEP, j * SIDE_SLOPE_STEP);
+        }
+    }
+}
+
+double DimensionlessDepthTable::estimate_relative_depth(double dimensionlessConveyance, double sideSlope) const
+{
+    if (!(dimensionlessConveyance > 0.0) || !(sideSlope >= 0.0) || sideSlope > MAX_SIDE_SLOPE)
+        return 0.0;
+
+    double u = (std::log(dimensionlessConveyance) - LOG_CONVEYANCE_MIN) / LOG_CONVEYANCE_STEP;
+    double v = sideSlope / SIDE_SLOPE_STEP;
+
+    if (u < 0.0 || u > LOG_CONVEYANCE_COUNT - 1)
+        return 0.0;
+
+    int i = std::min(static_cast<int>(u), LOG_CONVEYANCE_COUNT - 2);
+    int j = std::min(static_cast<int>(v), SIDE_SLOPE_COUNT - 2);
+    double fu = u - i;
+    double fv = v - j;
+
+    const double* row = &logRelativeDepths_[static_cast<std::size_t>(j * LOG_CONVEYANCE_COUNT + i)];
+    const double* nextRow = row + LOG_CONVEYANCE_COUNT;
+
+    double lower = row[0] + fu * (row[1] - row[0]);
+    double upper = nextRow[0] + fu * (nextRow[1] - nextRow[0]);
+
+    return std::exp(lower + fv * (upper - lower));
+}
+
+double estimate_normal_depth(const RectangularSection& section, double targetConveyance)
+{
+    if (!section.is_valid())
+        return 0.0;
+
+    double phi = targetConveyance / std::pow(section.width, 8.0 / 3.0);
+    return section.width * DimensionlessDepthTable::instance().estimate_relative_depth(phi, 0.0);
+}
+
+double estimate_normal_depth(const TrapezoidalSection& section, double targetConveyance)
+{
+    if (section.bottomWidth <= 0.0)
+        return estimate_normal_depth(TriangularSection{section.sideSlope}, targetConveyance);
+
+    double phi = targetConveyance / std::pow(section.bottomWidth, 8.0 / 3.0);
+    return section.bottomWidth * DimensionlessDepthTable::instance().estimate_relative_depth(phi, section.sideSlope);
+}
+
+// K = z^(5/3) y^(8/3) / (2 sqrt(1 + z^2))^(2/3) inverts in closed form.
+double estimate_normal_depth(const TriangularSection& section, double targetConveyance)
+{
+    if (!section.is_valid() || !(targetConveyance > 0.0))
+        return 0.0;
+
+    double wallFactor = section.wall_factor();
+    return std::pow(targetConveyance * std::cbrt(wallFactor * wallFactor)
+                        / std::pow(section.sideSlope, 5.0 / 3.0),
+                    3.0 / 8.0);
+}
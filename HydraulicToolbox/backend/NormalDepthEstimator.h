@@ -0,0 +1,41 @@
+#ifndef NORMALDEPTHESTIMATOR_H
+#define NORMALDEPTHESTIMATOR_H
+
+#include "ChannelGeometry.h"
+#include <vector>
+
+// Dimensionless normal-depth curve for trapezoidal sections (rectangular
+// when z = 0). With the geometric conveyance K = Q n / (k sqrt(S)), the
+// relative depth y/b depends only on Phi = K / b^(8/3) and the side slope z.
+// The table stores ln(y/b) on a uniform (ln Phi, z) grid, so a lookup is
+// two index computations and one bilinear interpolation.
+class DimensionlessDepthTable
+{
+public:
+    static const DimensionlessDepthTable& instance();
+
+    // Returns y/b, or 0 when (Phi, z) lies outside the table.
+    double estimate_relative_depth(double dimensionlessConveyance, double sideSlope) const;
+
+    static constexpr double MAX_SIDE_SLOPE = 8.0;
+
+private:
+    DimensionlessDepthTable();
+
+    std::vector<double> logRelativeDepths_;   // Row-major: [sideSlopeIndex][logConveyanceIndex]
+};
+
+// Initial normal-depth estimates from the geometric conveyance. They return
+// 0 when no estimate is available, in which case the solver brackets the
+// full depth range.
+double estimate_normal_depth(const RectangularSection& section, double targetConveyance);
+double estimate_normal_depth(const TrapezoidalSection& section, double targetConveyance);
+double estimate_normal_depth(const TriangularSection& section, double targetConveyance);
+
+template <typename Section>
+double estimate_normal_depth(const Section& /*section*/, double /*targetConveyance*/)
+{
+    return 0.0;
+}
+
+#endif // NORMALDEPTHESTIMATOR_H
@@ -0,0 +1,372 @@
+#include "ParameterSweep.h"
+#include "CalculationControl.h"
+#include "CounterRandom.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <utility>
+
+namespace
+{
+constexpr std::uint32_t FEISTEL_ROUNDS{4};
+constexpr std::uint32_t PERMUTATION_KEY_STREAM{0x9e37};
+
+// Keyed bijection on [0, count): a balanced Feistel network on the smallest
+// even power of two holding count, cycle-walked until the image falls in
+// range (under four rounds of the network on average).
+std::uint64_t permute(std::uint64_t index, std::uint64_t count, std::uint64_t key)
+{
+    int halfBits{1};
+    while (halfBits < 32 && (std::uint64_t{1} << (2 * halfBits)) < count)
+        ++halfBits;
+
+    std::uint64_t mask = (std::uint64_t{1} << halfBits) - 1;
+    std::uint64_t value{index};
+
+    do
+    {
+        std::uint64_t left = value >> halfBits;
+        std::uint64_t right = value & mask;
+
+        for (std::uint32_t round = 0; round < FEISTEL_ROUNDS; ++round)
+        {
+            std::uint64_t next = left ^ (counter_random_bits(key, right, round) & mask);
+            left = right;
+            right = next;
+        }
+
+        value = (left << halfBits) | right;
+    } while (value >= count);
+
+    return value;
+}
+
+// Value at `fraction` in [0, 1] of the axis range.
+double interpolate_range(const SweepAxis& axis, double fraction)
+{
+    if (axis.scale == SweepScale::Logarithmic)
+    {
+        double logLower = std::log(axis.lower);
+        return std::exp(logLower + fraction * (std::log(axis.upper) - logLower));
+    }
+
+    return axis.lower + fraction * (axis.upper - axis.lower);
+}
+
+void set_parameter(SweepParameter parameter, double value, GeometryData& geometry, HydraulicData& hydraulics)
+{
+    switch (parameter)
+    {
+    case SweepParameter::BottomWidth:
+        geometry.bottomWidth = value;
+        break;
+    case SweepParameter::SideSlope:
+        geometry.sideSlope = value;
+        break;
+    case SweepParameter::BedSlope:
+        geometry.bedSlope = value;
+        break;
+    case SweepParameter::Discharge:
+        hydraulics.discharge = value;
+        break;
+    case SweepParameter::ManningN:
+        hydraulics.manningN = value;
+        break;
+    case SweepParameter::BankManningN:
+        hydraulics.bankManningN = value;
+        break;
+    }
+}
+
+// Product of the cartesian level counts; false on overflow.
+bool multiply_level_counts(const std::vector<SweepAxis>& axes, std::uint64_t& product)
+{
+    product = 1;
+
+    for (const SweepAxis& axis : axes)
+    {
+        std::uint64_t levels = axis.get_level_count();
+        if (levels == 0 || product > std::numeric_limits<std::uint64_t>::max() / levels)
+            return false;
+        product *= levels;
+    }
+
+    return true;
+}
+}
+
+const char* get_sweep_parameter_name(SweepParameter parameter)
+{
+    switch (parameter)
+    {
+    case SweepParameter::BottomWidth:
+        return "Bottom width";
+    case SweepParameter::SideSlope:
+        return "Side slope";
+    case SweepParameter::BedSlope:
+        return "Bed slope";
+    case SweepParameter::Discharge:
+        return "Discharge";
+    case SweepParameter::ManningN:
+        return "Manning's n";
+    case SweepParameter::BankManningN:
+        return "Bank Manning's n";
+    default:
+        return "Unknown";
+    }
+}
+
+// ============================================================================
+// SWEEP AXIS
+// ============================================================================
+
+SweepAxis SweepAxis::range(SweepParameter parameter, double lower, double upper, std::size_t count, SweepScale scale)
+{
+    SweepAxis axis;
+    axis.parameter = parameter;
+    axis.lower = lower;
+    axis.upper = upper;
+    axis.count = count;
+    axis.scale = scale;
+    return axis;
+}
+
+SweepAxis SweepAxis::list(SweepParameter parameter, std::vector<double> values)
+{
+    SweepAxis axis;
+    axis.parameter = parameter;
+    axis.values = std::move(values);
+    return axis;
+}
+
+std::size_t SweepAxis::get_level_count() const
+{
+    return values.empty() ? count : values.size();
+}
+
+bool SweepAxis::is_valid() const
+{
+    if (!values.empty())
+        return std::all_of(values.begin(), values.end(), [](double value) { return std::isfinite(value); });
+
+    if (!std::isfinite(lower) || !std::isfinite(upper) || lower > upper)
+        return false;
+
+    return scale == SweepScale::Linear || lower > 0.0;
+}
+
+// ============================================================================
+// SWEEP SPECIFICATION
+// ============================================================================
+
+bool SweepSpecification::is_valid() const
+{
+    if (geometry.channelType == ChannelType::None)
+        return false;
+
+    for (std::size_t i = 0; i < axes.size(); ++i)
+    {
+        if (!axes[i].is_valid())
+            return false;
+
+        for (std::size_t j = 0; j < i; ++j)
+        {
+            if (axes[j].parameter == axes[i].parameter)
+                return false;
+        }
+    }
+
+    std::uint64_t product{0};
+    return design == SweepDesign::LatinHypercube ? sampleCount > 0 : multiply_level_counts(axes, product);
+}
+
+std::uint64_t SweepSpecification::get_point_count() const
+{
+    if (!is_valid())
+        return 0;
+
+    if (design == SweepDesign::LatinHypercube)
+        return sampleCount;
+
+    std::uint64_t product{0};
+    multiply_level_counts(axes, product);
+    return product;
+}
+
+void SweepSpecification::generate_point(std::uint64_t index, GeometryData& pointGeometry, HydraulicData& pointHydraulics) const
+{
+    pointGeometry = geometry;
+    pointHydraulics = hydraulics;
+
+    if (design == SweepDesign::LatinHypercube)
+    {
+        double inverseCount = 1.0 / static_cast<double>(sampleCount);
+
+        for (std::size_t a = 0; a < axes.size(); ++a)
+        {
+            const SweepAxis& axis = axes[a];
+            std::uint32_t stream = static_cast<std::uint32_t>(a);
+            std::uint64_t stratum = permute(index, sampleCount, counter_random_bits(seed, a, PERMUTATION_KEY_STREAM));
+            double fraction = (static_cast<double>(stratum) + counter_uniform(seed, index, stream)) * inverseCount;
+
+            double value = axis.values.empty()
+                               ? interpolate_range(axis, fraction)
+                               : axis.values[std::min(axis.values.size() - 1,
+                                                      static_cast<std::size_t>(fraction * static_cast<double>(axis.values.size())))];
+            set_parameter(axis.parameter, value, pointGeometry, pointHydraulics);
+        }
+
+        return;
+    }
+
+    // Mixed-radix digits, least significant on the last axis.
+    for (std::size_t a = axes.size(); a-- > 0;)
+    {
+        const SweepAxis& axis = axes[a];
+        std::uint64_t levelCount = axis.get_level_count();
+        std::size_t level = static_cast<std::size_t>(index % levelCount);
+        index /= levelCount;
+
+        double value = !axis.values.empty() ? axis.values[level]
+                                            : interpolate_range(axis, levelCount > 1 ? static_cast<double>(level) /
+                                                                                           static_cast<double>(levelCount - 1)
+                                                                                     : 0.0);
+        set_parameter(axis.parameter, value, pointGeometry, pointHydraulics);
+    }
+}
+
+// ============================================================================
+// PARAMETER SWEEP
+// ============================================================================
+
+struct ParameterSweep::RunState
+{
+    const SweepSpecification& specification;
+    const SweepSink& sink;
+    const CalculationControl* control;
+    std::uint64_t chunkSize;
+
+    std::mutex sinkMutex;
+    SweepSummary summary;   // Guarded by sinkMutex
+};
+
+ParameterSweep::ParameterSweep(WorkStealingPool& pool, bool useUsCustomary)
+    : pool_{pool}
+    , analyzer_{useUsCustomary}
+{
+}
+
+ParameterSweep::ParameterSweep(WorkStealingPool& pool, double manningsCoefficient, double gravity)
+    : pool_{pool}
+    , analyzer_{manningsCoefficient, gravity}
+{
+}
+
+SweepSummary ParameterSweep::run(const SweepSpecification& specification, const SweepSink& sink,
+                                 const CalculationControl* control, std::size_t chunkSize) const
+{
+    std::uint64_t pointCount = specification.get_point_count();
+
+    if (pointCount == 0 || chunkSize == 0 || !sink)
+        return SweepSummary{};
+
+    RunState state{specification, sink, control, chunkSize, {}, {}};
+    state.summary.pointCount = pointCount;
+
+    pool_.spawn([this, &state, pointCount] { run_range(state, 0, pointCount); });
+    pool_.wait();
+
+    state.summary.isCancelled = state.summary.completedCount < pointCount;
+    state.summary.isValid = !state.summary.isCancelled;
+    return state.summary;
+}
+
+// Splits at a chunk boundary, so every chunk but the last is full.
+void ParameterSweep::run_range(RunState& state, std::uint64_t begin, std::uint64_t end) const
+{
+    while (end - begin > state.chunkSize && !is_cancelled(state.control))
+    {
+        std::uint64_t chunkCount = (end - begin + state.chunkSize - 1) / state.chunkSize;
+        std::uint64_t middle = begin + chunkCount / 2 * state.chunkSize;
+
+        pool_.spawn([this, &state, middle, end] { run_range(state, middle, end); });
+        end = middle;
+    }
+
+    if (is_cancelled(state.control))
+        return;
+
+    thread_local SweepChunk chunk;
+    chunk.firstPoint = begin;
+    chunk.count = static_cast<std::size_t>(end - begin);
+    solve_chunk(state.specification, chunk);
+
+    std::uint64_t convergedCount = static_cast<std::uint64_t>(
+        std::count(chunk.status.begin(), chunk.status.end(), BatchStatus::Converged));
+
+    std::lock_guard<std::mutex> lock{state.sinkMutex};
+    state.sink(chunk);
+
+    SweepSummary& summary = state.summary;
+    summary.completedCount += chunk.count;
+    summary.convergedCount += convergedCount;
+    ++summary.chunkCount;
+    report_progress(state.control, static_cast<double>(summary.completedCount) / static_cast<double>(summary.pointCount));
+}
+
+// Scenarios without a bank n use the bed n for the banks, and the
+// composite kernel only runs when the sweep can produce a bank n.
+void ParameterSweep::solve_chunk(const SweepSpecification& specification, SweepChunk& chunk) const
+{
+    std::size_t count = chunk.count;
+
+    chunk.bottomWidth.resize(count);
+    chunk.sideSlope.resize(count);
+    chunk.bedSlope.resize(count);
+    chunk.discharge.resize(count);
+    chunk.manningN.resize(count);
+    chunk.bankManningN.resize(count);
+    chunk.status.resize(count);
+    chunk.normalDepth.resize(count);
+    chunk.velocity.resize(count);
+    chunk.froudeNumber.resize(count);
+    chunk.flowRegime.resize(count);
+    chunk.criticalStatus.resize(count);
+    chunk.criticalDepth.resize(count);
+    chunk.minimumSpecificEnergy.resize(count);
+    chunk.minimumSpecificForce.resize(count);
+
+    ChannelType channelType = specification.geometry.channelType;
+    bool hasBankRoughness = specification.hydraulics.bankManningN > 0.0 ||
+                            std::any_of(specification.axes.begin(), specification.axes.end(),
+                                        [](const SweepAxis& axis) { return axis.parameter == SweepParameter::BankManningN; });
+
+    GeometryData geometry;
+    HydraulicData hydraulics;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        specification.generate_point(chunk.firstPoint + i, geometry, hydraulics);
+
+        chunk.bottomWidth[i] = channelType == ChannelType::Triangular ? 0.0 : geometry.bottomWidth;
+        chunk.sideSlope[i] = channelType == ChannelType::Rectangular ? 0.0 : geometry.sideSlope;
+        chunk.bedSlope[i] = geometry.bedSlope;
+        chunk.discharge[i] = hydraulics.discharge;
+        chunk.manningN[i] = hydraulics.manningN;
+        chunk.bankManningN[i] = hydraulics.bankManningN > 0.0 ? hydraulics.bankManningN : hydraulics.manningN;
+    }
+
+    BatchInputs inputs{chunk.bottomWidth.data(), chunk.sideSlope.data(), chunk.discharge.data(), chunk.manningN.data(),
+                       chunk.bedSlope.data(), count, hasBankRoughness ? chunk.bankManningN.data() : nullptr,
+                       specification.hydraulics.roughnessMethod};
+
+    BatchOutputs outputs{chunk.normalDepth.data(), chunk.velocity.data(), chunk.froudeNumber.data(),
+                         chunk.flowRegime.data(), chunk.status.data()};
+    analyzer_.solve_for_depth(inputs, outputs);
+
+    BatchCriticalOutputs criticalOutputs{chunk.criticalDepth.data(), chunk.minimumSpecificEnergy.data(),
+                                         chunk.minimumSpecificForce.data(), chunk.criticalStatus.data()};
+    analyzer_.solve_critical_depth(inputs, criticalOutputs);
+}
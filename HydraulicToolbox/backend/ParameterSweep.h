@@ -0,0 +1,160 @@
+#ifndef PARAMETERSWEEP_H
+#define PARAMETERSWEEP_H
+
+#include "BatchAnalyzer.h"
+#include "CalculationInputs.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class CalculationControl;
+class WorkStealingPool;
+
+// GeometryData and HydraulicData fields that enter the normal- and
+// critical-depth solve.
+enum class SweepParameter : std::uint8_t
+{
+    BottomWidth,
+    SideSlope,
+    BedSlope,
+    Discharge,
+    ManningN,
+    BankManningN
+};
+
+const char* get_sweep_parameter_name(SweepParameter parameter);
+
+enum class SweepScale : std::uint8_t
+{
+    Linear,
+    Logarithmic     // Even in ln x; both bounds must be positive
+};
+
+// One swept field: an explicit list of values, or a range from lower to
+// upper. A cartesian sweep takes `count` evenly spaced levels of a range; a
+// Latin hypercube draws from the whole range, or picks from the list.
+struct SweepAxis
+{
+    SweepParameter parameter{SweepParameter::Discharge};
+    std::vector<double> values;     // Used instead of the range when not empty
+    double lower{0.0};
+    double upper{0.0};
+    std::size_t count{0};
+    SweepScale scale{SweepScale::Linear};
+
+    static SweepAxis range(SweepParameter parameter, double lower, double upper, std::size_t count,
+                           SweepScale scale = SweepScale::Linear);
+    static SweepAxis list(SweepParameter parameter, std::vector<double> values);
+
+    // Cartesian levels: the list size or `count`.
+    std::size_t get_level_count() const;
+    bool is_valid() const;
+};
+
+enum class SweepDesign : std::uint8_t
+{
+    Cartesian,
+    LatinHypercube
+};
+
+// A sweep over a base calculation. Points are generated on demand from
+// their index, so a sweep of any size costs no memory until it runs:
+// cartesian points decode the index digit by digit over the axes (the last
+// axis varies fastest); Latin hypercube points place sample i in stratum
+// pi_a(i) of each axis a, where pi_a is a keyed pseudo-random permutation
+// of [0, sampleCount) evaluated directly rather than stored, and jitter it
+// within the stratum with a counter-based draw.
+struct SweepSpecification
+{
+    GeometryData geometry;          // Fields not swept keep these values
+    HydraulicData hydraulics;
+    std::vector<SweepAxis> axes;
+    SweepDesign design{SweepDesign::Cartesian};
+    std::uint64_t sampleCount{0};   // Latin hypercube points
+    std::uint64_t seed{0x5eed};
+
+    bool is_valid() const;
+
+    // 0 when the specification is invalid or the cartesian product
+    // overflows 64 bits.
+    std::uint64_t get_point_count() const;
+
+    void generate_point(std::uint64_t index, GeometryData& geometry, HydraulicData& hydraulics) const;
+};
+
+// Inputs and results of consecutive sweep points [firstPoint, firstPoint +
+// count), as structure-of-arrays. Shape-specific inputs are stored as
+// solved: rectangular channels have sideSlope 0 and triangular channels
+// bottomWidth 0.
+struct SweepChunk
+{
+    std::uint64_t firstPoint{0};
+    std::size_t count{0};
+
+    std::vector<double> bottomWidth;
+    std::vector<double> sideSlope;
+    std::vector<double> bedSlope;
+    std::vector<double> discharge;
+    std::vector<double> manningN;
+    std::vector<double> bankManningN;   // Bed n where the banks are not lined differently
+
+    std::vector<BatchStatus> status;
+    std::vector<double> normalDepth;
+    std::vector<double> velocity;
+    std::vector<double> froudeNumber;
+    std::vector<FlowRegime> flowRegime;
+    std::vector<BatchStatus> criticalStatus;
+    std::vector<double> criticalDepth;
+    std::vector<double> minimumSpecificEnergy;
+    std::vector<double> minimumSpecificForce;
+};
+
+struct SweepSummary
+{
+    std::uint64_t pointCount{0};
+    std::uint64_t completedCount{0};    // Points handed to the sink
+    std::uint64_t convergedCount{0};
+    std::uint64_t chunkCount{0};
+    bool isCancelled{false};
+    bool isValid{false};
+};
+
+// Called once per chunk. Calls never overlap, but chunks arrive in
+// completion order, not point order. The chunk is reused after the call
+// returns.
+using SweepSink = std::function<void(const SweepChunk& chunk)>;
+
+// Runs a sweep on a work-stealing pool. The point range is split in halves
+// down to chunkSize, each split spawning its upper half, so idle workers
+// steal large ranges and only O(threads log points) tasks are ever queued.
+// Each chunk is generated, solved with BatchAnalyzer in a per-thread
+// buffer and streamed to the sink, so memory stays at one chunk per worker
+// whatever the sweep size.
+//
+// run() must be called from outside the pool. `control` is polled between
+// chunks; progress is reported after each chunk.
+class ParameterSweep
+{
+public:
+    ParameterSweep(WorkStealingPool& pool, bool useUsCustomary);
+    ParameterSweep(WorkStealingPool& pool, double manningsCoefficient, double gravity);
+
+    SweepSummary run(const SweepSpecification& specification, const SweepSink& sink,
+                     const CalculationControl* control = nullptr, std::size_t chunkSize = DEFAULT_CHUNK_SIZE) const;
+
+    // Large enough to amortize a task and a sink call, small enough that a
+    // chunk's arrays stay in L2; a multiple of BatchAnalyzer::LANE_COUNT.
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE = 2048;
+
+private:
+    struct RunState;
+
+    void run_range(RunState& state, std::uint64_t begin, std::uint64_t end) const;
+    void solve_chunk(const SweepSpecification& specification, SweepChunk& chunk) const;
+
+    WorkStealingPool& pool_;
+    BatchAnalyzer analyzer_;
+};
+
+#endif // PARAMETERSWEEP_H
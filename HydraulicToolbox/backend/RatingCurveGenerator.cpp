@@ -0,0 +1,191 @@
+#include "RatingCurveGenerator.h"
+#include "ThreadPool.h"
+#include "UnitSystemConstants.h"
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <variant>
+
+namespace
+{
+constexpr std::size_t DEFAULT_CHANNELS_PER_CHUNK{64};
+constexpr std::size_t ROWS_PER_TASK_RANGE{1024};
+
+bool is_valid_channel(const RatingCurveChannel& channel)
+{
+    bool isValidSection = std::visit([](const auto& section) { return section.is_valid(); }, channel.section);
+    return isValidSection && channel.manningN > 0.0 && channel.bedSlope > 0.0 && channel.maxDepth > 0.0;
+}
+
+// Rows [beginRow, endRow) of one channel, starting at stage index firstLevel.
+// V = (k / n) sqrt(S) R^(2/3) with R^(2/3) as cbrt(R^2), which is cheaper
+// than std::pow and keeps the loop free of calls the compiler cannot inline.
+template <typename Section>
+void fill_levels(const Section& section, double depthStep, double velocityFactor, double gravity,
+                 std::size_t firstLevel, std::size_t beginRow, std::size_t endRow, RatingCurveColumns& columns)
+{
+    for (std::size_t row = beginRow; row < endRow; ++row)
+    {
+        double depth = depthStep * static_cast<double>(firstLevel + (row - beginRow) + 1);
+        SectionProperties properties = section.evaluate(depth);
+
+        double hydraulicRadius = properties.area / properties.wettedPerimeter;
+        double velocity = velocityFactor * std::cbrt(hydraulicRadius * hydraulicRadius);
+
+        columns.depth[row] = depth;
+        columns.area[row] = properties.area;
+        columns.discharge[row] = velocity * properties.area;
+        columns.velocity[row] = velocity;
+        columns.froudeNumber[row] = velocity / std::sqrt(gravity * properties.area / properties.topWidth);
+    }
+}
+}
+
+void RatingCurveColumns::resize(std::size_t rowCount)
+{
+    depth.resize(rowCount);
+    area.resize(rowCount);
+    discharge.resize(rowCount);
+    velocity.resize(rowCount);
+    froudeNumber.resize(rowCount);
+}
+
+RatingCurveChunk RatingCurveColumns::view(std::size_t firstChannel, std::size_t channelCount, std::size_t levelCount) const
+{
+    return RatingCurveChunk{firstChannel, channelCount, levelCount,
+                            depth.data(), area.data(), discharge.data(), velocity.data(), froudeNumber.data()};
+}
+
+RatingCurveGenerator::RatingCurveGenerator(ThreadPool& threadPool, bool useUsCustomary)
+    : RatingCurveGenerator(threadPool,
+                           UnitSystemConstants::get_mannings_coefficient(useUsCustomary),
+                           UnitSystemConstants::get_gravity(useUsCustomary))
+{
+}
+
+RatingCurveGenerator::RatingCurveGenerator(ThreadPool& threadPool, double manningsCoefficient, double gravity)
+    : threadPool_{threadPool}
+    , manningsCoefficient_{manningsCoefficient}
+    , gravity_{gravity}
+    , channelsPerChunk_{DEFAULT_CHANNELS_PER_CHUNK}
+{
+}
+
+void RatingCurveGenerator::set_channels_per_chunk(std::size_t channelsPerChunk)
+{
+    channelsPerChunk_ = std::max<std::size_t>(channelsPerChunk, 1);
+}
+
+std::size_t RatingCurveGenerator::get_channels_per_chunk() const
+{
+    return channelsPerChunk_;
+}
+
+void RatingCurveGenerator::generate(const std::vector<RatingCurveChannel>& channels, std::size_t levelCount,
+                                    const ChunkConsumer& consumer) const
+{
+    if (channels.empty() || levelCount == 0)
+        return;
+
+    RatingCurveColumns buffers[2];
+    buffers[0].resize(channelsPerChunk_ * levelCount);
+    buffers[1].resize(channelsPerChunk_ * levelCount);
+
+    std::vector<std::future<void>> currentFutures;
+    std::vector<std::future<void>> pendingFutures;
+    std::size_t pendingFirstChannel{0};
+    std::size_t pendingChannelCount{0};
+    std::size_t chunkIndex{0};
+
+    try
+    {
+        for (std::size_t firstChannel = 0; firstChannel < channels.size(); firstChannel += channelsPerChunk_, ++chunkIndex)
+        {
+            std::size_t channelCount = std::min(channelsPerChunk_, channels.size() - firstChannel);
+            RatingCurveColumns& target = buffers[chunkIndex % 2];
+
+            currentFutures = threadPool_.submit_range(
+                channelCount * levelCount, ROWS_PER_TASK_RANGE,
+                [this, &channels, &target, firstChannel, levelCount](std::size_t beginRow, std::size_t endRow)
+                { fill_rows(channels, firstChannel, levelCount, beginRow, endRow, target); });
+
+            if (pendingChannelCount > 0)
+            {
+                ThreadPool::wait_all(pendingFutures);
+                consumer(buffers[(chunkIndex + 1) % 2].view(pendingFirstChannel, pendingChannelCount, levelCount));
+            }
+
+            pendingFutures = std::move(currentFutures);
+            currentFutures.clear();
+            pendingFirstChannel = firstChannel;
+            pendingChannelCount = channelCount;
+        }
+
+        ThreadPool::wait_all(pendingFutures);
+        consumer(buffers[(chunkIndex + 1) % 2].view(pendingFirstChannel, pendingChannelCount, levelCount));
+    }
+    catch (...)
+    {
+        // Workers may still be writing into the local buffers.
+        for (std::vector<std::future<void>>* futures : {&currentFutures, &pendingFutures})
+        {
+            for (std::future<void>& future : *futures)
+            {
+                if (future.valid())
+                    future.wait();
+            }
+        }
+        throw;
+    }
+}
+
+RatingCurveColumns RatingCurveGenerator::generate_all(const std::vector<RatingCurveChannel>& channels,
+                                                      std::size_t levelCount) const
+{
+    RatingCurveColumns columns;
+    columns.resize(channels.size() * levelCount);
+
+    threadPool_.parallel_for(channels.size() * levelCount, ROWS_PER_TASK_RANGE,
+                             [this, &channels, &columns, levelCount](std::size_t beginRow, std::size_t endRow)
+                             { fill_rows(channels, 0, levelCount, beginRow, endRow, columns); });
+
+    return columns;
+}
+
+// Rows are numbered relative to firstChannel; a range may span several
+// channels, so it is split at channel boundaries and each segment is
+// filled by the kernel for that channel's section type.
+void RatingCurveGenerator::fill_rows(const std::vector<RatingCurveChannel>& channels, std::size_t firstChannel,
+                                     std::size_t levelCount, std::size_t beginRow, std::size_t endRow,
+                                     RatingCurveColumns& columns) const
+{
+    std::size_t row{beginRow};
+
+    while (row < endRow)
+    {
+        std::size_t localChannel = row / levelCount;
+        std::size_t segmentEnd = std::min(endRow, (localChannel + 1) * levelCount);
+        std::size_t firstLevel = row - localChannel * levelCount;
+        const RatingCurveChannel& channel = channels[firstChannel + localChannel];
+
+        if (is_valid_channel(channel))
+        {
+            double depthStep = channel.maxDepth / static_cast<double>(levelCount);
+            double velocityFactor = manningsCoefficient_ / channel.manningN * std::sqrt(channel.bedSlope);
+
+            std::visit([&](const auto& section)
+                       { fill_levels(section, depthStep, velocityFactor, gravity_, firstLevel, row, segmentEnd, columns); },
+                       channel.section);
+        }
+        else
+        {
+            std::fill(columns.depth.begin() + row, columns.depth.begin() + segmentEnd, 0.0);
+            std::fill(columns.area.begin() + row, columns.area.begin() + segmentEnd, 0.0);
+            std::fill(columns.discharge.begin() + row, columns.discharge.begin() + segmentEnd, 0.0);
+            std::fill(columns.velocity.begin() + row, columns.velocity.begin() + segmentEnd, 0.0);
+            std::fill(columns.froudeNumber.begin() + row, columns.froudeNumber.begin() + segmentEnd, 0.0);
+        }
+
+        row = segmentEnd;
+    }
+}
@@ -0,0 +1,82 @@
+#ifndef RATINGCURVEGENERATOR_H
+#define RATINGCURVEGENERATOR_H
+
+#include "ChannelGeometry.h"
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+class ThreadPool;
+
+struct RatingCurveChannel
+{
+    ChannelSection section;
+    double manningN{0.0};
+    double bedSlope{0.0};
+    double maxDepth{0.0};   // Top stage; levels are spaced evenly up to it
+};
+
+// Read-only view of consecutive channels' rating curves in columnar form.
+// Row (channel c, level i) lives at index (c - firstChannel) * levelCount + i
+// of every column. The view is only valid inside the consumer call.
+struct RatingCurveChunk
+{
+    std::size_t firstChannel{0};
+    std::size_t channelCount{0};
+    std::size_t levelCount{0};
+
+    const double* depth{nullptr};
+    const double* area{nullptr};
+    const double* discharge{nullptr};
+    const double* velocity{nullptr};
+    const double* froudeNumber{nullptr};
+};
+
+// Owning columnar buffer with the same row layout as RatingCurveChunk.
+struct RatingCurveColumns
+{
+    std::vector<double> depth;
+    std::vector<double> area;
+    std::vector<double> discharge;
+    std::vector<double> velocity;
+    std::vector<double> froudeNumber;
+
+    void resize(std::size_t rowCount);
+    RatingCurveChunk view(std::size_t firstChannel, std::size_t channelCount, std::size_t levelCount) const;
+};
+
+// Stage-discharge tables from Manning's equation. Channels are processed in
+// chunks: the rows of a chunk are computed in parallel on the pool while
+// the previous chunk is handed to the consumer, so at most two chunks are
+// in memory and the consumer always runs on the calling thread, in channel
+// order.
+class RatingCurveGenerator
+{
+public:
+    using ChunkConsumer = std::function<void(const RatingCurveChunk& chunk)>;
+
+    RatingCurveGenerator(ThreadPool& threadPool, bool useUsCustomary);
+    RatingCurveGenerator(ThreadPool& threadPool, double manningsCoefficient, double gravity);
+
+    // levelCount stages from maxDepth / levelCount to maxDepth per channel.
+    void generate(const std::vector<RatingCurveChannel>& channels, std::size_t levelCount,
+                  const ChunkConsumer& consumer) const;
+
+    // Materializes every channel's curve; convenient for small inputs.
+    RatingCurveColumns generate_all(const std::vector<RatingCurveChannel>& channels, std::size_t levelCount) const;
+
+    void set_channels_per_chunk(std::size_t channelsPerChunk);
+    std::size_t get_channels_per_chunk() const;
+
+private:
+    void fill_rows(const std::vector<RatingCurveChannel>& channels, std::size_t firstChannel,
+                   std::size_t levelCount, std::size_t beginRow, std::size_t endRow,
+                   RatingCurveColumns& columns) const;
+
+    ThreadPool& threadPool_;
+    double manningsCoefficient_;
+    double gravity_;
+    std::size_t channelsPerChunk_;
+};
+
+#endif // RATINGCURVEGENERATOR_H
@@ -1,24 +1,24 @@
 #include "RectangularChannel.h"
 
 RectangularChannel::RectangularChannel(double width, double depth)
-    : width_{width}
+    : section_{width}
     , depth_{depth}
 {
 }
 
 double RectangularChannel::calculate_area() const
 {
-    return width_ * depth_;
+    return section_.calculate_area(depth_);
 }
 
 double RectangularChannel::calculate_wetted_perimeter() const
 {
-    return width_ + 2.0 * depth_;
+    return section_.calculate_wetted_perimeter(depth_);
 }
 
 bool RectangularChannel::is_valid() const
 {
-    return width_ > 0.0 && depth_ > 0.0;
+    return section_.is_valid() && depth_ > 0.0;
 }
 
 void RectangularChannel::set_depth(double depth)
@@ -28,5 +28,25 @@ void RectangularChannel::set_depth(double depth)
 
 double RectangularChannel::calculate_top_width() const
 {
-    return width_;
+    return section_.calculate_top_width(depth_);
+}
+
+double RectangularChannel::calculate_wetted_perimeter_derivative() const
+{
+    return section_.calculate_wetted_perimeter_derivative(depth_);
+}
+
+double RectangularChannel::calculate_first_moment_of_area() const
+{
+    return section_.calculate_first_moment(depth_);
+}
+
+std::optional<ChannelSection> RectangularChannel::get_channel_section() const
+{
+    return ChannelSection{section_};
+}
+
+const RectangularSection& RectangularChannel::get_section() const
+{
+    return section_;
 }
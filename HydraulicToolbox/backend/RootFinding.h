@@ -0,0 +1,121 @@
+#ifndef ROOTFINDING_H
+#define ROOTFINDING_H
+
+#include <algorithm>
+#include <cmath>
+
+struct RootResult
+{
+    double root{0.0};
+    int iterations{0};
+    bool converged{false};
+};
+
+// Brent's method on [low, high]. f(low) and f(high) must differ in sign.
+// Combines inverse quadratic interpolation and the secant step with
+// bisection, so it needs no derivative and never leaves the bracket.
+// Converges when the bracket is narrower than `tolerance` or f is zero.
+template <typename Function>
+RootResult find_root_brent(Function&& f, double low, double high, double tolerance, int maxIterations)
+{
+    RootResult result;
+
+    double a{low};
+    double b{high};
+    double fa = f(a);
+    double fb = f(b);
+
+    if (!std::isfinite(fa) || !std::isfinite(fb) || (fa > 0.0 && fb > 0.0) || (fa < 0.0 && fb < 0.0))
+        return result;
+
+    double c{b};
+    double fc{fb};
+    double d{b - a};
+    double e{d};
+
+    for (int i = 0; i < maxIterations; ++i)
+    {
+        result.iterations = i + 1;
+
+        if ((fb > 0.0 && fc > 0.0) || (fb < 0.0 && fc < 0.0))
+        {
+            c = a;
+            fc = fa;
+            d = b - a;
+            e = d;
+        }
+
+        if (std::abs(fc) < std::abs(fb))
+        {
+            a = b;
+            b = c;
+            c = a;
+            fa = fb;
+            fb = fc;
+            fc = fa;
+        }
+
+        double halfTolerance = 0.5 * tolerance;
+        double midpoint = 0.5 * (c - b);
+
+        if (std::abs(midpoint) <= halfTolerance || fb == 0.0)
+        {
+            result.root = b;
+            result.converged = true;
+            return result;
+        }
+
+        if (std::abs(e) >= halfTolerance && std::abs(fa) > std::abs(fb))
+        {
+            double s = fb / fa;
+            double p{0.0};
+            double q{0.0};
+
+            if (a == c)
+            {
+                p = 2.0 * midpoint * s;
+                q = 1.0 - s;
+            }
+            else
+            {
+                double r = fb / fc;
+                q = fa / fc;
+                p = s * (2.0 * midpoint * q * (q - r) - (b - a) * (r - 1.0));
+                q = (q - 1.0) * (r - 1.0) * (s - 1.0);
+            }
+
+            if (p > 0.0)
+                q = -q;
+            p = std::abs(p);
+
+            if (2.0 * p < std::min(3.0 * midpoint * q - std::abs(halfTolerance * q), std::abs(e * q)))
+            {
+                e = d;
+                d = p / q;
+            }
+            else
+            {
+                d = midpoint;
+                e = d;
+            }
+        }
+        else
+        {
+            d = midpoint;
+            e = d;
+        }
+
+        a = b;
+        fa = fb;
+        b += std::abs(d) > halfTolerance ? d : (midpoint > 0.0 ? halfTolerance : -halfTolerance);
+        fb = f(b);
+
+        if (!std::isfinite(fb))
+            return RootResult{};
+    }
+
+    result.root = b;
+    return result;
+}
+
+#endif // ROOTFINDING_H
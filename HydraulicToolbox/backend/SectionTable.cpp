@@ -0,0 +1,125 @@
+#include "SectionTable.h"
+#include "Channel.h"
+#include <algorithm>
+#include <cmath>
+
+SectionTable::SectionTable(Channel& channel, double maxDepth, std::size_t size)
+    : maxDepth_{std::min(maxDepth, channel.get_max_conveyance_depth())}
+    , spacing_{0.0}
+    , inverseSpacing_{0.0}
+    , isValid_{false}
+{
+    if (size < 2 || !(maxDepth_ > 0.0) || !std::isfinite(maxDepth_))
+        return;
+
+    channel.set_depth(maxDepth_);
+    if (!channel.is_valid())
+        return;
+
+    spacing_ = maxDepth_ / static_cast<double>(size - 1);
+    inverseSpacing_ = 1.0 / spacing_;
+    entries_.reserve(size);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        channel.set_depth(spacing_ * static_cast<double>(i));
+
+        SectionTableEntry entry;
+        entry.area = channel.calculate_area();
+        entry.topWidth = channel.calculate_top_width();
+        entry.firstMoment = channel.calculate_first_moment_of_area();
+
+        // K = A^(5/3) P^(-2/3), so dK/dy = K (5 T / A - 2 P' / P) / 3.
+        if (entry.area > 0.0)
+        {
+            double perimeter = channel.calculate_wetted_perimeter();
+            entry.conveyance = entry.area * std::pow(entry.area / perimeter, 2.0 / 3.0);
+            entry.conveyanceDerivative = entry.conveyance * (5.0 * entry.topWidth / entry.area
+                                                             - 2.0 * channel.calculate_wetted_perimeter_derivative() / perimeter) / 3.0;
+        }
+
+        entries_.push_back(entry);
+    }
+
+    // dK/dy is unbounded at the bed of a section without a flat bottom; use
+    // the slope of the first interval instead.
+    entries_.front().conveyanceDerivative = entries_[1].conveyance * inverseSpacing_;
+
+    isValid_ = true;
+    for (std::size_t i = 1; i < size && isValid_; ++i)
+    {
+        const SectionTableEntry& low = entries_[i - 1];
+        const SectionTableEntry& high = entries_[i];
+        isValid_ = std::isfinite(high.area) && std::isfinite(high.conveyance) && std::isfinite(high.firstMoment)
+                   && high.area > low.area && high.conveyance > low.conveyance;
+    }
+}
+
+bool SectionTable::is_valid() const
+{
+    return isValid_;
+}
+
+std::size_t SectionTable::size() const
+{
+    return entries_.size();
+}
+
+double SectionTable::get_max_depth() const
+{
+    return maxDepth_;
+}
+
+double SectionTable::get_max_area() const
+{
+    return entries_.empty() ? 0.0 : entries_.back().area;
+}
+
+SectionTableEntry SectionTable::lookup(double depth) const
+{
+    double position = std::min(std::max(depth, 0.0), maxDepth_) * inverseSpacing_;
+    std::size_t index = std::min(static_cast<std::size_t>(position), entries_.size() - 2);
+    double fraction = position - static_cast<double>(index);
+
+    const SectionTableEntry& low = entries_[index];
+    const SectionTableEntry& high = entries_[index + 1];
+
+    return {low.area + fraction * (high.area - low.area),
+            low.topWidth + fraction * (high.topWidth - low.topWidth),
+            low.conveyance + fraction * (high.conveyance - low.conveyance),
+            low.conveyanceDerivative + fraction * (high.conveyanceDerivative - low.conveyanceDerivative),
+            low.firstMoment + fraction * (high.firstMoment - low.firstMoment)};
+}
+
+double SectionTable::calculate_depth_for_area(double area) const
+{
+    return calculate_depth_for(area, &SectionTableEntry::area);
+}
+
+double SectionTable::calculate_depth_for_conveyance(double conveyance) const
+{
+    return calculate_depth_for(conveyance, &SectionTableEntry::conveyance);
+}
+
+std::size_t SectionTable::get_memory_footprint() const
+{
+    return sizeof(*this) + entries_.capacity() * sizeof(SectionTableEntry);
+}
+
+// Both columns increase strictly with depth, so the interval is found by
+// binary search and the depth by inverting its linear interpolant.
+double SectionTable::calculate_depth_for(double value, double SectionTableEntry::*member) const
+{
+    if (!(value > entries_.front().*member))
+        return 0.0;
+
+    if (value >= entries_.back().*member)
+        return maxDepth_;
+
+    auto high = std::upper_bound(entries_.begin(), entries_.end(), value,
+                                 [member](double target, const SectionTableEntry& entry) { return target < entry.*member; });
+    auto low = high - 1;
+
+    double fraction = (value - (*low).*member) / ((*high).*member - (*low).*member);
+    return spacing_ * (static_cast<double>(low - entries_.begin()) + fraction);
+}
@@ -0,0 +1,56 @@
+#ifndef SECTIONTABLE_H
+#define SECTIONTABLE_H
+
+#include <cstddef>
+#include <vector>
+
+class Channel;
+
+struct SectionTableEntry
+{
+    double area{0.0};
+    double topWidth{0.0};               // dA/dy
+    double conveyance{0.0};             // A R^(2/3), before Manning's n and the unit coefficient
+    double conveyanceDerivative{0.0};   // dK/dy
+    double firstMoment{0.0};            // A times the centroid depth below the surface
+};
+
+// Cross-section properties of one Channel on an even depth grid from the bed
+// to maxDepth, for unsteady solvers that need A(y), T(y) and R(y) (through
+// the geometric conveyance) at every node on every time step and cannot pay
+// for a virtual call and a set_depth per lookup. Values between grid depths
+// are interpolated linearly, so a lookup is one multiply and two loads.
+//
+// Closed conduits are tabulated only up to their depth of maximum
+// conveyance, where conveyance is still monotone and the flow still open.
+// The channel's depth is changed while the table is built and not restored.
+class SectionTable
+{
+public:
+    SectionTable(Channel& channel, double maxDepth, std::size_t size = 1025);
+
+    bool is_valid() const;
+    std::size_t size() const;
+    double get_max_depth() const;
+    double get_max_area() const;
+
+    // Depths outside [0, max depth] are clamped.
+    SectionTableEntry lookup(double depth) const;
+
+    // Inverses of the interpolated area and conveyance, clamped to the table.
+    double calculate_depth_for_area(double area) const;
+    double calculate_depth_for_conveyance(double conveyance) const;
+
+    std::size_t get_memory_footprint() const;
+
+private:
+    double calculate_depth_for(double value, double SectionTableEntry::*member) const;
+
+    std::vector<SectionTableEntry> entries_;
+    double maxDepth_;
+    double spacing_;
+    double inverseSpacing_;
+    bool isValid_;
+};
+
+#endif // SECTIONTABLE_H
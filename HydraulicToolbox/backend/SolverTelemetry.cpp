@@ -0,0 +1,161 @@
+#include "SolverTelemetry.h"
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+std::size_t get_latency_bucket(std::uint64_t nanoseconds)
+{
+    std::size_t bucket{0};
+
+    while (nanoseconds > 1 && bucket + 1 < LATENCY_BUCKET_COUNT)
+    {
+        nanoseconds >>= 1;
+        ++bucket;
+    }
+
+    return bucket;
+}
+}
+
+const char* get_metric_solver_name(MetricSolver solver)
+{
+    switch (solver)
+    {
+    case MetricSolver::NormalDepth:
+        return "Normal depth";
+    case MetricSolver::CriticalDepth:
+        return "Critical depth";
+    case MetricSolver::BatchNormalDepth:
+        return "Batch normal depth";
+    case MetricSolver::BatchCriticalDepth:
+        return "Batch critical depth";
+    default:
+        return "Unknown";
+    }
+}
+
+double SolverMetricsSnapshot::get_mean_iterations() const
+{
+    return solveCount > 0 ? static_cast<double>(iterationCount) / static_cast<double>(solveCount) : 0.0;
+}
+
+double SolverMetricsSnapshot::get_mean_latency_seconds() const
+{
+    return sampleCount > 0 ? 1e-9 * static_cast<double>(totalNanoseconds) / static_cast<double>(sampleCount) : 0.0;
+}
+
+double SolverMetricsSnapshot::get_latency_percentile_seconds(double fraction) const
+{
+    std::uint64_t bucketTotal{0};
+    for (std::uint64_t count : latencyBuckets)
+        bucketTotal += count;
+
+    if (bucketTotal == 0)
+        return 0.0;
+
+    double target = fraction * static_cast<double>(bucketTotal);
+    std::uint64_t cumulative{0};
+
+    for (std::size_t bucket = 0; bucket < LATENCY_BUCKET_COUNT; ++bucket)
+    {
+        cumulative += latencyBuckets[bucket];
+
+        if (static_cast<double>(cumulative) >= target)
+            return 1e-9 * std::ldexp(1.0, static_cast<int>(bucket) + 1);
+    }
+
+    return 1e-9 * std::ldexp(1.0, static_cast<int>(LATENCY_BUCKET_COUNT));
+}
+
+SolverMetrics& SolverMetrics::instance()
+{
+    static SolverMetrics metrics;
+    return metrics;
+}
+
+void SolverMetrics::set_enabled(bool isEnabled)
+{
+    isEnabled_.store(isEnabled, std::memory_order_relaxed);
+}
+
+void SolverMetrics::record(MetricSolver solver, std::uint64_t solves, std::uint64_t failures,
+                           std::uint64_t iterations, SolverClock::duration elapsed)
+{
+    Counters& counters = counters_[static_cast<std::size_t>(solver)];
+
+    auto nanoseconds = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+    counters.sampleCount.fetch_add(1, std::memory_order_relaxed);
+    counters.solveCount.fetch_add(solves, std::memory_order_relaxed);
+    counters.failureCount.fetch_add(failures, std::memory_order_relaxed);
+    counters.iterationCount.fetch_add(iterations, std::memory_order_relaxed);
+    counters.totalNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    counters.latencyBuckets[get_latency_bucket(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+}
+
+SolverMetricsSnapshot SolverMetrics::get_snapshot(MetricSolver solver) const
+{
+    const Counters& counters = counters_[static_cast<std::size_t>(solver)];
+    SolverMetricsSnapshot snapshot;
+
+    snapshot.sampleCount = counters.sampleCount.load(std::memory_order_relaxed);
+    snapshot.solveCount = counters.solveCount.load(std::memory_order_relaxed);
+    snapshot.failureCount = counters.failureCount.load(std::memory_order_relaxed);
+    snapshot.iterationCount = counters.iterationCount.load(std::memory_order_relaxed);
+    snapshot.totalNanoseconds = counters.totalNanoseconds.load(std::memory_order_relaxed);
+
+    for (std::size_t bucket = 0; bucket < LATENCY_BUCKET_COUNT; ++bucket)
+        snapshot.latencyBuckets[bucket] = counters.latencyBuckets[bucket].load(std::memory_order_relaxed);
+
+    return snapshot;
+}
+
+void SolverMetrics::reset()
+{
+    for (Counters& counters : counters_)
+    {
+        counters.sampleCount.store(0, std::memory_order_relaxed);
+        counters.solveCount.store(0, std::memory_order_relaxed);
+        counters.failureCount.store(0, std::memory_order_relaxed);
+        counters.iterationCount.store(0, std::memory_order_relaxed);
+        counters.totalNanoseconds.store(0, std::memory_order_relaxed);
+
+        for (std::atomic<std::uint64_t>& bucket : counters.latencyBuckets)
+            bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::string SolverMetrics::format_report() const
+{
+    std::string report;
+    char line[256];
+
+    for (std::size_t index = 0; index < static_cast<std::size_t>(MetricSolver::Count); ++index)
+    {
+        MetricSolver solver = static_cast<MetricSolver>(index);
+        SolverMetricsSnapshot snapshot = get_snapshot(solver);
+
+        if (snapshot.sampleCount == 0)
+            continue;
+
+        std::snprintf(line, sizeof(line),
+                      "%-21s calls %llu, solves %llu, failures %llu, mean iterations %.2f, "
+                      "latency mean %.3g us, p50 <= %.3g us, p99 <= %.3g us\n",
+                      get_metric_solver_name(solver),
+                      static_cast<unsigned long long>(snapshot.sampleCount),
+                      static_cast<unsigned long long>(snapshot.solveCount),
+                      static_cast<unsigned long long>(snapshot.failureCount),
+                      snapshot.get_mean_iterations(),
+                      1e6 * snapshot.get_mean_latency_seconds(),
+                      1e6 * snapshot.get_latency_percentile_seconds(0.50),
+                      1e6 * snapshot.get_latency_percentile_seconds(0.99));
+        report += line;
+    }
+
+    if (report.empty())
+        report = "No solves recorded\n";
+
+    return report;
+}
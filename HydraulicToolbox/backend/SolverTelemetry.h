@@ -0,0 +1,172 @@
+#ifndef SOLVERTELEMETRY_H
+#define SOLVERTELEMETRY_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Telemetry is compiled in unless the build defines
+// HYDRAULIC_ENABLE_TELEMETRY=0. When compiled in, the process-wide metrics
+// stay off until SolverMetrics::set_enabled(true); a disabled check costs
+// one relaxed atomic load per solve.
+#ifndef HYDRAULIC_ENABLE_TELEMETRY
+#define HYDRAULIC_ENABLE_TELEMETRY 1
+#endif
+
+using SolverClock = std::chrono::steady_clock;
+
+// One evaluated iterate and the bracket that was known when it was chosen.
+// residual is the signed relative discharge error (Q(y) - Q) / Q.
+struct BracketStep
+{
+    double lowDepth{0.0};
+    double highDepth{0.0};
+    double depth{0.0};
+    double residual{0.0};
+};
+
+// Optional record of a single solve, filled when a pointer is passed to the
+// solver. Fixed capacity, so recording never allocates; steps past
+// MAX_BRACKET_STEPS are counted but not stored.
+struct SolverTelemetry
+{
+    static constexpr std::size_t MAX_BRACKET_STEPS = 64;
+
+    int iterations{0};
+    double residual{0.0};                // Final |Q(y) - Q| / Q
+    double elapsedSeconds{0.0};
+    bool isConverged{false};
+    std::size_t bracketStepCount{0};
+    std::array<BracketStep, MAX_BRACKET_STEPS> bracketSteps{};
+
+    void record_step(double lowDepth, double highDepth, double depth, double residual)
+    {
+        if (bracketStepCount < MAX_BRACKET_STEPS)
+            bracketSteps[bracketStepCount] = BracketStep{lowDepth, highDepth, depth, residual};
+
+        ++bracketStepCount;
+    }
+
+    std::size_t get_stored_step_count() const
+    {
+        return bracketStepCount < MAX_BRACKET_STEPS ? bracketStepCount : MAX_BRACKET_STEPS;
+    }
+};
+
+enum class MetricSolver : std::uint8_t
+{
+    NormalDepth,
+    CriticalDepth,
+    BatchNormalDepth,      // One sample per call over the whole batch
+    BatchCriticalDepth,
+    Count
+};
+
+const char* get_metric_solver_name(MetricSolver solver);
+
+// Latency bucket i counts solves that took [2^i, 2^(i+1)) nanoseconds.
+constexpr std::size_t LATENCY_BUCKET_COUNT = 40;
+
+struct SolverMetricsSnapshot
+{
+    std::uint64_t sampleCount{0};        // Calls recorded
+    std::uint64_t solveCount{0};         // Scenarios solved; equals sampleCount except for batches
+    std::uint64_t failureCount{0};
+    std::uint64_t iterationCount{0};     // Fixed per scenario for the batch kernels
+    std::uint64_t totalNanoseconds{0};
+    std::array<std::uint64_t, LATENCY_BUCKET_COUNT> latencyBuckets{};
+
+    double get_mean_iterations() const;
+    double get_mean_latency_seconds() const;
+
+    // Upper bound of the bucket holding the given fraction of samples.
+    double get_latency_percentile_seconds(double fraction) const;
+};
+
+// Process-wide counters and latency histograms per solver. Recording uses
+// relaxed atomic increments only, so any number of solver threads can record
+// without locks; a snapshot taken while solves run may be slightly skewed
+// between fields.
+class SolverMetrics
+{
+public:
+    static SolverMetrics& instance();
+
+    void set_enabled(bool isEnabled);
+
+    bool is_enabled() const
+    {
+#if HYDRAULIC_ENABLE_TELEMETRY
+        return isEnabled_.load(std::memory_order_relaxed);
+#else
+        return false;
+#endif
+    }
+
+    void record(MetricSolver solver, std::uint64_t solves, std::uint64_t failures,
+                std::uint64_t iterations, SolverClock::duration elapsed);
+
+    SolverMetricsSnapshot get_snapshot(MetricSolver solver) const;
+    void reset();
+
+    // One line per solver that has samples: counts, mean iterations and
+    // mean/p50/p99 latency. Shared by the batch driver and the GUI.
+    std::string format_report() const;
+
+private:
+    SolverMetrics() = default;
+
+    // Own cache line per solver so threads recording different solvers do
+    // not contend.
+    struct alignas(64) Counters
+    {
+        std::atomic<std::uint64_t> sampleCount{0};
+        std::atomic<std::uint64_t> solveCount{0};
+        std::atomic<std::uint64_t> failureCount{0};
+        std::atomic<std::uint64_t> iterationCount{0};
+        std::atomic<std::uint64_t> totalNanoseconds{0};
+        std::array<std::atomic<std::uint64_t>, LATENCY_BUCKET_COUNT> latencyBuckets{};
+    };
+
+    std::atomic<bool> isEnabled_{false};
+    std::array<Counters, static_cast<std::size_t>(MetricSolver::Count)> counters_;
+};
+
+// Times one solve and records it into SolverMetrics and, when given, a
+// SolverTelemetry. The clock is only read when one of them wants it.
+class SolveTimer
+{
+public:
+    explicit SolveTimer(SolverTelemetry* telemetry)
+        : telemetry_{telemetry}
+        , isMetricsEnabled_{SolverMetrics::instance().is_enabled()}
+        , start_{telemetry || isMetricsEnabled_ ? SolverClock::now() : SolverClock::time_point{}}
+    {
+    }
+
+    bool is_active() const { return telemetry_ || isMetricsEnabled_; }
+
+    void finish(MetricSolver solver, std::uint64_t solves, std::uint64_t failures, std::uint64_t iterations)
+    {
+        if (!is_active())
+            return;
+
+        SolverClock::duration elapsed = SolverClock::now() - start_;
+
+        if (telemetry_)
+            telemetry_->elapsedSeconds = std::chrono::duration<double>(elapsed).count();
+
+        if (isMetricsEnabled_)
+            SolverMetrics::instance().record(solver, solves, failures, iterations, elapsed);
+    }
+
+private:
+    SolverTelemetry* telemetry_;
+    bool isMetricsEnabled_;
+    SolverClock::time_point start_;
+};
+
+#endif // SOLVERTELEMETRY_H
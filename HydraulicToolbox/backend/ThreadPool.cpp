@@ -0,0 +1,126 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+ThreadPool::ThreadPool(std::size_t threadCount)
+    : isStopping_{false}
+{
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    workers_.reserve(threadCount);
+
+    for (std::size_t i = 0; i < threadCount; ++i)
+    {
+        workers_.emplace_back([this] { run_worker(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isStopping_ = true;
+    }
+
+    condition_.notify_all();
+
+    for (std::thread& worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+std::size_t ThreadPool::get_thread_count() const
+{
+    return workers_.size();
+}
+
+std::future<void> ThreadPool::submit(std::function<void()> task)
+{
+    std::packaged_task<void()> packagedTask(std::move(task));
+    std::future<void> future = packagedTask.get_future();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push(std::move(packagedTask));
+    }
+
+    condition_.notify_one();
+    return future;
+}
+
+std::vector<std::future<void>> ThreadPool::submit_range(std::size_t count, std::size_t grainSize, RangeFunction body)
+{
+    std::vector<std::future<void>> futures;
+
+    if (count == 0)
+        return futures;
+
+    grainSize = std::max<std::size_t>(grainSize, 1);
+    std::size_t rangeCount = (count + grainSize - 1) / grainSize;
+    std::size_t taskCount = std::min(rangeCount, workers_.size());
+
+    // Tasks claim ranges from a shared counter so uneven ranges balance out.
+    auto nextRange = std::make_shared<std::atomic<std::size_t>>(0);
+    auto sharedBody = std::make_shared<RangeFunction>(std::move(body));
+
+    futures.reserve(taskCount);
+
+    for (std::size_t i = 0; i < taskCount; ++i)
+    {
+        futures.push_back(submit([=]
+        {
+            for (std::size_t range = (*nextRange)++; range < rangeCount; range = (*nextRange)++)
+            {
+                std::size_t begin = range * grainSize;
+                (*sharedBody)(begin, std::min(begin + grainSize, count));
+            }
+        }));
+    }
+
+    return futures;
+}
+
+void ThreadPool::parallel_for(std::size_t count, std::size_t grainSize, RangeFunction body)
+{
+    std::vector<std::future<void>> futures = submit_range(count, grainSize, std::move(body));
+    wait_all(futures);
+}
+
+void ThreadPool::wait_all(std::vector<std::future<void>>& futures)
+{
+    for (std::future<void>& future : futures)
+    {
+        future.wait();
+    }
+
+    for (std::future<void>& future : futures)
+    {
+        future.get();
+    }
+
+    futures.clear();
+}
+
+void ThreadPool::run_worker()
+{
+    for (;;)
+    {
+        std::packaged_task<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this] { return isStopping_ || !tasks_.empty(); });
+
+            if (tasks_.empty())
+                return;
+
+            task = std::move(tasks_.front());
+            tasks_.pop();
+        }
+
+        task();
+    }
+}
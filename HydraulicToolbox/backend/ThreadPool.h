@@ -0,0 +1,52 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Fixed-size pool of worker threads shared by the parallel backend
+// components. Tasks run in submission order on whichever worker is free.
+// The pool is not re-entrant: tasks must not wait on other pool tasks.
+class ThreadPool
+{
+public:
+    using RangeFunction = std::function<void(std::size_t begin, std::size_t end)>;
+
+    // threadCount = 0 uses one thread per hardware core.
+    explicit ThreadPool(std::size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t get_thread_count() const;
+
+    std::future<void> submit(std::function<void()> task);
+
+    // Splits [0, count) into ranges of at most grainSize and hands them to
+    // at most one task per worker. Returns without waiting; exceptions from
+    // `body` surface through the futures.
+    std::vector<std::future<void>> submit_range(std::size_t count, std::size_t grainSize, RangeFunction body);
+
+    // Blocking form of submit_range. Rethrows the first exception.
+    void parallel_for(std::size_t count, std::size_t grainSize, RangeFunction body);
+
+    static void wait_all(std::vector<std::future<void>>& futures);
+
+private:
+    void run_worker();
+
+    std::vector<std::thread> workers_;
+    std::queue<std::packaged_task<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool isStopping_;
+};
+
+#endif // THREADPOOL_H
@@ -1,26 +1,24 @@
 #include "TrapezoidalChannel.h"
-#include <cmath>
 
 TrapezoidalChannel::TrapezoidalChannel(double bottomWidth, double sideSlope, double depth)
-    : bottomWidth_{bottomWidth}
-    , sideSlope_{sideSlope}
+    : section_{bottomWidth, sideSlope}
     , depth_{depth}
 {
 }
 
 double TrapezoidalChannel::calculate_area() const
 {
-    return (bottomWidth_ + sideSlope_ * depth_) * depth_;
+    return section_.calculate_area(depth_);
 }
 
 double TrapezoidalChannel::calculate_wetted_perimeter() const
 {
-    return bottomWidth_ + 2.0 * depth_ * std::sqrt(sideSlope_ * sideSlope_ + 1.0);
+    return section_.calculate_wetted_perimeter(depth_);
 }
 
 bool TrapezoidalChannel::is_valid() const
 {
-    return bottomWidth_ > 0.0 && sideSlope_ > 0.0 && depth_ > 0.0;
+    return section_.is_valid() && depth_ > 0.0;
 }
 
 void TrapezoidalChannel::set_depth(double depth)
@@ -30,5 +28,25 @@ void TrapezoidalChannel::set_depth(double depth)
 
 double TrapezoidalChannel::calculate_top_width() const
 {
-    return bottomWidth_ + 2.0 * sideSlope_ * depth_;
+    return section_.calculate_top_width(depth_);
+}
+
+double TrapezoidalChannel::calculate_wetted_perimeter_derivative() const
+{
+    return section_.calculate_wetted_perimeter_derivative(depth_);
+}
+
+double TrapezoidalChannel::calculate_first_moment_of_area() const
+{
+    return section_.calculate_first_moment(depth_);
+}
+
+std::optional<ChannelSection> TrapezoidalChannel::get_channel_section() const
+{
+    return ChannelSection{section_};
+}
+
+const TrapezoidalSection& TrapezoidalChannel::get_section() const
+{
+    return section_;
 }
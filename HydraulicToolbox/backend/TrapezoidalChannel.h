@@ -2,6 +2,7 @@
 #define TRAPEZOIDALCHANNEL_H
 
 #include "Channel.h"
+#include "ChannelGeometry.h"
 
 class TrapezoidalChannel : public Channel
 {
@@ -13,10 +14,14 @@ public:
     bool is_valid() const override;
     void set_depth(double depth) override;
     double calculate_top_width() const override;
+    double calculate_wetted_perimeter_derivative() const override;
+    double calculate_first_moment_of_area() const override;
+    std::optional<ChannelSection> get_channel_section() const override;
+
+    const TrapezoidalSection& get_section() const;
 
 private:
-    double bottomWidth_;
-    double sideSlope_;
+    TrapezoidalSection section_;
     double depth_;
 };
 
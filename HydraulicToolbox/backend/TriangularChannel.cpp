@@ -1,25 +1,24 @@
 #include "TriangularChannel.h"
-#include <cmath>
 
 TriangularChannel::TriangularChannel(double sideSlope, double depth)
-    : sideSlope_{sideSlope}
+    : section_{sideSlope}
     , depth_{depth}
 {
 }
 
 double TriangularChannel::calculate_area() const
 {
-    return sideSlope_ * depth_ * depth_;
+    return section_.calculate_area(depth_);
 }
 
 double TriangularChannel::calculate_wetted_perimeter() const
 {
-    return 2.0 * depth_ * std::sqrt(sideSlope_ * sideSlope_ + 1.0);
+    return section_.calculate_wetted_perimeter(depth_);
 }
 
 bool TriangularChannel::is_valid() const
 {
-    return sideSlope_ > 0.0 && depth_ > 0.0;
+    return section_.is_valid() && depth_ > 0.0;
 }
 
 void TriangularChannel::set_depth(double depth)
@@ -29,5 +28,25 @@ void TriangularChannel::set_depth(double depth)
 
 double TriangularChannel::calculate_top_width() const
 {
-    return 2.0 * sideSlope_ * depth_;
+    return section_.calculate_top_width(depth_);
+}
+
+double TriangularChannel::calculate_wetted_perimeter_derivative() const
+{
+    return section_.calculate_wetted_perimeter_derivative(depth_);
+}
+
+double TriangularChannel::calculate_first_moment_of_area() const
+{
+    return section_.calculate_first_moment(depth_);
+}
+
+std::optional<ChannelSection> TriangularChannel::get_channel_section() const
+{
+    return ChannelSection{section_};
+}
+
+const TriangularSection& TriangularChannel::get_section() const
+{
+    return section_;
 }
@@ -2,6 +2,7 @@
 #define TRIANGULARCHANNEL_H
 
 #include "Channel.h"
+#include "ChannelGeometry.h"
 
 class TriangularChannel : public Channel
 {
@@ -13,9 +14,14 @@ public:
     bool is_valid() const override;
     void set_depth(double depth) override;
     double calculate_top_width() const override;
+    double calculate_wetted_perimeter_derivative() const override;
+    double calculate_first_moment_of_area() const override;
+    std::optional<ChannelSection> get_channel_section() const override;
+
+    const TriangularSection& get_section() const;
 
 private:
-    double sideSlope_;
+    TriangularSection section_;
     double depth_;
 };
 
@@ -0,0 +1,358 @@
+#include "UncertaintyAnalyzer.h"
+#include "CalculationControl.h"
+#include "CounterRandom.h"
+#include "ThreadPool.h"
+#include "UnitSystemConstants.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+constexpr double PI{3.14159265358979323846};
+constexpr double HISTOGRAM_PADDING{0.25};   // Fraction of the pilot span added on each side
+constexpr std::size_t PILOT_GRAIN_SIZE{256};
+
+// Random streams per sample: two uniforms for each input variable.
+constexpr std::uint32_t MANNING_N_STREAM{0};
+constexpr std::uint32_t DISCHARGE_STREAM{2};
+constexpr std::uint32_t BED_SLOPE_STREAM{4};
+
+struct ChunkStatistics
+{
+    std::uint64_t count{0};
+    std::uint64_t rejectedCount{0};
+    double mean{0.0};
+    double sumSquaredDeviations{0.0};
+    double minimum{std::numeric_limits<double>::infinity()};
+    double maximum{-std::numeric_limits<double>::infinity()};
+    std::vector<std::uint64_t> histogram;
+    std::uint64_t underflowCount{0};
+    std::uint64_t overflowCount{0};
+};
+
+// Chan et al. pairwise update of the running mean and squared deviations.
+void merge_statistics(ChunkStatistics& total, const ChunkStatistics& chunk)
+{
+    if (chunk.count == 0)
+    {
+        total.rejectedCount += chunk.rejectedCount;
+        return;
+    }
+
+    std::uint64_t count = total.count + chunk.count;
+    double delta = chunk.mean - total.mean;
+
+    total.mean += delta * static_cast<double>(chunk.count) / static_cast<double>(count);
+    total.sumSquaredDeviations += chunk.sumSquaredDeviations
+                                  + delta * delta * static_cast<double>(total.count) * static_cast<double>(chunk.count)
+                                        / static_cast<double>(count);
+    total.count = count;
+    total.rejectedCount += chunk.rejectedCount;
+    total.minimum = std::min(total.minimum, chunk.minimum);
+    total.maximum = std::max(total.maximum, chunk.maximum);
+    total.underflowCount += chunk.underflowCount;
+    total.overflowCount += chunk.overflowCount;
+
+    for (std::size_t bin = 0; bin < total.histogram.size(); ++bin)
+        total.histogram[bin] += chunk.histogram[bin];
+}
+}
+
+// ============================================================================
+// DISTRIBUTION
+// ============================================================================
+
+Distribution Distribution::fixed(double value)
+{
+    return Distribution{DistributionType::Fixed, value, 0.0, 0.0};
+}
+
+Distribution Distribution::uniform(double lower, double upper)
+{
+    return Distribution{DistributionType::Uniform, lower, upper, 0.0};
+}
+
+Distribution Distribution::normal(double mean, double standardDeviation)
+{
+    return Distribution{DistributionType::Normal, mean, standardDeviation, 0.0};
+}
+
+Distribution Distribution::log_normal(double median, double logStandardDeviation)
+{
+    return Distribution{DistributionType::LogNormal, median, logStandardDeviation, 0.0};
+}
+
+Distribution Distribution::triangular(double lower, double mode, double upper)
+{
+    return Distribution{DistributionType::Triangular, lower, mode, upper};
+}
+
+double Distribution::sample(double uniform1, double uniform2) const
+{
+    switch (type)
+    {
+    case DistributionType::Uniform:
+        return first + (second - first) * uniform1;
+    case DistributionType::Normal:
+        return first + second * std::sqrt(-2.0 * std::log(uniform1)) * std::cos(2.0 * PI * uniform2);
+    case DistributionType::LogNormal:
+        return first * std::exp(second * std::sqrt(-2.0 * std::log(uniform1)) * std::cos(2.0 * PI * uniform2));
+    case DistributionType::Triangular:
+    {
+        double range = third - first;
+        if (range <= 0.0)
+            return first;
+
+        double modeFraction = (second - first) / range;
+        if (uniform1 < modeFraction)
+            return first + std::sqrt(uniform1 * range * (second - first));
+        return third - std::sqrt((1.0 - uniform1) * range * (third - second));
+    }
+    case DistributionType::Fixed:
+    default:
+        return first;
+    }
+}
+
+bool Distribution::is_valid() const
+{
+    if (!std::isfinite(first) || !std::isfinite(second) || !std::isfinite(third))
+        return false;
+
+    switch (type)
+    {
+    case DistributionType::Uniform:
+        return second >= first;
+    case DistributionType::Normal:
+        return second >= 0.0;
+    case DistributionType::LogNormal:
+        return first > 0.0 && second >= 0.0;
+    case DistributionType::Triangular:
+        return first <= second && second <= third;
+    case DistributionType::Fixed:
+    default:
+        return true;
+    }
+}
+
+// ============================================================================
+// RESULT
+// ============================================================================
+
+double UncertaintyResult::get_bin_width() const
+{
+    return histogram.empty() ? 0.0 : (histogramMaximum - histogramMinimum) / static_cast<double>(histogram.size());
+}
+
+double UncertaintyResult::percentile(double fraction) const
+{
+    if (convergedCount == 0)
+        return 0.0;
+
+    double target = std::min(std::max(fraction, 0.0), 1.0) * static_cast<double>(convergedCount);
+    double cumulative{0.0};
+    double value{maximum};
+
+    auto visit_segment = [&](std::uint64_t count, double lower, double upper)
+    {
+        if (count == 0)
+            return false;
+
+        double segmentCount = static_cast<double>(count);
+        if (cumulative + segmentCount >= target)
+        {
+            value = lower + (target - cumulative) / segmentCount * (upper - lower);
+            return true;
+        }
+
+        cumulative += segmentCount;
+        return false;
+    };
+
+    if (visit_segment(underflowCount, minimum, histogramMinimum))
+        return value;
+
+    double binWidth = get_bin_width();
+    for (std::size_t bin = 0; bin < histogram.size(); ++bin)
+    {
+        double lower = histogramMinimum + binWidth * static_cast<double>(bin);
+        if (visit_segment(histogram[bin], std::max(lower, minimum), std::min(lower + binWidth, maximum)))
+            return value;
+    }
+
+    visit_segment(overflowCount, histogramMaximum, maximum);
+    return value;
+}
+
+// ============================================================================
+// ANALYZER
+// ============================================================================
+
+UncertaintyAnalyzer::UncertaintyAnalyzer(ThreadPool& threadPool, bool useUsCustomary)
+    : UncertaintyAnalyzer(threadPool,
+                          UnitSystemConstants::get_mannings_coefficient(useUsCustomary),
+                          UnitSystemConstants::get_gravity(useUsCustomary))
+{
+}
+
+UncertaintyAnalyzer::UncertaintyAnalyzer(ThreadPool& threadPool, double manningsCoefficient, double gravity)
+    : threadPool_{threadPool}
+    , manningsCoefficient_{manningsCoefficient}
+    , gravity_{gravity}
+{
+}
+
+bool UncertaintyAnalyzer::solve_sample(const UncertaintyInputs& inputs, const Analyzer& analyzer, std::uint64_t seed,
+                                       std::uint64_t sampleIndex, double& depth) const
+{
+    double manningN = inputs.manningN.sample(counter_uniform(seed, sampleIndex, MANNING_N_STREAM),
+                                             counter_uniform(seed, sampleIndex, MANNING_N_STREAM + 1));
+    double discharge = inputs.discharge.sample(counter_uniform(seed, sampleIndex, DISCHARGE_STREAM),
+                                               counter_uniform(seed, sampleIndex, DISCHARGE_STREAM + 1));
+    double bedSlope = inputs.bedSlope.sample(counter_uniform(seed, sampleIndex, BED_SLOPE_STREAM),
+                                             counter_uniform(seed, sampleIndex, BED_SLOPE_STREAM + 1));
+
+    if (!(manningN > 0.0) || !(discharge > 0.0) || !(bedSlope > 0.0))
+        return false;
+
+    AnalysisResult result = analyzer.solve_section(inputs.section, Flow{discharge, manningN}, bedSlope,
+                                                   manningsCoefficient_, gravity_);
+    depth = result.normalDepth;
+    return result.isValid;
+}
+
+UncertaintyResult UncertaintyAnalyzer::run(const UncertaintyInputs& inputs, const UncertaintySettings& settings,
+                                           const CalculationControl* control) const
+{
+    UncertaintyResult result;
+    result.sampleCount = settings.sampleCount;
+
+    if (settings.sampleCount == 0 || settings.histogramBinCount == 0 ||
+        !inputs.manningN.is_valid() || !inputs.discharge.is_valid() || !inputs.bedSlope.is_valid())
+        return result;
+
+    Analyzer analyzer{settings.solverSettings};
+
+    // The pilot reuses the first samples of the run to place the histogram.
+    std::size_t pilotCount = std::max<std::size_t>(1, std::min(settings.pilotSampleCount, settings.sampleCount));
+    std::vector<double> pilotDepths(pilotCount, std::numeric_limits<double>::quiet_NaN());
+
+    threadPool_.parallel_for(pilotCount, PILOT_GRAIN_SIZE, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            double depth{0.0};
+            if (solve_sample(inputs, analyzer, settings.seed, i, depth))
+                pilotDepths[i] = depth;
+        }
+    });
+
+    double pilotMinimum{std::numeric_limits<double>::infinity()};
+    double pilotMaximum{-std::numeric_limits<double>::infinity()};
+
+    for (double depth : pilotDepths)
+    {
+        if (std::isfinite(depth))
+        {
+            pilotMinimum = std::min(pilotMinimum, depth);
+            pilotMaximum = std::max(pilotMaximum, depth);
+        }
+    }
+
+    if (!(pilotMaximum >= pilotMinimum))
+    {
+        pilotMinimum = settings.solverSettings.minDepth;
+        pilotMaximum = settings.solverSettings.maxDepth;
+    }
+
+    double padding = HISTOGRAM_PADDING * (pilotMaximum - pilotMinimum);
+    if (padding <= 0.0)
+        padding = 1e-6 * std::max(pilotMaximum, 1e-9);
+
+    double histogramMinimum = std::max(0.0, pilotMinimum - padding);
+    double histogramMaximum = pilotMaximum + padding;
+    std::size_t binCount{settings.histogramBinCount};
+    double binScale = static_cast<double>(binCount) / (histogramMaximum - histogramMinimum);
+
+    std::size_t chunkCount = (settings.sampleCount + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    std::vector<ChunkStatistics> chunks(chunkCount);
+    std::atomic<std::size_t> completedChunkCount{0};
+
+    threadPool_.parallel_for(chunkCount, 1, [&](std::size_t beginChunk, std::size_t endChunk)
+    {
+        for (std::size_t chunkIndex = beginChunk; chunkIndex < endChunk; ++chunkIndex)
+        {
+            if (is_cancelled(control))
+                return;
+
+            ChunkStatistics& chunk = chunks[chunkIndex];
+            chunk.histogram.assign(binCount, 0);
+
+            std::size_t beginSample = chunkIndex * CHUNK_SIZE;
+            std::size_t endSample = std::min(beginSample + CHUNK_SIZE, settings.sampleCount);
+
+            for (std::size_t i = beginSample; i < endSample; ++i)
+            {
+                double depth{0.0};
+                if (!solve_sample(inputs, analyzer, settings.seed, i, depth))
+                {
+                    ++chunk.rejectedCount;
+                    continue;
+                }
+
+                ++chunk.count;
+                double delta = depth - chunk.mean;
+                chunk.mean += delta / static_cast<double>(chunk.count);
+                chunk.sumSquaredDeviations += delta * (depth - chunk.mean);
+                chunk.minimum = std::min(chunk.minimum, depth);
+                chunk.maximum = std::max(chunk.maximum, depth);
+
+                double position = (depth - histogramMinimum) * binScale;
+                if (position < 0.0)
+                    ++chunk.underflowCount;
+                else if (position >= static_cast<double>(binCount))
+                    ++chunk.overflowCount;
+                else
+                    ++chunk.histogram[static_cast<std::size_t>(position)];
+            }
+
+            std::size_t completed = ++completedChunkCount;
+            report_progress(control, static_cast<double>(completed) / static_cast<double>(chunkCount));
+        }
+    });
+
+    if (is_cancelled(control))
+    {
+        result.isCancelled = true;
+        return result;
+    }
+
+    ChunkStatistics total;
+    total.histogram.assign(binCount, 0);
+
+    for (const ChunkStatistics& chunk : chunks)
+        merge_statistics(total, chunk);
+
+    result.convergedCount = total.count;
+    result.rejectedCount = total.rejectedCount;
+    result.histogramMinimum = histogramMinimum;
+    result.histogramMaximum = histogramMaximum;
+    result.histogram = std::move(total.histogram);
+    result.underflowCount = total.underflowCount;
+    result.overflowCount = total.overflowCount;
+    result.isValid = total.count > 0;
+
+    if (result.isValid)
+    {
+        result.mean = total.mean;
+        result.standardDeviation = total.count > 1
+                                       ? std::sqrt(total.sumSquaredDeviations / static_cast<double>(total.count - 1))
+                                       : 0.0;
+        result.minimum = total.minimum;
+        result.maximum = total.maximum;
+    }
+
+    return result;
+}
@@ -0,0 +1,119 @@
+#ifndef UNCERTAINTYANALYZER_H
+#define UNCERTAINTYANALYZER_H
+
+#include "Analyzer.h"
+#include "ChannelGeometry.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class CalculationControl;
+class ThreadPool;
+
+enum class DistributionType
+{
+    Fixed,
+    Uniform,
+    Normal,
+    LogNormal,
+    Triangular
+};
+
+// Input distribution. The parameters depend on the type:
+//   Fixed       first = value
+//   Uniform     first = lower, second = upper
+//   Normal      first = mean, second = standard deviation
+//   LogNormal   first = median, second = standard deviation of ln(x)
+//   Triangular  first = lower, second = mode, third = upper
+struct Distribution
+{
+    DistributionType type{DistributionType::Fixed};
+    double first{0.0};
+    double second{0.0};
+    double third{0.0};
+
+    static Distribution fixed(double value);
+    static Distribution uniform(double lower, double upper);
+    static Distribution normal(double mean, double standardDeviation);
+    static Distribution log_normal(double median, double logStandardDeviation);
+    static Distribution triangular(double lower, double mode, double upper);
+
+    // Maps two independent uniforms on (0, 1) to a sample.
+    double sample(double uniform1, double uniform2) const;
+    bool is_valid() const;
+};
+
+struct UncertaintyInputs
+{
+    ChannelSection section;
+    Distribution manningN;
+    Distribution discharge;
+    Distribution bedSlope;
+};
+
+struct UncertaintySettings
+{
+    std::size_t sampleCount{100000};
+    std::uint64_t seed{0x5eed};
+    std::size_t histogramBinCount{256};
+    std::size_t pilotSampleCount{4096};   // Samples used to place the histogram range
+    SolverSettings solverSettings;
+};
+
+// Normal-depth distribution summary. Samples are never stored: the run keeps
+// running moments, the extremes and a fixed-range histogram whose under- and
+// overflow bins extend to the observed minimum and maximum.
+struct UncertaintyResult
+{
+    std::size_t sampleCount{0};
+    std::size_t convergedCount{0};
+    std::size_t rejectedCount{0};   // Non-positive n, Q or S drawn, or no convergence
+
+    double mean{0.0};
+    double standardDeviation{0.0};
+    double minimum{0.0};
+    double maximum{0.0};
+
+    double histogramMinimum{0.0};
+    double histogramMaximum{0.0};
+    std::vector<std::uint64_t> histogram;
+    std::uint64_t underflowCount{0};
+    std::uint64_t overflowCount{0};
+
+    bool isValid{false};
+    bool isCancelled{false};
+
+    // Depth below which `fraction` (0 to 1) of the converged samples lie,
+    // interpolated linearly inside the histogram bin.
+    double percentile(double fraction) const;
+    double get_bin_width() const;
+};
+
+// Monte Carlo propagation of n, Q and S uncertainty through the normal-depth
+// solver. Samples are processed in fixed-size chunks on the thread pool and
+// chunk results are merged in chunk order, and every sample draws from a
+// counter-based generator keyed by its index, so the result is bit-for-bit
+// identical for any thread count.
+class UncertaintyAnalyzer
+{
+public:
+    UncertaintyAnalyzer(ThreadPool& threadPool, bool useUsCustomary);
+    UncertaintyAnalyzer(ThreadPool& threadPool, double manningsCoefficient, double gravity);
+
+    // Checks `control` for cancellation before every chunk and reports the
+    // fraction of chunks completed. A cancelled run returns an invalid result.
+    UncertaintyResult run(const UncertaintyInputs& inputs, const UncertaintySettings& settings,
+                          const CalculationControl* control = nullptr) const;
+
+    static constexpr std::size_t CHUNK_SIZE = 16384;
+
+private:
+    bool solve_sample(const UncertaintyInputs& inputs, const Analyzer& analyzer, std::uint64_t seed,
+                      std::uint64_t sampleIndex, double& depth) const;
+
+    ThreadPool& threadPool_;
+    double manningsCoefficient_;
+    double gravity_;
+};
+
+#endif // UNCERTAINTYANALYZER_H
@@ -0,0 +1,161 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+
+namespace
+{
+// Lets spawn() find the calling worker's own deque.
+thread_local const WorkStealingPool* currentPool{nullptr};
+thread_local std::size_t currentWorker{0};
+}
+
+WorkStealingPool::WorkStealingPool(std::size_t threadCount)
+{
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    queues_.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i)
+        queues_.push_back(std::make_unique<WorkerQueue>());
+
+    workers_.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i)
+        workers_.emplace_back([this, i] { run_worker(i); });
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isStopping_ = true;
+    }
+
+    workCondition_.notify_all();
+
+    for (std::thread& worker : workers_)
+        worker.join();
+}
+
+std::size_t WorkStealingPool::get_thread_count() const
+{
+    return workers_.size();
+}
+
+// The queued count is raised before the sleeper count is read, and a
+// worker raises the sleeper count before it reads the queued count, so
+// either the spawner sees the sleeper and wakes it or the worker sees the
+// task and stays up. The lock is only taken when someone sleeps.
+void WorkStealingPool::spawn(Task task)
+{
+    pendingCount_.fetch_add(1);
+
+    std::size_t index = currentPool == this ? currentWorker : nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    WorkerQueue& queue = *queues_[index];
+
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    queuedCount_.fetch_add(1);
+
+    if (sleepingCount_.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        workCondition_.notify_one();
+    }
+}
+
+void WorkStealingPool::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    doneCondition_.wait(lock, [this] { return pendingCount_.load() == 0; });
+
+    if (firstException_)
+    {
+        std::exception_ptr exception = firstException_;
+        firstException_ = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+void WorkStealingPool::run_worker(std::size_t index)
+{
+    currentPool = this;
+    currentWorker = index;
+
+    for (;;)
+    {
+        Task task;
+
+        if (try_pop(index, task) || try_steal(index, task))
+        {
+            run_task(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        sleepingCount_.fetch_add(1);
+        workCondition_.wait(lock, [this] { return isStopping_ || queuedCount_.load() > 0; });
+        sleepingCount_.fetch_sub(1);
+
+        if (isStopping_ && queuedCount_.load() == 0)
+            return;
+    }
+}
+
+bool WorkStealingPool::try_pop(std::size_t index, Task& task)
+{
+    WorkerQueue& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.tasks.empty())
+        return false;
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    queuedCount_.fetch_sub(1);
+    return true;
+}
+
+bool WorkStealingPool::try_steal(std::size_t thief, Task& task)
+{
+    std::size_t queueCount = queues_.size();
+
+    for (std::size_t offset = 1; offset < queueCount; ++offset)
+    {
+        WorkerQueue& queue = *queues_[(thief + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (queue.tasks.empty())
+            continue;
+
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        queuedCount_.fetch_sub(1);
+        return true;
+    }
+
+    return false;
+}
+
+void WorkStealingPool::run_task(Task& task)
+{
+    try
+    {
+        task();
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!firstException_)
+            firstException_ = std::current_exception();
+    }
+
+    // Children were counted before their parent finishes, so zero means the
+    // whole graph is done.
+    if (pendingCount_.fetch_sub(1) == 1)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        doneCondition_.notify_all();
+    }
+}
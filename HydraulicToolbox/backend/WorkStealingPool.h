@@ -0,0 +1,71 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Worker threads with one task deque each, for task graphs whose tasks
+// spawn further tasks (network traversals, recursive splits). A task
+// spawned from inside a worker goes to the back of that worker's deque and
+// is popped from the back again, so a subtree stays on the core that has it
+// cached; an idle worker steals from the front of another deque, where the
+// oldest and usually largest piece of work sits. Tasks spawned from outside
+// the pool are dealt round-robin.
+//
+// Unlike ThreadPool, tasks may spawn tasks. They must not call wait().
+class WorkStealingPool
+{
+public:
+    using Task = std::function<void()>;
+
+    // threadCount = 0 uses one thread per hardware core.
+    explicit WorkStealingPool(std::size_t threadCount = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    std::size_t get_thread_count() const;
+
+    void spawn(Task task);
+
+    // Blocks until every spawned task, nested ones included, has finished.
+    // Rethrows the first exception a task threw since the last wait().
+    void wait();
+
+private:
+    struct alignas(64) WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void run_worker(std::size_t index);
+    bool try_pop(std::size_t index, Task& task);
+    bool try_steal(std::size_t thief, Task& task);
+    void run_task(Task& task);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::atomic<std::size_t> queuedCount_{0};     // Tasks sitting in a deque
+    std::atomic<std::size_t> pendingCount_{0};    // Spawned and not yet finished
+    std::atomic<std::size_t> sleepingCount_{0};
+    std::atomic<std::size_t> nextQueue_{0};
+
+    std::mutex mutex_;
+    std::condition_variable workCondition_;
+    std::condition_variable doneCondition_;
+    std::exception_ptr firstException_;
+    bool isStopping_{false};
+};
+
+#endif // WORKSTEALINGPOOL_H
@@ -0,0 +1,171 @@
+#include <benchmark/benchmark.h>
+#include "Analyzer.h"
+#include "ChannelGeometry.h"
+#include "Flow.h"
+#include "RectangularChannel.h"
+#include "TrapezoidalChannel.h"
+#include "TriangularChannel.h"
+#include "UnitSystemConstants.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Arguments are {shape, discharge class}. Shapes: 0 rectangular,
+// 1 trapezoidal, 2 triangular. Discharge classes span the solver's range:
+// 0 tiny (1 L/s), 1 typical (10 m³/s), 2 huge (5000 m³/s).
+namespace
+{
+constexpr double MANNING_N{0.015};
+constexpr double BED_SLOPE{0.001};
+constexpr const char* SHAPE_NAMES[] = {"rectangular", "trapezoidal", "triangular"};
+constexpr const char* DISCHARGE_NAMES[] = {"tiny", "typical", "huge"};
+constexpr double DISCHARGES[] = {0.001, 10.0, 5000.0};
+
+ChannelSection make_section(int64_t shape)
+{
+    switch (shape)
+    {
+    case 0:
+        return RectangularSection{4.0};
+    case 1:
+        return TrapezoidalSection{4.0, 2.0};
+    default:
+        return TriangularSection{2.0};
+    }
+}
+
+std::unique_ptr<Channel> make_channel(int64_t shape)
+{
+    switch (shape)
+    {
+    case 0:
+        return std::make_unique<RectangularChannel>(4.0, 0.0);
+    case 1:
+        return std::make_unique<TrapezoidalChannel>(4.0, 2.0, 0.0);
+    default:
+        return std::make_unique<TriangularChannel>(2.0, 0.0);
+    }
+}
+
+void set_case_label(benchmark::State& state)
+{
+    state.SetLabel(std::string{SHAPE_NAMES[state.range(0)]} + "/" + DISCHARGE_NAMES[state.range(1)]);
+}
+
+void report_solves(benchmark::State& state, int64_t totalIterations, bool isValid)
+{
+    state.SetItemsProcessed(state.iterations());
+    state.counters["iterations_per_solve"] = static_cast<double>(totalIterations) / static_cast<double>(state.iterations());
+
+    if (!isValid)
+        state.SkipWithError("solver did not converge");
+}
+
+void apply_cases(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgNames({"shape", "discharge"})->ArgsProduct({{0, 1, 2}, {0, 1, 2}});
+}
+}
+
+static void BM_SolveForDepthVirtual(benchmark::State& state)
+{
+    std::unique_ptr<Channel> channel = make_channel(state.range(0));
+    Flow flow{DISCHARGES[state.range(1)], MANNING_N};
+    Analyzer analyzer;
+
+    int64_t totalIterations{0};
+    bool isValid{true};
+
+    for (auto _ : state)
+    {
+        AnalysisResult result = analyzer.solve_for_depth(*channel, flow, BED_SLOPE,
+                                                         UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                         UnitSystemConstants::GRAVITY_SI);
+        totalIterations += result.iterations;
+        isValid = isValid && result.isValid;
+        benchmark::DoNotOptimize(result);
+    }
+
+    set_case_label(state);
+    report_solves(state, totalIterations, isValid);
+}
+BENCHMARK(BM_SolveForDepthVirtual)->Apply(apply_cases);
+
+static void BM_SolveForDepthSection(benchmark::State& state)
+{
+    ChannelSection section = make_section(state.range(0));
+    Flow flow{DISCHARGES[state.range(1)], MANNING_N};
+    Analyzer analyzer;
+
+    int64_t totalIterations{0};
+    bool isValid{true};
+
+    for (auto _ : state)
+    {
+        AnalysisResult result = analyzer.solve_section(section, flow, BED_SLOPE,
+                                                       UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                       UnitSystemConstants::GRAVITY_SI);
+        totalIterations += result.iterations;
+        isValid = isValid && result.isValid;
+        benchmark::DoNotOptimize(result);
+    }
+
+    set_case_label(state);
+    report_solves(state, totalIterations, isValid);
+}
+BENCHMARK(BM_SolveForDepthSection)->Apply(apply_cases);
+
+static void BM_SolveForDepthBisection(benchmark::State& state)
+{
+    ChannelSection section = make_section(state.range(0));
+    Flow flow{DISCHARGES[state.range(1)], MANNING_N};
+
+    SolverSettings settings;
+    settings.method = SolverMethod::Bisection;
+    Analyzer analyzer{settings};
+
+    int64_t totalIterations{0};
+    bool isValid{true};
+
+    for (auto _ : state)
+    {
+        AnalysisResult result = analyzer.solve_section(section, flow, BED_SLOPE,
+                                                       UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                       UnitSystemConstants::GRAVITY_SI);
+        totalIterations += result.iterations;
+        isValid = isValid && result.isValid;
+        benchmark::DoNotOptimize(result);
+    }
+
+    set_case_label(state);
+    report_solves(state, totalIterations, isValid);
+}
+BENCHMARK(BM_SolveForDepthBisection)->Apply(apply_cases);
+
+// Cost of telemetry on a typical trapezoidal solve. Argument: 0 off,
+// 1 process-wide metrics, 2 metrics plus a per-solve SolverTelemetry.
+static void BM_SolveForDepthTelemetry(benchmark::State& state)
+{
+    ChannelSection section = make_section(1);
+    Flow flow{DISCHARGES[1], MANNING_N};
+    Analyzer analyzer;
+    SolverTelemetry telemetry;
+    SolverTelemetry* telemetryPointer = state.range(0) == 2 ? &telemetry : nullptr;
+
+    SolverMetrics::instance().reset();
+    SolverMetrics::instance().set_enabled(state.range(0) > 0);
+
+    for (auto _ : state)
+    {
+        AnalysisResult result = analyzer.solve_section(section, flow, BED_SLOPE,
+                                                       UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                       UnitSystemConstants::GRAVITY_SI, telemetryPointer);
+        benchmark::DoNotOptimize(result);
+    }
+
+    SolverMetrics::instance().set_enabled(false);
+    SolverMetrics::instance().reset();
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SolveForDepthTelemetry)->ArgName("mode")->DenseRange(0, 2);
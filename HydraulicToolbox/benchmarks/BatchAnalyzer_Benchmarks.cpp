@@ -0,0 +1,110 @@
+#include <benchmark/benchmark.h>
+#include "BatchAnalyzer.h"
+#include "Analyzer.h"
+#include "RectangularChannel.h"
+#include "TrapezoidalChannel.h"
+#include "TriangularChannel.h"
+#include "Flow.h"
+#include "UnitSystemConstants.h"
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+struct ScenarioSet
+{
+    std::vector<double> bottomWidth;
+    std::vector<double> sideSlope;
+    std::vector<double> discharge;
+    std::vector<double> manningN;
+    std::vector<double> bedSlope;
+};
+
+// Mix of culvert/ditch-sized rectangular, trapezoidal and triangular sections.
+ScenarioSet make_scenarios(std::size_t count)
+{
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int> shape{0, 2};
+    std::uniform_real_distribution<double> width{0.5, 10.0};
+    std::uniform_real_distribution<double> slope{0.5, 4.0};
+    std::uniform_real_distribution<double> logDischarge{-1.0, 2.5};
+    std::uniform_real_distribution<double> roughness{0.011, 0.05};
+    std::uniform_real_distribution<double> logBedSlope{-4.0, -1.5};
+
+    ScenarioSet set;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        int kind = shape(generator);
+        set.bottomWidth.push_back(kind == 2 ? 0.0 : width(generator));
+        set.sideSlope.push_back(kind == 0 ? 0.0 : slope(generator));
+        set.discharge.push_back(std::pow(10.0, logDischarge(generator)));
+        set.manningN.push_back(roughness(generator));
+        set.bedSlope.push_back(std::pow(10.0, logBedSlope(generator)));
+    }
+
+    return set;
+}
+
+std::unique_ptr<Channel> make_channel(double bottomWidth, double sideSlope)
+{
+    if (sideSlope == 0.0)
+        return std::make_unique<RectangularChannel>(bottomWidth, 1.0);
+    if (bottomWidth == 0.0)
+        return std::make_unique<TriangularChannel>(sideSlope, 1.0);
+    return std::make_unique<TrapezoidalChannel>(bottomWidth, sideSlope, 1.0);
+}
+}
+
+// Mirrors what HydraulicCalculator::calculate does per scenario: a heap
+// Channel plus one virtual-dispatch solve.
+static void BM_ScalarAnalyzerScenarios(benchmark::State& state)
+{
+    ScenarioSet set = make_scenarios(static_cast<std::size_t>(state.range(0)));
+    Analyzer analyzer;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < set.discharge.size(); ++i)
+        {
+            std::unique_ptr<Channel> channel = make_channel(set.bottomWidth[i], set.sideSlope[i]);
+            Flow flow{set.discharge[i], set.manningN[i]};
+            AnalysisResult result = analyzer.solve_for_depth(*channel, flow, set.bedSlope[i],
+                                                             UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                             UnitSystemConstants::GRAVITY_SI);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ScalarAnalyzerScenarios)->Arg(1 << 14);
+
+static void BM_BatchAnalyzerScenarios(benchmark::State& state)
+{
+    std::size_t count = static_cast<std::size_t>(state.range(0));
+    ScenarioSet set = make_scenarios(count);
+
+    std::vector<double> normalDepth(count);
+    std::vector<double> velocity(count);
+    std::vector<double> froudeNumber(count);
+    std::vector<FlowRegime> flowRegime(count);
+    std::vector<BatchStatus> status(count);
+
+    BatchInputs inputs{set.bottomWidth.data(), set.sideSlope.data(), set.discharge.data(),
+                       set.manningN.data(), set.bedSlope.data(), count};
+    BatchOutputs outputs{normalDepth.data(), velocity.data(), froudeNumber.data(),
+                         flowRegime.data(), status.data()};
+    BatchAnalyzer analyzer{false};
+
+    for (auto _ : state)
+    {
+        analyzer.solve_for_depth(inputs, outputs);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BatchAnalyzerScenarios)->Arg(1 << 14)->Arg(1 << 20);
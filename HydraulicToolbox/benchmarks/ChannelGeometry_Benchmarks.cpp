@@ -0,0 +1,119 @@
+#include <benchmark/benchmark.h>
+#include "ChannelGeometry.h"
+#include "RectangularChannel.h"
+#include "TrapezoidalChannel.h"
+#include "TriangularChannel.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Cost of one property evaluation on its own, as paid by every solver
+// iteration: the virtual Channel interface against the value-type sections.
+namespace
+{
+constexpr std::size_t DEPTH_COUNT{1024};
+
+std::vector<double> make_depths()
+{
+    std::vector<double> depths(DEPTH_COUNT);
+
+    for (std::size_t i = 0; i < DEPTH_COUNT; ++i)
+    {
+        depths[i] = 0.01 + 0.005 * static_cast<double>(i);
+    }
+
+    return depths;
+}
+
+std::unique_ptr<Channel> make_channel(int64_t shape)
+{
+    switch (shape)
+    {
+    case 0:
+        return std::make_unique<RectangularChannel>(4.0, 0.0);
+    case 1:
+        return std::make_unique<TrapezoidalChannel>(4.0, 2.0, 0.0);
+    default:
+        return std::make_unique<TriangularChannel>(2.0, 0.0);
+    }
+}
+
+template <typename Section>
+void evaluate_section(benchmark::State& state, const Section& section)
+{
+    std::vector<double> depths = make_depths();
+
+    for (auto _ : state)
+    {
+        for (double depth : depths)
+        {
+            SectionProperties properties = section.evaluate(depth);
+            benchmark::DoNotOptimize(properties);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(depths.size()));
+}
+}
+
+static void BM_ChannelProperties(benchmark::State& state)
+{
+    std::unique_ptr<Channel> channel = make_channel(state.range(0));
+    std::vector<double> depths = make_depths();
+
+    for (auto _ : state)
+    {
+        for (double depth : depths)
+        {
+            channel->set_depth(depth);
+            double area = channel->calculate_area();
+            double perimeter = channel->calculate_wetted_perimeter();
+            double topWidth = channel->calculate_top_width();
+            double perimeterDerivative = channel->calculate_wetted_perimeter_derivative();
+            benchmark::DoNotOptimize(area);
+            benchmark::DoNotOptimize(perimeter);
+            benchmark::DoNotOptimize(topWidth);
+            benchmark::DoNotOptimize(perimeterDerivative);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(depths.size()));
+}
+BENCHMARK(BM_ChannelProperties)->ArgName("shape")->DenseRange(0, 2);
+
+static void BM_ChannelHydraulicRadius(benchmark::State& state)
+{
+    std::unique_ptr<Channel> channel = make_channel(state.range(0));
+    std::vector<double> depths = make_depths();
+
+    for (auto _ : state)
+    {
+        for (double depth : depths)
+        {
+            channel->set_depth(depth);
+            double radius = channel->calculate_hydraulic_radius();
+            benchmark::DoNotOptimize(radius);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(depths.size()));
+}
+BENCHMARK(BM_ChannelHydraulicRadius)->ArgName("shape")->DenseRange(0, 2);
+
+static void BM_RectangularSectionEvaluate(benchmark::State& state)
+{
+    evaluate_section(state, RectangularSection{4.0});
+}
+BENCHMARK(BM_RectangularSectionEvaluate);
+
+static void BM_TrapezoidalSectionEvaluate(benchmark::State& state)
+{
+    evaluate_section(state, TrapezoidalSection{4.0, 2.0});
+}
+BENCHMARK(BM_TrapezoidalSectionEvaluate);
+
+static void BM_TriangularSectionEvaluate(benchmark::State& state)
+{
+    evaluate_section(state, TriangularSection{2.0});
+}
+BENCHMARK(BM_TriangularSectionEvaluate);
@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+#include "Analyzer.h"
+#include "CircularChannel.h"
+#include "UnitSystemConstants.h"
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// Partial-flow geometry from the shared table against direct trigonometry,
+// and full normal-depth solves on a pipe.
+namespace
+{
+constexpr double DIAMETER{1.2};
+constexpr std::size_t DEPTH_COUNT{1024};
+
+std::vector<double> make_depths()
+{
+    std::vector<double> depths(DEPTH_COUNT);
+
+    for (std::size_t i = 0; i < DEPTH_COUNT; ++i)
+        depths[i] = DIAMETER * (0.05 + 0.9 * static_cast<double>(i) / static_cast<double>(DEPTH_COUNT));
+
+    return depths;
+}
+}
+
+static void BM_CircularTableEvaluate(benchmark::State& state)
+{
+    CircularChannel channel{DIAMETER, 0.0};
+    std::vector<double> depths = make_depths();
+
+    for (auto _ : state)
+    {
+        for (double depth : depths)
+        {
+            SectionProperties properties = channel.evaluate(depth);
+            benchmark::DoNotOptimize(properties);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(depths.size()));
+}
+BENCHMARK(BM_CircularTableEvaluate);
+
+static void BM_CircularTrigonometricEvaluate(benchmark::State& state)
+{
+    std::vector<double> depths = make_depths();
+
+    for (auto _ : state)
+    {
+        for (double depth : depths)
+        {
+            double halfAngle = std::acos(1.0 - 2.0 * depth / DIAMETER);
+            double sine = std::sin(halfAngle);
+            double cosine = std::cos(halfAngle);
+
+            SectionProperties properties{0.25 * DIAMETER * DIAMETER * (halfAngle - sine * cosine),
+                                         DIAMETER * halfAngle,
+                                         DIAMETER * sine,
+                                         1.0 / std::sqrt(depth / DIAMETER * (1.0 - depth / DIAMETER))};
+            benchmark::DoNotOptimize(properties);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(depths.size()));
+}
+BENCHMARK(BM_CircularTrigonometricEvaluate);
+
+static void BM_CircularSolveForDepth(benchmark::State& state)
+{
+    CircularChannel channel{DIAMETER, 0.0};
+    Flow flow{1.0, 0.013};
+    Analyzer analyzer;
+
+    for (auto _ : state)
+    {
+        AnalysisResult result = analyzer.solve_for_depth(channel, flow, 0.002,
+                                                         UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                         UnitSystemConstants::GRAVITY_SI);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CircularSolveForDepth);
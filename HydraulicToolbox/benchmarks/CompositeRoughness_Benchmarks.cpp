@@ -0,0 +1,125 @@
+#include <benchmark/benchmark.h>
+#include "Analyzer.h"
+#include "BatchAnalyzer.h"
+#include "CompositeRoughness.h"
+#include "UnitSystemConstants.h"
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Composite-roughness solves against the uniform solve of the same section.
+// The argument picks the method: 0 Horton-Einstein, 1 Lotter, 2 Pavlovskii.
+namespace
+{
+constexpr double BED_SLOPE{0.001};
+constexpr double DISCHARGE{12.0};
+
+CompositeRoughnessMethod get_method(int64_t index)
+{
+    return static_cast<CompositeRoughnessMethod>(index);
+}
+}
+
+static void BM_CompositeRoughnessEvaluate(benchmark::State& state)
+{
+    TrapezoidalSection section{4.0, 2.0};
+    CompositeRoughness roughness{get_method(state.range(0)), 0.013, 0.035, 0.035};
+    double depth{1.5};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(depth);
+        CompositeRoughnessProperties properties = roughness.evaluate(depth, section.evaluate(depth));
+        benchmark::DoNotOptimize(properties);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CompositeRoughnessEvaluate)->ArgName("method")->DenseRange(0, 2);
+
+static void BM_SolveCompositeRoughness(benchmark::State& state)
+{
+    TrapezoidalSection section{4.0, 2.0};
+    CompositeRoughness roughness{get_method(state.range(0)), 0.013, 0.035, 0.035};
+    Analyzer analyzer;
+
+    int64_t totalIterations{0};
+
+    for (auto _ : state)
+    {
+        AnalysisResult result = analyzer.solve_section(section, roughness, DISCHARGE, BED_SLOPE,
+                                                       UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                       UnitSystemConstants::GRAVITY_SI);
+        totalIterations += result.iterations;
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["iterations_per_solve"] = static_cast<double>(totalIterations) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_SolveCompositeRoughness)->ArgName("method")->DenseRange(0, 2);
+
+static void BM_SolveUniformRoughness(benchmark::State& state)
+{
+    TrapezoidalSection section{4.0, 2.0};
+    Flow flow{DISCHARGE, 0.013};
+    Analyzer analyzer;
+
+    for (auto _ : state)
+    {
+        AnalysisResult result = analyzer.solve_section(section, flow, BED_SLOPE,
+                                                       UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                       UnitSystemConstants::GRAVITY_SI);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SolveUniformRoughness);
+
+// Batch kernel over random trapezoids with a concrete bed and rougher banks.
+// Argument: method, as above; the uniform lane count is the baseline.
+static void BM_BatchCompositeRoughness(benchmark::State& state)
+{
+    const std::size_t count{16384};
+    std::mt19937 generator{42};
+    std::uniform_real_distribution<double> width{0.5, 10.0};
+    std::uniform_real_distribution<double> slope{0.5, 4.0};
+    std::uniform_real_distribution<double> logDischarge{-1.0, 2.5};
+    std::uniform_real_distribution<double> bankRoughness{0.02, 0.05};
+
+    std::vector<double> bottomWidth, sideSlope, discharge, bankManningN;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        bottomWidth.push_back(width(generator));
+        sideSlope.push_back(slope(generator));
+        discharge.push_back(std::pow(10.0, logDischarge(generator)));
+        bankManningN.push_back(bankRoughness(generator));
+    }
+
+    std::vector<double> manningN(count, 0.013);
+    std::vector<double> bedSlope(count, BED_SLOPE);
+    std::vector<double> normalDepth(count), velocity(count), froudeNumber(count);
+    std::vector<FlowRegime> flowRegime(count);
+    std::vector<BatchStatus> status(count);
+
+    BatchAnalyzer analyzer{false};
+    BatchInputs inputs{bottomWidth.data(), sideSlope.data(), discharge.data(), manningN.data(), bedSlope.data(), count};
+    BatchOutputs outputs{normalDepth.data(), velocity.data(), froudeNumber.data(), flowRegime.data(), status.data()};
+
+    if (state.range(0) >= 0)
+    {
+        inputs.bankManningN = bankManningN.data();
+        inputs.roughnessMethod = get_method(state.range(0));
+    }
+
+    for (auto _ : state)
+    {
+        analyzer.solve_for_depth(inputs, outputs);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_BatchCompositeRoughness)->ArgName("method")->DenseRange(-1, 2)->Unit(benchmark::kMicrosecond);
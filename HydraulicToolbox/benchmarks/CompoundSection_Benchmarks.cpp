@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+#include "Analyzer.h"
+#include "CompoundSection.h"
+#include "UnitSystemConstants.h"
+#include <cstdint>
+
+// Compound solves against a plain trapezoidal solve of the main channel.
+// The argument picks the discharge: 0 in bank (20 m³/s), 1 over the banks
+// (250 m³/s).
+namespace
+{
+constexpr double BED_SLOPE{0.001};
+constexpr double DISCHARGES[] = {20.0, 250.0};
+
+CompoundSection make_section()
+{
+    return CompoundSection{10.0, 2.0, 2.0, 0.03, Floodplain{50.0, 3.0, 0.06}, Floodplain{30.0, 2.0, 0.08}};
+}
+}
+
+static void BM_CompoundSectionEvaluate(benchmark::State& state)
+{
+    CompoundSection section = make_section();
+    double depth{3.0};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(depth);
+        CompoundSectionProperties properties = section.evaluate(depth);
+        benchmark::DoNotOptimize(properties);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CompoundSectionEvaluate);
+
+static void BM_SolveCompound(benchmark::State& state)
+{
+    CompoundSection section = make_section();
+    double discharge = DISCHARGES[state.range(0)];
+    Analyzer analyzer;
+
+    int64_t totalIterations{0};
+
+    for (auto _ : state)
+    {
+        AnalysisResult result = analyzer.solve_compound(section, discharge, BED_SLOPE,
+                                                        UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                        UnitSystemConstants::GRAVITY_SI);
+        totalIterations += result.iterations;
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["iterations_per_solve"] = static_cast<double>(totalIterations) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_SolveCompound)->ArgName("discharge")->DenseRange(0, 1);
+
+static void BM_SolveMainChannelOnly(benchmark::State& state)
+{
+    TrapezoidalSection section{10.0, 2.0};
+    Flow flow{DISCHARGES[state.range(0)], 0.03};
+    Analyzer analyzer;
+
+    for (auto _ : state)
+    {
+        AnalysisResult result = analyzer.solve_section(section, flow, BED_SLOPE,
+                                                       UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                       UnitSystemConstants::GRAVITY_SI);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SolveMainChannelOnly)->ArgName("discharge")->DenseRange(0, 1);
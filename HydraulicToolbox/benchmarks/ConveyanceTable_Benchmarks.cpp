@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+#include "ConveyanceTable.h"
+#include "Analyzer.h"
+#include "TrapezoidalChannel.h"
+#include "Flow.h"
+#include "UnitSystemConstants.h"
+#include <cmath>
+#include <vector>
+
+namespace
+{
+// Discharges spanning five decades for re-solving a single section.
+std::vector<double> make_discharges(std::size_t count)
+{
+    std::vector<double> discharges;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        discharges.push_back(std::pow(10.0, -1.0 + 5.0 * static_cast<double>(i) / count));
+    }
+
+    return discharges;
+}
+}
+
+static void BM_AnalyzerResolveSection(benchmark::State& state)
+{
+    TrapezoidalChannel channel{4.0, 2.0, 0.0};
+    std::vector<double> discharges = make_discharges(1024);
+    Analyzer analyzer;
+
+    for (auto _ : state)
+    {
+        for (double discharge : discharges)
+        {
+            Flow flow{discharge, 0.013};
+            AnalysisResult result = analyzer.solve_for_depth(channel, flow, 0.001,
+                                                             UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                             UnitSystemConstants::GRAVITY_SI);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(discharges.size()));
+}
+BENCHMARK(BM_AnalyzerResolveSection);
+
+static void BM_ConveyanceTableResolveSection(benchmark::State& state)
+{
+    TrapezoidalChannel channel{4.0, 2.0, 0.0};
+    ConveyanceTable table{channel};
+    std::vector<double> discharges = make_discharges(1024);
+
+    for (auto _ : state)
+    {
+        for (double discharge : discharges)
+        {
+            Flow flow{discharge, 0.013};
+            AnalysisResult result = table.solve_for_depth(flow, 0.001,
+                                                          UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                          UnitSystemConstants::GRAVITY_SI);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(discharges.size()));
+}
+BENCHMARK(BM_ConveyanceTableResolveSection);
+
+static void BM_ConveyanceTableBuild(benchmark::State& state)
+{
+    TrapezoidalChannel channel{4.0, 2.0, 0.0};
+
+    for (auto _ : state)
+    {
+        ConveyanceTable table{channel};
+        benchmark::DoNotOptimize(table);
+    }
+}
+BENCHMARK(BM_ConveyanceTableBuild);
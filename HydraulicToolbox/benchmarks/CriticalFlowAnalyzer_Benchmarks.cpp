@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+#include "BatchAnalyzer.h"
+#include "CriticalFlowAnalyzer.h"
+#include "TrapezoidalChannel.h"
+#include "UnitSystemConstants.h"
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t CURVE_POINTS{256};
+
+std::vector<TrapezoidalSection> make_sections(std::size_t count)
+{
+    std::vector<TrapezoidalSection> sections;
+    sections.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        sections.push_back({1.0 + static_cast<double>(i % 17), 0.5 + 0.25 * static_cast<double>(i % 9)});
+    }
+
+    return sections;
+}
+}
+
+static void BM_CriticalDepthVirtual(benchmark::State& state)
+{
+    std::vector<TrapezoidalSection> sections = make_sections(static_cast<std::size_t>(state.range(0)));
+    CriticalFlowAnalyzer analyzer;
+
+    for (auto _ : state)
+    {
+        for (const TrapezoidalSection& section : sections)
+        {
+            TrapezoidalChannel channel{section.bottomWidth, section.sideSlope, 0.0};
+            CriticalFlowResult result = analyzer.solve_critical_depth(channel, 25.0, UnitSystemConstants::GRAVITY_SI);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CriticalDepthVirtual)->Arg(4096);
+
+static void BM_CriticalDepthSection(benchmark::State& state)
+{
+    std::vector<TrapezoidalSection> sections = make_sections(static_cast<std::size_t>(state.range(0)));
+    CriticalFlowAnalyzer analyzer;
+
+    for (auto _ : state)
+    {
+        for (const TrapezoidalSection& section : sections)
+        {
+            CriticalFlowResult result = analyzer.solve_section(section, 25.0, UnitSystemConstants::GRAVITY_SI);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CriticalDepthSection)->Arg(4096);
+
+static void BM_CriticalDepthBatch(benchmark::State& state)
+{
+    std::size_t count = static_cast<std::size_t>(state.range(0));
+    std::vector<TrapezoidalSection> sections = make_sections(count);
+
+    std::vector<double> bottomWidth(count);
+    std::vector<double> sideSlope(count);
+    std::vector<double> discharge(count, 25.0);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        bottomWidth[i] = sections[i].bottomWidth;
+        sideSlope[i] = sections[i].sideSlope;
+    }
+
+    std::vector<double> criticalDepth(count);
+    std::vector<double> minimumSpecificEnergy(count);
+    std::vector<double> minimumSpecificForce(count);
+    std::vector<BatchStatus> status(count);
+
+    BatchAnalyzer analyzer{false};
+    BatchInputs inputs{bottomWidth.data(), sideSlope.data(), discharge.data(), nullptr, nullptr, count};
+    BatchCriticalOutputs outputs{criticalDepth.data(), minimumSpecificEnergy.data(),
+                                 minimumSpecificForce.data(), status.data()};
+
+    for (auto _ : state)
+    {
+        analyzer.solve_critical_depth(inputs, outputs);
+        benchmark::DoNotOptimize(criticalDepth.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CriticalDepthBatch)->Arg(4096);
+
+// E-y and M-y curves for many sections on a shared depth grid.
+static void BM_EnergyMomentumCurves(benchmark::State& state)
+{
+    std::vector<TrapezoidalSection> sections = make_sections(static_cast<std::size_t>(state.range(0)));
+    CriticalFlowAnalyzer analyzer;
+
+    std::vector<double> depths(CURVE_POINTS);
+    for (std::size_t i = 0; i < CURVE_POINTS; ++i)
+        depths[i] = 0.02 * static_cast<double>(i + 1);
+
+    std::vector<double> specificEnergy(CURVE_POINTS);
+    std::vector<double> specificForce(CURVE_POINTS);
+
+    for (auto _ : state)
+    {
+        for (const TrapezoidalSection& section : sections)
+        {
+            analyzer.evaluate_curves(section, 25.0, UnitSystemConstants::GRAVITY_SI, depths.data(),
+                                     specificEnergy.data(), specificForce.data(), CURVE_POINTS);
+            benchmark::DoNotOptimize(specificEnergy.data());
+            benchmark::DoNotOptimize(specificForce.data());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(CURVE_POINTS));
+}
+BENCHMARK(BM_EnergyMomentumCurves)->Arg(4096);
@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+#include "DynamicWaveSolver.h"
+#include "SectionTable.h"
+#include "TrapezoidalChannel.h"
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+constexpr double TIME_STEP{60.0};
+constexpr double PI{3.141592653589793};
+
+// A day of one-minute inflows with a six-hour flood, into a 20 km reach
+// backed up by a semidiurnal tide.
+DynamicWaveBoundary make_boundary()
+{
+    DynamicWaveBoundary boundary{TIME_STEP, {}, {}};
+
+    for (int step = 0; step <= 24 * 60; ++step)
+    {
+        double hours = step / 60.0;
+        double flood = hours < 6.0 ? 200.0 * std::sin(PI * hours / 6.0) : 0.0;
+        boundary.upstreamDischarge.push_back(50.0 + flood);
+        boundary.downstreamDepth.push_back(6.0 + 1.0 * std::sin(2.0 * PI * hours / 12.42));
+    }
+
+    return boundary;
+}
+}
+
+// Arguments: cells, scheme (0 Preissmann, 1 MacCormack). Items are cell
+// time steps, substeps included; the bytes counter is the solver's working
+// set for sizing long runs.
+static void BM_SolveDynamicWave(benchmark::State& state)
+{
+    TrapezoidalChannel channel{30.0, 2.0, 0.0};
+    SectionTable table{channel, 15.0};
+    DynamicWaveSolver solver{false};
+    DynamicWaveBoundary boundary = make_boundary();
+
+    DynamicWaveReach reach;
+    reach.length = 20000.0;
+    reach.bedSlope = 0.0001;
+    reach.manningN = 0.03;
+
+    DynamicWaveSettings settings;
+    settings.cellCount = static_cast<std::size_t>(state.range(0));
+    settings.scheme = state.range(1) == 0 ? DynamicWaveScheme::Preissmann : DynamicWaveScheme::MacCormack;
+
+    DynamicWaveResult result;
+
+    for (auto _ : state)
+    {
+        result = solver.solve(table, reach, boundary, settings);
+        benchmark::DoNotOptimize(result.outflow.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * result.cellCount * result.timeStepCount));
+    state.counters["bytes"] = static_cast<double>(result.memoryFootprint);
+    state.counters["steps"] = static_cast<double>(result.timeStepCount);
+    state.counters["iterations"] = static_cast<double>(result.iterationCount);
+}
+BENCHMARK(BM_SolveDynamicWave)
+    ->Args({100, 0})
+    ->Args({1000, 0})
+    ->Args({100, 1})
+    ->Args({1000, 1})
+    ->Unit(benchmark::kMillisecond);
+
+// Building the section table from the virtual Channel. Argument: entries.
+static void BM_BuildSectionTable(benchmark::State& state)
+{
+    TrapezoidalChannel channel{30.0, 2.0, 0.0};
+
+    for (auto _ : state)
+    {
+        SectionTable table{channel, 15.0, static_cast<std::size_t>(state.range(0))};
+        benchmark::DoNotOptimize(table.get_max_area());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BuildSectionTable)->Arg(257)->Arg(1025)->Arg(4097);
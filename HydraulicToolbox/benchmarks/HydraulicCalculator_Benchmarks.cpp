@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+#include "HydraulicCalculator.h"
+#include <cstddef>
+#include <cstdint>
+
+// HydraulicCalculator::calculate as the UI calls it: validation, normal and
+// critical depth and sensitivities. The uncached runs disable the result
+// cache so every iteration solves; the cached run measures the lookup that
+// repeated inputs hit. The opt-in Monte Carlo band is measured separately.
+namespace
+{
+GeometryData make_geometry(int64_t shape)
+{
+    GeometryData geometry;
+    geometry.channelType = shape == 0 ? ChannelType::Rectangular
+                         : shape == 1 ? ChannelType::Trapezoidal
+                                      : ChannelType::Triangular;
+    geometry.bottomWidth = 4.0;
+    geometry.sideSlope = 2.0;
+    geometry.bedSlope = 0.001;
+    return geometry;
+}
+
+HydraulicData make_hydraulics()
+{
+    HydraulicData hydraulics;
+    hydraulics.discharge = 10.0;
+    hydraulics.manningN = 0.015;
+    return hydraulics;
+}
+
+void run_calculation(benchmark::State& state, std::size_t cacheCapacity)
+{
+    HydraulicCalculator calculator;
+    calculator.set_cache_capacity(cacheCapacity);
+
+    GeometryData geometry = make_geometry(state.range(0));
+    HydraulicData hydraulics = make_hydraulics();
+
+    for (auto _ : state)
+    {
+        CalculationResults results = calculator.calculate(false, geometry, hydraulics);
+        benchmark::DoNotOptimize(results);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+}
+
+static void BM_CalculateUncached(benchmark::State& state)
+{
+    run_calculation(state, 0);
+}
+BENCHMARK(BM_CalculateUncached)->ArgName("shape")->DenseRange(0, 2);
+
+// Triangular n over a material range at the default sample count.
+static void BM_CalculateUncertainty(benchmark::State& state)
+{
+    HydraulicCalculator calculator;
+    GeometryData geometry = make_geometry(state.range(0));
+
+    for (auto _ : state)
+    {
+        UncertaintyResult result = calculator.calculate_uncertainty(false, geometry,
+                                                                    Distribution::triangular(0.012, 0.015, 0.018),
+                                                                    Distribution::fixed(10.0),
+                                                                    Distribution::fixed(0.001));
+        benchmark::DoNotOptimize(result.mean);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CalculateUncertainty)->ArgName("shape")->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_CalculateCached(benchmark::State& state)
+{
+    run_calculation(state, HydraulicCalculator::DEFAULT_CACHE_CAPACITY);
+}
+BENCHMARK(BM_CalculateCached)->ArgName("shape")->Arg(1);
@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+#include "HydrographRouter.h"
+#include "ThreadPool.h"
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+constexpr double TIME_STEP{60.0};
+
+RoutingReach make_reach(double length)
+{
+    RoutingReach reach;
+    reach.section = TrapezoidalSection{20.0, 2.0};
+    reach.length = length;
+    reach.bedSlope = 0.0005;
+    reach.manningN = 0.035;
+    reach.lateralInflow = 1e-4;
+    return reach;
+}
+
+// One-minute flows over `days` days: a seasonal base flow with a storm
+// every five days.
+Hydrograph make_inflow(std::size_t days)
+{
+    Hydrograph hydrograph{TIME_STEP, {}};
+    std::size_t stepCount = days * 24 * 60;
+    hydrograph.discharge.reserve(stepCount);
+
+    for (std::size_t step = 0; step < stepCount; ++step)
+    {
+        double hours = static_cast<double>(step) / 60.0;
+        double season = 10.0 + 5.0 * std::sin(2.0 * 3.141592653589793 * hours / (365.0 * 24.0));
+        double stormHours = std::fmod(hours, 120.0);
+        double storm = stormHours < 6.0 ? 150.0 * std::sin(3.141592653589793 * stormHours / 6.0) : 0.0;
+        hydrograph.discharge.push_back(season + storm);
+    }
+
+    return hydrograph;
+}
+}
+
+// Arguments: simulated days, method (0 kinematic wave, 1 Muskingum-Cunge).
+// A 50 km reach on the automatic grid; node updates are reported as items.
+static void BM_RouteHydrograph(benchmark::State& state)
+{
+    ThreadPool pool{1};
+    HydrographRouter router{pool, false};
+    RoutingReach reach = make_reach(50000.0);
+    Hydrograph inflow = make_inflow(static_cast<std::size_t>(state.range(0)));
+
+    RoutingSettings settings;
+    settings.method = state.range(1) == 0 ? RoutingMethod::KinematicWave : RoutingMethod::MuskingumCunge;
+
+    std::size_t segmentCount{0};
+
+    for (auto _ : state)
+    {
+        RoutingResult result = router.route(reach, inflow, settings);
+        segmentCount = result.segmentCount;
+        benchmark::DoNotOptimize(result.peakOutflow);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(inflow.discharge.size() * segmentCount));
+    state.counters["segments"] = static_cast<double>(segmentCount);
+}
+BENCHMARK(BM_RouteHydrograph)
+    ->Args({30, 0})
+    ->Args({30, 1})
+    ->Args({365, 0})
+    ->Args({365, 1})
+    ->Unit(benchmark::kMillisecond);
+
+// Independent 20 km reaches, each with a 30-day record, across the pool.
+// Arguments: reach count, worker threads.
+static void BM_RouteAllHydrographs(benchmark::State& state)
+{
+    std::size_t reachCount = static_cast<std::size_t>(state.range(0));
+    ThreadPool pool{static_cast<std::size_t>(state.range(1))};
+    HydrographRouter router{pool, false};
+
+    std::vector<RoutingReach> reaches(reachCount, make_reach(20000.0));
+    std::vector<Hydrograph> inflows(reachCount, make_inflow(30));
+
+    for (auto _ : state)
+    {
+        std::vector<RoutingResult> results = router.route_all(reaches, inflows, RoutingSettings{});
+        benchmark::DoNotOptimize(results.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RouteAllHydrographs)
+    ->Args({16, 1})
+    ->Args({16, 2})
+    ->Args({16, 4})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+#include "Analyzer.h"
+#include "IrregularChannel.h"
+#include "UnitSystemConstants.h"
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// Surveyed natural sections: a parabolic valley with a rippled bed that
+// leaves several islands at low stages. Argument: point count.
+namespace
+{
+constexpr std::size_t DEPTH_COUNT{64};
+
+IrregularChannel make_survey(int64_t pointCount)
+{
+    std::vector<double> stations(static_cast<std::size_t>(pointCount));
+    std::vector<double> elevations(static_cast<std::size_t>(pointCount));
+    double spacing = 100.0 / static_cast<double>(pointCount - 1);
+
+    for (std::size_t i = 0; i < stations.size(); ++i)
+    {
+        double station = spacing * static_cast<double>(i);
+        stations[i] = station;
+        elevations[i] = 0.002 * (station - 50.0) * (station - 50.0) + 0.3 * std::sin(0.7 * station);
+    }
+
+    return IrregularChannel{stations, elevations, 1.0};
+}
+}
+
+static void BM_IrregularChannelEvaluate(benchmark::State& state)
+{
+    IrregularChannel channel = make_survey(state.range(0));
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < DEPTH_COUNT; ++i)
+        {
+            SectionProperties properties = channel.evaluate(0.1 + 0.1 * static_cast<double>(i));
+            benchmark::DoNotOptimize(properties);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(DEPTH_COUNT));
+    state.counters["segments"] = static_cast<double>(channel.get_segment_count());
+}
+BENCHMARK(BM_IrregularChannelEvaluate)->ArgName("points")->Arg(100)->Arg(1000)->Arg(10000);
+
+static void BM_IrregularChannelSolveForDepth(benchmark::State& state)
+{
+    IrregularChannel channel = make_survey(state.range(0));
+    Flow flow{20.0, 0.035};
+    Analyzer analyzer;
+
+    for (auto _ : state)
+    {
+        AnalysisResult result = analyzer.solve_for_depth(channel, flow, 0.001,
+                                                         UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                         UnitSystemConstants::GRAVITY_SI);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IrregularChannelSolveForDepth)->ArgName("points")->Arg(1000);
@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+#include "ChannelNetwork.h"
+#include "NetworkAnalyzer.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace
+{
+// Synthetic storm network: reach i > 0 drains into a random reach with a
+// lower index, so the tree is a few dozen levels deep with uneven
+// subtrees. Sections are sized to the discharge they collect and about a
+// fifth of the reaches are steep.
+ChannelNetwork make_network(std::size_t reachCount)
+{
+    std::mt19937 generator{42};
+    std::uniform_real_distribution<double> inflow{0.05, 0.5};
+    std::uniform_real_distribution<double> logSlope{-3.5, -1.5};
+
+    std::vector<NetworkReach> reaches(reachCount);
+    std::vector<double> discharge(reachCount);
+
+    for (std::size_t i = 0; i < reachCount; ++i)
+    {
+        reaches[i].downstream = i == 0 ? NO_REACH : std::uniform_int_distribution<std::size_t>{0, i - 1}(generator);
+        reaches[i].lateralInflow = inflow(generator);
+        reaches[i].bedSlope = std::pow(10.0, logSlope(generator));
+        reaches[i].length = 150.0;
+        reaches[i].manningN = 0.015;
+        reaches[i].junctionDrop = 0.05;
+        discharge[i] = reaches[i].lateralInflow;
+    }
+
+    for (std::size_t i = reachCount - 1; i > 0; --i)
+        discharge[reaches[i].downstream] += discharge[i];
+
+    for (std::size_t i = 0; i < reachCount; ++i)
+        reaches[i].section = TrapezoidalSection{std::max(0.5, std::pow(discharge[i], 0.4)), 2.0};
+
+    return ChannelNetwork{std::move(reaches)};
+}
+}
+
+// Both passes of a network solve: accumulation with normal and critical
+// depth, then the backwater profiles. Arguments: reach count, worker
+// threads. Wall-clock time, since the work runs on the pool.
+static void BM_SolveNetwork(benchmark::State& state)
+{
+    ChannelNetwork network = make_network(static_cast<std::size_t>(state.range(0)));
+    WorkStealingPool pool{static_cast<std::size_t>(state.range(1))};
+    NetworkAnalyzer analyzer{pool, false};
+
+    for (auto _ : state)
+    {
+        NetworkResult result = analyzer.solve(network, 2.0);
+        benchmark::DoNotOptimize(result.failedReachCount);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SolveNetwork)
+    ->Args({10000, 1})
+    ->Args({10000, 2})
+    ->Args({10000, 4})
+    ->Args({10000, 8})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Spawn and steal overhead of the pool alone: a binary task tree with a
+// trivial body per task. Argument: worker threads.
+static void BM_WorkStealingTaskTree(benchmark::State& state)
+{
+    WorkStealingPool pool{static_cast<std::size_t>(state.range(0))};
+    constexpr int LEVELS{14};
+
+    struct TreeTask
+    {
+        WorkStealingPool& pool;
+
+        void operator()(int levels) const
+        {
+            if (levels == 0)
+                return;
+
+            pool.spawn([this, levels] { (*this)(levels - 1); });
+            pool.spawn([this, levels] { (*this)(levels - 1); });
+        }
+    };
+
+    TreeTask tree{pool};
+
+    for (auto _ : state)
+    {
+        pool.spawn([&tree] { tree(LEVELS); });
+        pool.wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * ((int64_t{1} << (LEVELS + 1)) - 1));
+}
+BENCHMARK(BM_WorkStealingTaskTree)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+#include "Analyzer.h"
+#include "ChannelGeometry.h"
+#include "Flow.h"
+#include "UnitSystemConstants.h"
+#include <cmath>
+#include <vector>
+
+namespace
+{
+struct CatalogueEntry
+{
+    ChannelSection section;
+    double discharge;
+};
+
+// Design catalogue of every shape over a range of widths, slopes and flows.
+std::vector<CatalogueEntry> make_catalogue()
+{
+    std::vector<CatalogueEntry> catalogue;
+
+    for (double width : {0.5, 1.0, 2.0, 4.0, 8.0})
+    {
+        for (double sideSlope : {0.5, 1.0, 2.0, 3.0})
+        {
+            for (double discharge : {0.05, 1.0, 20.0, 500.0})
+            {
+                catalogue.push_back({RectangularSection{width}, discharge});
+                catalogue.push_back({TrapezoidalSection{width, sideSlope}, discharge});
+                catalogue.push_back({TriangularSection{sideSlope}, discharge});
+            }
+        }
+    }
+
+    return catalogue;
+}
+
+void solve_catalogue(benchmark::State& state, bool useDepthEstimates)
+{
+    std::vector<CatalogueEntry> catalogue = make_catalogue();
+
+    SolverSettings settings;
+    settings.useDepthEstimates = useDepthEstimates;
+    Analyzer analyzer{settings};
+
+    int64_t iterations{0};
+
+    for (auto _ : state)
+    {
+        for (const CatalogueEntry& entry : catalogue)
+        {
+            Flow flow{entry.discharge, 0.015};
+            AnalysisResult result = analyzer.solve_section(entry.section, flow, 0.002,
+                                                           UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                           UnitSystemConstants::GRAVITY_SI);
+            iterations += result.iterations;
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+    int64_t solves = state.iterations() * static_cast<int64_t>(catalogue.size());
+    state.SetItemsProcessed(solves);
+    state.counters["iterations_per_solve"] = static_cast<double>(iterations) / static_cast<double>(solves);
+}
+}
+
+static void BM_CatalogueSolveUnseeded(benchmark::State& state)
+{
+    solve_catalogue(state, false);
+}
+BENCHMARK(BM_CatalogueSolveUnseeded);
+
+static void BM_CatalogueSolveSeeded(benchmark::State& state)
+{
+    solve_catalogue(state, true);
+}
+BENCHMARK(BM_CatalogueSolveSeeded);
@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+#include "ParameterSweep.h"
+#include "WorkStealingPool.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+SweepSpecification make_base_specification()
+{
+    SweepSpecification specification;
+    specification.geometry.channelType = ChannelType::Trapezoidal;
+    specification.geometry.bottomWidth = 3.0;
+    specification.geometry.sideSlope = 1.5;
+    specification.geometry.bedSlope = 0.001;
+    specification.hydraulics.discharge = 10.0;
+    specification.hydraulics.manningN = 0.025;
+    return specification;
+}
+
+// 64 x 16 x 16 x 16 = 2^18 points.
+SweepSpecification make_cartesian_specification()
+{
+    SweepSpecification specification = make_base_specification();
+    specification.axes = {SweepAxis::range(SweepParameter::BottomWidth, 1.0, 10.0, 64),
+                          SweepAxis::range(SweepParameter::SideSlope, 0.0, 4.0, 16),
+                          SweepAxis::range(SweepParameter::BedSlope, 1e-4, 1e-2, 16, SweepScale::Logarithmic),
+                          SweepAxis::range(SweepParameter::Discharge, 1.0, 100.0, 16, SweepScale::Logarithmic)};
+    return specification;
+}
+
+SweepSpecification make_latin_hypercube_specification()
+{
+    SweepSpecification specification = make_cartesian_specification();
+    specification.design = SweepDesign::LatinHypercube;
+    specification.sampleCount = std::uint64_t{1} << 18;
+    specification.axes.push_back(SweepAxis::range(SweepParameter::ManningN, 0.012, 0.05, 0));
+    return specification;
+}
+
+void run_sweep(benchmark::State& state, const SweepSpecification& specification)
+{
+    WorkStealingPool pool{static_cast<std::size_t>(state.range(0))};
+    ParameterSweep sweep{pool, false};
+    std::uint64_t pointCount{0};
+
+    for (auto _ : state)
+    {
+        std::uint64_t received{0};
+        SweepSummary summary = sweep.run(specification, [&received](const SweepChunk& chunk) { received += chunk.count; });
+        benchmark::DoNotOptimize(received);
+        pointCount = summary.pointCount;
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * pointCount));
+}
+}
+
+// Normal and critical depth over every point, streamed to a counting sink.
+// Argument: pool threads.
+static void BM_CartesianSweep(benchmark::State& state)
+{
+    run_sweep(state, make_cartesian_specification());
+}
+BENCHMARK(BM_CartesianSweep)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_LatinHypercubeSweep(benchmark::State& state)
+{
+    run_sweep(state, make_latin_hypercube_specification());
+}
+BENCHMARK(BM_LatinHypercubeSweep)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,50 @@
+#include <benchmark/benchmark.h>
+#include "RatingCurveGenerator.h"
+#include "ThreadPool.h"
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+std::vector<RatingCurveChannel> make_channels(std::size_t count)
+{
+    std::vector<RatingCurveChannel> channels;
+    channels.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        double width = 1.0 + static_cast<double>(i % 25);
+        channels.push_back({TrapezoidalSection{width, 0.5 + 0.5 * static_cast<double>(i % 5)}, 0.015, 0.001, 6.0});
+    }
+
+    return channels;
+}
+}
+
+// Arguments: channel count, stage levels per channel, worker threads.
+static void BM_RatingCurveStreaming(benchmark::State& state)
+{
+    std::vector<RatingCurveChannel> channels = make_channels(static_cast<std::size_t>(state.range(0)));
+    std::size_t levelCount = static_cast<std::size_t>(state.range(1));
+
+    ThreadPool pool{static_cast<std::size_t>(state.range(2))};
+    RatingCurveGenerator generator{pool, false};
+
+    for (auto _ : state)
+    {
+        double checksum{0.0};
+        generator.generate(channels, levelCount, [&checksum](const RatingCurveChunk& chunk)
+        {
+            checksum += chunk.discharge[chunk.channelCount * chunk.levelCount - 1];
+        });
+        benchmark::DoNotOptimize(checksum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+BENCHMARK(BM_RatingCurveStreaming)
+    ->Args({500, 5000, 1})
+    ->Args({500, 5000, 2})
+    ->Args({500, 5000, 4})
+    ->Args({500, 5000, 8})
+    ->UseRealTime();
@@ -0,0 +1,32 @@
+#include <benchmark/benchmark.h>
+#include "UncertaintyAnalyzer.h"
+#include "ThreadPool.h"
+#include <cstddef>
+
+// Arguments: sample count, worker threads.
+static void BM_UncertaintyNormalDepth(benchmark::State& state)
+{
+    ThreadPool pool{static_cast<std::size_t>(state.range(1))};
+    UncertaintyAnalyzer uncertaintyAnalyzer{pool, false};
+
+    UncertaintyInputs inputs{TrapezoidalSection{4.0, 2.0},
+                             Distribution::triangular(0.011, 0.013, 0.018),
+                             Distribution::normal(10.0, 1.0),
+                             Distribution::log_normal(0.001, 0.1)};
+
+    UncertaintySettings settings;
+    settings.sampleCount = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        UncertaintyResult result = uncertaintyAnalyzer.run(inputs, settings);
+        benchmark::DoNotOptimize(result.mean);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_UncertaintyNormalDepth)
+    ->Args({1000000, 1})
+    ->Args({1000000, 4})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,95 @@
+#include "BatchRunner.h"
+#include "ThreadPool.h"
+#include <limits>
+
+BatchRunner::BatchRunner(ThreadPool& pool, const BatchAnalyzer& analyzer, bool computeSensitivities,
+                         CompositeRoughnessMethod roughnessMethod)
+    : pool_{pool}
+    , analyzer_{analyzer}
+    , computeSensitivities_{computeSensitivities}
+    , roughnessMethod_{roughnessMethod}
+{
+}
+
+void BatchRunner::run(const std::vector<Scenario>& scenarios, BatchResults& results)
+{
+    std::size_t count = scenarios.size();
+    resize(count, results);
+
+    // Unparsed records become NaN inputs, which the batch kernel reports as
+    // InvalidInput without a separate pass. Scenarios without a bank n use
+    // the bed n for the banks, which the composite kernel reduces to the
+    // uniform result, so the composite kernel only runs when some scenario
+    // needs it.
+    bool hasBankRoughness{false};
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Scenario& scenario = scenarios[i];
+        double nan = std::numeric_limits<double>::quiet_NaN();
+
+        bottomWidth_[i] = scenario.isValid ? scenario.bottomWidth : nan;
+        sideSlope_[i] = scenario.isValid ? scenario.sideSlope : nan;
+        discharge_[i] = scenario.isValid ? scenario.discharge : nan;
+        manningN_[i] = scenario.isValid ? scenario.manningN : nan;
+        bankManningN_[i] = scenario.bankManningN > 0.0 ? scenario.bankManningN : manningN_[i];
+        bedSlope_[i] = scenario.isValid ? scenario.bedSlope : nan;
+        hasBankRoughness = hasBankRoughness || (scenario.isValid && scenario.bankManningN > 0.0);
+    }
+
+    pool_.parallel_for(count, GRAIN_SIZE, [this, &results, hasBankRoughness](std::size_t begin, std::size_t end)
+    {
+        BatchInputs inputs{bottomWidth_.data() + begin, sideSlope_.data() + begin, discharge_.data() + begin,
+                           manningN_.data() + begin, bedSlope_.data() + begin, end - begin,
+                           hasBankRoughness ? bankManningN_.data() + begin : nullptr, roughnessMethod_};
+
+        BatchOutputs outputs{results.normalDepth.data() + begin, results.velocity.data() + begin,
+                             results.froudeNumber.data() + begin, results.flowRegime.data() + begin,
+                             results.status.data() + begin};
+        analyzer_.solve_for_depth(inputs, outputs);
+
+        BatchCriticalOutputs criticalOutputs{results.criticalDepth.data() + begin,
+                                             results.minimumSpecificEnergy.data() + begin,
+                                             minimumSpecificForce_.data() + begin,
+                                             criticalStatus_.data() + begin};
+        analyzer_.solve_critical_depth(inputs, criticalOutputs);
+
+        if (computeSensitivities_)
+        {
+            BatchSensitivityOutputs sensitivityOutputs{results.sensitivityManningN.data() + begin,
+                                                       results.sensitivityDischarge.data() + begin,
+                                                       results.sensitivityBedSlope.data() + begin,
+                                                       results.sensitivityBottomWidth.data() + begin,
+                                                       results.sensitivitySideSlope.data() + begin};
+            analyzer_.calculate_sensitivities(inputs, results.normalDepth.data() + begin,
+                                              results.status.data() + begin, sensitivityOutputs);
+        }
+    });
+}
+
+void BatchRunner::resize(std::size_t count, BatchResults& results)
+{
+    bottomWidth_.resize(count);
+    sideSlope_.resize(count);
+    discharge_.resize(count);
+    manningN_.resize(count);
+    bankManningN_.resize(count);
+    bedSlope_.resize(count);
+    criticalStatus_.resize(count);
+    minimumSpecificForce_.resize(count);
+
+    results.status.resize(count);
+    results.normalDepth.resize(count);
+    results.velocity.resize(count);
+    results.froudeNumber.resize(count);
+    results.flowRegime.resize(count);
+    results.criticalDepth.resize(count);
+    results.minimumSpecificEnergy.resize(count);
+
+    std::size_t sensitivityCount = computeSensitivities_ ? count : 0;
+    results.sensitivityManningN.resize(sensitivityCount);
+    results.sensitivityDischarge.resize(sensitivityCount);
+    results.sensitivityBedSlope.resize(sensitivityCount);
+    results.sensitivityBottomWidth.resize(sensitivityCount);
+    results.sensitivitySideSlope.resize(sensitivityCount);
+}
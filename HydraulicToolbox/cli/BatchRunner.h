@@ -0,0 +1,66 @@
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include "BatchAnalyzer.h"
+#include "ScenarioReader.h"
+#include <cstddef>
+#include <vector>
+
+class ThreadPool;
+
+// Structure-of-arrays results for one block of scenarios, indexed like the
+// block passed to BatchRunner::run. Sensitivity arrays are only filled when
+// the runner was asked for them.
+struct BatchResults
+{
+    std::vector<BatchStatus> status;
+    std::vector<double> normalDepth;
+    std::vector<double> velocity;
+    std::vector<double> froudeNumber;
+    std::vector<FlowRegime> flowRegime;
+    std::vector<double> criticalDepth;
+    std::vector<double> minimumSpecificEnergy;
+    std::vector<double> sensitivityManningN;
+    std::vector<double> sensitivityDischarge;
+    std::vector<double> sensitivityBedSlope;
+    std::vector<double> sensitivityBottomWidth;
+    std::vector<double> sensitivitySideSlope;
+};
+
+// Solves blocks of scenarios with BatchAnalyzer, splitting each block
+// across the pool. Buffers are reused between blocks so a long stream runs
+// without further allocation once the first block has been sized.
+class BatchRunner
+{
+public:
+    // roughnessMethod combines bed and bank n for scenarios that give a
+    // bank_manning_n.
+    BatchRunner(ThreadPool& pool, const BatchAnalyzer& analyzer, bool computeSensitivities,
+                CompositeRoughnessMethod roughnessMethod);
+
+    // Records that failed to parse are reported as InvalidInput.
+    void run(const std::vector<Scenario>& scenarios, BatchResults& results);
+
+    // Scenarios handed to one task; large enough to amortize scheduling and
+    // a multiple of BatchAnalyzer::LANE_COUNT.
+    static constexpr std::size_t GRAIN_SIZE = 1024;
+
+private:
+    void resize(std::size_t count, BatchResults& results);
+
+    ThreadPool& pool_;
+    const BatchAnalyzer& analyzer_;
+    bool computeSensitivities_;
+    CompositeRoughnessMethod roughnessMethod_;
+
+    std::vector<double> bottomWidth_;
+    std::vector<double> sideSlope_;
+    std::vector<double> discharge_;
+    std::vector<double> manningN_;
+    std::vector<double> bankManningN_;
+    std::vector<double> bedSlope_;
+    std::vector<BatchStatus> criticalStatus_;
+    std::vector<double> minimumSpecificForce_;
+};
+
+#endif // BATCHRUNNER_H
@@ -0,0 +1,242 @@
+#include "ResultWriter.h"
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+
+namespace
+{
+const char* to_status_text(const Scenario& scenario, BatchStatus status)
+{
+    if (!scenario.isValid)
+        return "parse_error";
+
+    switch (status)
+    {
+    case BatchStatus::Converged:
+        return "converged";
+    case BatchStatus::InvalidInput:
+        return "invalid_input";
+    case BatchStatus::NotConverged:
+        return "not_converged";
+    }
+
+    return "unknown";
+}
+
+const char* to_regime_text(FlowRegime regime)
+{
+    switch (regime)
+    {
+    case FlowRegime::Subcritical:
+        return "subcritical";
+    case FlowRegime::Critical:
+        return "critical";
+    case FlowRegime::Supercritical:
+        return "supercritical";
+    }
+
+    return "unknown";
+}
+
+const char* const RESULT_COLUMNS[] = {
+    "normal_depth", "velocity", "froude_number", "critical_depth", "min_specific_energy"};
+
+const char* const SENSITIVITY_COLUMNS[] = {
+    "dy_dn", "dy_dq", "dy_ds", "dy_db", "dy_dz"};
+}
+
+ResultWriter::ResultWriter(std::ostream& output, ResultFormat format, bool includeSensitivities)
+    : output_{output}
+    , format_{format}
+    , includeSensitivities_{includeSensitivities}
+{
+}
+
+void ResultWriter::write_header()
+{
+    if (format_ != ResultFormat::Csv)
+        return;
+
+    line_ = "id,status,flow_regime";
+    for (const char* column : RESULT_COLUMNS)
+        line_.append(",").append(column);
+
+    if (includeSensitivities_)
+    {
+        for (const char* column : SENSITIVITY_COLUMNS)
+            line_.append(",").append(column);
+    }
+
+    line_ += ",error\n";
+    output_.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+}
+
+void ResultWriter::write(const std::vector<Scenario>& scenarios, const BatchResults& results)
+{
+    for (std::size_t i = 0; i < scenarios.size(); ++i)
+    {
+        line_.clear();
+
+        if (format_ == ResultFormat::Csv)
+            write_csv_row(scenarios[i], results, i);
+        else
+            write_json_row(scenarios[i], results, i);
+
+        output_.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+    }
+}
+
+void ResultWriter::write_csv_row(const Scenario& scenario, const BatchResults& results, std::size_t index)
+{
+    bool isConverged = scenario.isValid && results.status[index] == BatchStatus::Converged;
+
+    append_quoted(scenario.id);
+    line_.append(",").append(to_status_text(scenario, results.status[index])).append(",");
+
+    if (isConverged)
+        line_.append(to_regime_text(results.flowRegime[index]));
+
+    const double values[] = {results.normalDepth[index], results.velocity[index], results.froudeNumber[index],
+                             results.criticalDepth[index], results.minimumSpecificEnergy[index]};
+
+    for (double value : values)
+    {
+        line_ += ',';
+        if (isConverged)
+            append_number(value);
+    }
+
+    if (includeSensitivities_)
+    {
+        const double sensitivities[] = {results.sensitivityManningN[index], results.sensitivityDischarge[index],
+                                        results.sensitivityBedSlope[index], results.sensitivityBottomWidth[index],
+                                        results.sensitivitySideSlope[index]};
+
+        for (double value : sensitivities)
+        {
+            line_ += ',';
+            if (isConverged)
+                append_number(value);
+        }
+    }
+
+    line_ += ',';
+    if (!scenario.isValid)
+        append_quoted(scenario.error);
+
+    line_ += '\n';
+}
+
+void ResultWriter::write_json_row(const Scenario& scenario, const BatchResults& results, std::size_t index)
+{
+    bool isConverged = scenario.isValid && results.status[index] == BatchStatus::Converged;
+
+    line_ += "{\"id\":";
+    append_quoted(scenario.id);
+    line_.append(",\"status\":\"").append(to_status_text(scenario, results.status[index])).append("\"");
+
+    if (!scenario.isValid)
+    {
+        line_ += ",\"error\":";
+        append_quoted(scenario.error);
+        line_ += "}\n";
+        return;
+    }
+
+    line_ += ",\"flow_regime\":";
+    if (isConverged)
+        line_.append("\"").append(to_regime_text(results.flowRegime[index])).append("\"");
+    else
+        line_ += "null";
+
+    const double values[] = {results.normalDepth[index], results.velocity[index], results.froudeNumber[index],
+                             results.criticalDepth[index], results.minimumSpecificEnergy[index]};
+
+    for (std::size_t column = 0; column < std::size(RESULT_COLUMNS); ++column)
+    {
+        line_.append(",\"").append(RESULT_COLUMNS[column]).append("\":");
+        if (isConverged)
+            append_number(values[column]);
+        else
+            line_ += "null";
+    }
+
+    if (includeSensitivities_)
+    {
+        const double sensitivities[] = {results.sensitivityManningN[index], results.sensitivityDischarge[index],
+                                        results.sensitivityBedSlope[index], results.sensitivityBottomWidth[index],
+                                        results.sensitivitySideSlope[index]};
+
+        for (std::size_t column = 0; column < std::size(SENSITIVITY_COLUMNS); ++column)
+        {
+            line_.append(",\"").append(SENSITIVITY_COLUMNS[column]).append("\":");
+            if (isConverged)
+                append_number(sensitivities[column]);
+            else
+                line_ += "null";
+        }
+    }
+
+    line_ += "}\n";
+}
+
+void ResultWriter::append_number(double value)
+{
+    if (!std::isfinite(value))
+    {
+        line_ += format_ == ResultFormat::Csv ? "" : "null";
+        return;
+    }
+
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%.10g", value);
+    line_.append(buffer, static_cast<std::size_t>(length));
+}
+
+// CSV fields are quoted only when needed; JSON strings always are.
+void ResultWriter::append_quoted(const std::string& text)
+{
+    if (format_ == ResultFormat::Csv)
+    {
+        if (text.find_first_of(",\"\n\r") == std::string::npos)
+        {
+            line_ += text;
+            return;
+        }
+
+        line_ += '"';
+        for (char c : text)
+        {
+            if (c == '"')
+                line_ += '"';
+            line_ += c;
+        }
+        line_ += '"';
+        return;
+    }
+
+    line_ += '"';
+    for (char c : text)
+    {
+        switch (c)
+        {
+        case '"': line_ += "\\\""; break;
+        case '\\': line_ += "\\\\"; break;
+        case '\n': line_ += "\\n"; break;
+        case '\r': line_ += "\\r"; break;
+        case '\t': line_ += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char buffer[8];
+                std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned char>(c));
+                line_ += buffer;
+            }
+            else
+            {
+                line_ += c;
+            }
+        }
+    }
+    line_ += '"';
+}
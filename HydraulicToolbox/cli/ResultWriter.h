@@ -0,0 +1,41 @@
+#ifndef RESULTWRITER_H
+#define RESULTWRITER_H
+
+#include "BatchRunner.h"
+#include <ostream>
+#include <string>
+#include <vector>
+
+enum class ResultFormat
+{
+    Csv,
+    JsonLines
+};
+
+// Streams solved blocks as CSV (one header row, then one row per scenario)
+// or JSON Lines (one object per scenario). Each row carries the scenario id
+// and a status of
+//     converged, invalid_input, not_converged or parse_error
+// Values of scenarios that did not converge are written empty (CSV) or null
+// (JSON) rather than as NaN.
+class ResultWriter
+{
+public:
+    ResultWriter(std::ostream& output, ResultFormat format, bool includeSensitivities);
+
+    void write_header();
+    void write(const std::vector<Scenario>& scenarios, const BatchResults& results);
+
+private:
+    void write_csv_row(const Scenario& scenario, const BatchResults& results, std::size_t index);
+    void write_json_row(const Scenario& scenario, const BatchResults& results, std::size_t index);
+    void append_number(double value);
+    void append_quoted(const std::string& text);
+
+    std::ostream& output_;
+    ResultFormat format_;
+    bool includeSensitivities_;
+    std::string line_;   // Reused row buffer
+};
+
+#endif // RESULTWRITER_H
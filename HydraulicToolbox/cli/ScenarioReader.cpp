@@ -0,0 +1,484 @@
+#include "ScenarioReader.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdlib>
+#include <optional>
+
+namespace
+{
+enum Field
+{
+    FIELD_ID,
+    FIELD_SHAPE,
+    FIELD_BOTTOM_WIDTH,
+    FIELD_SIDE_SLOPE,
+    FIELD_DISCHARGE,
+    FIELD_MANNING_N,
+    FIELD_BED_SLOPE,
+    FIELD_BANK_MANNING_N,
+    FIELD_COUNT,
+    FIELD_UNKNOWN = -1
+};
+
+using FieldValues = std::array<std::optional<std::string>, FIELD_COUNT>;
+
+std::string to_lower(std::string text)
+{
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+std::string trim(const std::string& text)
+{
+    std::size_t begin = text.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos)
+        return std::string{};
+
+    std::size_t end = text.find_last_not_of(" \t\r\n");
+    return text.substr(begin, end - begin + 1);
+}
+
+int find_field(const std::string& name)
+{
+    static const std::array<const char*, FIELD_COUNT> NAMES{
+        "id", "shape", "bottom_width", "side_slope", "discharge", "manning_n", "bed_slope", "bank_manning_n"};
+
+    std::string key = to_lower(trim(name));
+    for (int field = 0; field < FIELD_COUNT; ++field)
+    {
+        if (key == NAMES[field])
+            return field;
+    }
+
+    return FIELD_UNKNOWN;
+}
+
+bool parse_number(const std::optional<std::string>& text, double& value)
+{
+    if (!text || text->empty())
+        return false;
+
+    const char* begin = text->c_str();
+    char* end = nullptr;
+    value = std::strtod(begin, &end);
+    return end == begin + text->size();
+}
+
+// Fills `scenario` from the raw field text. recordIndex is 1-based and is
+// used as the id when none is given.
+void build_scenario(const FieldValues& fields, std::size_t recordIndex, Scenario& scenario)
+{
+    scenario = Scenario{};
+    scenario.id = fields[FIELD_ID] && !fields[FIELD_ID]->empty() ? *fields[FIELD_ID] : std::to_string(recordIndex);
+
+    std::string shape = fields[FIELD_SHAPE] ? to_lower(*fields[FIELD_SHAPE]) : std::string{};
+    bool needsWidth = shape != "triangular";
+    bool needsSideSlope = shape != "rectangular";
+
+    if (!shape.empty() && shape != "rectangular" && shape != "trapezoidal" && shape != "triangular")
+    {
+        scenario.error = "unknown shape '" + *fields[FIELD_SHAPE] + "'";
+        return;
+    }
+
+    struct Requirement
+    {
+        int field;
+        double* target;
+        bool isRequired;
+        const char* name;
+    };
+
+    const Requirement requirements[] = {
+        {FIELD_BOTTOM_WIDTH, &scenario.bottomWidth, needsWidth, "bottom_width"},
+        {FIELD_SIDE_SLOPE, &scenario.sideSlope, needsSideSlope && !shape.empty(), "side_slope"},
+        {FIELD_DISCHARGE, &scenario.discharge, true, "discharge"},
+        {FIELD_MANNING_N, &scenario.manningN, true, "manning_n"},
+        {FIELD_BED_SLOPE, &scenario.bedSlope, true, "bed_slope"},
+        {FIELD_BANK_MANNING_N, &scenario.bankManningN, false, "bank_manning_n"},
+    };
+
+    for (const Requirement& requirement : requirements)
+    {
+        const std::optional<std::string>& text = fields[requirement.field];
+        bool isPresent = text && !text->empty();
+
+        if (!isPresent)
+        {
+            if (requirement.isRequired)
+            {
+                scenario.error = std::string{"missing "} + requirement.name;
+                return;
+            }
+            continue;
+        }
+
+        if (!parse_number(text, *requirement.target))
+        {
+            scenario.error = std::string{"invalid "} + requirement.name + " '" + *text + "'";
+            return;
+        }
+    }
+
+    if (!needsWidth)
+        scenario.bottomWidth = 0.0;
+    if (!needsSideSlope)
+        scenario.sideSlope = 0.0;
+
+    scenario.isValid = true;
+}
+
+// Splits one CSV line, honouring double-quoted fields with "" escapes.
+std::vector<std::string> split_csv_line(const std::string& line)
+{
+    std::vector<std::string> cells;
+    std::string cell;
+    bool isQuoted{false};
+
+    for (std::size_t i = 0; i < line.size(); ++i)
+    {
+        char c = line[i];
+
+        if (isQuoted)
+        {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"')
+            {
+                cell += '"';
+                ++i;
+            }
+            else if (c == '"')
+            {
+                isQuoted = false;
+            }
+            else
+            {
+                cell += c;
+            }
+        }
+        else if (c == '"')
+        {
+            isQuoted = true;
+        }
+        else if (c == ',')
+        {
+            cells.push_back(trim(cell));
+            cell.clear();
+        }
+        else
+        {
+            cell += c;
+        }
+    }
+
+    cells.push_back(trim(cell));
+    return cells;
+}
+
+bool is_blank_or_comment(const std::string& line)
+{
+    std::string content = trim(line);
+    return content.empty() || content[0] == '#';
+}
+}
+
+ScenarioReader::ScenarioReader(std::istream& input, ScenarioFormat format)
+    : input_{input}
+    , format_{format}
+    , headerRead_{false}
+    , recordCount_{0}
+    , lineNumber_{1}
+{
+}
+
+std::size_t ScenarioReader::read(std::vector<Scenario>& scenarios, std::size_t maxCount)
+{
+    if (has_error())
+        return 0;
+
+    if (format_ == ScenarioFormat::Csv && !headerRead_ && !read_csv_header())
+        return 0;
+
+    std::size_t count{0};
+
+    while (count < maxCount)
+    {
+        Scenario scenario;
+        bool hasRecord = format_ == ScenarioFormat::Csv ? read_csv_record(scenario) : read_json_record(scenario);
+
+        if (!hasRecord)
+            break;
+
+        scenarios.push_back(std::move(scenario));
+        ++count;
+    }
+
+    return count;
+}
+
+bool ScenarioReader::has_error() const
+{
+    return !error_.empty();
+}
+
+const std::string& ScenarioReader::get_error() const
+{
+    return error_;
+}
+
+std::size_t ScenarioReader::get_record_count() const
+{
+    return recordCount_;
+}
+
+ScenarioFormat ScenarioReader::detect_format(std::istream& input)
+{
+    while (input && std::isspace(input.peek()))
+        input.get();
+
+    int first = input.peek();
+    return first == '[' || first == '{' ? ScenarioFormat::Json : ScenarioFormat::Csv;
+}
+
+bool ScenarioReader::read_csv_header()
+{
+    std::string line;
+
+    while (std::getline(input_, line))
+    {
+        ++lineNumber_;
+
+        if (is_blank_or_comment(line))
+            continue;
+
+        bool hasKnownColumn{false};
+        for (const std::string& name : split_csv_line(line))
+        {
+            int field = find_field(name);
+            columnFields_.push_back(field);
+            hasKnownColumn = hasKnownColumn || field != FIELD_UNKNOWN;
+        }
+
+        if (!hasKnownColumn)
+        {
+            set_error("CSV header names none of the scenario columns");
+            return false;
+        }
+
+        headerRead_ = true;
+        return true;
+    }
+
+    headerRead_ = true;
+    return false;
+}
+
+bool ScenarioReader::read_csv_record(Scenario& scenario)
+{
+    std::string line;
+
+    while (std::getline(input_, line))
+    {
+        ++lineNumber_;
+
+        if (is_blank_or_comment(line))
+            continue;
+
+        FieldValues fields;
+        std::vector<std::string> cells = split_csv_line(line);
+
+        for (std::size_t column = 0; column < cells.size() && column < columnFields_.size(); ++column)
+        {
+            if (columnFields_[column] != FIELD_UNKNOWN)
+                fields[columnFields_[column]] = cells[column];
+        }
+
+        build_scenario(fields, ++recordCount_, scenario);
+        return true;
+    }
+
+    return false;
+}
+
+bool ScenarioReader::read_json_record(Scenario& scenario)
+{
+    // Array brackets and separators between objects carry no information, so
+    // an array of objects and JSON Lines are read the same way.
+    for (;;)
+    {
+        skip_whitespace();
+        int c = peek_character();
+
+        if (c == EOF)
+            return false;
+
+        if (c == '[' || c == ']' || c == ',')
+        {
+            next_character();
+            continue;
+        }
+
+        if (c != '{')
+        {
+            set_error("expected '{' at line " + std::to_string(lineNumber_));
+            return false;
+        }
+
+        break;
+    }
+
+    next_character();
+
+    FieldValues fields;
+    skip_whitespace();
+
+    if (peek_character() == '}')
+    {
+        next_character();
+        build_scenario(fields, ++recordCount_, scenario);
+        return true;
+    }
+
+    for (;;)
+    {
+        std::string key;
+        std::string value;
+
+        skip_whitespace();
+        if (!parse_json_string(key))
+            return false;
+
+        skip_whitespace();
+        if (next_character() != ':')
+        {
+            set_error("expected ':' after key at line " + std::to_string(lineNumber_));
+            return false;
+        }
+
+        skip_whitespace();
+        bool isParsed = peek_character() == '"' ? parse_json_string(value) : parse_json_scalar(value);
+        if (!isParsed)
+            return false;
+
+        int field = find_field(key);
+        if (field != FIELD_UNKNOWN && value != "null")
+            fields[field] = value;
+
+        skip_whitespace();
+        int separator = next_character();
+
+        if (separator == '}')
+            break;
+
+        if (separator != ',')
+        {
+            set_error("expected ',' or '}' at line " + std::to_string(lineNumber_));
+            return false;
+        }
+    }
+
+    build_scenario(fields, ++recordCount_, scenario);
+    return true;
+}
+
+int ScenarioReader::next_character()
+{
+    int c = input_.get();
+    if (c == '\n')
+        ++lineNumber_;
+    return c;
+}
+
+int ScenarioReader::peek_character()
+{
+    return input_.peek();
+}
+
+void ScenarioReader::skip_whitespace()
+{
+    while (std::isspace(peek_character()))
+        next_character();
+}
+
+bool ScenarioReader::parse_json_string(std::string& value)
+{
+    if (next_character() != '"')
+    {
+        set_error("expected string at line " + std::to_string(lineNumber_));
+        return false;
+    }
+
+    value.clear();
+
+    for (;;)
+    {
+        int c = next_character();
+
+        if (c == EOF)
+        {
+            set_error("unterminated string at line " + std::to_string(lineNumber_));
+            return false;
+        }
+
+        if (c == '"')
+            return true;
+
+        if (c == '\\')
+        {
+            int escaped = next_character();
+            switch (escaped)
+            {
+            case 'n': value += '\n'; break;
+            case 't': value += '\t'; break;
+            case 'r': value += '\r'; break;
+            case '"':
+            case '\\':
+            case '/':
+                value += static_cast<char>(escaped);
+                break;
+            default:
+                set_error("unsupported escape in string at line " + std::to_string(lineNumber_));
+                return false;
+            }
+            continue;
+        }
+
+        value += static_cast<char>(c);
+    }
+}
+
+// Numbers, true, false and null. Nested objects and arrays are rejected.
+bool ScenarioReader::parse_json_scalar(std::string& value)
+{
+    value.clear();
+
+    for (;;)
+    {
+        int c = peek_character();
+
+        if (c == EOF || c == ',' || c == '}' || c == ']' || std::isspace(c))
+            break;
+
+        if (c == '{' || c == '[')
+        {
+            set_error("nested values are not supported at line " + std::to_string(lineNumber_));
+            return false;
+        }
+
+        value += static_cast<char>(next_character());
+    }
+
+    if (value.empty())
+    {
+        set_error("expected value at line " + std::to_string(lineNumber_));
+        return false;
+    }
+
+    return true;
+}
+
+void ScenarioReader::set_error(const std::string& message)
+{
+    error_ = message;
+}
@@ -0,0 +1,83 @@
+#ifndef SCENARIOREADER_H
+#define SCENARIOREADER_H
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <vector>
+
+enum class ScenarioFormat
+{
+    Csv,
+    Json
+};
+
+// One design check. Every shape is expressed with the trapezoidal
+// parameters used by BatchAnalyzer: rectangular channels have sideSlope = 0
+// and triangular channels have bottomWidth = 0.
+struct Scenario
+{
+    std::string id;
+    double bottomWidth{0.0};
+    double sideSlope{0.0};
+    double discharge{0.0};
+    double manningN{0.0};
+    double bankManningN{0.0};   // Zero when the banks share manningN
+    double bedSlope{0.0};
+    bool isValid{false};
+    std::string error;   // Why the record could not be used, when !isValid
+};
+
+// Streams scenarios from CSV or JSON in blocks so arbitrarily large inputs
+// are processed with bounded memory.
+//
+// CSV needs a header row naming the columns; order is free and unknown
+// columns are ignored. Blank lines and lines starting with '#' are skipped.
+// JSON input is either an array of objects or one object per line (JSON
+// Lines). Both formats use the keys
+//     id, shape, bottom_width, side_slope, discharge, manning_n, bed_slope
+// where shape is rectangular, trapezoidal or triangular. Without a shape the
+// section is taken as trapezoidal with the given width and side slope. An
+// optional bank_manning_n gives the banks their own roughness; manning_n is
+// then the bed roughness.
+//
+// A record with a missing or malformed value is returned with isValid =
+// false. Malformed JSON structure stops the reader; see has_error().
+class ScenarioReader
+{
+public:
+    ScenarioReader(std::istream& input, ScenarioFormat format);
+
+    // Appends up to maxCount scenarios and returns how many were read. Zero
+    // means the input is exhausted or a fatal error occurred.
+    std::size_t read(std::vector<Scenario>& scenarios, std::size_t maxCount);
+
+    bool has_error() const;
+    const std::string& get_error() const;
+    std::size_t get_record_count() const;
+
+    // Picks JSON when the first non-blank character is '[' or '{'.
+    static ScenarioFormat detect_format(std::istream& input);
+
+private:
+    bool read_csv_header();
+    bool read_csv_record(Scenario& scenario);
+    bool read_json_record(Scenario& scenario);
+
+    int next_character();
+    int peek_character();
+    void skip_whitespace();
+    bool parse_json_string(std::string& value);
+    bool parse_json_scalar(std::string& value);
+    void set_error(const std::string& message);
+
+    std::istream& input_;
+    ScenarioFormat format_;
+    std::vector<int> columnFields_;   // CSV column index -> field id
+    bool headerRead_;
+    std::size_t recordCount_;
+    std::size_t lineNumber_;
+    std::string error_;
+};
+
+#endif // SCENARIOREADER_H
@@ -0,0 +1,284 @@
+// Headless batch driver: reads channel scenarios from CSV or JSON, solves
+// them in parallel with BatchAnalyzer and streams the results. Links only
+// the backend, so it runs on machines without a display.
+
+#include "BatchRunner.h"
+#include "ResultWriter.h"
+#include "ScenarioReader.h"
+#include "SolverTelemetry.h"
+#include "ThreadPool.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+
+namespace
+{
+struct Options
+{
+    std::string inputPath{"-"};
+    std::string outputPath{"-"};
+    std::optional<ScenarioFormat> inputFormat;
+    ResultFormat outputFormat{ResultFormat::Csv};
+    bool useUsCustomary{false};
+    bool includeSensitivities{false};
+    bool reportMetrics{false};
+    CompositeRoughnessMethod roughnessMethod{CompositeRoughnessMethod::HortonEinstein};
+    std::size_t threadCount{0};
+    std::size_t blockSize{16384};
+};
+
+void print_usage(std::ostream& stream)
+{
+    stream << "Usage: hydraulic_batch [options] [input]\n"
+              "\n"
+              "Solves normal and critical depth for every scenario in `input`\n"
+              "(a CSV or JSON file, or '-' for stdin) and writes one result per\n"
+              "scenario.\n"
+              "\n"
+              "Options:\n"
+              "  --input-format csv|json   Input format (default: detect)\n"
+              "  -o, --output PATH         Output file (default: stdout)\n"
+              "  --output-format csv|jsonl Output format (default: csv)\n"
+              "  --units si|us             Unit system of the inputs (default: si)\n"
+              "  --threads N               Worker threads (default: one per core)\n"
+              "  --block-size N            Scenarios solved per block (default: 16384)\n"
+              "  --sensitivities           Add dy/dn, dy/dQ, dy/dS, dy/db, dy/dz\n"
+              "  --roughness horton|lotter|pavlovskii\n"
+              "                            Composite n method for rows with bank_manning_n\n"
+              "                            (default: horton)\n"
+              "  --metrics                 Print solver counts and latencies to stderr\n"
+              "  -h, --help                Show this message\n"
+              "\n"
+              "Input columns/keys: id, shape, bottom_width, side_slope,\n"
+              "discharge, manning_n, bed_slope, bank_manning_n (optional)\n";
+}
+
+bool parse_count(const char* text, std::size_t& value)
+{
+    char* end = nullptr;
+    unsigned long long parsed = std::strtoull(text, &end, 10);
+
+    if (end == text || *end != '\0')
+        return false;
+
+    value = static_cast<std::size_t>(parsed);
+    return true;
+}
+
+// Returns false and prints the reason on invalid arguments.
+bool parse_options(int argc, char* argv[], Options& options, bool& showHelp)
+{
+    bool hasInput{false};
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        bool takesValue = argument == "--input-format" || argument == "-o" || argument == "--output" ||
+                          argument == "--output-format" || argument == "--units" || argument == "--threads" ||
+                          argument == "--block-size" || argument == "--roughness";
+
+        if (takesValue && !value)
+        {
+            std::cerr << "hydraulic_batch: " << argument << " needs a value\n";
+            return false;
+        }
+
+        if (argument == "-h" || argument == "--help")
+        {
+            showHelp = true;
+        }
+        else if (argument == "--sensitivities")
+        {
+            options.includeSensitivities = true;
+        }
+        else if (argument == "--metrics")
+        {
+            options.reportMetrics = true;
+        }
+        else if (argument == "--input-format")
+        {
+            if (std::strcmp(value, "csv") == 0)
+                options.inputFormat = ScenarioFormat::Csv;
+            else if (std::strcmp(value, "json") == 0)
+                options.inputFormat = ScenarioFormat::Json;
+            else
+            {
+                std::cerr << "hydraulic_batch: unknown input format '" << value << "'\n";
+                return false;
+            }
+        }
+        else if (argument == "-o" || argument == "--output")
+        {
+            options.outputPath = value;
+        }
+        else if (argument == "--output-format")
+        {
+            if (std::strcmp(value, "csv") == 0)
+                options.outputFormat = ResultFormat::Csv;
+            else if (std::strcmp(value, "jsonl") == 0)
+                options.outputFormat = ResultFormat::JsonLines;
+            else
+            {
+                std::cerr << "hydraulic_batch: unknown output format '" << value << "'\n";
+                return false;
+            }
+        }
+        else if (argument == "--units")
+        {
+            if (std::strcmp(value, "si") == 0)
+                options.useUsCustomary = false;
+            else if (std::strcmp(value, "us") == 0)
+                options.useUsCustomary = true;
+            else
+            {
+                std::cerr << "hydraulic_batch: unknown unit system '" << value << "'\n";
+                return false;
+            }
+        }
+        else if (argument == "--roughness")
+        {
+            if (std::strcmp(value, "horton") == 0)
+                options.roughnessMethod = CompositeRoughnessMethod::HortonEinstein;
+            else if (std::strcmp(value, "lotter") == 0)
+                options.roughnessMethod = CompositeRoughnessMethod::Lotter;
+            else if (std::strcmp(value, "pavlovskii") == 0)
+                options.roughnessMethod = CompositeRoughnessMethod::Pavlovskii;
+            else
+            {
+                std::cerr << "hydraulic_batch: unknown roughness method '" << value << "'\n";
+                return false;
+            }
+        }
+        else if (argument == "--threads")
+        {
+            if (!parse_count(value, options.threadCount))
+            {
+                std::cerr << "hydraulic_batch: invalid thread count '" << value << "'\n";
+                return false;
+            }
+        }
+        else if (argument == "--block-size")
+        {
+            if (!parse_count(value, options.blockSize) || options.blockSize == 0)
+            {
+                std::cerr << "hydraulic_batch: invalid block size '" << value << "'\n";
+                return false;
+            }
+        }
+        else if (argument.size() > 1 && argument[0] == '-')
+        {
+            std::cerr << "hydraulic_batch: unknown option '" << argument << "'\n";
+            return false;
+        }
+        else if (!hasInput)
+        {
+            options.inputPath = argument;
+            hasInput = true;
+        }
+        else
+        {
+            std::cerr << "hydraulic_batch: more than one input given\n";
+            return false;
+        }
+
+        if (takesValue)
+            ++i;
+    }
+
+    return true;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    std::ios::sync_with_stdio(false);
+
+    Options options;
+    bool showHelp{false};
+
+    if (!parse_options(argc, argv, options, showHelp))
+    {
+        print_usage(std::cerr);
+        return EXIT_FAILURE;
+    }
+
+    if (showHelp)
+    {
+        print_usage(std::cout);
+        return EXIT_SUCCESS;
+    }
+
+    SolverMetrics::instance().set_enabled(options.reportMetrics);
+
+    std::ifstream inputFile;
+    if (options.inputPath != "-")
+    {
+        inputFile.open(options.inputPath, std::ios::binary);
+        if (!inputFile)
+        {
+            std::cerr << "hydraulic_batch: cannot open '" << options.inputPath << "'\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::ofstream outputFile;
+    if (options.outputPath != "-")
+    {
+        outputFile.open(options.outputPath, std::ios::binary | std::ios::trunc);
+        if (!outputFile)
+        {
+            std::cerr << "hydraulic_batch: cannot write '" << options.outputPath << "'\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::istream& input = inputFile.is_open() ? static_cast<std::istream&>(inputFile) : std::cin;
+    std::ostream& output = outputFile.is_open() ? static_cast<std::ostream&>(outputFile) : std::cout;
+
+    ScenarioFormat inputFormat = options.inputFormat ? *options.inputFormat : ScenarioReader::detect_format(input);
+    ScenarioReader reader{input, inputFormat};
+
+    ThreadPool pool{options.threadCount};
+    BatchAnalyzer analyzer{options.useUsCustomary};
+    BatchRunner runner{pool, analyzer, options.includeSensitivities, options.roughnessMethod};
+    ResultWriter writer{output, options.outputFormat, options.includeSensitivities};
+
+    std::vector<Scenario> scenarios;
+    BatchResults results;
+    scenarios.reserve(options.blockSize);
+
+    writer.write_header();
+
+    for (;;)
+    {
+        scenarios.clear();
+        if (reader.read(scenarios, options.blockSize) == 0)
+            break;
+
+        runner.run(scenarios, results);
+        writer.write(scenarios, results);
+    }
+
+    output.flush();
+
+    if (options.reportMetrics)
+        std::cerr << SolverMetrics::instance().format_report();
+
+    if (reader.has_error())
+    {
+        std::cerr << "hydraulic_batch: " << reader.get_error() << "\n";
+        return EXIT_FAILURE;
+    }
+
+    if (!output)
+    {
+        std::cerr << "hydraulic_batch: failed writing results\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -3,6 +3,7 @@
 #include "RectangularChannel.h"
 #include "TrapezoidalChannel.h"
 #include "TriangularChannel.h"
+#include "CircularChannel.h"
 #include "Flow.h"
 #include "UnitSystemConstants.h"
 
@@ -288,6 +289,17 @@ TEST(FlowRegimeClassification, GivenNearCriticalFlowConditions_WhenAnalyzing_Exp
     EXPECT_NEAR(1.0, result.froudeNumber, 0.15);
 }
 
+TEST(FlowRegimeClassification, GivenNormalAndCriticalDepths_WhenClassifyingByDepth_ExpectToleranceBand)
+{
+    double criticalDepth{2.0};
+
+    EXPECT_EQ(FlowRegime::Subcritical, classify_flow_regime_by_depth(2.1, criticalDepth));
+    EXPECT_EQ(FlowRegime::Supercritical, classify_flow_regime_by_depth(1.9, criticalDepth));
+    EXPECT_EQ(FlowRegime::Critical, classify_flow_regime_by_depth(2.01, criticalDepth));
+    EXPECT_EQ(FlowRegime::Critical, classify_flow_regime_by_depth(1.99, criticalDepth));
+    EXPECT_EQ(FlowRegime::Subcritical, classify_flow_regime_by_depth(2.01, criticalDepth, 0.001));
+}
+
 // ============================================================================
 // EDGE CASE TESTS - INVALID INPUTS
 // ============================================================================
@@ -693,3 +705,268 @@ TEST(AnalyzerUnitSystems, GivenSamePhysicalConditionsInDifferentUnits_WhenSolvin
     // Flow regimes should match
     EXPECT_EQ(resultUS.flowRegime, resultSI.flowRegime);
 }
+
+// ============================================================================
+// SOLVER METHOD TESTS
+// ============================================================================
+
+TEST(AnalyzerSolverMethods, GivenDefaultSettings_WhenSolving_ExpectNewtonConvergesInFewIterations)
+{
+    double bottomWidth{4.0};
+    double sideSlope{2.0};
+    double depth{0.0};
+    TrapezoidalChannel channel{bottomWidth, sideSlope, depth};
+
+    double discharge{50.0};
+    double manningN{0.013};
+    Flow flow{discharge, manningN};
+
+    double slope{0.001};
+    double manningsCoef{UnitSystemConstants::MANNINGS_COEFFICIENT_SI};
+    double gravity{UnitSystemConstants::GRAVITY_SI};
+
+    Analyzer analyzer;
+    AnalysisResult result = analyzer.solve_for_depth(channel, flow, slope, manningsCoef, gravity);
+
+    EXPECT_TRUE(result.isValid);
+    EXPECT_LE(result.iterations, 10);
+    EXPECT_LT(result.residual, 1e-10);
+}
+
+TEST(AnalyzerSolverMethods, GivenBisectionSelected_WhenSolving_ExpectSameDepthAsNewton)
+{
+    double width{10.0};
+    double depth{0.0};
+    RectangularChannel channel{width, depth};
+
+    double discharge{50.0};
+    double manningN{0.013};
+    Flow flow{discharge, manningN};
+
+    double slope{0.001};
+    double manningsCoef{UnitSystemConstants::MANNINGS_COEFFICIENT_SI};
+    double gravity{UnitSystemConstants::GRAVITY_SI};
+
+    SolverSettings settings;
+    settings.method = SolverMethod::Bisection;
+
+    Analyzer bisection{settings};
+    Analyzer newton;
+    AnalysisResult bisectionResult = bisection.solve_for_depth(channel, flow, slope, manningsCoef, gravity);
+    AnalysisResult newtonResult = newton.solve_for_depth(channel, flow, slope, manningsCoef, gravity);
+
+    EXPECT_TRUE(bisectionResult.isValid);
+    EXPECT_TRUE(newtonResult.isValid);
+    EXPECT_NEAR(newtonResult.normalDepth, bisectionResult.normalDepth, 0.001);
+    EXPECT_GT(bisectionResult.iterations, newtonResult.iterations);
+}
+
+TEST(AnalyzerSolverMethods, GivenTinyDischarge_WhenSolvingWithNewton_ExpectRelativeAccuracy)
+{
+    double sideSlope{1.5};
+    double depth{0.0};
+    TriangularChannel channel{sideSlope, depth};
+
+    double discharge{1e-4};
+    double manningN{0.013};
+    Flow flow{discharge, manningN};
+
+    double slope{0.001};
+    double manningsCoef{UnitSystemConstants::MANNINGS_COEFFICIENT_SI};
+    double gravity{UnitSystemConstants::GRAVITY_SI};
+
+    Analyzer analyzer;
+    AnalysisResult result = analyzer.solve_for_depth(channel, flow, slope, manningsCoef, gravity);
+
+    ASSERT_TRUE(result.isValid);
+
+    double area = sideSlope * result.normalDepth * result.normalDepth;
+    double perimeter = 2.0 * result.normalDepth * std::sqrt(sideSlope * sideSlope + 1.0);
+    double calculatedDischarge = area * std::pow(area / perimeter, 2.0 / 3.0) * std::sqrt(slope) / manningN;
+
+    EXPECT_NEAR(1.0, calculatedDischarge / discharge, 1e-8);
+}
+
+TEST(AnalyzerSolverMethods, GivenHugeDischarge_WhenSolvingWithNewton_ExpectValidResult)
+{
+    double width{50.0};
+    double depth{0.0};
+    RectangularChannel channel{width, depth};
+
+    double discharge{1e5};
+    double manningN{0.03};
+    Flow flow{discharge, manningN};
+
+    double slope{0.001};
+    double manningsCoef{UnitSystemConstants::MANNINGS_COEFFICIENT_SI};
+    double gravity{UnitSystemConstants::GRAVITY_SI};
+
+    Analyzer analyzer;
+    AnalysisResult result = analyzer.solve_for_depth(channel, flow, slope, manningsCoef, gravity);
+
+    EXPECT_TRUE(result.isValid);
+    EXPECT_LE(result.iterations, 15);
+    EXPECT_LT(result.residual, 1e-10);
+}
+
+TEST(AnalyzerSolverMethods, GivenCappedIterations_WhenNewtonFails_ExpectLastIterationsAndResidualReported)
+{
+    SolverSettings settings;
+    settings.maxIterations = 2;
+    settings.useDepthEstimates = false;
+
+    Analyzer analyzer{settings};
+    SolverTelemetry telemetry;
+    AnalysisResult result = analyzer.solve_section(TrapezoidalSection{4.0, 2.0}, Flow{50.0, 0.013}, 0.001,
+                                                   UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                   UnitSystemConstants::GRAVITY_SI, &telemetry);
+
+    EXPECT_FALSE(result.isValid);
+    EXPECT_EQ(2, result.iterations);
+    EXPECT_GT(result.residual, settings.relativeTolerance);
+    EXPECT_EQ(result.iterations, telemetry.iterations);
+    EXPECT_DOUBLE_EQ(result.residual, telemetry.residual);
+    EXPECT_FALSE(telemetry.isConverged);
+}
+
+// ============================================================================
+// SENSITIVITY TESTS
+// ============================================================================
+
+namespace
+{
+SolverSettings make_sensitivity_settings()
+{
+    SolverSettings settings;
+    settings.computeSensitivities = true;
+    settings.relativeTolerance = 1e-14;
+    return settings;
+}
+
+double solve_trapezoid_depth(double bottomWidth, double sideSlope, double discharge, double manningN, double slope)
+{
+    Analyzer analyzer{make_sensitivity_settings()};
+    return analyzer.solve_section(TrapezoidalSection{bottomWidth, sideSlope}, Flow{discharge, manningN}, slope,
+                                  UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                  UnitSystemConstants::GRAVITY_SI).normalDepth;
+}
+}
+
+TEST(AnalyzerSensitivities, GivenDefaultSettings_WhenSolving_ExpectNoSensitivities)
+{
+    Analyzer analyzer;
+    AnalysisResult result = analyzer.solve_section(TrapezoidalSection{4.0, 2.0}, Flow{50.0, 0.013}, 0.001,
+                                                   UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                   UnitSystemConstants::GRAVITY_SI);
+
+    EXPECT_TRUE(result.isValid);
+    EXPECT_FALSE(result.sensitivities.isValid);
+}
+
+TEST(AnalyzerSensitivities, GivenTrapezoidalSection_WhenComputingSensitivities_ExpectCentralDifferences)
+{
+    double b{4.0};
+    double z{2.0};
+    double q{50.0};
+    double n{0.013};
+    double s{0.001};
+
+    Analyzer analyzer{make_sensitivity_settings()};
+    AnalysisResult result = analyzer.solve_section(TrapezoidalSection{b, z}, Flow{q, n}, s,
+                                                   UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                   UnitSystemConstants::GRAVITY_SI);
+
+    ASSERT_TRUE(result.sensitivities.isValid);
+
+    auto central = [](auto&& depthOf, double value)
+    {
+        double step = 1e-5 * value;
+        return (depthOf(value + step) - depthOf(value - step)) / (2.0 * step);
+    };
+
+    const NormalDepthSensitivities& sensitivities = result.sensitivities;
+    EXPECT_NEAR(central([&](double x) { return solve_trapezoid_depth(b, z, q, x, s); }, n), sensitivities.manningN,
+                1e-5 * std::abs(sensitivities.manningN));
+    EXPECT_NEAR(central([&](double x) { return solve_trapezoid_depth(b, z, x, n, s); }, q), sensitivities.discharge,
+                1e-5 * std::abs(sensitivities.discharge));
+    EXPECT_NEAR(central([&](double x) { return solve_trapezoid_depth(b, z, q, n, x); }, s), sensitivities.bedSlope,
+                1e-5 * std::abs(sensitivities.bedSlope));
+    EXPECT_NEAR(central([&](double x) { return solve_trapezoid_depth(x, z, q, n, s); }, b), sensitivities.width,
+                1e-5 * std::abs(sensitivities.width));
+    EXPECT_NEAR(central([&](double x) { return solve_trapezoid_depth(b, x, q, n, s); }, z), sensitivities.sideSlope,
+                1e-5 * std::abs(sensitivities.sideSlope));
+
+    EXPECT_GT(sensitivities.manningN, 0.0);
+    EXPECT_GT(sensitivities.discharge, 0.0);
+    EXPECT_LT(sensitivities.bedSlope, 0.0);
+    EXPECT_LT(sensitivities.width, 0.0);
+    EXPECT_LT(sensitivities.sideSlope, 0.0);
+}
+
+TEST(AnalyzerSensitivities, GivenTriangularSection_WhenComputingSensitivities_ExpectClosedFormPowerLaw)
+{
+    // y = (Q n / k sqrt(S))^(3/8) * const, so y_n = 3y/8n, y_Q = 3y/8Q, y_S = -3y/16S.
+    Analyzer analyzer{make_sensitivity_settings()};
+    AnalysisResult result = analyzer.solve_section(TriangularSection{1.5}, Flow{10.0, 0.02}, 0.002,
+                                                   UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                   UnitSystemConstants::GRAVITY_SI);
+    double depth = result.normalDepth;
+
+    ASSERT_TRUE(result.sensitivities.isValid);
+    EXPECT_NEAR(3.0 * depth / (8.0 * 0.02), result.sensitivities.manningN, 1e-10);
+    EXPECT_NEAR(3.0 * depth / (8.0 * 10.0), result.sensitivities.discharge, 1e-12);
+    EXPECT_NEAR(-3.0 * depth / (16.0 * 0.002), result.sensitivities.bedSlope, 1e-9);
+    EXPECT_DOUBLE_EQ(0.0, result.sensitivities.width);
+}
+
+TEST(AnalyzerSensitivities, GivenPrismaticChannelPath_WhenComputingSensitivities_ExpectAllSensitivitiesMatchSectionPath)
+{
+    Analyzer analyzer{make_sensitivity_settings()};
+    RectangularChannel channel{10.0, 0.0};
+    Flow flow{50.0, 0.013};
+
+    AnalysisResult channelResult = analyzer.solve_for_depth(channel, flow, 0.001,
+                                                            UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                            UnitSystemConstants::GRAVITY_SI);
+    AnalysisResult sectionResult = analyzer.solve_section(RectangularSection{10.0}, flow, 0.001,
+                                                          UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                          UnitSystemConstants::GRAVITY_SI);
+
+    ASSERT_TRUE(channelResult.sensitivities.isValid);
+    EXPECT_NEAR(sectionResult.sensitivities.manningN, channelResult.sensitivities.manningN, 1e-9);
+    EXPECT_NEAR(sectionResult.sensitivities.discharge, channelResult.sensitivities.discharge, 1e-12);
+    EXPECT_NEAR(sectionResult.sensitivities.bedSlope, channelResult.sensitivities.bedSlope, 1e-9);
+    EXPECT_NEAR(sectionResult.sensitivities.width, channelResult.sensitivities.width, 1e-12);
+    EXPECT_TRUE(channelResult.sensitivities.hasDimensions);
+    EXPECT_LT(channelResult.sensitivities.width, 0.0);
+}
+
+TEST(AnalyzerSensitivities, GivenTrapezoidalChannelPath_WhenComputingSensitivities_ExpectSeededDimensions)
+{
+    Analyzer analyzer{make_sensitivity_settings()};
+    TrapezoidalChannel channel{4.0, 2.0, 0.0};
+
+    AnalysisResult result = analyzer.solve_for_depth(channel, Flow{50.0, 0.013}, 0.001,
+                                                     UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                     UnitSystemConstants::GRAVITY_SI);
+
+    ASSERT_TRUE(result.sensitivities.isValid);
+    EXPECT_TRUE(result.sensitivities.hasDimensions);
+    EXPECT_LT(result.sensitivities.width, 0.0);
+    EXPECT_LT(result.sensitivities.sideSlope, 0.0);
+}
+
+TEST(AnalyzerSensitivities, GivenCircularChannelPath_WhenComputingSensitivities_ExpectDimensionsUnavailable)
+{
+    Analyzer analyzer{make_sensitivity_settings()};
+    CircularChannel channel{2.0, 0.0};
+
+    AnalysisResult result = analyzer.solve_for_depth(channel, Flow{1.5, 0.013}, 0.001,
+                                                     UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                     UnitSystemConstants::GRAVITY_SI);
+
+    ASSERT_TRUE(result.isValid);
+    EXPECT_TRUE(result.sensitivities.isValid);
+    EXPECT_FALSE(result.sensitivities.hasDimensions);
+    EXPECT_GT(result.sensitivities.discharge, 0.0);
+}
@@ -0,0 +1,251 @@
+#include <gtest/gtest.h>
+#include "BatchAnalyzer.h"
+#include "Analyzer.h"
+#include "CriticalFlowAnalyzer.h"
+#include "RectangularChannel.h"
+#include "TrapezoidalChannel.h"
+#include "TriangularChannel.h"
+#include "Flow.h"
+#include "UnitSystemConstants.h"
+#include <vector>
+
+namespace
+{
+struct BatchBuffers
+{
+    std::vector<double> bottomWidth;
+    std::vector<double> sideSlope;
+    std::vector<double> discharge;
+    std::vector<double> manningN;
+    std::vector<double> bedSlope;
+
+    std::vector<double> normalDepth;
+    std::vector<double> velocity;
+    std::vector<double> froudeNumber;
+    std::vector<FlowRegime> flowRegime;
+    std::vector<BatchStatus> status;
+
+    void add(double b, double z, double q, double n, double s)
+    {
+        bottomWidth.push_back(b);
+        sideSlope.push_back(z);
+        discharge.push_back(q);
+        manningN.push_back(n);
+        bedSlope.push_back(s);
+    }
+
+    void solve(const BatchAnalyzer& analyzer)
+    {
+        std::size_t count = discharge.size();
+        normalDepth.assign(count, -1.0);
+        velocity.assign(count, -1.0);
+        froudeNumber.assign(count, -1.0);
+        flowRegime.assign(count, FlowRegime::Critical);
+        status.assign(count, BatchStatus::NotConverged);
+
+        BatchInputs inputs{bottomWidth.data(), sideSlope.data(), discharge.data(),
+                           manningN.data(), bedSlope.data(), count};
+        BatchOutputs outputs{normalDepth.data(), velocity.data(), froudeNumber.data(),
+                             flowRegime.data(), status.data()};
+        analyzer.solve_for_depth(inputs, outputs);
+    }
+};
+}
+
+// ============================================================================
+// AGREEMENT WITH SCALAR SOLVER
+// ============================================================================
+
+TEST(BatchAnalyzerSolving, GivenKnownSectionsOfEachShape_WhenSolvingBatch_ExpectScalarDepths)
+{
+    BatchBuffers buffers;
+    buffers.add(10.0, 0.0, 50.0, 0.013, 0.001);   // Rectangular
+    buffers.add(4.0, 2.0, 50.0, 0.013, 0.001);    // Trapezoidal
+    buffers.add(0.0, 2.0, 50.0, 0.013, 0.001);    // Triangular
+
+    buffers.solve(BatchAnalyzer{false});
+
+    EXPECT_EQ(BatchStatus::Converged, buffers.status[0]);
+    EXPECT_EQ(BatchStatus::Converged, buffers.status[1]);
+    EXPECT_EQ(BatchStatus::Converged, buffers.status[2]);
+    EXPECT_NEAR(1.736, buffers.normalDepth[0], 0.001);
+    EXPECT_NEAR(2.110, buffers.normalDepth[1], 0.001);
+    EXPECT_NEAR(2.930, buffers.normalDepth[2], 0.001);
+}
+
+TEST(BatchAnalyzerSolving, GivenTrapezoidalScenario_WhenSolvingBatch_ExpectSameResultAsAnalyzer)
+{
+    BatchBuffers buffers;
+    buffers.add(3.0, 1.5, 12.0, 0.022, 0.004);
+
+    buffers.solve(BatchAnalyzer{UnitSystemConstants::MANNINGS_COEFFICIENT_US,
+                                UnitSystemConstants::GRAVITY_US_CUSTOMARY});
+
+    TrapezoidalChannel channel{3.0, 1.5, 0.0};
+    Flow flow{12.0, 0.022};
+    Analyzer analyzer;
+    AnalysisResult expected = analyzer.solve_for_depth(channel, flow, 0.004,
+                                                       UnitSystemConstants::MANNINGS_COEFFICIENT_US,
+                                                       UnitSystemConstants::GRAVITY_US_CUSTOMARY);
+
+    ASSERT_TRUE(expected.isValid);
+    EXPECT_EQ(BatchStatus::Converged, buffers.status[0]);
+    EXPECT_NEAR(expected.normalDepth, buffers.normalDepth[0], 0.001);
+    EXPECT_NEAR(expected.velocity, buffers.velocity[0], 0.001);
+    EXPECT_NEAR(expected.froudeNumber, buffers.froudeNumber[0], 0.001);
+    EXPECT_EQ(expected.flowRegime, buffers.flowRegime[0]);
+}
+
+TEST(BatchAnalyzerSolving, GivenSolvedDepth_WhenCheckingManningEquation_ExpectDischargeRecovered)
+{
+    BatchBuffers buffers;
+    buffers.add(10.0, 0.0, 0.01, 0.013, 0.001);
+    buffers.add(10.0, 0.0, 10000.0, 0.013, 0.001);
+
+    buffers.solve(BatchAnalyzer{false});
+
+    for (std::size_t i = 0; i < buffers.discharge.size(); ++i)
+    {
+        ASSERT_EQ(BatchStatus::Converged, buffers.status[i]);
+
+        double y = buffers.normalDepth[i];
+        double area = buffers.bottomWidth[i] * y;
+        double radius = area / (buffers.bottomWidth[i] + 2.0 * y);
+        double discharge = area * std::pow(radius, 2.0 / 3.0) * std::sqrt(buffers.bedSlope[i]) / buffers.manningN[i];
+
+        EXPECT_NEAR(1.0, discharge / buffers.discharge[i], 1e-9);
+    }
+}
+
+// ============================================================================
+// BLOCK HANDLING AND STATUS TESTS
+// ============================================================================
+
+TEST(BatchAnalyzerSolving, GivenCountNotMultipleOfLaneCount_WhenSolvingBatch_ExpectEveryScenarioSolved)
+{
+    BatchBuffers buffers;
+    std::size_t count = 3 * BatchAnalyzer::LANE_COUNT + 5;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        buffers.add(2.0 + 0.1 * i, 1.0, 5.0 + i, 0.015, 0.002);
+    }
+
+    buffers.solve(BatchAnalyzer{false});
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        EXPECT_EQ(BatchStatus::Converged, buffers.status[i]);
+        EXPECT_GT(buffers.normalDepth[i], 0.0);
+    }
+
+    EXPECT_LT(buffers.normalDepth.front(), buffers.normalDepth.back());
+}
+
+TEST(BatchAnalyzerEdgeCases, GivenInvalidInputs_WhenSolvingBatch_ExpectInvalidInputStatus)
+{
+    BatchBuffers buffers;
+    buffers.add(10.0, 0.0, 50.0, 0.013, 0.0);     // Zero slope
+    buffers.add(10.0, 0.0, -50.0, 0.013, 0.001);  // Negative discharge
+    buffers.add(-10.0, 0.0, 50.0, 0.013, 0.001);  // Negative width
+    buffers.add(0.0, 0.0, 50.0, 0.013, 0.001);    // No section at all
+    buffers.add(10.0, 0.0, 50.0, 0.013, 0.001);   // Valid neighbour
+
+    buffers.solve(BatchAnalyzer{false});
+
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(BatchStatus::InvalidInput, buffers.status[i]);
+        EXPECT_DOUBLE_EQ(0.0, buffers.normalDepth[i]);
+    }
+
+    EXPECT_EQ(BatchStatus::Converged, buffers.status[4]);
+}
+
+TEST(BatchAnalyzerEdgeCases, GivenDepthOutsideSolverRange_WhenSolvingBatch_ExpectNotConvergedStatus)
+{
+    BatchBuffers buffers;
+    buffers.add(0.01, 0.0, 10000.0, 0.5, 0.00001);
+
+    buffers.solve(BatchAnalyzer{false});
+
+    EXPECT_EQ(BatchStatus::NotConverged, buffers.status[0]);
+}
+
+// ============================================================================
+// CRITICAL DEPTH BATCH
+// ============================================================================
+
+TEST(BatchAnalyzerCritical, GivenSectionsOfEachShape_WhenSolvingCriticalBatch_ExpectScalarCriticalDepths)
+{
+    std::vector<double> bottomWidth{4.0, 4.0, 0.0, 10.0};
+    std::vector<double> sideSlope{0.0, 2.0, 2.0, 1.5};
+    std::vector<double> discharge{20.0, 50.0, 10.0, -1.0};
+    std::size_t count = discharge.size();
+
+    std::vector<double> criticalDepth(count);
+    std::vector<double> minimumSpecificEnergy(count);
+    std::vector<double> minimumSpecificForce(count);
+    std::vector<BatchStatus> status(count);
+
+    BatchAnalyzer batchAnalyzer{false};
+    BatchInputs inputs{bottomWidth.data(), sideSlope.data(), discharge.data(), nullptr, nullptr, count};
+    BatchCriticalOutputs outputs{criticalDepth.data(), minimumSpecificEnergy.data(),
+                                 minimumSpecificForce.data(), status.data()};
+    batchAnalyzer.solve_critical_depth(inputs, outputs);
+
+    CriticalFlowAnalyzer analyzer;
+    double gravity{UnitSystemConstants::GRAVITY_SI};
+    CriticalFlowResult rectangular = analyzer.solve_section(RectangularSection{4.0}, 20.0, gravity);
+    CriticalFlowResult trapezoidal = analyzer.solve_section(TrapezoidalSection{4.0, 2.0}, 50.0, gravity);
+    CriticalFlowResult triangular = analyzer.solve_section(TriangularSection{2.0}, 10.0, gravity);
+
+    EXPECT_EQ(BatchStatus::Converged, status[0]);
+    EXPECT_NEAR(rectangular.criticalDepth, criticalDepth[0], 1e-9);
+    EXPECT_NEAR(trapezoidal.criticalDepth, criticalDepth[1], 1e-9);
+    EXPECT_NEAR(trapezoidal.minimumSpecificEnergy, minimumSpecificEnergy[1], 1e-9);
+    EXPECT_NEAR(trapezoidal.minimumSpecificForce, minimumSpecificForce[1], 1e-9);
+    EXPECT_NEAR(triangular.criticalDepth, criticalDepth[2], 1e-9);
+    EXPECT_EQ(BatchStatus::InvalidInput, status[3]);
+    EXPECT_DOUBLE_EQ(0.0, criticalDepth[3]);
+}
+
+// ============================================================================
+// SENSITIVITIES
+// ============================================================================
+
+TEST(BatchAnalyzerSensitivities, GivenConvergedScenarios_WhenCalculatingSensitivities_ExpectScalarSensitivities)
+{
+    BatchBuffers buffers;
+    buffers.add(4.0, 2.0, 50.0, 0.013, 0.001);
+    buffers.add(10.0, 0.0, 20.0, 0.015, 0.002);
+    buffers.add(4.0, 2.0, -1.0, 0.013, 0.001);
+
+    BatchAnalyzer batchAnalyzer{false};
+    buffers.solve(batchAnalyzer);
+
+    std::size_t count = buffers.discharge.size();
+    std::vector<double> manningN(count);
+    std::vector<double> discharge(count);
+    std::vector<double> bedSlope(count);
+    std::vector<double> bottomWidth(count);
+
+    BatchInputs inputs{buffers.bottomWidth.data(), buffers.sideSlope.data(), buffers.discharge.data(),
+                       buffers.manningN.data(), buffers.bedSlope.data(), count};
+    BatchSensitivityOutputs outputs{manningN.data(), discharge.data(), bedSlope.data(), bottomWidth.data(), nullptr};
+    batchAnalyzer.calculate_sensitivities(inputs, buffers.normalDepth.data(), buffers.status.data(), outputs);
+
+    SolverSettings settings;
+    settings.computeSensitivities = true;
+    Analyzer analyzer{settings};
+    AnalysisResult expected = analyzer.solve_section(TrapezoidalSection{4.0, 2.0}, Flow{50.0, 0.013}, 0.001,
+                                                     UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                     UnitSystemConstants::GRAVITY_SI);
+
+    EXPECT_NEAR(expected.sensitivities.manningN, manningN[0], 1e-6 * expected.sensitivities.manningN);
+    EXPECT_NEAR(expected.sensitivities.discharge, discharge[0], 1e-6 * expected.sensitivities.discharge);
+    EXPECT_NEAR(expected.sensitivities.bedSlope, bedSlope[0], -1e-6 * expected.sensitivities.bedSlope);
+    EXPECT_NEAR(expected.sensitivities.width, bottomWidth[0], -1e-6 * expected.sensitivities.width);
+    EXPECT_GT(manningN[1], 0.0);
+    EXPECT_TRUE(std::isnan(manningN[2]));
+}
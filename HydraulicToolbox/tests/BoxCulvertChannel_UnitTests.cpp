@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "Analyzer.h"
+#include "BoxCulvertChannel.h"
+#include "CriticalFlowAnalyzer.h"
+#include "RectangularChannel.h"
+#include "UnitSystemConstants.h"
+
+TEST(BoxCulvertChannelGeometry, GivenDepthBelowCrown_WhenCalculatingProperties_ExpectRectangularValues)
+{
+    BoxCulvertChannel culvert{3.0, 2.0, 1.5};
+    RectangularChannel rectangle{3.0, 1.5};
+
+    EXPECT_DOUBLE_EQ(rectangle.calculate_area(), culvert.calculate_area());
+    EXPECT_DOUBLE_EQ(rectangle.calculate_wetted_perimeter(), culvert.calculate_wetted_perimeter());
+    EXPECT_DOUBLE_EQ(rectangle.calculate_top_width(), culvert.calculate_top_width());
+    EXPECT_DOUBLE_EQ(rectangle.calculate_first_moment_of_area(), culvert.calculate_first_moment_of_area());
+    EXPECT_FALSE(culvert.is_flowing_full());
+}
+
+TEST(BoxCulvertChannelGeometry, GivenDepthAboveCrown_WhenCalculatingProperties_ExpectFullBarrel)
+{
+    BoxCulvertChannel culvert{3.0, 2.0, 2.5};
+
+    EXPECT_TRUE(culvert.is_flowing_full());
+    EXPECT_DOUBLE_EQ(6.0, culvert.calculate_area());
+    EXPECT_DOUBLE_EQ(10.0, culvert.calculate_wetted_perimeter());
+    EXPECT_DOUBLE_EQ(0.0, culvert.calculate_top_width());
+    EXPECT_DOUBLE_EQ(6.0 * 1.5, culvert.calculate_first_moment_of_area());
+}
+
+TEST(BoxCulvertChannelGeometry, GivenInvalidDimensions_WhenCreatingChannel_ExpectInvalidConfiguration)
+{
+    EXPECT_FALSE((BoxCulvertChannel{0.0, 2.0, 1.0}.is_valid()));
+    EXPECT_FALSE((BoxCulvertChannel{3.0, 0.0, 1.0}.is_valid()));
+    EXPECT_FALSE((BoxCulvertChannel{3.0, 2.0, 0.0}.is_valid()));
+}
+
+TEST(BoxCulvertChannelSolve, GivenDischargeBelowCrownCapacity_WhenSolvingNormalDepth_ExpectRectangularDepth)
+{
+    BoxCulvertChannel culvert{3.0, 2.0, 0.0};
+    Flow flow{8.0, 0.013};
+    Analyzer analyzer;
+
+    AnalysisResult boxResult = analyzer.solve_for_depth(culvert, flow, 0.002, UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                        UnitSystemConstants::GRAVITY_SI);
+    AnalysisResult openResult = analyzer.solve_section(RectangularSection{3.0}, flow, 0.002,
+                                                       UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                       UnitSystemConstants::GRAVITY_SI);
+
+    ASSERT_TRUE(boxResult.isValid);
+    EXPECT_LT(boxResult.normalDepth, 2.0);
+    EXPECT_NEAR(openResult.normalDepth, boxResult.normalDepth, 1e-8);
+}
+
+TEST(BoxCulvertChannelSolve, GivenDischargeAboveCrownCapacity_WhenSolving_ExpectInvalidResults)
+{
+    BoxCulvertChannel culvert{3.0, 2.0, 0.0};
+
+    // Open-channel capacity at the crown: A = 6, P = 7.
+    culvert.set_depth(2.0);
+    double crownDischarge = calculate_manning_discharge(culvert.calculate_area(), culvert.calculate_wetted_perimeter(),
+                                                        0.013, 0.002, UnitSystemConstants::MANNINGS_COEFFICIENT_SI);
+
+    Analyzer analyzer;
+    AnalysisResult normal = analyzer.solve_for_depth(culvert, Flow{1.01 * crownDischarge, 0.013}, 0.002,
+                                                     UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                     UnitSystemConstants::GRAVITY_SI);
+
+    // Critical depth (q^2 / g)^(1/3) > 2 m once q > 8.86 m^2/s.
+    CriticalFlowAnalyzer criticalAnalyzer;
+    CriticalFlowResult critical = criticalAnalyzer.solve_critical_depth(culvert, 30.0, UnitSystemConstants::GRAVITY_SI);
+
+    EXPECT_FALSE(normal.isValid);
+    EXPECT_FALSE(critical.isValid);
+    EXPECT_TRUE(criticalAnalyzer.solve_critical_depth(culvert, 20.0, UnitSystemConstants::GRAVITY_SI).isValid);
+}
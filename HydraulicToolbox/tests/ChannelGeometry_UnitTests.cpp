@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "ChannelGeometry.h"
+#include "Analyzer.h"
+#include "RectangularChannel.h"
+#include "TrapezoidalChannel.h"
+#include "TriangularChannel.h"
+#include "Flow.h"
+#include "UnitSystemConstants.h"
+
+// ============================================================================
+// SECTION KERNEL TESTS
+// ============================================================================
+
+TEST(ChannelGeometrySections, GivenTrapezoidalSection_WhenEvaluating_ExpectSameValuesAsChannel)
+{
+    TrapezoidalSection section{4.0, 2.0};
+    TrapezoidalChannel channel{4.0, 2.0, 3.0};
+
+    SectionProperties properties = section.evaluate(3.0);
+
+    EXPECT_DOUBLE_EQ(channel.calculate_area(), properties.area);
+    EXPECT_DOUBLE_EQ(channel.calculate_wetted_perimeter(), properties.wettedPerimeter);
+    EXPECT_DOUBLE_EQ(channel.calculate_top_width(), properties.topWidth);
+    EXPECT_DOUBLE_EQ(channel.calculate_wetted_perimeter_derivative(), properties.wettedPerimeterDerivative);
+}
+
+TEST(ChannelGeometrySections, GivenRectangularSection_WhenEvaluating_ExpectFusedValuesMatchIndividualCalls)
+{
+    RectangularSection section{5.0};
+
+    SectionProperties properties = section.evaluate(2.0);
+
+    EXPECT_DOUBLE_EQ(section.calculate_area(2.0), properties.area);
+    EXPECT_DOUBLE_EQ(section.calculate_wetted_perimeter(2.0), properties.wettedPerimeter);
+    EXPECT_DOUBLE_EQ(section.calculate_top_width(2.0), properties.topWidth);
+}
+
+TEST(ChannelGeometrySections, GivenTriangularSection_WhenEvaluating_ExpectSameValuesAsChannel)
+{
+    TriangularSection section{2.0};
+    TriangularChannel channel{2.0, 3.0};
+
+    SectionProperties properties = section.evaluate(3.0);
+
+    EXPECT_DOUBLE_EQ(channel.calculate_area(), properties.area);
+    EXPECT_DOUBLE_EQ(channel.calculate_wetted_perimeter(), properties.wettedPerimeter);
+    EXPECT_DOUBLE_EQ(channel.calculate_top_width(), properties.topWidth);
+}
+
+// ============================================================================
+// DEVIRTUALIZED SOLVER TESTS
+// ============================================================================
+
+TEST(ChannelGeometrySolving, GivenEachSectionType_WhenSolvingSection_ExpectSameResultAsVirtualPath)
+{
+    Flow flow{50.0, 0.013};
+    double slope{0.001};
+    double manningsCoef{UnitSystemConstants::MANNINGS_COEFFICIENT_SI};
+    double gravity{UnitSystemConstants::GRAVITY_SI};
+
+    RectangularChannel rectangular{10.0, 0.0};
+    TrapezoidalChannel trapezoidal{4.0, 2.0, 0.0};
+    TriangularChannel triangular{2.0, 0.0};
+
+    Analyzer analyzer;
+
+    AnalysisResult rectangularResult = analyzer.solve_section(rectangular.get_section(), flow, slope, manningsCoef, gravity);
+    AnalysisResult trapezoidalResult = analyzer.solve_section(trapezoidal.get_section(), flow, slope, manningsCoef, gravity);
+    AnalysisResult triangularResult = analyzer.solve_section(triangular.get_section(), flow, slope, manningsCoef, gravity);
+
+    EXPECT_NEAR(analyzer.solve_for_depth(rectangular, flow, slope, manningsCoef, gravity).normalDepth,
+                rectangularResult.normalDepth, 1e-9);
+    EXPECT_NEAR(analyzer.solve_for_depth(trapezoidal, flow, slope, manningsCoef, gravity).normalDepth,
+                trapezoidalResult.normalDepth, 1e-9);
+    EXPECT_NEAR(analyzer.solve_for_depth(triangular, flow, slope, manningsCoef, gravity).normalDepth,
+                triangularResult.normalDepth, 1e-9);
+}
+
+TEST(ChannelGeometrySolving, GivenSectionVariant_WhenSolvingSection_ExpectDispatchToHeldType)
+{
+    ChannelSection section = TrapezoidalSection{4.0, 2.0};
+    Flow flow{50.0, 0.013};
+
+    Analyzer analyzer;
+    AnalysisResult result = analyzer.solve_section(section, flow, 0.001,
+                                                   UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                   UnitSystemConstants::GRAVITY_SI);
+
+    EXPECT_TRUE(result.isValid);
+    EXPECT_NEAR(2.110, result.normalDepth, 0.001);
+}
+
+TEST(ChannelGeometrySolving, GivenInvalidSection_WhenSolvingSection_ExpectInvalidResult)
+{
+    RectangularSection section{0.0};
+    Flow flow{50.0, 0.013};
+
+    Analyzer analyzer;
+    AnalysisResult result = analyzer.solve_section(section, flow, 0.001,
+                                                   UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                   UnitSystemConstants::GRAVITY_SI);
+
+    EXPECT_FALSE(result.isValid);
+}
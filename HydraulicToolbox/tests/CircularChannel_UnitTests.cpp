@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include "Analyzer.h"
+#include "CircularChannel.h"
+#include "CriticalFlowAnalyzer.h"
+#include "UnitSystemConstants.h"
+#include <cmath>
+
+namespace
+{
+constexpr double PI{3.14159265358979323846};
+constexpr double DIAMETER{1.5};
+
+double calculate_exact_area(double diameter, double depth)
+{
+    double halfAngle = std::acos(1.0 - 2.0 * depth / diameter);
+    return 0.25 * diameter * diameter * (halfAngle - std::sin(halfAngle) * std::cos(halfAngle));
+}
+
+double calculate_exact_wetted_perimeter(double diameter, double depth)
+{
+    return diameter * std::acos(1.0 - 2.0 * depth / diameter);
+}
+
+double calculate_pipe_discharge(CircularChannel& channel, double depth)
+{
+    channel.set_depth(depth);
+    return calculate_manning_discharge(channel.calculate_area(), channel.calculate_wetted_perimeter(), 0.013, 0.002,
+                                       UnitSystemConstants::MANNINGS_COEFFICIENT_SI);
+}
+}
+
+// ============================================================================
+// GEOMETRY
+// ============================================================================
+
+TEST(CircularChannelGeometry, GivenHalfFullPipe_WhenCalculatingProperties_ExpectSemicircleValues)
+{
+    CircularChannel channel{DIAMETER, 0.5 * DIAMETER};
+
+    EXPECT_NEAR(PI * DIAMETER * DIAMETER / 8.0, channel.calculate_area(), 1e-12);
+    EXPECT_NEAR(PI * DIAMETER / 2.0, channel.calculate_wetted_perimeter(), 1e-12);
+    EXPECT_DOUBLE_EQ(DIAMETER, channel.calculate_top_width());
+    EXPECT_DOUBLE_EQ(2.0, channel.calculate_wetted_perimeter_derivative());
+    EXPECT_NEAR(DIAMETER * DIAMETER * DIAMETER / 12.0, channel.calculate_first_moment_of_area(), 1e-12);
+}
+
+TEST(CircularChannelGeometry, GivenDepthsAcrossPipe_WhenReadingTable_ExpectExactGeometry)
+{
+    CircularChannel channel{DIAMETER, 0.0};
+
+    // Off-node ratios, including the exact bands at the invert and crown.
+    for (double ratio = 0.0007; ratio < 1.0; ratio += 0.0123)
+    {
+        double depth = ratio * DIAMETER;
+        SectionProperties properties = channel.evaluate(depth);
+
+        EXPECT_NEAR(calculate_exact_area(DIAMETER, depth), properties.area, 1e-10 * DIAMETER * DIAMETER) << ratio;
+        EXPECT_NEAR(calculate_exact_wetted_perimeter(DIAMETER, depth), properties.wettedPerimeter, 1e-9 * DIAMETER) << ratio;
+        EXPECT_NEAR(2.0 * std::sqrt(depth * (DIAMETER - depth)), properties.topWidth, 1e-12) << ratio;
+    }
+}
+
+TEST(CircularChannelGeometry, GivenPartialDepth_WhenCalculatingFirstMoment_ExpectIntegralOfTopWidth)
+{
+    constexpr double DEPTH{0.4 * DIAMETER};
+    constexpr int STEPS{20000};
+
+    // M = integral over 0..y of T(eta) (y - eta) d eta, by the midpoint rule.
+    double moment{0.0};
+    double step = DEPTH / STEPS;
+    for (int i = 0; i < STEPS; ++i)
+    {
+        double eta = (i + 0.5) * step;
+        moment += 2.0 * std::sqrt(eta * (DIAMETER - eta)) * (DEPTH - eta) * step;
+    }
+
+    CircularChannel channel{DIAMETER, DEPTH};
+    EXPECT_NEAR(moment, channel.calculate_first_moment_of_area(), 1e-6);
+}
+
+TEST(CircularChannelGeometry, GivenDepthAboveCrown_WhenCalculatingProperties_ExpectFullPipe)
+{
+    CircularChannel channel{DIAMETER, 2.0 * DIAMETER};
+
+    EXPECT_DOUBLE_EQ(0.25 * PI * DIAMETER * DIAMETER, channel.calculate_area());
+    EXPECT_DOUBLE_EQ(PI * DIAMETER, channel.calculate_wetted_perimeter());
+    EXPECT_DOUBLE_EQ(0.0, channel.calculate_top_width());
+    EXPECT_DOUBLE_EQ(DIAMETER, channel.get_full_flow_depth());
+    EXPECT_TRUE(channel.is_valid());
+}
+
+TEST(CircularChannelGeometry, GivenInvalidDimensions_WhenCreatingChannel_ExpectInvalidConfiguration)
+{
+    EXPECT_FALSE((CircularChannel{0.0, 1.0}.is_valid()));
+    EXPECT_FALSE((CircularChannel{1.0, 0.0}.is_valid()));
+    EXPECT_DOUBLE_EQ(0.0, (CircularChannel{-1.0, 0.5}.calculate_area()));
+}
+
+// ============================================================================
+// CONVEYANCE MAXIMUM
+// ============================================================================
+
+TEST(CircularChannelConveyance, GivenCircularPipe_WhenFindingConveyanceMaximum_ExpectKnownRatioAndExcessOverFull)
+{
+    CircularChannel channel{DIAMETER, 0.0};
+
+    double ratio = CircularChannel::get_max_conveyance_depth_ratio();
+    double maxDischarge = calculate_pipe_discharge(channel, ratio * DIAMETER);
+    double fullDischarge = calculate_pipe_discharge(channel, DIAMETER);
+
+    EXPECT_NEAR(0.9382, ratio, 1e-4);
+    EXPECT_NEAR(1.0757, maxDischarge / fullDischarge, 1e-3);
+    EXPECT_GT(maxDischarge, calculate_pipe_discharge(channel, (ratio - 0.01) * DIAMETER));
+    EXPECT_GT(maxDischarge, calculate_pipe_discharge(channel, (ratio + 0.01) * DIAMETER));
+}
+
+TEST(CircularChannelConveyance, GivenDischargeAboveFullFlow_WhenSolvingNormalDepth_ExpectLowerRoot)
+{
+    CircularChannel channel{DIAMETER, 0.0};
+    double fullDischarge = calculate_pipe_discharge(channel, DIAMETER);
+    double maxConveyanceDepth = channel.get_max_conveyance_depth();
+
+    Analyzer analyzer;
+    AnalysisResult result = analyzer.solve_for_depth(channel, Flow{1.03 * fullDischarge, 0.013}, 0.002,
+                                                     UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                     UnitSystemConstants::GRAVITY_SI);
+
+    ASSERT_TRUE(result.isValid);
+    EXPECT_LT(result.normalDepth, maxConveyanceDepth);
+    EXPECT_NEAR(1.03 * fullDischarge, calculate_pipe_discharge(channel, result.normalDepth), 1e-8 * fullDischarge);
+}
+
+TEST(CircularChannelConveyance, GivenDischargeAboveMaximum_WhenSolvingNormalDepth_ExpectInvalidResult)
+{
+    CircularChannel channel{DIAMETER, 0.0};
+    double fullDischarge = calculate_pipe_discharge(channel, DIAMETER);
+
+    Analyzer analyzer;
+    AnalysisResult result = analyzer.solve_for_depth(channel, Flow{1.1 * fullDischarge, 0.013}, 0.002,
+                                                     UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                     UnitSystemConstants::GRAVITY_SI);
+
+    EXPECT_FALSE(result.isValid);
+}
+
+TEST(CircularChannelConveyance, GivenPartFullDischarge_WhenSolvingNormalDepth_ExpectManningsEquationSatisfied)
+{
+    CircularChannel channel{DIAMETER, 0.0};
+    Analyzer analyzer;
+
+    for (double discharge : {0.01, 0.3, 1.5, 3.0})
+    {
+        AnalysisResult result = analyzer.solve_for_depth(channel, Flow{discharge, 0.013}, 0.002,
+                                                         UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                         UnitSystemConstants::GRAVITY_SI);
+
+        ASSERT_TRUE(result.isValid) << discharge;
+        EXPECT_NEAR(discharge, calculate_pipe_discharge(channel, result.normalDepth), 1e-8 * discharge);
+    }
+}
+
+// ============================================================================
+// CRITICAL DEPTH
+// ============================================================================
+
+TEST(CircularChannelCritical, GivenLargeDischarge_WhenSolvingCriticalDepth_ExpectDepthBelowCrown)
+{
+    CircularChannel channel{DIAMETER, 0.0};
+    CriticalFlowAnalyzer analyzer;
+
+    for (double discharge : {0.5, 5.0, 20.0})
+    {
+        CriticalFlowResult result = analyzer.solve_critical_depth(channel, discharge, UnitSystemConstants::GRAVITY_SI);
+
+        ASSERT_TRUE(result.isValid) << discharge;
+        EXPECT_LT(result.criticalDepth, DIAMETER);
+
+        channel.set_depth(result.criticalDepth);
+        double area = channel.calculate_area();
+        double froudeSquared = discharge * discharge * channel.calculate_top_width()
+                               / (UnitSystemConstants::GRAVITY_SI * area * area * area);
+        EXPECT_NEAR(1.0, froudeSquared, 1e-8);
+    }
+}
@@ -0,0 +1,227 @@
+#include <gtest/gtest.h>
+#include "Analyzer.h"
+#include "BatchAnalyzer.h"
+#include "CompositeRoughness.h"
+#include "UnitSystemConstants.h"
+#include <cmath>
+#include <vector>
+
+namespace
+{
+constexpr double BED_N{0.013};
+constexpr double BANK_N{0.035};
+constexpr double SLOPE{0.001};
+
+constexpr CompositeRoughnessMethod METHODS[]{CompositeRoughnessMethod::HortonEinstein,
+                                             CompositeRoughnessMethod::Lotter,
+                                             CompositeRoughnessMethod::Pavlovskii};
+
+double calculate_composite_discharge(const SectionProperties& properties, double manningN)
+{
+    double hydraulicRadius = properties.area / properties.wettedPerimeter;
+    return UnitSystemConstants::get_mannings_coefficient(false) / manningN * properties.area
+           * std::pow(hydraulicRadius, 2.0 / 3.0) * std::sqrt(SLOPE);
+}
+}
+
+// ============================================================================
+// EQUIVALENT ROUGHNESS
+// ============================================================================
+
+TEST(CompositeRoughnessEvaluation, GivenEqualSegmentRoughness_WhenEvaluating_ExpectUniformN)
+{
+    TrapezoidalSection section{4.0, 2.0};
+
+    for (CompositeRoughnessMethod method : METHODS)
+    {
+        CompositeRoughness roughness{method, 0.02, 0.02, 0.02};
+
+        CompositeRoughnessProperties properties = roughness.evaluate(1.5, section.evaluate(1.5));
+
+        EXPECT_NEAR(0.02, properties.manningN, 1e-15) << get_composite_roughness_method_name(method);
+        EXPECT_NEAR(0.0, properties.manningNDerivative, 1e-15) << get_composite_roughness_method_name(method);
+    }
+}
+
+TEST(CompositeRoughnessEvaluation, GivenConcreteBedAndRiprapBanks_WhenEvaluating_ExpectHandCalculatedN)
+{
+    // y = 1.5 on b = 4, z = 2: 4 m of bed and 3 sqrt(5) m of banks.
+    TrapezoidalSection section{4.0, 2.0};
+    SectionProperties properties = section.evaluate(1.5);
+    double bedLength{4.0};
+    double bankLength{3.0 * std::sqrt(5.0)};
+    double perimeter{bedLength + bankLength};
+
+    double horton = std::pow((bedLength * std::pow(BED_N, 1.5) + bankLength * std::pow(BANK_N, 1.5)) / perimeter, 2.0 / 3.0);
+    double lotter = perimeter / (bedLength / BED_N + bankLength / BANK_N);
+    double pavlovskii = std::sqrt((bedLength * BED_N * BED_N + bankLength * BANK_N * BANK_N) / perimeter);
+
+    EXPECT_NEAR(horton, CompositeRoughness(CompositeRoughnessMethod::HortonEinstein, BED_N, BANK_N, BANK_N).evaluate(1.5, properties).manningN, 1e-14);
+    EXPECT_NEAR(lotter, CompositeRoughness(CompositeRoughnessMethod::Lotter, BED_N, BANK_N, BANK_N).evaluate(1.5, properties).manningN, 1e-14);
+    EXPECT_NEAR(pavlovskii, CompositeRoughness(CompositeRoughnessMethod::Pavlovskii, BED_N, BANK_N, BANK_N).evaluate(1.5, properties).manningN, 1e-14);
+
+    // Lotter weights the smooth bed most, Pavlovskii the rough banks.
+    EXPECT_LT(lotter, horton);
+    EXPECT_LT(horton, pavlovskii);
+}
+
+TEST(CompositeRoughnessEvaluation, GivenUnequalBanks_WhenEvaluating_ExpectBanksAveraged)
+{
+    TrapezoidalSection section{4.0, 2.0};
+    SectionProperties properties = section.evaluate(1.0);
+    double bankLength{std::sqrt(5.0)};
+
+    CompositeRoughness roughness{CompositeRoughnessMethod::Pavlovskii, BED_N, 0.025, 0.045};
+    double expected = std::sqrt((4.0 * BED_N * BED_N + bankLength * (0.025 * 0.025 + 0.045 * 0.045)) / properties.wettedPerimeter);
+
+    EXPECT_NEAR(expected, roughness.evaluate(1.0, properties).manningN, 1e-14);
+}
+
+TEST(CompositeRoughnessEvaluation, GivenEachMethodAndShape_WhenEvaluatingDerivative_ExpectFiniteDifference)
+{
+    const double step{1e-6};
+    ChannelSection sections[]{RectangularSection{3.0}, TrapezoidalSection{4.0, 2.0}, TriangularSection{1.5}};
+
+    for (const ChannelSection& section : sections)
+    {
+        for (CompositeRoughnessMethod method : METHODS)
+        {
+            CompositeRoughness roughness{method, BED_N, BANK_N, 0.025};
+
+            std::visit([&](const auto& concreteSection)
+                       {
+                           double depth{1.2};
+                           double upper = roughness.evaluate(depth + step, concreteSection.evaluate(depth + step)).manningN;
+                           double lower = roughness.evaluate(depth - step, concreteSection.evaluate(depth - step)).manningN;
+                           double derivative = roughness.evaluate(depth, concreteSection.evaluate(depth)).manningNDerivative;
+
+                           EXPECT_NEAR((upper - lower) / (2.0 * step), derivative, 1e-8)
+                               << get_composite_roughness_method_name(method);
+                       },
+                       section);
+        }
+    }
+}
+
+TEST(CompositeRoughnessEvaluation, GivenTriangularSection_WhenEvaluating_ExpectBankNOnly)
+{
+    TriangularSection section{1.5};
+
+    for (CompositeRoughnessMethod method : METHODS)
+    {
+        CompositeRoughness roughness{method, BED_N, BANK_N, BANK_N};
+        EXPECT_NEAR(BANK_N, roughness.evaluate(0.8, section.evaluate(0.8)).manningN, 1e-15);
+    }
+}
+
+TEST(CompositeRoughnessEvaluation, GivenNonPositiveSegmentN_WhenChecking_ExpectInvalid)
+{
+    EXPECT_TRUE(CompositeRoughness(CompositeRoughnessMethod::HortonEinstein, BED_N, BANK_N, BANK_N).is_valid());
+    EXPECT_FALSE(CompositeRoughness(CompositeRoughnessMethod::HortonEinstein, 0.0, BANK_N, BANK_N).is_valid());
+    EXPECT_FALSE(CompositeRoughness(CompositeRoughnessMethod::Lotter, BED_N, -0.01, BANK_N).is_valid());
+}
+
+// ============================================================================
+// NORMAL DEPTH
+// ============================================================================
+
+TEST(CompositeRoughnessSolving, GivenEachMethod_WhenSolving_ExpectManningWithEquivalentN)
+{
+    Analyzer analyzer;
+    TrapezoidalSection section{4.0, 2.0};
+    double discharge{12.0};
+
+    for (CompositeRoughnessMethod method : METHODS)
+    {
+        CompositeRoughness roughness{method, BED_N, BANK_N, BANK_N};
+
+        AnalysisResult result = analyzer.solve_section(section, roughness, discharge, SLOPE,
+                                                       UnitSystemConstants::get_mannings_coefficient(false),
+                                                       UnitSystemConstants::get_gravity(false));
+
+        ASSERT_TRUE(result.isValid) << get_composite_roughness_method_name(method);
+        SectionProperties properties = section.evaluate(result.normalDepth);
+        double manningN = roughness.evaluate(result.normalDepth, properties).manningN;
+
+        EXPECT_NEAR(discharge, calculate_composite_discharge(properties, manningN), 1e-6 * discharge);
+        EXPECT_NEAR(discharge / properties.area, result.velocity, 1e-12);
+        EXPECT_FALSE(result.sensitivities.isValid);
+    }
+}
+
+TEST(CompositeRoughnessSolving, GivenEqualSegmentRoughness_WhenSolving_ExpectUniformDepth)
+{
+    Analyzer analyzer;
+    TrapezoidalSection section{4.0, 2.0};
+    double manningsCoefficient = UnitSystemConstants::get_mannings_coefficient(false);
+    double gravity = UnitSystemConstants::get_gravity(false);
+
+    AnalysisResult uniform = analyzer.solve_section(section, Flow{12.0, 0.02}, SLOPE, manningsCoefficient, gravity);
+    AnalysisResult composite = analyzer.solve_section(section, CompositeRoughness{CompositeRoughnessMethod::Lotter, 0.02, 0.02, 0.02},
+                                                      12.0, SLOPE, manningsCoefficient, gravity);
+
+    ASSERT_TRUE(uniform.isValid && composite.isValid);
+    EXPECT_NEAR(uniform.normalDepth, composite.normalDepth, 1e-9);
+}
+
+TEST(CompositeRoughnessSolving, GivenInvalidRoughness_WhenSolving_ExpectInvalidResult)
+{
+    Analyzer analyzer;
+
+    AnalysisResult result = analyzer.solve_section(ChannelSection{RectangularSection{3.0}},
+                                                   CompositeRoughness{CompositeRoughnessMethod::HortonEinstein, BED_N, 0.0, BANK_N},
+                                                   5.0, SLOPE, 1.0, 9.81);
+
+    EXPECT_FALSE(result.isValid);
+}
+
+// ============================================================================
+// BATCH AGREEMENT
+// ============================================================================
+
+TEST(CompositeRoughnessBatch, GivenEachMethodAndShape_WhenSolvingBatch_ExpectScalarDepths)
+{
+    BatchAnalyzer batchAnalyzer{false};
+    Analyzer analyzer;
+    double manningsCoefficient = UnitSystemConstants::get_mannings_coefficient(false);
+    double gravity = UnitSystemConstants::get_gravity(false);
+
+    // Rectangular, trapezoidal, triangular, and one lane with equal n.
+    std::vector<double> bottomWidth{3.0, 4.0, 0.0, 4.0};
+    std::vector<double> sideSlope{0.0, 2.0, 1.5, 2.0};
+    std::vector<double> discharge{6.0, 12.0, 1.5, 12.0};
+    std::vector<double> manningN{BED_N, BED_N, BED_N, 0.02};
+    std::vector<double> bankManningN{BANK_N, BANK_N, BANK_N, 0.02};
+    std::vector<double> bedSlope(4, SLOPE);
+    std::size_t count = discharge.size();
+
+    for (CompositeRoughnessMethod method : METHODS)
+    {
+        std::vector<double> normalDepth(count, -1.0);
+        std::vector<double> velocity(count);
+        std::vector<double> froudeNumber(count);
+        std::vector<FlowRegime> flowRegime(count);
+        std::vector<BatchStatus> status(count, BatchStatus::NotConverged);
+
+        BatchInputs inputs{bottomWidth.data(), sideSlope.data(), discharge.data(), manningN.data(), bedSlope.data(), count};
+        inputs.bankManningN = bankManningN.data();
+        inputs.roughnessMethod = method;
+        batchAnalyzer.solve_for_depth(inputs, BatchOutputs{normalDepth.data(), velocity.data(), froudeNumber.data(),
+                                                           flowRegime.data(), status.data()});
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            ChannelSection section = sideSlope[i] == 0.0 ? ChannelSection{RectangularSection{bottomWidth[i]}}
+                                     : bottomWidth[i] == 0.0 ? ChannelSection{TriangularSection{sideSlope[i]}}
+                                                             : ChannelSection{TrapezoidalSection{bottomWidth[i], sideSlope[i]}};
+            AnalysisResult expected = analyzer.solve_section(section, CompositeRoughness{method, manningN[i], bankManningN[i], bankManningN[i]},
+                                                             discharge[i], SLOPE, manningsCoefficient, gravity);
+
+            ASSERT_TRUE(expected.isValid);
+            ASSERT_EQ(BatchStatus::Converged, status[i]) << get_composite_roughness_method_name(method) << " lane " << i;
+            EXPECT_NEAR(expected.normalDepth, normalDepth[i], 1e-9 * expected.normalDepth);
+            EXPECT_NEAR(expected.velocity, velocity[i], 1e-8 * expected.velocity);
+            EXPECT_NEAR(expected.froudeNumber, froudeNumber[i], 1e-8 * expected.froudeNumber);
+        }
+    }
+}
@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include "Analyzer.h"
+#include "CompoundSection.h"
+#include "UnitSystemConstants.h"
+#include <cmath>
+
+namespace
+{
+constexpr double SLOPE{0.001};
+
+// b = 10, z = 2, bank height 2, with unequal floodplains.
+CompoundSection make_section()
+{
+    return CompoundSection{10.0, 2.0, 2.0, 0.03, Floodplain{50.0, 3.0, 0.06}, Floodplain{30.0, 2.0, 0.08}};
+}
+
+double calculate_conveyance(double area, double wettedPerimeter, double manningN)
+{
+    return area * std::pow(area / wettedPerimeter, 2.0 / 3.0) / manningN;
+}
+}
+
+// ============================================================================
+// GEOMETRY
+// ============================================================================
+
+TEST(CompoundSectionGeometry, GivenDepthBelowBank_WhenEvaluating_ExpectMainChannelOnly)
+{
+    CompoundSection section = make_section();
+    SectionProperties trapezoid = TrapezoidalSection{10.0, 2.0}.evaluate(1.5);
+
+    CompoundSectionProperties properties = section.evaluate(1.5);
+
+    EXPECT_DOUBLE_EQ(trapezoid.area, properties.area);
+    EXPECT_DOUBLE_EQ(trapezoid.topWidth, properties.topWidth);
+    EXPECT_NEAR(calculate_conveyance(trapezoid.area, trapezoid.wettedPerimeter, 0.03), properties.conveyance, 1e-9);
+    EXPECT_DOUBLE_EQ(0.0, properties.conveyances[CompoundSubsection::LEFT_OVERBANK]);
+    EXPECT_DOUBLE_EQ(0.0, properties.conveyances[CompoundSubsection::RIGHT_OVERBANK]);
+    EXPECT_DOUBLE_EQ(1.0, properties.velocityCoefficient);
+}
+
+TEST(CompoundSectionGeometry, GivenDepthAboveBank_WhenEvaluating_ExpectDividedSubsections)
+{
+    CompoundSection section = make_section();
+
+    CompoundSectionProperties properties = section.evaluate(3.0);
+
+    // Main: bankfull trapezoid 28 m^2 plus an 18 m wide strip; the division
+    // lines add no perimeter.
+    const SectionProperties& main = properties.subsections[CompoundSubsection::MAIN_CHANNEL];
+    EXPECT_DOUBLE_EQ(46.0, main.area);
+    EXPECT_NEAR(10.0 + 4.0 * std::sqrt(5.0), main.wettedPerimeter, 1e-12);
+    EXPECT_DOUBLE_EQ(18.0, main.topWidth);
+    EXPECT_DOUBLE_EQ(0.0, main.wettedPerimeterDerivative);
+
+    const SectionProperties& left = properties.subsections[CompoundSubsection::LEFT_OVERBANK];
+    EXPECT_DOUBLE_EQ(51.5, left.area);
+    EXPECT_NEAR(50.0 + std::sqrt(10.0), left.wettedPerimeter, 1e-12);
+    EXPECT_DOUBLE_EQ(53.0, left.topWidth);
+
+    const SectionProperties& right = properties.subsections[CompoundSubsection::RIGHT_OVERBANK];
+    EXPECT_DOUBLE_EQ(31.0, right.area);
+    EXPECT_NEAR(30.0 + std::sqrt(5.0), right.wettedPerimeter, 1e-12);
+
+    double mainConveyance = calculate_conveyance(main.area, main.wettedPerimeter, 0.03);
+    double leftConveyance = calculate_conveyance(left.area, left.wettedPerimeter, 0.06);
+    double rightConveyance = calculate_conveyance(right.area, right.wettedPerimeter, 0.08);
+    double conveyance = mainConveyance + leftConveyance + rightConveyance;
+    double area = main.area + left.area + right.area;
+
+    EXPECT_NEAR(conveyance, properties.conveyance, 1e-9 * conveyance);
+    EXPECT_DOUBLE_EQ(area, properties.area);
+    EXPECT_DOUBLE_EQ(18.0 + 53.0 + 32.0, properties.topWidth);
+
+    double alpha = (mainConveyance * mainConveyance * mainConveyance / (main.area * main.area)
+                    + leftConveyance * leftConveyance * leftConveyance / (left.area * left.area)
+                    + rightConveyance * rightConveyance * rightConveyance / (right.area * right.area))
+                   * area * area / (conveyance * conveyance * conveyance);
+    EXPECT_NEAR(alpha, properties.velocityCoefficient, 1e-12);
+    EXPECT_GT(properties.velocityCoefficient, 1.0);
+}
+
+TEST(CompoundSectionGeometry, GivenDepthsAroundBank_WhenEvaluating_ExpectContinuousConveyance)
+{
+    CompoundSection section = make_section();
+
+    double below = section.evaluate(2.0 - 1e-9).conveyance;
+    double above = section.evaluate(2.0 + 1e-9).conveyance;
+
+    EXPECT_NEAR(below, above, 1e-6 * below);
+}
+
+TEST(CompoundSectionGeometry, GivenDepths_WhenEvaluating_ExpectConveyanceDerivativeMatchesFiniteDifference)
+{
+    CompoundSection section = make_section();
+    constexpr double STEP{1e-6};
+
+    for (double depth : {0.5, 1.9, 2.3, 4.0})
+    {
+        double difference = (section.evaluate(depth + STEP).conveyance - section.evaluate(depth - STEP).conveyance)
+                            / (2.0 * STEP);
+        double derivative = section.evaluate(depth).conveyanceDerivative;
+
+        EXPECT_NEAR(difference, derivative, 1e-6 * std::abs(difference)) << depth;
+    }
+}
+
+TEST(CompoundSectionGeometry, GivenInvalidParameters_WhenCreatingSection_ExpectInvalid)
+{
+    EXPECT_TRUE(make_section().is_valid());
+    EXPECT_TRUE((CompoundSection{10.0, 2.0, 2.0, 0.03, Floodplain{}, Floodplain{}}.is_valid()));
+
+    EXPECT_FALSE((CompoundSection{0.0, 0.0, 2.0, 0.03, Floodplain{}, Floodplain{}}.is_valid()));
+    EXPECT_FALSE((CompoundSection{10.0, 2.0, 0.0, 0.03, Floodplain{}, Floodplain{}}.is_valid()));
+    EXPECT_FALSE((CompoundSection{10.0, 2.0, 2.0, 0.0, Floodplain{}, Floodplain{}}.is_valid()));
+    EXPECT_FALSE((CompoundSection{10.0, 2.0, 2.0, 0.03, Floodplain{50.0, 3.0, 0.0}, Floodplain{}}.is_valid()));
+    EXPECT_FALSE((CompoundSection{10.0, 2.0, 2.0, 0.03, Floodplain{}, Floodplain{-1.0, 0.0, 0.05}}.is_valid()));
+}
+
+// ============================================================================
+// NORMAL DEPTH
+// ============================================================================
+
+TEST(CompoundSectionSolve, GivenInBankDischarge_WhenSolving_ExpectTrapezoidalDepth)
+{
+    CompoundSection section = make_section();
+    Analyzer analyzer;
+
+    AnalysisResult compound = analyzer.solve_compound(section, 20.0, SLOPE, UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                      UnitSystemConstants::GRAVITY_SI);
+    AnalysisResult trapezoid = analyzer.solve_section(TrapezoidalSection{10.0, 2.0}, Flow{20.0, 0.03}, SLOPE,
+                                                      UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                      UnitSystemConstants::GRAVITY_SI);
+
+    ASSERT_TRUE(compound.isValid);
+    EXPECT_LT(compound.normalDepth, 2.0);
+    EXPECT_NEAR(trapezoid.normalDepth, compound.normalDepth, 1e-9);
+    EXPECT_NEAR(trapezoid.froudeNumber, compound.froudeNumber, 1e-9);
+    EXPECT_DOUBLE_EQ(1.0, compound.velocityCoefficient);
+}
+
+TEST(CompoundSectionSolve, GivenOverbankDischarge_WhenSolving_ExpectSummedConveyanceCarriesFlow)
+{
+    CompoundSection section = make_section();
+    Analyzer analyzer;
+    constexpr double DISCHARGE{250.0};
+
+    AnalysisResult result = analyzer.solve_compound(section, DISCHARGE, SLOPE, UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                    UnitSystemConstants::GRAVITY_SI);
+
+    ASSERT_TRUE(result.isValid);
+    EXPECT_GT(result.normalDepth, 2.0);
+
+    CompoundSectionProperties properties = section.evaluate(result.normalDepth);
+    EXPECT_NEAR(DISCHARGE, UnitSystemConstants::MANNINGS_COEFFICIENT_SI * std::sqrt(SLOPE) * properties.conveyance,
+                1e-8 * DISCHARGE);
+    EXPECT_NEAR(DISCHARGE / properties.area, result.velocity, 1e-12);
+    EXPECT_DOUBLE_EQ(properties.velocityCoefficient, result.velocityCoefficient);
+    EXPECT_GT(result.velocityCoefficient, 1.0);
+
+    double plainFroude = result.velocity / std::sqrt(UnitSystemConstants::GRAVITY_SI * properties.area / properties.topWidth);
+    EXPECT_NEAR(plainFroude * std::sqrt(result.velocityCoefficient), result.froudeNumber, 1e-12);
+}
+
+TEST(CompoundSectionSolve, GivenBisectionSettings_WhenSolving_ExpectSameDepthAsNewton)
+{
+    CompoundSection section = make_section();
+    SolverSettings settings;
+    settings.method = SolverMethod::Bisection;
+    settings.dischargeTolerance = 1e-6;
+
+    AnalysisResult newton = Analyzer{}.solve_compound(section, 250.0, SLOPE, UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                      UnitSystemConstants::GRAVITY_SI);
+    AnalysisResult bisection = Analyzer{settings}.solve_compound(section, 250.0, SLOPE,
+                                                                 UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                                 UnitSystemConstants::GRAVITY_SI);
+
+    ASSERT_TRUE(bisection.isValid);
+    EXPECT_NEAR(newton.normalDepth, bisection.normalDepth, 1e-6);
+}
+
+TEST(CompoundSectionSolve, GivenInvalidInputs_WhenSolving_ExpectInvalidResult)
+{
+    Analyzer analyzer;
+    CompoundSection invalid{10.0, 2.0, 2.0, 0.0, Floodplain{}, Floodplain{}};
+
+    EXPECT_FALSE(analyzer.solve_compound(invalid, 20.0, SLOPE, UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                         UnitSystemConstants::GRAVITY_SI).isValid);
+    EXPECT_FALSE(analyzer.solve_compound(make_section(), 0.0, SLOPE, UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                         UnitSystemConstants::GRAVITY_SI).isValid);
+    EXPECT_FALSE(analyzer.solve_compound(make_section(), 20.0, 0.0, UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                         UnitSystemConstants::GRAVITY_SI).isValid);
+}
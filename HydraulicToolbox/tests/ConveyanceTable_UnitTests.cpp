@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include "ConveyanceTable.h"
+#include "Analyzer.h"
+#include "RectangularChannel.h"
+#include "TrapezoidalChannel.h"
+#include "TriangularChannel.h"
+#include "CircularChannel.h"
+#include "Flow.h"
+#include "UnitSystemConstants.h"
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// TABLE CONSTRUCTION TESTS
+// ============================================================================
+
+TEST(ConveyanceTableConstruction, GivenValidChannel_WhenBuildingTable_ExpectValidAdaptiveTable)
+{
+    TrapezoidalChannel channel{4.0, 2.0, 0.0};
+
+    ConveyanceTable table{channel};
+
+    EXPECT_TRUE(table.is_valid());
+    EXPECT_GT(table.size(), 17u);
+}
+
+TEST(ConveyanceTableConstruction, GivenZeroWidthChannel_WhenBuildingTable_ExpectInvalidTable)
+{
+    RectangularChannel channel{0.0, 0.0};
+
+    ConveyanceTable table{channel};
+
+    EXPECT_FALSE(table.is_valid());
+}
+
+TEST(ConveyanceTableConstruction, GivenSectionAndEquivalentChannel_WhenBuildingTables_ExpectSameTable)
+{
+    TrapezoidalChannel channel{4.0, 2.0, 0.0};
+
+    ConveyanceTable fromChannel{channel};
+    ConveyanceTable fromSection{TrapezoidalSection{4.0, 2.0}};
+
+    ASSERT_TRUE(fromSection.is_valid());
+    EXPECT_EQ(fromChannel.size(), fromSection.size());
+    EXPECT_DOUBLE_EQ(fromChannel.interpolate_depth(100.0), fromSection.interpolate_depth(100.0));
+}
+
+TEST(ConveyanceTableConstruction, GivenChannelWithoutValueSection_WhenBuildingTable_ExpectInvalidTable)
+{
+    CircularChannel channel{2.0, 0.0};
+
+    ConveyanceTable table{channel};
+
+    EXPECT_FALSE(table.is_valid());
+}
+
+// ============================================================================
+// LOOKUP TESTS
+// ============================================================================
+
+TEST(ConveyanceTableLookup, GivenRangeOfDischarges_WhenSolvingFromTable_ExpectAnalyzerDepths)
+{
+    TrapezoidalChannel channel{4.0, 2.0, 0.0};
+    ConveyanceTable table{channel};
+    Analyzer analyzer;
+
+    double manningsCoef{UnitSystemConstants::MANNINGS_COEFFICIENT_SI};
+    double gravity{UnitSystemConstants::GRAVITY_SI};
+
+    for (double discharge : {0.01, 0.5, 50.0, 2000.0, 1e5})
+    {
+        Flow flow{discharge, 0.013};
+
+        AnalysisResult fromTable = table.solve_for_depth(flow, 0.001, manningsCoef, gravity);
+        AnalysisResult fromSolver = analyzer.solve_section(channel.get_section(), flow, 0.001, manningsCoef, gravity);
+
+        ASSERT_TRUE(fromTable.isValid);
+        EXPECT_NEAR(1.0, fromTable.normalDepth / fromSolver.normalDepth, 1e-9);
+        EXPECT_LT(fromTable.residual, 1e-9);
+        EXPECT_NEAR(fromSolver.froudeNumber, fromTable.froudeNumber, 1e-6);
+    }
+}
+
+TEST(ConveyanceTableLookup, GivenKnownTriangularSolution_WhenSolvingFromTable_ExpectCorrectDepth)
+{
+    TriangularChannel channel{2.0, 0.0};
+    ConveyanceTable table{channel};
+
+    Flow flow{50.0, 0.013};
+    AnalysisResult result = table.solve_for_depth(flow, 0.001,
+                                                  UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                  UnitSystemConstants::GRAVITY_SI);
+
+    EXPECT_TRUE(result.isValid);
+    EXPECT_NEAR(2.930, result.normalDepth, 0.001);
+    EXPECT_EQ(1, result.iterations);
+}
+
+TEST(ConveyanceTableLookup, GivenIncreasingConveyance_WhenInterpolatingDepth_ExpectMonotoneDepths)
+{
+    RectangularChannel channel{10.0, 0.0};
+    ConveyanceTable table{channel};
+
+    double previousDepth{0.0};
+
+    for (double conveyance = 0.01; conveyance < 1e4; conveyance *= 1.37)
+    {
+        double depth = table.interpolate_depth(conveyance);
+        EXPECT_GT(depth, previousDepth);
+        previousDepth = depth;
+    }
+}
+
+TEST(ConveyanceTableLookup, GivenDischargeBeyondTableRange_WhenSolvingFromTable_ExpectInvalidResult)
+{
+    RectangularChannel channel{0.01, 0.0};
+    ConveyanceTable table{channel};
+
+    Flow flow{10000.0, 0.5};
+    AnalysisResult result = table.solve_for_depth(flow, 0.00001,
+                                                  UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                  UnitSystemConstants::GRAVITY_SI);
+
+    EXPECT_FALSE(result.isValid);
+}
+
+TEST(ConveyanceTableLookup, GivenChannelAtDepth_WhenBuildingAndSolving_ExpectChannelLeftUnchanged)
+{
+    TrapezoidalChannel channel{4.0, 2.0, 1.5};
+    double area{channel.calculate_area()};
+
+    ConveyanceTable table{channel};
+    table.solve_for_depth(Flow{50.0, 0.013}, 0.001,
+                          UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                          UnitSystemConstants::GRAVITY_SI);
+
+    EXPECT_DOUBLE_EQ(area, channel.calculate_area());
+}
+
+TEST(ConveyanceTableLookup, GivenConcurrentQueries_WhenSolvingFromTable_ExpectSerialResults)
+{
+    const ConveyanceTable table{TrapezoidalSection{4.0, 2.0}};
+    std::vector<double> discharges{0.5, 5.0, 50.0, 500.0};
+    std::vector<double> serial;
+
+    for (double discharge : discharges)
+    {
+        serial.push_back(table.solve_for_depth(Flow{discharge, 0.013}, 0.001,
+                                               UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                               UnitSystemConstants::GRAVITY_SI).normalDepth);
+    }
+
+    std::vector<int> mismatches(discharges.size(), 0);
+    std::vector<std::thread> threads;
+
+    for (std::size_t t = 0; t < discharges.size(); ++t)
+    {
+        threads.emplace_back([&, t]
+        {
+            for (int repeat = 0; repeat < 1000; ++repeat)
+            {
+                std::size_t i = (t + static_cast<std::size_t>(repeat)) % discharges.size();
+                AnalysisResult result = table.solve_for_depth(Flow{discharges[i], 0.013}, 0.001,
+                                                              UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                              UnitSystemConstants::GRAVITY_SI);
+                mismatches[t] += result.normalDepth != serial[i];
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    for (int count : mismatches)
+        EXPECT_EQ(0, count);
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "CriticalFlowAnalyzer.h"
+#include "Analyzer.h"
+#include "RectangularChannel.h"
+#include "TrapezoidalChannel.h"
+#include "TriangularChannel.h"
+#include "Flow.h"
+#include "UnitSystemConstants.h"
+#include <cmath>
+#include <vector>
+
+// ============================================================================
+// CRITICAL DEPTH TESTS
+// ============================================================================
+
+TEST(CriticalFlowAnalyzerSolving, GivenRectangularSection_WhenSolvingCriticalDepth_ExpectClosedForm)
+{
+    RectangularSection section{4.0};
+    double gravity{UnitSystemConstants::GRAVITY_SI};
+
+    CriticalFlowAnalyzer analyzer;
+    CriticalFlowResult result = analyzer.solve_section(section, 20.0, gravity);
+
+    EXPECT_TRUE(result.isValid);
+    EXPECT_EQ(0, result.iterations);
+    EXPECT_NEAR(std::cbrt(25.0 / gravity), result.criticalDepth, 1e-12);
+    EXPECT_NEAR(1.5 * result.criticalDepth, result.minimumSpecificEnergy, 1e-12);
+}
+
+TEST(CriticalFlowAnalyzerSolving, GivenTriangularSection_WhenSolvingCriticalDepth_ExpectClosedForm)
+{
+    TriangularSection section{2.0};
+    double gravity{UnitSystemConstants::GRAVITY_SI};
+
+    CriticalFlowAnalyzer analyzer;
+    CriticalFlowResult result = analyzer.solve_section(section, 10.0, gravity);
+
+    EXPECT_TRUE(result.isValid);
+    EXPECT_NEAR(std::pow(2.0 * 100.0 / (gravity * 4.0), 0.2), result.criticalDepth, 1e-12);
+    EXPECT_NEAR(1.25 * result.criticalDepth, result.minimumSpecificEnergy, 1e-12);
+}
+
+TEST(CriticalFlowAnalyzerSolving, GivenTrapezoidalSection_WhenSolvingCriticalDepth_ExpectFroudeNumberOfOne)
+{
+    TrapezoidalSection section{4.0, 2.0};
+    double discharge{50.0};
+    double gravity{UnitSystemConstants::GRAVITY_SI};
+
+    CriticalFlowAnalyzer analyzer;
+    CriticalFlowResult result = analyzer.solve_section(section, discharge, gravity);
+
+    double area = section.calculate_area(result.criticalDepth);
+    double topWidth = section.calculate_top_width(result.criticalDepth);
+
+    EXPECT_TRUE(result.isValid);
+    EXPECT_GT(result.iterations, 0);
+    EXPECT_NEAR(1.0, discharge * discharge * topWidth / (gravity * area * area * area), 1e-9);
+}
+
+TEST(CriticalFlowAnalyzerSolving, GivenEachChannelType_WhenSolvingThroughChannel_ExpectSameDepthAsSection)
+{
+    double gravity{UnitSystemConstants::GRAVITY_SI};
+
+    RectangularChannel rectangular{4.0, 0.0};
+    TrapezoidalChannel trapezoidal{4.0, 2.0, 0.0};
+    TriangularChannel triangular{2.0, 0.0};
+
+    CriticalFlowAnalyzer analyzer;
+
+    EXPECT_NEAR(analyzer.solve_section(rectangular.get_section(), 20.0, gravity).criticalDepth,
+                analyzer.solve_critical_depth(rectangular, 20.0, gravity).criticalDepth, 1e-9);
+    EXPECT_NEAR(analyzer.solve_section(trapezoidal.get_section(), 20.0, gravity).criticalDepth,
+                analyzer.solve_critical_depth(trapezoidal, 20.0, gravity).criticalDepth, 1e-9);
+    EXPECT_NEAR(analyzer.solve_section(triangular.get_section(), 20.0, gravity).criticalDepth,
+                analyzer.solve_critical_depth(triangular, 20.0, gravity).criticalDepth, 1e-9);
+}
+
+TEST(CriticalFlowAnalyzerSolving, GivenNormalDepthAboveCritical_WhenComparing_ExpectSubcriticalRegime)
+{
+    TrapezoidalSection section{4.0, 2.0};
+    Flow flow{50.0, 0.013};
+    double gravity{UnitSystemConstants::GRAVITY_SI};
+
+    Analyzer normalAnalyzer;
+    AnalysisResult normalResult = normalAnalyzer.solve_section(section, flow, 0.001,
+                                                               UnitSystemConstants::MANNINGS_COEFFICIENT_SI, gravity);
+    CriticalFlowAnalyzer criticalAnalyzer;
+    CriticalFlowResult criticalResult = criticalAnalyzer.solve_section(section, flow.get_discharge(), gravity);
+
+    EXPECT_EQ(FlowRegime::Subcritical, normalResult.flowRegime);
+    EXPECT_GT(normalResult.normalDepth, criticalResult.criticalDepth);
+}
+
+TEST(CriticalFlowAnalyzerSolving, GivenInvalidInputs_WhenSolvingCriticalDepth_ExpectInvalidResult)
+{
+    CriticalFlowAnalyzer analyzer;
+
+    EXPECT_FALSE(analyzer.solve_section(RectangularSection{0.0}, 10.0, 9.81).isValid);
+    EXPECT_FALSE(analyzer.solve_section(TrapezoidalSection{4.0, 2.0}, 0.0, 9.81).isValid);
+}
+
+// ============================================================================
+// SPECIFIC ENERGY AND FORCE TESTS
+// ============================================================================
+
+TEST(CriticalFlowAnalyzerCurves, GivenDepthGrid_WhenEvaluatingCurves_ExpectMinimaAtCriticalDepth)
+{
+    TrapezoidalSection section{4.0, 2.0};
+    double discharge{50.0};
+    double gravity{UnitSystemConstants::GRAVITY_SI};
+
+    CriticalFlowAnalyzer analyzer;
+    CriticalFlowResult critical = analyzer.solve_section(section, discharge, gravity);
+
+    std::vector<double> depths;
+    for (int i = 1; i <= 400; ++i)
+        depths.push_back(0.01 * i);
+
+    std::vector<double> specificEnergy(depths.size());
+    std::vector<double> specificForce(depths.size());
+    analyzer.evaluate_curves(section, discharge, gravity, depths.data(),
+                             specificEnergy.data(), specificForce.data(), depths.size());
+
+    for (std::size_t i = 0; i < depths.size(); ++i)
+    {
+        EXPECT_GE(specificEnergy[i], critical.minimumSpecificEnergy - 1e-12);
+        EXPECT_GE(specificForce[i], critical.minimumSpecificForce - 1e-12);
+    }
+}
+
+TEST(CriticalFlowAnalyzerCurves, GivenChannelAndSection_WhenEvaluatingAtSameDepth_ExpectSameValues)
+{
+    RectangularChannel channel{5.0, 0.0};
+    RectangularSection section{5.0};
+    double depth{1.5};
+    double gravity{UnitSystemConstants::GRAVITY_SI};
+
+    CriticalFlowAnalyzer analyzer;
+
+    double specificEnergy{0.0};
+    double specificForce{0.0};
+    analyzer.evaluate_curves(section, 12.0, gravity, &depth, &specificEnergy, &specificForce, 1);
+
+    // M = Q^2 / (g b y) + b y^2 / 2 for a rectangle.
+    EXPECT_DOUBLE_EQ(specificEnergy, analyzer.calculate_specific_energy(channel, depth, 12.0, gravity));
+    EXPECT_DOUBLE_EQ(specificForce, analyzer.calculate_specific_force(channel, depth, 12.0, gravity));
+    EXPECT_NEAR(144.0 / (gravity * 7.5) + 5.625, specificForce, 1e-12);
+}
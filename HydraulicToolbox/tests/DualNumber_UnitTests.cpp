@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "DualNumber.h"
+#include "ChannelGeometry.h"
+#include <cmath>
+
+using Dual2 = DualNumber<2>;
+
+// ============================================================================
+// ARITHMETIC
+// ============================================================================
+
+TEST(DualNumberArithmetic, GivenTwoVariables_WhenMultiplyingAndDividing_ExpectProductAndQuotientRules)
+{
+    Dual2 x = Dual2::variable(3.0, 0);
+    Dual2 y = Dual2::variable(2.0, 1);
+
+    Dual2 product = x * y;
+    EXPECT_DOUBLE_EQ(6.0, product.value);
+    EXPECT_DOUBLE_EQ(2.0, product.gradient[0]);
+    EXPECT_DOUBLE_EQ(3.0, product.gradient[1]);
+
+    Dual2 quotient = x / y;
+    EXPECT_DOUBLE_EQ(1.5, quotient.value);
+    EXPECT_DOUBLE_EQ(0.5, quotient.gradient[0]);
+    EXPECT_DOUBLE_EQ(-0.75, quotient.gradient[1]);
+}
+
+TEST(DualNumberArithmetic, GivenConstantsOnEitherSide_WhenCombining_ExpectConstantsHaveNoGradient)
+{
+    Dual2 x = Dual2::variable(4.0, 0);
+
+    Dual2 result = 2.0 * x + 1.0 - x / 4.0 - (3.0 - x);
+    EXPECT_DOUBLE_EQ(9.0, result.value);
+    EXPECT_DOUBLE_EQ(2.75, result.gradient[0]);
+    EXPECT_DOUBLE_EQ(0.0, result.gradient[1]);
+
+    Dual2 reciprocal = 1.0 / x;
+    EXPECT_DOUBLE_EQ(0.25, reciprocal.value);
+    EXPECT_DOUBLE_EQ(-1.0 / 16.0, reciprocal.gradient[0]);
+}
+
+// ============================================================================
+// ELEMENTARY FUNCTIONS
+// ============================================================================
+
+TEST(DualNumberFunctions, GivenVariable_WhenApplyingElementaryFunctions_ExpectAnalyticDerivatives)
+{
+    Dual2 x = Dual2::variable(2.0, 0);
+
+    EXPECT_DOUBLE_EQ(1.0 / (2.0 * std::sqrt(2.0)), sqrt(x).gradient[0]);
+    EXPECT_DOUBLE_EQ(2.0 / 3.0 * std::pow(2.0, -1.0 / 3.0), pow(x, 2.0 / 3.0).gradient[0]);
+    EXPECT_DOUBLE_EQ(0.5, log(x).gradient[0]);
+    EXPECT_DOUBLE_EQ(std::exp(2.0), exp(x).gradient[0]);
+    EXPECT_DOUBLE_EQ(2.0, abs(-x).value);
+    EXPECT_DOUBLE_EQ(1.0, abs(-x).gradient[0]);
+}
+
+// ============================================================================
+// GENERIC SECTION KERNELS
+// ============================================================================
+
+TEST(DualNumberSections, GivenTrapezoidWithSeededDimensions_WhenEvaluating_ExpectGeometricPartials)
+{
+    using Dual3 = DualNumber<3>;
+    BasicTrapezoidalSection<Dual3> section{Dual3::variable(4.0, 0), Dual3::variable(2.0, 1)};
+    Dual3 depth = Dual3::variable(1.5, 2);
+
+    BasicSectionProperties<Dual3> properties = section.evaluate(depth);
+
+    // A = (b + z y) y
+    EXPECT_DOUBLE_EQ(10.5, properties.area.value);
+    EXPECT_DOUBLE_EQ(1.5, properties.area.gradient[0]);
+    EXPECT_DOUBLE_EQ(2.25, properties.area.gradient[1]);
+    EXPECT_DOUBLE_EQ(10.0, properties.area.gradient[2]);
+
+    // P = b + 2 y sqrt(1 + z^2)
+    EXPECT_DOUBLE_EQ(1.0, properties.wettedPerimeter.gradient[0]);
+    EXPECT_NEAR(2.0 * 1.5 * 2.0 / std::sqrt(5.0), properties.wettedPerimeter.gradient[1], 1e-12);
+    EXPECT_NEAR(2.0 * std::sqrt(5.0), properties.wettedPerimeter.gradient[2], 1e-12);
+
+    // The double instantiation agrees with the dual values.
+    SectionProperties plain = TrapezoidalSection{4.0, 2.0}.evaluate(1.5);
+    EXPECT_DOUBLE_EQ(plain.area, properties.area.value);
+    EXPECT_DOUBLE_EQ(plain.wettedPerimeter, properties.wettedPerimeter.value);
+    EXPECT_DOUBLE_EQ(plain.topWidth, properties.topWidth.value);
+}
@@ -0,0 +1,291 @@
+#include <gtest/gtest.h>
+#include "DynamicWaveSolver.h"
+#include "Flow.h"
+#include "GradualFlowAnalyzer.h"
+#include "SectionTable.h"
+#include "TrapezoidalChannel.h"
+#include "UnitSystemConstants.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+constexpr double TIME_STEP{60.0};
+constexpr double PI{3.14159265358979323846};
+
+constexpr DynamicWaveScheme SCHEMES[]{DynamicWaveScheme::Preissmann, DynamicWaveScheme::MacCormack};
+
+DynamicWaveReach make_reach()
+{
+    DynamicWaveReach reach;
+    reach.length = 5000.0;
+    reach.bedSlope = 0.0005;
+    reach.manningN = 0.03;
+    return reach;
+}
+
+DynamicWaveSettings make_settings(DynamicWaveScheme scheme)
+{
+    DynamicWaveSettings settings;
+    settings.scheme = scheme;
+    settings.cellCount = 50;
+    return settings;
+}
+
+// Smooth flood wave on a base flow: a cosine rise to the peak over 1 h and
+// back over 1 h, then base flow until `hours`.
+std::vector<double> make_flood(double baseFlow, double peakFlow, double hours)
+{
+    std::vector<double> discharge;
+
+    for (int step = 0; step * TIME_STEP <= hours * 3600.0; ++step)
+    {
+        double time = step * TIME_STEP;
+        double phase = time < 7200.0 ? 0.5 * (1.0 - std::cos(PI * time / 3600.0)) : 0.0;
+        discharge.push_back(baseFlow + (peakFlow - baseFlow) * phase);
+    }
+
+    return discharge;
+}
+
+double calculate_storage(const SectionTable& table, const std::vector<double>& depth, double spaceStep)
+{
+    double storage{0.0};
+    for (std::size_t node = 0; node + 1 < depth.size(); ++node)
+        storage += 0.5 * (table.lookup(depth[node]).area + table.lookup(depth[node + 1]).area) * spaceStep;
+    return storage;
+}
+
+double calculate_range(const std::vector<double>& values, std::size_t first)
+{
+    auto bounds = std::minmax_element(values.begin() + static_cast<std::ptrdiff_t>(first), values.end());
+    return *bounds.second - *bounds.first;
+}
+}
+
+// ============================================================================
+// STEADY FLOW
+// ============================================================================
+
+TEST(DynamicWaveSolverSteady, GivenUniformFlow_WhenSolving_ExpectStateUnchanged)
+{
+    TrapezoidalChannel channel{10.0, 2.0, 0.0};
+    SectionTable table{channel, 10.0};
+    DynamicWaveSolver solver{false};
+    DynamicWaveBoundary boundary{TIME_STEP, std::vector<double>(100, 30.0), {}};
+
+    for (DynamicWaveScheme scheme : SCHEMES)
+    {
+        DynamicWaveResult result = solver.solve(table, make_reach(), boundary, make_settings(scheme));
+
+        ASSERT_TRUE(result.isValid) << get_dynamic_wave_scheme_name(scheme);
+        EXPECT_NEAR(30.0, result.outflow.back(), 1e-6) << get_dynamic_wave_scheme_name(scheme);
+        EXPECT_NEAR(result.depth.front(), result.depth.back(), 1e-8) << get_dynamic_wave_scheme_name(scheme);
+        EXPECT_EQ(100u, result.outflow.size());
+    }
+}
+
+TEST(DynamicWaveSolverSteady, GivenHighTailwater_WhenSettled_ExpectGradualFlowProfile)
+{
+    TrapezoidalChannel channel{10.0, 2.0, 0.0};
+    SectionTable table{channel, 10.0};
+    DynamicWaveSolver solver{false};
+    DynamicWaveReach reach = make_reach();
+
+    // Twelve hours for the level-pool start to drain to the M1 profile.
+    DynamicWaveBoundary boundary{TIME_STEP, std::vector<double>(720, 30.0), std::vector<double>(720, 4.0)};
+
+    ProfileSummary profile = GradualFlowAnalyzer{}.compute_profile(channel, Flow{30.0, reach.manningN}, reach.bedSlope,
+                                                                   reach.length, 4.0,
+                                                                   UnitSystemConstants::get_mannings_coefficient(false),
+                                                                   UnitSystemConstants::get_gravity(false),
+                                                                   [](const ProfileStation&) {});
+    ASSERT_EQ(ProfileStatus::Completed, profile.status);
+
+    for (DynamicWaveScheme scheme : SCHEMES)
+    {
+        DynamicWaveResult result = solver.solve(table, reach, boundary, make_settings(scheme));
+
+        ASSERT_TRUE(result.isValid) << get_dynamic_wave_scheme_name(scheme);
+        EXPECT_NEAR(profile.endDepth, result.depth.front(), 0.01) << get_dynamic_wave_scheme_name(scheme);
+        EXPECT_NEAR(30.0, result.outflow.back(), 1e-3 * 30.0) << get_dynamic_wave_scheme_name(scheme);
+    }
+}
+
+// ============================================================================
+// UNSTEADY FLOW
+// ============================================================================
+
+TEST(DynamicWaveSolverUnsteady, GivenFloodWave_WhenSolvingPreissmann_ExpectVolumeBalance)
+{
+    TrapezoidalChannel channel{10.0, 2.0, 0.0};
+    SectionTable table{channel, 10.0};
+    DynamicWaveSolver solver{false};
+    DynamicWaveReach reach = make_reach();
+    DynamicWaveSettings settings = make_settings(DynamicWaveScheme::Preissmann);
+    DynamicWaveBoundary boundary{TIME_STEP, make_flood(20.0, 120.0, 4.0), {}};
+
+    DynamicWaveResult initial = solver.solve(table, reach, DynamicWaveBoundary{TIME_STEP, {20.0}, {}}, settings);
+    DynamicWaveResult result = solver.solve(table, reach, boundary, settings);
+
+    // Continuity weights the boundary discharges by theta in time, so the
+    // storage change matches the same weighting to solver tolerance.
+    double netInflow{0.0};
+    for (std::size_t step = 1; step < result.outflow.size(); ++step)
+    {
+        double inflow = settings.theta * boundary.upstreamDischarge[step] + (1.0 - settings.theta) * boundary.upstreamDischarge[step - 1];
+        double outflow = settings.theta * result.outflow[step] + (1.0 - settings.theta) * result.outflow[step - 1];
+        netInflow += (inflow - outflow) * TIME_STEP;
+    }
+
+    double spaceStep = reach.length / static_cast<double>(settings.cellCount);
+    double storageChange = calculate_storage(table, result.depth, spaceStep) - calculate_storage(table, initial.depth, spaceStep);
+
+    ASSERT_TRUE(result.isValid);
+    EXPECT_GT(storageChange, 0.0);
+    EXPECT_NEAR(netInflow, storageChange, 1e-6 * storageChange);
+}
+
+TEST(DynamicWaveSolverUnsteady, GivenFloodWave_WhenSolvingWithBothSchemes_ExpectSimilarOutflow)
+{
+    TrapezoidalChannel channel{10.0, 2.0, 0.0};
+    SectionTable table{channel, 10.0};
+    DynamicWaveSolver solver{false};
+    DynamicWaveBoundary boundary{TIME_STEP, make_flood(20.0, 120.0, 5.0), {}};
+
+    DynamicWaveResult preissmann = solver.solve(table, make_reach(), boundary, make_settings(DynamicWaveScheme::Preissmann));
+    DynamicWaveResult macCormack = solver.solve(table, make_reach(), boundary, make_settings(DynamicWaveScheme::MacCormack));
+
+    ASSERT_TRUE(preissmann.isValid && macCormack.isValid);
+
+    double preissmannPeak = *std::max_element(preissmann.outflow.begin(), preissmann.outflow.end());
+    double macCormackPeak = *std::max_element(macCormack.outflow.begin(), macCormack.outflow.end());
+
+    // Attenuated, but by well under half the rise over a 5 km reach.
+    EXPECT_LT(preissmannPeak, 120.0);
+    EXPECT_GT(preissmannPeak, 70.0);
+    EXPECT_NEAR(preissmannPeak, macCormackPeak, 0.03 * preissmannPeak);
+    EXPECT_GT(macCormack.timeStepCount, preissmann.timeStepCount);
+}
+
+TEST(DynamicWaveSolverUnsteady, GivenTideAtOutletOfClosedChannel_WhenSolving_ExpectTideFillsAndDrainsChannel)
+{
+    TrapezoidalChannel channel{10.0, 2.0, 0.0};
+    SectionTable table{channel, 10.0};
+    DynamicWaveSolver solver{false};
+
+    DynamicWaveReach reach = make_reach();
+    reach.bedSlope = 0.0;
+
+    // M2 tide of 0.5 m amplitude for two cycles; the reach is far shorter
+    // than the tidal wavelength, so the whole channel rises and falls with it.
+    double period{12.42 * 3600.0};
+    double meanDepth{5.0};
+    double amplitude{0.5};
+    DynamicWaveBoundary boundary{TIME_STEP, {}, {}};
+
+    for (double time = 0.0; time <= 2.0 * period; time += TIME_STEP)
+    {
+        boundary.upstreamDischarge.push_back(0.0);
+        boundary.downstreamDepth.push_back(meanDepth + amplitude * std::sin(2.0 * PI * time / period));
+    }
+
+    // Outlet discharge is the rate of change of storage: L T a w.
+    double surfaceWidth = table.lookup(meanDepth).topWidth;
+    double expectedDischarge = reach.length * surfaceWidth * amplitude * 2.0 * PI / period;
+    std::size_t secondCycle = boundary.downstreamDepth.size() / 2;
+
+    for (DynamicWaveScheme scheme : SCHEMES)
+    {
+        DynamicWaveResult result = solver.solve(table, reach, boundary, make_settings(scheme));
+
+        ASSERT_TRUE(result.isValid) << get_dynamic_wave_scheme_name(scheme);
+        EXPECT_NEAR(2.0 * amplitude, calculate_range(result.upstreamDepth, secondCycle), 0.05) << get_dynamic_wave_scheme_name(scheme);
+        EXPECT_NEAR(2.0 * expectedDischarge, calculate_range(result.outflow, secondCycle), 0.1 * expectedDischarge)
+            << get_dynamic_wave_scheme_name(scheme);
+    }
+}
+
+// ============================================================================
+// FAILURES AND SIZING
+// ============================================================================
+
+TEST(DynamicWaveSolverInputs, GivenInvalidInputs_WhenSolving_ExpectInvalidInputStatus)
+{
+    TrapezoidalChannel channel{10.0, 2.0, 0.0};
+    SectionTable table{channel, 10.0};
+    DynamicWaveSolver solver{false};
+    DynamicWaveSettings settings = make_settings(DynamicWaveScheme::Preissmann);
+    DynamicWaveBoundary boundary{TIME_STEP, {30.0, 30.0}, {}};
+
+    DynamicWaveReach flatReach = make_reach();
+    flatReach.bedSlope = 0.0;
+    DynamicWaveSettings badTheta = settings;
+    badTheta.theta = 0.4;
+
+    EXPECT_EQ(DynamicWaveStatus::InvalidInput, solver.solve(table, flatReach, boundary, settings).status);
+    EXPECT_EQ(DynamicWaveStatus::InvalidInput, solver.solve(table, make_reach(), boundary, badTheta).status);
+    EXPECT_EQ(DynamicWaveStatus::InvalidInput,
+              solver.solve(table, make_reach(), DynamicWaveBoundary{TIME_STEP, {30.0, 30.0}, {4.0}}, settings).status);
+    EXPECT_EQ(DynamicWaveStatus::InvalidInput,
+              solver.solve(table, make_reach(), DynamicWaveBoundary{0.0, {30.0, 30.0}, {}}, settings).status);
+    EXPECT_FALSE(solver.solve(table, make_reach(), DynamicWaveBoundary{TIME_STEP, {}, {}}, settings).isValid);
+}
+
+TEST(DynamicWaveSolverInputs, GivenFloodAboveTable_WhenSolving_ExpectDepthOutOfRange)
+{
+    TrapezoidalChannel channel{10.0, 2.0, 0.0};
+    SectionTable table{channel, 3.0};
+    DynamicWaveSolver solver{false};
+
+    for (DynamicWaveScheme scheme : SCHEMES)
+    {
+        DynamicWaveResult result = solver.solve(table, make_reach(), DynamicWaveBoundary{TIME_STEP, make_flood(20.0, 2000.0, 3.0), {}},
+                                                make_settings(scheme));
+
+        EXPECT_FALSE(result.isValid);
+        EXPECT_EQ(DynamicWaveStatus::DepthOutOfRange, result.status) << get_dynamic_wave_scheme_name(scheme);
+    }
+
+    EXPECT_STREQ("Depth left the section table (dry or overtopped)",
+                 get_dynamic_wave_status_message(DynamicWaveStatus::DepthOutOfRange));
+}
+
+TEST(DynamicWaveSolverInputs, GivenOneNewtonIteration_WhenSolvingUnsteadyFlow_ExpectNotConverged)
+{
+    TrapezoidalChannel channel{10.0, 2.0, 0.0};
+    SectionTable table{channel, 10.0};
+    DynamicWaveSolver solver{false};
+    DynamicWaveSettings settings = make_settings(DynamicWaveScheme::Preissmann);
+    settings.maxIterations = 1;
+
+    DynamicWaveResult result = solver.solve(table, make_reach(), DynamicWaveBoundary{TIME_STEP, make_flood(20.0, 120.0, 1.0), {}},
+                                            settings);
+
+    EXPECT_EQ(DynamicWaveStatus::NotConverged, result.status);
+}
+
+TEST(DynamicWaveSolverSizing, GivenMoreCells_WhenSolving_ExpectFootprintLinearInCells)
+{
+    TrapezoidalChannel channel{10.0, 2.0, 0.0};
+    SectionTable table{channel, 10.0};
+    DynamicWaveSolver solver{false};
+    DynamicWaveBoundary boundary{TIME_STEP, std::vector<double>(10, 30.0), {}};
+
+    for (DynamicWaveScheme scheme : SCHEMES)
+    {
+        DynamicWaveSettings settings = make_settings(scheme);
+        settings.cellCount = 100;
+        DynamicWaveResult small = solver.solve(table, make_reach(), boundary, settings);
+        settings.cellCount = 200;
+        DynamicWaveResult large = solver.solve(table, make_reach(), boundary, settings);
+        settings.cellCount = 300;
+        DynamicWaveResult larger = solver.solve(table, make_reach(), boundary, settings);
+
+        ASSERT_TRUE(small.isValid && large.isValid && larger.isValid);
+        EXPECT_GT(small.memoryFootprint, table.get_memory_footprint());
+        EXPECT_EQ(large.memoryFootprint - small.memoryFootprint, larger.memoryFootprint - large.memoryFootprint);
+        EXPECT_GE(small.timeStepCount, 9u);
+    }
+}
@@ -0,0 +1,224 @@
+#include <gtest/gtest.h>
+#include "GradualFlowAnalyzer.h"
+#include "RectangularChannel.h"
+#include "TrapezoidalChannel.h"
+#include "Flow.h"
+#include "UnitSystemConstants.h"
+#include <cmath>
+#include <vector>
+
+namespace
+{
+// Distance between two depths by the direct step method with many small
+// depth increments, used as an independent reference.
+double direct_step_distance(const RectangularSection& section, const Flow& flow, double slope,
+                            double fromDepth, double toDepth, int increments)
+{
+    double gravity{UnitSystemConstants::GRAVITY_SI};
+    double discharge{flow.get_discharge()};
+    double manningN{flow.get_manning_n()};
+
+    auto energy = [&](double depth)
+    {
+        double velocity = discharge / section.calculate_area(depth);
+        return depth + velocity * velocity / (2.0 * gravity);
+    };
+    auto friction_slope = [&](double depth)
+    {
+        double area = section.calculate_area(depth);
+        double hydraulicRadius = area / section.calculate_wetted_perimeter(depth);
+        double velocity = discharge / area;
+        return std::pow(velocity * manningN, 2.0) / std::pow(hydraulicRadius, 4.0 / 3.0);
+    };
+
+    double distance{0.0};
+    double depthStep = (toDepth - fromDepth) / increments;
+
+    for (int i = 0; i < increments; ++i)
+    {
+        double depth1 = fromDepth + i * depthStep;
+        double depth2 = depth1 + depthStep;
+        double averageFriction = 0.5 * (friction_slope(depth1) + friction_slope(depth2));
+        distance += (energy(depth2) - energy(depth1)) / (slope - averageFriction);
+    }
+
+    return std::abs(distance);
+}
+}
+
+// ============================================================================
+// PROFILE CLASSIFICATION
+// ============================================================================
+
+TEST(GradualFlowClassification, GivenDepthsAroundNormalAndCritical_WhenClassifying_ExpectChowProfileTypes)
+{
+    EXPECT_EQ(ProfileType::M1, classify_profile(3.0, 2.0, 1.0));
+    EXPECT_EQ(ProfileType::M2, classify_profile(1.5, 2.0, 1.0));
+    EXPECT_EQ(ProfileType::M3, classify_profile(0.5, 2.0, 1.0));
+    EXPECT_EQ(ProfileType::S1, classify_profile(3.0, 1.0, 2.0));
+    EXPECT_EQ(ProfileType::S2, classify_profile(1.5, 1.0, 2.0));
+    EXPECT_EQ(ProfileType::S3, classify_profile(0.5, 1.0, 2.0));
+    EXPECT_EQ(ProfileType::C1, classify_profile(3.0, 2.0, 2.0));
+    EXPECT_EQ(ProfileType::Uniform, classify_profile(2.0, 2.0, 1.0));
+}
+
+// ============================================================================
+// MILD SLOPE PROFILES
+// ============================================================================
+
+TEST(GradualFlowProfiles, GivenDownstreamPoolOnMildSlope_WhenComputing_ExpectM1ApproachingNormalDepthUpstream)
+{
+    RectangularSection section{10.0};
+    Flow flow{50.0, 0.013};
+    std::vector<ProfileStation> stations;
+
+    GradualFlowAnalyzer analyzer;
+    ProfileSummary summary = analyzer.compute_section_profile(section, flow, 0.001, 5000.0, 3.0,
+                                                              UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                              UnitSystemConstants::GRAVITY_SI,
+                                                              [&stations](const ProfileStation& station)
+                                                              { stations.push_back(station); });
+
+    ASSERT_EQ(ProfileStatus::Completed, summary.status);
+    EXPECT_EQ(ProfileType::M1, summary.profileType);
+    EXPECT_EQ(stations.size(), summary.stationCount);
+    EXPECT_DOUBLE_EQ(5000.0, stations.front().station);
+    EXPECT_DOUBLE_EQ(0.0, stations.back().station);
+
+    for (std::size_t i = 1; i < stations.size(); ++i)
+    {
+        EXPECT_LT(stations[i].station, stations[i - 1].station);
+        EXPECT_LE(stations[i].depth, stations[i - 1].depth);
+        EXPECT_GT(stations[i].depth, summary.normalDepth);
+    }
+
+}
+
+TEST(GradualFlowProfiles, GivenM1Profile_WhenComparingWithDirectStep_ExpectSameReachLength)
+{
+    RectangularSection section{10.0};
+    Flow flow{50.0, 0.013};
+
+    GradualFlowAnalyzer analyzer;
+    ProfileSummary summary = analyzer.compute_section_profile(section, flow, 0.001, 1000.0, 3.0,
+                                                              UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                              UnitSystemConstants::GRAVITY_SI,
+                                                              [](const ProfileStation&) {});
+
+    ASSERT_EQ(ProfileStatus::Completed, summary.status);
+
+    double referenceDistance = direct_step_distance(section, flow, 0.001, 3.0, summary.endDepth, 20000);
+    EXPECT_NEAR(1000.0, referenceDistance, 1.0);
+}
+
+TEST(GradualFlowProfiles, GivenFreeOverfallOnMildSlope_WhenComputing_ExpectM2BetweenCriticalAndNormalDepth)
+{
+    RectangularSection section{10.0};
+    Flow flow{50.0, 0.013};
+    double criticalDepth = std::cbrt(25.0 / UnitSystemConstants::GRAVITY_SI);
+    double minDepth{1e9};
+    double maxDepth{0.0};
+
+    GradualFlowAnalyzer analyzer;
+    ProfileSummary summary = analyzer.compute_section_profile(section, flow, 0.001, 3000.0, criticalDepth,
+                                                              UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                              UnitSystemConstants::GRAVITY_SI,
+                                                              [&](const ProfileStation& station)
+                                                              {
+                                                                  minDepth = std::min(minDepth, station.depth);
+                                                                  maxDepth = std::max(maxDepth, station.depth);
+                                                              });
+
+    ASSERT_EQ(ProfileStatus::Completed, summary.status);
+    EXPECT_EQ(ProfileType::M2, summary.profileType);
+    EXPECT_GT(minDepth, summary.criticalDepth);
+    EXPECT_LT(maxDepth, summary.normalDepth);
+    EXPECT_NEAR(summary.normalDepth, summary.endDepth, 0.01);
+}
+
+// ============================================================================
+// STEEP SLOPE PROFILES
+// ============================================================================
+
+TEST(GradualFlowProfiles, GivenCriticalInletOnSteepSlope_WhenComputing_ExpectS2MarchingDownstream)
+{
+    TrapezoidalSection section{4.0, 2.0};
+    Flow flow{30.0, 0.013};
+    std::vector<ProfileStation> stations;
+
+    CriticalFlowAnalyzer criticalAnalyzer;
+    double criticalDepth = criticalAnalyzer.solve_section(section, 30.0, UnitSystemConstants::GRAVITY_SI).criticalDepth;
+
+    GradualFlowAnalyzer analyzer;
+    ProfileSummary summary = analyzer.compute_section_profile(section, flow, 0.02, 500.0, criticalDepth,
+                                                              UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                              UnitSystemConstants::GRAVITY_SI,
+                                                              [&stations](const ProfileStation& station)
+                                                              { stations.push_back(station); });
+
+    ASSERT_EQ(ProfileStatus::Completed, summary.status);
+    EXPECT_EQ(ProfileType::S2, summary.profileType);
+    EXPECT_DOUBLE_EQ(0.0, stations.front().station);
+    EXPECT_DOUBLE_EQ(500.0, stations.back().station);
+    EXPECT_GT(stations.back().froudeNumber, 1.0);
+    EXPECT_NEAR(summary.normalDepth, summary.endDepth, 0.01);
+}
+
+// ============================================================================
+// OUTPUT AND DISPATCH
+// ============================================================================
+
+TEST(GradualFlowOutput, GivenOutputInterval_WhenComputing_ExpectEvenlySpacedStations)
+{
+    GradualFlowSettings settings;
+    settings.outputInterval = 0.5;
+
+    RectangularSection section{10.0};
+    Flow flow{50.0, 0.013};
+    std::vector<double> stations;
+
+    GradualFlowAnalyzer analyzer{settings};
+    ProfileSummary summary = analyzer.compute_section_profile(section, flow, 0.001, 1000.0, 2.5,
+                                                              UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                              UnitSystemConstants::GRAVITY_SI,
+                                                              [&stations](const ProfileStation& station)
+                                                              { stations.push_back(station.station); });
+
+    ASSERT_EQ(ProfileStatus::Completed, summary.status);
+    ASSERT_EQ(2001u, stations.size());
+    EXPECT_LT(summary.stepCount, stations.size());
+
+    for (std::size_t i = 0; i < stations.size(); ++i)
+        EXPECT_NEAR(1000.0 - 0.5 * static_cast<double>(i), stations[i], 1e-9);
+}
+
+TEST(GradualFlowOutput, GivenChannelAndSection_WhenComputing_ExpectSameEndDepth)
+{
+    TrapezoidalChannel channel{4.0, 2.0, 0.0};
+    Flow flow{50.0, 0.013};
+
+    GradualFlowAnalyzer analyzer;
+    auto ignore = [](const ProfileStation&) {};
+
+    ProfileSummary virtualSummary = analyzer.compute_profile(channel, flow, 0.001, 2000.0, 3.0,
+                                                             UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                             UnitSystemConstants::GRAVITY_SI, ignore);
+    ProfileSummary sectionSummary = analyzer.compute_section_profile(channel.get_section(), flow, 0.001, 2000.0, 3.0,
+                                                                     UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                                     UnitSystemConstants::GRAVITY_SI, ignore);
+
+    EXPECT_EQ(ProfileStatus::Completed, virtualSummary.status);
+    EXPECT_NEAR(sectionSummary.endDepth, virtualSummary.endDepth, 1e-9);
+}
+
+TEST(GradualFlowOutput, GivenZeroReachLength_WhenComputing_ExpectInvalidInput)
+{
+    GradualFlowAnalyzer analyzer;
+    ProfileSummary summary = analyzer.compute_section_profile(RectangularSection{10.0}, Flow{50.0, 0.013}, 0.001,
+                                                              0.0, 3.0, UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                              UnitSystemConstants::GRAVITY_SI,
+                                                              [](const ProfileStation&) {});
+
+    EXPECT_EQ(ProfileStatus::InvalidInput, summary.status);
+    EXPECT_EQ(0u, summary.stationCount);
+}
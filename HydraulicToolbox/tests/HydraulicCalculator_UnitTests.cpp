@@ -0,0 +1,347 @@
+#include <gtest/gtest.h>
+#include "HydraulicCalculator.h"
+#include "CalculationControl.h"
+#include "CalculationKey.h"
+#include <cstring>
+#include <type_traits>
+
+namespace
+{
+GeometryData make_geometry(ChannelType channelType, double bottomWidth, double sideSlope)
+{
+    GeometryData geometry;
+    geometry.channelType = channelType;
+    geometry.bottomWidth = bottomWidth;
+    geometry.sideSlope = sideSlope;
+    geometry.length = 100.0;
+    geometry.bedSlope = 0.001;
+    return geometry;
+}
+
+HydraulicData make_hydraulics(double discharge)
+{
+    HydraulicData hydraulics;
+    hydraulics.discharge = discharge;
+    hydraulics.manningN = 0.013;
+    return hydraulics;
+}
+}
+
+// ============================================================================
+// CALCULATION KEY
+// ============================================================================
+
+TEST(CalculationKey, GivenUnusedDimensionsDiffer_WhenMakingKeys_ExpectEqualKeysAndHashes)
+{
+    bool useUsCustomary{false};
+    HydraulicData hydraulics = make_hydraulics(50.0);
+
+    std::optional<CalculationKey> first = make_calculation_key(useUsCustomary, make_geometry(ChannelType::Rectangular, 10.0, 0.0), hydraulics);
+    std::optional<CalculationKey> second = make_calculation_key(useUsCustomary, make_geometry(ChannelType::Rectangular, 10.0, 3.0), hydraulics);
+
+    ASSERT_TRUE(first && second);
+    EXPECT_EQ(*first, *second);
+    EXPECT_EQ(CalculationKeyHash{}(*first), CalculationKeyHash{}(*second));
+}
+
+TEST(CalculationKey, GivenDifferentUnitsOrShape_WhenMakingKeys_ExpectDifferentKeys)
+{
+    bool useUsCustomary{false};
+    HydraulicData hydraulics = make_hydraulics(50.0);
+    GeometryData geometry = make_geometry(ChannelType::Trapezoidal, 4.0, 2.0);
+
+    std::optional<CalculationKey> si = make_calculation_key(useUsCustomary, geometry, hydraulics);
+    useUsCustomary = true;
+    std::optional<CalculationKey> us = make_calculation_key(useUsCustomary, geometry, hydraulics);
+    std::optional<CalculationKey> triangular = make_calculation_key(useUsCustomary, make_geometry(ChannelType::Triangular, 4.0, 2.0), hydraulics);
+
+    EXPECT_NE(*si, *us);
+    EXPECT_NE(*us, *triangular);
+    EXPECT_FALSE(make_calculation_key(useUsCustomary, make_geometry(ChannelType::None, 4.0, 2.0), hydraulics).has_value());
+}
+
+TEST(CalculationKey, GivenCompositeRoughness_WhenMakingKeys_ExpectKeyedOnBankNAndMethod)
+{
+    GeometryData geometry = make_geometry(ChannelType::Trapezoidal, 4.0, 2.0);
+    HydraulicData uniform = make_hydraulics(50.0);
+    HydraulicData horton = uniform;
+    horton.bankManningN = 0.035;
+    HydraulicData lotter = horton;
+    lotter.roughnessMethod = CompositeRoughnessMethod::Lotter;
+
+    std::optional<CalculationKey> uniformKey = make_calculation_key(false, geometry, uniform);
+    std::optional<CalculationKey> hortonKey = make_calculation_key(false, geometry, horton);
+    std::optional<CalculationKey> lotterKey = make_calculation_key(false, geometry, lotter);
+
+    ASSERT_TRUE(uniformKey && hortonKey && lotterKey);
+    EXPECT_NE(*uniformKey, *hortonKey);
+    EXPECT_NE(*hortonKey, *lotterKey);
+    EXPECT_NE(CalculationKeyHash{}(*hortonKey), CalculationKeyHash{}(*lotterKey));
+
+    // The method only matters once a bank n is given.
+    uniform.roughnessMethod = CompositeRoughnessMethod::Pavlovskii;
+    EXPECT_EQ(*uniformKey, *make_calculation_key(false, geometry, uniform));
+}
+
+// ============================================================================
+// RESULT CACHE
+// ============================================================================
+
+TEST(HydraulicCalculatorCache, GivenRepeatedInputs_WhenCalculating_ExpectCachedResultAndHit)
+{
+    HydraulicCalculator calculator;
+    bool useUsCustomary{false};
+    GeometryData geometry = make_geometry(ChannelType::Rectangular, 10.0, 0.0);
+    HydraulicData hydraulics = make_hydraulics(50.0);
+
+    CalculationResults first = calculator.calculate(useUsCustomary, geometry, hydraulics);
+    geometry.length = 250.0;   // Not an input to calculate()
+    CalculationResults second = calculator.calculate(useUsCustomary, geometry, hydraulics);
+
+    ASSERT_TRUE(first.isValid);
+    EXPECT_DOUBLE_EQ(first.normalDepth, second.normalDepth);
+    EXPECT_DOUBLE_EQ(first.criticalDepth, second.criticalDepth);
+
+    CacheStatistics statistics = calculator.get_cache_statistics();
+    EXPECT_EQ(1u, statistics.missCount);
+    EXPECT_EQ(1u, statistics.hitCount);
+    EXPECT_EQ(1u, statistics.size);
+}
+
+TEST(HydraulicCalculatorCache, GivenChangedSolverSettings_WhenCalculating_ExpectCacheCleared)
+{
+    HydraulicCalculator calculator;
+    bool useUsCustomary{false};
+    GeometryData geometry = make_geometry(ChannelType::Trapezoidal, 4.0, 2.0);
+    HydraulicData hydraulics = make_hydraulics(50.0);
+
+    calculator.calculate(useUsCustomary, geometry, hydraulics);
+
+    SolverSettings settings;
+    settings.method = SolverMethod::Bisection;
+    calculator.set_solver_settings(settings);
+    EXPECT_EQ(0u, calculator.get_cache_statistics().size);
+
+    CalculationResults results = calculator.calculate(useUsCustomary, geometry, hydraulics);
+
+    EXPECT_TRUE(results.isValid);
+    EXPECT_EQ(2u, calculator.get_cache_statistics().missCount);
+    EXPECT_EQ(0u, calculator.get_cache_statistics().hitCount);
+}
+
+TEST(HydraulicCalculatorCache, GivenInvalidInputs_WhenCalculatingTwice_ExpectCachedError)
+{
+    HydraulicCalculator calculator;
+    bool useUsCustomary{false};
+    GeometryData geometry = make_geometry(ChannelType::Rectangular, 10.0, 0.0);
+    HydraulicData hydraulics = make_hydraulics(-1.0);
+
+    CalculationResults first = calculator.calculate(useUsCustomary, geometry, hydraulics);
+    CalculationResults second = calculator.calculate(useUsCustomary, geometry, hydraulics);
+
+    EXPECT_FALSE(first.isValid);
+    EXPECT_FALSE(second.isValid);
+    EXPECT_EQ(CalculationError::InvalidDischarge, first.error);
+    EXPECT_EQ(first.error, second.error);
+    EXPECT_EQ(1u, calculator.get_cache_statistics().hitCount);
+}
+
+// ============================================================================
+// CANCELLATION
+// ============================================================================
+
+TEST(HydraulicCalculatorControl, GivenCancelledControl_WhenCalculating_ExpectCancelledResultNotCached)
+{
+    HydraulicCalculator calculator;
+    bool useUsCustomary{false};
+    GeometryData geometry = make_geometry(ChannelType::Trapezoidal, 4.0, 2.0);
+    HydraulicData hydraulics = make_hydraulics(50.0);
+
+    CalculationControl control;
+    control.cancel();
+    CalculationResults cancelled = calculator.calculate(useUsCustomary, geometry, hydraulics, &control);
+
+    EXPECT_FALSE(cancelled.isValid);
+    EXPECT_EQ(0u, calculator.get_cache_statistics().size);
+
+    CalculationResults results = calculator.calculate(useUsCustomary, geometry, hydraulics);
+    EXPECT_TRUE(results.isValid);
+}
+
+TEST(HydraulicCalculatorControl, GivenProgressCallback_WhenCalculating_ExpectCompletionReported)
+{
+    HydraulicCalculator calculator;
+    double lastFraction{0.0};
+    CalculationControl control{[&lastFraction](double fraction) { lastFraction = fraction; }};
+
+    CalculationResults results = calculator.calculate(false, make_geometry(ChannelType::Rectangular, 10.0, 0.0),
+                                                      make_hydraulics(50.0), &control);
+
+    EXPECT_TRUE(results.isValid);
+    EXPECT_DOUBLE_EQ(1.0, lastFraction);
+}
+
+// ============================================================================
+// RESULT VALUES
+// ============================================================================
+
+TEST(HydraulicCalculatorResults, GivenResultStruct_WhenInspectingType_ExpectTriviallyCopyable)
+{
+    EXPECT_TRUE(std::is_trivially_copyable<CalculationResults>::value);
+    EXPECT_TRUE(std::is_trivially_copyable<GeometryData>::value);
+    EXPECT_TRUE(std::is_trivially_copyable<HydraulicData>::value);
+}
+
+TEST(HydraulicCalculatorResults, GivenValidInputs_WhenCalculating_ExpectRegimeCodeAndNoError)
+{
+    HydraulicCalculator calculator;
+
+    CalculationResults results = calculator.calculate(false, make_geometry(ChannelType::Rectangular, 10.0, 0.0),
+                                                      make_hydraulics(50.0));
+
+    ASSERT_TRUE(results.isValid);
+    EXPECT_EQ(CalculationError::None, results.error);
+    EXPECT_EQ(FlowRegime::Subcritical, results.flowRegime);
+    EXPECT_STREQ("Subcritical", get_flow_regime_name(results.flowRegime));
+    EXPECT_STREQ("", get_error_message(results.error));
+}
+
+TEST(HydraulicCalculatorResults, GivenCriticalSolveFails_WhenCalculating_ExpectNormalDepthWithCriticalUnavailable)
+{
+    // Three iterations are enough for the seeded normal-depth Newton but
+    // not for the trapezoidal critical-depth iteration.
+    HydraulicCalculator calculator;
+    SolverSettings settings;
+    settings.maxIterations = 3;
+    calculator.set_solver_settings(settings);
+
+    GeometryData geometry = make_geometry(ChannelType::Trapezoidal, 4.0, 2.0);
+    CalculationResults results = calculator.calculate(false, geometry, make_hydraulics(50.0));
+    CalculationResults converged = HydraulicCalculator{}.calculate(false, geometry, make_hydraulics(50.0));
+
+    ASSERT_TRUE(results.isValid);
+    EXPECT_GT(results.normalDepth, 0.0);
+    EXPECT_FALSE(results.hasCriticalDepth);
+    EXPECT_DOUBLE_EQ(0.0, results.criticalDepth);
+    EXPECT_DOUBLE_EQ(0.0, results.minimumSpecificEnergy);
+    EXPECT_TRUE(converged.hasCriticalDepth);
+    EXPECT_GT(converged.criticalDepth, 0.0);
+}
+
+TEST(HydraulicCalculatorResults, GivenSlopesAroundCritical_WhenCalculating_ExpectRegimeFromNormalAgainstCriticalDepth)
+{
+    HydraulicCalculator calculator;
+
+    for(double slope : {0.0005, 0.002, 0.0021, 0.0023, 0.01})
+    {
+        GeometryData geometry = make_geometry(ChannelType::Trapezoidal, 4.0, 2.0);
+        geometry.bedSlope = slope;
+        CalculationResults results = calculator.calculate(false, geometry, make_hydraulics(50.0));
+
+        ASSERT_TRUE(results.isValid && results.hasCriticalDepth);
+        EXPECT_EQ(classify_flow_regime_by_depth(results.normalDepth, results.criticalDepth), results.flowRegime);
+    }
+
+    // Fr = 1.009 here: inside the Froude band and within tolerance of critical depth.
+    GeometryData nearCritical = make_geometry(ChannelType::Rectangular, 10.0, 0.0);
+    nearCritical.bedSlope = 0.0021;
+    EXPECT_EQ(FlowRegime::Critical, calculator.calculate(false, nearCritical, make_hydraulics(50.0)).flowRegime);
+}
+
+TEST(HydraulicCalculatorResults, GivenCompositeRoughness_WhenCalculating_ExpectEquivalentNBetweenSegments)
+{
+    HydraulicCalculator calculator;
+    GeometryData geometry = make_geometry(ChannelType::Trapezoidal, 4.0, 2.0);
+    HydraulicData hydraulics = make_hydraulics(12.0);
+    hydraulics.bankManningN = 0.035;
+
+    CalculationResults uniform = calculator.calculate(false, geometry, make_hydraulics(12.0));
+    CalculationResults composite = calculator.calculate(false, geometry, hydraulics);
+
+    ASSERT_TRUE(uniform.isValid && composite.isValid);
+    EXPECT_DOUBLE_EQ(0.013, uniform.manningN);
+    EXPECT_GT(composite.manningN, 0.013);
+    EXPECT_LT(composite.manningN, 0.035);
+    EXPECT_GT(composite.normalDepth, uniform.normalDepth);
+    EXPECT_FALSE(composite.sensitivities.isValid);
+    EXPECT_FALSE(composite.hasUncertainty);
+}
+
+TEST(HydraulicCalculatorResults, GivenEachInvalidInput_WhenCalculating_ExpectMatchingErrorCode)
+{
+    HydraulicCalculator calculator;
+    HydraulicData hydraulics = make_hydraulics(50.0);
+
+    GeometryData flat = make_geometry(ChannelType::Trapezoidal, 4.0, 2.0);
+    flat.bedSlope = 0.0;
+    GeometryData steep = make_geometry(ChannelType::Trapezoidal, 4.0, 2.0);
+    steep.bedSlope = 1.5;
+    HydraulicData roughN = make_hydraulics(50.0);
+    roughN.manningN = 0.5;
+
+    EXPECT_EQ(CalculationError::InvalidBedSlope, calculator.calculate(false, flat, hydraulics).error);
+    EXPECT_EQ(CalculationError::BedSlopeTooSteep, calculator.calculate(false, steep, hydraulics).error);
+    EXPECT_EQ(CalculationError::InvalidManningN,
+              calculator.calculate(false, make_geometry(ChannelType::Trapezoidal, 4.0, 2.0), roughN).error);
+    EXPECT_EQ(CalculationError::InvalidBottomWidth,
+              calculator.calculate(false, make_geometry(ChannelType::Rectangular, 0.0, 0.0), hydraulics).error);
+    EXPECT_EQ(CalculationError::InvalidSideSlope,
+              calculator.calculate(false, make_geometry(ChannelType::Triangular, 0.0, 0.0), hydraulics).error);
+    EXPECT_EQ(CalculationError::InvalidChannelType,
+              calculator.calculate(false, make_geometry(ChannelType::None, 4.0, 2.0), hydraulics).error);
+    EXPECT_NE(0u, std::strlen(get_error_message(CalculationError::InvalidChannelType)));
+}
+
+// ============================================================================
+// UNCERTAINTY
+// ============================================================================
+
+TEST(HydraulicCalculatorUncertainty, GivenPlainCalculation_WhenCalculating_ExpectNoMonteCarloBand)
+{
+    HydraulicCalculator calculator;
+
+    CalculationResults results = calculator.calculate(false, make_geometry(ChannelType::Trapezoidal, 4.0, 2.0),
+                                                      make_hydraulics(12.0));
+
+    ASSERT_TRUE(results.isValid);
+    EXPECT_FALSE(results.hasUncertainty);
+}
+
+TEST(HydraulicCalculatorUncertainty, GivenChosenDistributions_WhenCalculatingUncertainty_ExpectBandAroundNormalDepth)
+{
+    HydraulicCalculator calculator;
+    UncertaintySettings settings;
+    settings.sampleCount = 4096;
+    calculator.set_uncertainty_settings(settings);
+
+    GeometryData geometry = make_geometry(ChannelType::Trapezoidal, 4.0, 2.0);
+    CalculationResults results = calculator.calculate(false, geometry, make_hydraulics(12.0));
+    UncertaintyResult uncertainty = calculator.calculate_uncertainty(false, geometry,
+                                                                     Distribution::triangular(0.011, 0.013, 0.016),
+                                                                     Distribution::normal(12.0, 1.0),
+                                                                     Distribution::fixed(0.001));
+
+    ASSERT_TRUE(results.isValid);
+    ASSERT_TRUE(uncertainty.isValid);
+    EXPECT_EQ(4096u, uncertainty.sampleCount);
+    EXPECT_LT(uncertainty.percentile(0.05), results.normalDepth);
+    EXPECT_GT(uncertainty.percentile(0.95), results.normalDepth);
+}
+
+TEST(HydraulicCalculatorUncertainty, GivenInvalidGeometryOrCancel_WhenCalculatingUncertainty_ExpectInvalidResult)
+{
+    HydraulicCalculator calculator;
+    Distribution manningN = Distribution::fixed(0.013);
+    Distribution discharge = Distribution::fixed(12.0);
+    Distribution bedSlope = Distribution::fixed(0.001);
+
+    CalculationControl control;
+    control.cancel();
+
+    EXPECT_FALSE(calculator.calculate_uncertainty(false, make_geometry(ChannelType::Rectangular, 0.0, 0.0),
+                                                  manningN, discharge, bedSlope).isValid);
+    EXPECT_FALSE(calculator.calculate_uncertainty(false, make_geometry(ChannelType::None, 4.0, 2.0),
+                                                  manningN, discharge, bedSlope).isValid);
+    EXPECT_FALSE(calculator.calculate_uncertainty(false, make_geometry(ChannelType::Trapezoidal, 4.0, 2.0),
+                                                  manningN, discharge, bedSlope, &control).isValid);
+}
@@ -0,0 +1,262 @@
+#include <gtest/gtest.h>
+#include "HydrographRouter.h"
+#include "Analyzer.h"
+#include "ThreadPool.h"
+#include "UnitSystemConstants.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+constexpr double TIME_STEP{60.0};
+constexpr double BASE_FLOW{10.0};
+constexpr double PEAK_FLOW{100.0};
+
+constexpr RoutingMethod METHODS[]{RoutingMethod::KinematicWave, RoutingMethod::MuskingumCunge};
+
+RoutingReach make_reach()
+{
+    RoutingReach reach;
+    reach.section = TrapezoidalSection{20.0, 2.0};
+    reach.length = 20000.0;
+    reach.bedSlope = 0.0005;
+    reach.manningN = 0.035;
+    return reach;
+}
+
+// Triangular event on a base flow: rises over 2 h, falls over 4 h, then
+// 30 h of base flow so the wave leaves the reach.
+Hydrograph make_event()
+{
+    Hydrograph hydrograph{TIME_STEP, {}};
+
+    for (int step = 0; step < 36 * 60; ++step)
+    {
+        double hours = step * TIME_STEP / 3600.0;
+        double rise = hours < 2.0 ? hours / 2.0 : std::max(0.0, 1.0 - (hours - 2.0) / 4.0);
+        hydrograph.discharge.push_back(BASE_FLOW + (PEAK_FLOW - BASE_FLOW) * rise);
+    }
+
+    return hydrograph;
+}
+
+double calculate_volume(const std::vector<double>& discharge)
+{
+    double volume{0.0};
+    for (double value : discharge)
+        volume += value * TIME_STEP;
+    return volume;
+}
+
+// Kinematic celerity dQ/dA at uniform flow, by central differences.
+double calculate_celerity(const RoutingReach& reach, double discharge)
+{
+    Analyzer analyzer;
+    TrapezoidalSection section = std::get<TrapezoidalSection>(reach.section);
+    double manningsCoefficient = UnitSystemConstants::get_mannings_coefficient(false);
+    double gravity = UnitSystemConstants::get_gravity(false);
+    double delta{1e-4 * discharge};
+
+    double upperDepth = analyzer.solve_section(section, Flow{discharge + delta, reach.manningN}, reach.bedSlope,
+                                               manningsCoefficient, gravity).normalDepth;
+    double lowerDepth = analyzer.solve_section(section, Flow{discharge - delta, reach.manningN}, reach.bedSlope,
+                                               manningsCoefficient, gravity).normalDepth;
+
+    return 2.0 * delta / (section.calculate_area(upperDepth) - section.calculate_area(lowerDepth));
+}
+}
+
+// ============================================================================
+// STEADY FLOW AND CONSERVATION
+// ============================================================================
+
+TEST(HydrographRouterRouting, GivenSteadyInflowAndLateralInflow_WhenRouting_ExpectSteadyOutflow)
+{
+    ThreadPool pool{1};
+    HydrographRouter router{pool, false};
+    RoutingReach reach = make_reach();
+    reach.lateralInflow = 1e-4;
+
+    for (RoutingMethod method : METHODS)
+    {
+        RoutingSettings settings;
+        settings.method = method;
+
+        RoutingResult result = router.route(reach, Hydrograph{TIME_STEP, std::vector<double>(500, 25.0)}, settings);
+
+        ASSERT_TRUE(result.isValid) << get_routing_method_name(method);
+        EXPECT_NEAR(27.0, result.outflow.front(), 1e-9);
+        EXPECT_NEAR(27.0, result.outflow.back(), 1e-6 * 27.0) << get_routing_method_name(method);
+    }
+}
+
+TEST(HydrographRouterRouting, GivenEventHydrograph_WhenRouting_ExpectVolumeConserved)
+{
+    ThreadPool pool{1};
+    HydrographRouter router{pool, false};
+    Hydrograph inflow = make_event();
+
+    for (RoutingMethod method : METHODS)
+    {
+        RoutingSettings settings;
+        settings.method = method;
+
+        RoutingResult result = router.route(make_reach(), inflow, settings);
+
+        // Variable-parameter Muskingum-Cunge is not strictly conservative; a
+        // few percent of the event volume is the documented loss.
+        double tolerance = method == RoutingMethod::KinematicWave ? 0.005 : 0.03;
+
+        ASSERT_TRUE(result.isValid);
+        EXPECT_NEAR(calculate_volume(inflow.discharge), calculate_volume(result.outflow),
+                    tolerance * calculate_volume(inflow.discharge)) << get_routing_method_name(method);
+    }
+}
+
+// ============================================================================
+// WAVE SPEED AND ATTENUATION
+// ============================================================================
+
+TEST(HydrographRouterRouting, GivenEventHydrograph_WhenRouting_ExpectPeakDelayedByKinematicTravelTime)
+{
+    ThreadPool pool{1};
+    HydrographRouter router{pool, false};
+    RoutingReach reach = make_reach();
+    double inflowPeakTime{2.0 * 3600.0};
+
+    // The attenuated peak travels slower than the inflow peak would but no
+    // slower than the base flow.
+    double fastestTravelTime = reach.length / calculate_celerity(reach, PEAK_FLOW);
+    double slowestTravelTime = reach.length / calculate_celerity(reach, BASE_FLOW);
+
+    for (RoutingMethod method : METHODS)
+    {
+        RoutingSettings settings;
+        settings.method = method;
+
+        RoutingResult result = router.route(reach, make_event(), settings);
+
+        ASSERT_TRUE(result.isValid);
+        EXPECT_GT(result.peakOutflowTime - inflowPeakTime, fastestTravelTime) << get_routing_method_name(method);
+        EXPECT_LT(result.peakOutflowTime - inflowPeakTime, slowestTravelTime) << get_routing_method_name(method);
+        EXPECT_LT(result.peakOutflow, PEAK_FLOW);
+    }
+}
+
+TEST(HydrographRouterRouting, GivenEventHydrograph_WhenRoutingMuskingumCunge_ExpectMoreAttenuationThanKinematicWave)
+{
+    ThreadPool pool{1};
+    HydrographRouter router{pool, false};
+    RoutingSettings kinematic;
+    kinematic.method = RoutingMethod::KinematicWave;
+    RoutingSettings muskingumCunge;
+
+    // A long, flat reach, where diffusion matters.
+    RoutingReach reach = make_reach();
+    reach.length = 60000.0;
+    reach.bedSlope = 0.0002;
+
+    RoutingResult kinematicResult = router.route(reach, make_event(), kinematic);
+    RoutingResult muskingumCungeResult = router.route(reach, make_event(), muskingumCunge);
+
+    ASSERT_TRUE(kinematicResult.isValid && muskingumCungeResult.isValid);
+    EXPECT_LT(muskingumCungeResult.peakOutflow, kinematicResult.peakOutflow);
+    EXPECT_GT(muskingumCungeResult.peakOutflow, BASE_FLOW);
+}
+
+// ============================================================================
+// GRID AND INPUTS
+// ============================================================================
+
+TEST(HydrographRouterGrid, GivenSpaceStep_WhenRouting_ExpectSegmentsFromIt)
+{
+    ThreadPool pool{1};
+    HydrographRouter router{pool, false};
+    RoutingSettings settings;
+    settings.spaceStep = 3000.0;
+
+    RoutingResult result = router.route(make_reach(), make_event(), settings);
+
+    ASSERT_TRUE(result.isValid);
+    EXPECT_EQ(7u, result.segmentCount);
+    EXPECT_DOUBLE_EQ(20000.0 / 7.0, result.spaceStep);
+}
+
+TEST(HydrographRouterGrid, GivenAutomaticSpaceStep_WhenRouting_ExpectLargestStepMeetingCungeCriterion)
+{
+    ThreadPool pool{1};
+    HydrographRouter router{pool, false};
+    RoutingReach reach = make_reach();
+    TrapezoidalSection section = std::get<TrapezoidalSection>(reach.section);
+
+    double depth = Analyzer{}.solve_section(section, Flow{PEAK_FLOW, reach.manningN}, reach.bedSlope,
+                                            UnitSystemConstants::get_mannings_coefficient(false),
+                                            UnitSystemConstants::get_gravity(false)).normalDepth;
+    double celerity = calculate_celerity(reach, PEAK_FLOW);
+    double limit = 0.5 * (celerity * TIME_STEP + PEAK_FLOW / (section.calculate_top_width(depth) * reach.bedSlope * celerity));
+
+    RoutingResult result = router.route(reach, make_event(), RoutingSettings{});
+
+    ASSERT_TRUE(result.isValid);
+    EXPECT_LE(result.spaceStep, 1.001 * limit);
+    EXPECT_GT(reach.length / static_cast<double>(result.segmentCount - 1), 0.999 * limit);
+    EXPECT_DOUBLE_EQ(reach.length, result.spaceStep * static_cast<double>(result.segmentCount));
+}
+
+TEST(HydrographRouterGrid, GivenInvalidInputs_WhenRouting_ExpectInvalidResult)
+{
+    ThreadPool pool{1};
+    HydrographRouter router{pool, false};
+    RoutingReach badReach = make_reach();
+    badReach.bedSlope = 0.0;
+
+    EXPECT_FALSE(router.route(badReach, make_event(), RoutingSettings{}).isValid);
+    EXPECT_FALSE(router.route(make_reach(), Hydrograph{0.0, {1.0, 2.0}}, RoutingSettings{}).isValid);
+    EXPECT_FALSE(router.route(make_reach(), Hydrograph{TIME_STEP, {}}, RoutingSettings{}).isValid);
+    EXPECT_FALSE(router.route(make_reach(), Hydrograph{TIME_STEP, {1.0, -2.0}}, RoutingSettings{}).isValid);
+}
+
+TEST(HydrographRouterGrid, GivenDryReach_WhenRouting_ExpectZeroOutflow)
+{
+    ThreadPool pool{1};
+    HydrographRouter router{pool, false};
+
+    RoutingResult result = router.route(make_reach(), Hydrograph{TIME_STEP, std::vector<double>(10, 0.0)}, RoutingSettings{});
+
+    ASSERT_TRUE(result.isValid);
+    EXPECT_EQ(10u, result.outflow.size());
+    EXPECT_DOUBLE_EQ(0.0, result.peakOutflow);
+}
+
+// ============================================================================
+// PARALLEL ROUTING
+// ============================================================================
+
+TEST(HydrographRouterParallel, GivenSeveralReaches_WhenRoutingAll_ExpectSameAsOneByOne)
+{
+    ThreadPool pool{4};
+    HydrographRouter router{pool, false};
+    std::vector<RoutingReach> reaches;
+    std::vector<Hydrograph> inflows;
+
+    for (int i = 0; i < 6; ++i)
+    {
+        RoutingReach reach = make_reach();
+        reach.length = 5000.0 * (i + 1);
+        reaches.push_back(reach);
+        inflows.push_back(make_event());
+    }
+
+    std::vector<RoutingResult> results = router.route_all(reaches, inflows, RoutingSettings{});
+
+    ASSERT_EQ(reaches.size(), results.size());
+    for (std::size_t i = 0; i < reaches.size(); ++i)
+    {
+        RoutingResult expected = router.route(reaches[i], inflows[i], RoutingSettings{});
+        ASSERT_TRUE(results[i].isValid);
+        EXPECT_EQ(expected.outflow, results[i].outflow);
+    }
+
+    EXPECT_FALSE(router.route_all(reaches, {}, RoutingSettings{}).front().isValid);
+}
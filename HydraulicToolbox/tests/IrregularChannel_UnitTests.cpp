@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "Analyzer.h"
+#include "IrregularChannel.h"
+#include "TrapezoidalChannel.h"
+#include "UnitSystemConstants.h"
+#include <cmath>
+#include <vector>
+
+namespace
+{
+// Trapezoid with a 4 m base and 2:1 side slopes, banks 5 m above the invert.
+IrregularChannel make_trapezoid_survey(double depth)
+{
+    return IrregularChannel{{0.0, 10.0, 14.0, 24.0}, {105.0, 100.0, 100.0, 105.0}, depth};
+}
+}
+
+// ============================================================================
+// GEOMETRY
+// ============================================================================
+
+TEST(IrregularChannelGeometry, GivenTrapezoidSurvey_WhenCalculatingProperties_ExpectTrapezoidalValues)
+{
+    IrregularChannel survey = make_trapezoid_survey(3.0);
+    TrapezoidalChannel trapezoid{4.0, 2.0, 3.0};
+
+    EXPECT_DOUBLE_EQ(trapezoid.calculate_area(), survey.calculate_area());
+    EXPECT_DOUBLE_EQ(trapezoid.calculate_wetted_perimeter(), survey.calculate_wetted_perimeter());
+    EXPECT_DOUBLE_EQ(trapezoid.calculate_top_width(), survey.calculate_top_width());
+    EXPECT_DOUBLE_EQ(trapezoid.calculate_wetted_perimeter_derivative(), survey.calculate_wetted_perimeter_derivative());
+    EXPECT_NEAR(trapezoid.calculate_first_moment_of_area(), survey.calculate_first_moment_of_area(), 1e-12);
+    EXPECT_TRUE(survey.is_valid());
+}
+
+TEST(IrregularChannelGeometry, GivenDepthAboveBanks_WhenCalculatingProperties_ExpectVerticalWallExtension)
+{
+    IrregularChannel rectangle{{0.0, 0.0, 4.0, 4.0}, {1.0, 0.0, 0.0, 1.0}, 2.0};
+
+    EXPECT_DOUBLE_EQ(8.0, rectangle.calculate_area());
+    EXPECT_DOUBLE_EQ(8.0, rectangle.calculate_wetted_perimeter());
+    EXPECT_DOUBLE_EQ(4.0, rectangle.calculate_top_width());
+    EXPECT_DOUBLE_EQ(2.0, rectangle.calculate_wetted_perimeter_derivative());
+    EXPECT_DOUBLE_EQ(1.0, rectangle.get_bank_full_depth());
+}
+
+TEST(IrregularChannelGeometry, GivenIslandAboveWater_WhenCalculatingProperties_ExpectTwoWettedRegions)
+{
+    // Two V channels 2 m deep separated by a bar 1 m above their inverts.
+    IrregularChannel channel{{0.0, 2.0, 4.0, 6.0, 8.0}, {2.0, 0.0, 1.0, 0.0, 2.0}, 0.5};
+
+    // Each channel has 1:1 outer and 2:1 bar slopes: top width 1.5, area 0.375.
+    EXPECT_EQ(2u, channel.count_wetted_regions());
+    EXPECT_DOUBLE_EQ(3.0, channel.calculate_top_width());
+    EXPECT_DOUBLE_EQ(0.75, channel.calculate_area());
+
+    channel.set_depth(1.5);
+    EXPECT_EQ(1u, channel.count_wetted_regions());
+    EXPECT_DOUBLE_EQ(7.0, channel.calculate_top_width());
+}
+
+TEST(IrregularChannelGeometry, GivenSurfaceTouchingIsland_WhenCountingRegions_ExpectRegionsStaySeparate)
+{
+    IrregularChannel channel{{0.0, 2.0, 4.0, 6.0, 8.0}, {2.0, 0.0, 1.0, 0.0, 2.0}, 1.0};
+
+    EXPECT_EQ(2u, channel.count_wetted_regions());
+}
+
+TEST(IrregularChannelGeometry, GivenManyPointSurvey_WhenChangingDepth_ExpectDerivativesMatchFiniteDifferences)
+{
+    std::vector<double> stations;
+    std::vector<double> elevations;
+
+    for (int i = 0; i <= 200; ++i)
+    {
+        double station = 0.5 * i;
+        stations.push_back(station);
+        elevations.push_back(0.002 * (station - 50.0) * (station - 50.0) + 0.3 * std::sin(0.7 * station));
+    }
+
+    constexpr double DEPTH{2.3};
+    constexpr double STEP{1e-6};
+
+    IrregularChannel channel{stations, elevations, DEPTH};
+    SectionProperties below = channel.evaluate(DEPTH - STEP);
+    SectionProperties above = channel.evaluate(DEPTH + STEP);
+
+    EXPECT_GT(channel.count_wetted_regions(), 1u);
+    EXPECT_NEAR(channel.calculate_top_width(), (above.area - below.area) / (2.0 * STEP), 1e-6);
+    EXPECT_NEAR(channel.calculate_wetted_perimeter_derivative(),
+                (above.wettedPerimeter - below.wettedPerimeter) / (2.0 * STEP), 1e-4);
+    EXPECT_NEAR(channel.calculate_area(), channel.evaluate(DEPTH).area, 0.0);
+}
+
+TEST(IrregularChannelGeometry, GivenInvalidSurveys_WhenCreatingChannel_ExpectInvalidConfiguration)
+{
+    EXPECT_FALSE((IrregularChannel{{0.0}, {1.0}, 1.0}.is_valid()));
+    EXPECT_FALSE((IrregularChannel{{0.0, 1.0}, {1.0}, 1.0}.is_valid()));
+    EXPECT_FALSE((IrregularChannel{{0.0, 2.0, 1.0}, {1.0, 0.0, 1.0}, 1.0}.is_valid()));
+    EXPECT_FALSE((IrregularChannel{{0.0, 0.0}, {1.0, 0.0}, 1.0}.is_valid()));
+    EXPECT_FALSE(make_trapezoid_survey(0.0).is_valid());
+    EXPECT_DOUBLE_EQ(0.0, make_trapezoid_survey(-1.0).calculate_area());
+}
+
+// ============================================================================
+// NORMAL DEPTH
+// ============================================================================
+
+TEST(IrregularChannelSolve, GivenTrapezoidSurvey_WhenSolvingNormalDepth_ExpectTrapezoidalDepth)
+{
+    Analyzer analyzer;
+    Flow flow{25.0, 0.015};
+    IrregularChannel survey = make_trapezoid_survey(0.0);
+
+    AnalysisResult irregular = analyzer.solve_for_depth(survey, flow, 0.001, UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                        UnitSystemConstants::GRAVITY_SI);
+    AnalysisResult trapezoidal = analyzer.solve_section(TrapezoidalSection{4.0, 2.0}, flow, 0.001,
+                                                        UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                        UnitSystemConstants::GRAVITY_SI);
+
+    ASSERT_TRUE(irregular.isValid);
+    EXPECT_NEAR(trapezoidal.normalDepth, irregular.normalDepth, 1e-8);
+    EXPECT_NEAR(trapezoidal.froudeNumber, irregular.froudeNumber, 1e-8);
+}
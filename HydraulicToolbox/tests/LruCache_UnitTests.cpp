@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include "LruCache.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// LOOKUP AND EVICTION
+// ============================================================================
+
+TEST(LruCacheLookup, GivenInsertedValue_WhenFinding_ExpectValueAndHit)
+{
+    LruCache<int, std::string> cache{4};
+    cache.insert(1, "one");
+
+    std::optional<std::string> value = cache.find(1);
+
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ("one", *value);
+    EXPECT_FALSE(cache.find(2).has_value());
+
+    CacheStatistics statistics = cache.get_statistics();
+    EXPECT_EQ(1u, statistics.hitCount);
+    EXPECT_EQ(1u, statistics.missCount);
+    EXPECT_EQ(1u, statistics.size);
+    EXPECT_EQ(4u, statistics.capacity);
+}
+
+TEST(LruCacheLookup, GivenFullCache_WhenInserting_ExpectLeastRecentlyUsedEvicted)
+{
+    LruCache<int, int> cache{3};
+    cache.insert(1, 10);
+    cache.insert(2, 20);
+    cache.insert(3, 30);
+
+    cache.find(1);           // 2 is now the least recently used
+    cache.insert(4, 40);
+
+    EXPECT_TRUE(cache.find(1).has_value());
+    EXPECT_FALSE(cache.find(2).has_value());
+    EXPECT_TRUE(cache.find(3).has_value());
+    EXPECT_TRUE(cache.find(4).has_value());
+    EXPECT_EQ(1u, cache.get_statistics().evictionCount);
+}
+
+TEST(LruCacheLookup, GivenExistingKey_WhenInserting_ExpectValueReplacedWithoutEviction)
+{
+    LruCache<int, int> cache{2};
+    cache.insert(1, 10);
+    cache.insert(2, 20);
+    cache.insert(1, 11);
+
+    EXPECT_EQ(11, *cache.find(1));
+    EXPECT_EQ(20, *cache.find(2));
+    EXPECT_EQ(2u, cache.get_statistics().size);
+    EXPECT_EQ(0u, cache.get_statistics().evictionCount);
+}
+
+TEST(LruCacheLookup, GivenSmallerCapacity_WhenResizing_ExpectOldestEntriesEvicted)
+{
+    LruCache<int, int> cache{4};
+    for (int i = 0; i < 4; ++i)
+        cache.insert(i, i);
+
+    cache.set_capacity(2);
+
+    EXPECT_EQ(2u, cache.get_statistics().size);
+    EXPECT_FALSE(cache.find(0).has_value());
+    EXPECT_TRUE(cache.find(3).has_value());
+}
+
+TEST(LruCacheLookup, GivenZeroCapacity_WhenInserting_ExpectNothingStored)
+{
+    LruCache<int, int> cache{0};
+    cache.insert(1, 10);
+
+    EXPECT_FALSE(cache.find(1).has_value());
+    EXPECT_EQ(0u, cache.get_statistics().size);
+}
+
+TEST(LruCacheLookup, GivenEntries_WhenClearing_ExpectEmptyCacheWithStatisticsKept)
+{
+    LruCache<int, int> cache{4};
+    cache.insert(1, 10);
+    cache.find(1);
+
+    cache.clear();
+
+    EXPECT_FALSE(cache.find(1).has_value());
+    CacheStatistics statistics = cache.get_statistics();
+    EXPECT_EQ(0u, statistics.size);
+    EXPECT_EQ(1u, statistics.hitCount);
+
+    cache.reset_statistics();
+    EXPECT_EQ(0u, cache.get_statistics().hitCount);
+    EXPECT_EQ(0u, cache.get_statistics().missCount);
+}
+
+// ============================================================================
+// CONCURRENCY
+// ============================================================================
+
+TEST(LruCacheConcurrency, GivenSeveralThreads_WhenReadingAndWriting_ExpectConsistentCounters)
+{
+    constexpr int THREAD_COUNT{4};
+    constexpr int OPERATIONS{5000};
+    LruCache<int, int> cache{64};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREAD_COUNT; ++t)
+    {
+        threads.emplace_back([&cache, t]()
+        {
+            for (int i = 0; i < OPERATIONS; ++i)
+            {
+                int key = (i * 7 + t) % 128;
+                if (std::optional<int> value = cache.find(key))
+                    EXPECT_EQ(key * 2, *value);
+                else
+                    cache.insert(key, key * 2);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    CacheStatistics statistics = cache.get_statistics();
+    EXPECT_EQ(static_cast<std::uint64_t>(THREAD_COUNT * OPERATIONS), statistics.hitCount + statistics.missCount);
+    EXPECT_LE(statistics.size, 64u);
+}
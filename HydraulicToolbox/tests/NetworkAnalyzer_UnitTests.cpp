@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+#include "NetworkAnalyzer.h"
+#include "ChannelNetwork.h"
+#include "CriticalFlowAnalyzer.h"
+#include "UnitSystemConstants.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+NetworkReach make_reach(double lateralInflow, std::size_t downstream, double bedSlope = 0.001)
+{
+    NetworkReach reach;
+    reach.section = RectangularSection{3.0};
+    reach.length = 500.0;
+    reach.bedSlope = bedSlope;
+    reach.manningN = 0.013;
+    reach.lateralInflow = lateralInflow;
+    reach.downstream = downstream;
+    return reach;
+}
+
+// Two headwater reaches joining into one outlet.
+ChannelNetwork make_confluence()
+{
+    return ChannelNetwork{{make_reach(2.0, 2), make_reach(3.0, 2), make_reach(1.0, NO_REACH)}};
+}
+
+// Random tree in which reach i > 0 drains into a reach with a lower index,
+// sized to the discharge it collects.
+ChannelNetwork make_random_network(std::size_t reachCount)
+{
+    std::mt19937 generator{7};
+    std::uniform_real_distribution<double> inflow{0.05, 0.5};
+    std::uniform_real_distribution<double> logSlope{-3.5, -1.5};
+
+    std::vector<NetworkReach> reaches(reachCount);
+    std::vector<double> discharge(reachCount);
+
+    for (std::size_t i = 0; i < reachCount; ++i)
+    {
+        reaches[i].downstream = i == 0 ? NO_REACH : std::uniform_int_distribution<std::size_t>{0, i - 1}(generator);
+        reaches[i].lateralInflow = inflow(generator);
+        reaches[i].bedSlope = std::pow(10.0, logSlope(generator));
+        reaches[i].length = 200.0;
+        reaches[i].manningN = 0.015;
+        discharge[i] = reaches[i].lateralInflow;
+    }
+
+    for (std::size_t i = reachCount - 1; i > 0; --i)
+        discharge[reaches[i].downstream] += discharge[i];
+
+    for (std::size_t i = 0; i < reachCount; ++i)
+        reaches[i].section = TrapezoidalSection{std::max(0.5, std::pow(discharge[i], 0.4)), 2.0};
+
+    return ChannelNetwork{std::move(reaches)};
+}
+}
+
+// ============================================================================
+// TOPOLOGY
+// ============================================================================
+
+TEST(ChannelNetworkTopology, GivenConfluence_WhenBuilding_ExpectHeadwatersOutletAndOrder)
+{
+    ChannelNetwork network = make_confluence();
+
+    ASSERT_TRUE(network.is_valid());
+    EXPECT_EQ((std::vector<std::size_t>{0, 1}), network.get_headwaters());
+    EXPECT_EQ((std::vector<std::size_t>{2}), network.get_outlets());
+    EXPECT_EQ(2u, network.get_upstream_count(2));
+    EXPECT_EQ(0u, network.get_upstream_count(0));
+    EXPECT_EQ(2u, network.get_topological_order().back());
+}
+
+TEST(ChannelNetworkTopology, GivenBadNetworks_WhenBuilding_ExpectMatchingError)
+{
+    EXPECT_EQ(NetworkError::Empty, ChannelNetwork{}.get_error());
+    EXPECT_EQ(NetworkError::Empty, ChannelNetwork{std::vector<NetworkReach>{}}.get_error());
+    EXPECT_EQ(NetworkError::InvalidDownstream, (ChannelNetwork{{make_reach(1.0, 5)}}.get_error()));
+    EXPECT_EQ(NetworkError::InvalidDownstream, (ChannelNetwork{{make_reach(1.0, 0)}}.get_error()));
+    EXPECT_EQ(NetworkError::Cycle, (ChannelNetwork{{make_reach(1.0, 1), make_reach(1.0, 0), make_reach(1.0, NO_REACH)}}.get_error()));
+    EXPECT_EQ(NetworkError::InvalidReach, (ChannelNetwork{{make_reach(1.0, NO_REACH, -0.001)}}.get_error()));
+    EXPECT_STREQ("Reaches form a loop", get_network_error_message(NetworkError::Cycle));
+}
+
+// ============================================================================
+// FLOW ACCUMULATION AND BOUNDARY PROPAGATION
+// ============================================================================
+
+TEST(NetworkAnalyzerSolving, GivenConfluence_WhenSolving_ExpectAccumulatedDischarge)
+{
+    WorkStealingPool pool{2};
+    NetworkAnalyzer analyzer{pool, false};
+
+    NetworkResult result = analyzer.solve(make_confluence());
+
+    ASSERT_TRUE(result.isValid);
+    EXPECT_DOUBLE_EQ(2.0, result.reaches[0].discharge);
+    EXPECT_DOUBLE_EQ(3.0, result.reaches[1].discharge);
+    EXPECT_DOUBLE_EQ(6.0, result.reaches[2].discharge);
+}
+
+TEST(NetworkAnalyzerSolving, GivenSingleReachWithoutTailwater_WhenSolving_ExpectUniformFlowAtNormalDepth)
+{
+    WorkStealingPool pool{1};
+    NetworkAnalyzer analyzer{pool, false};
+
+    NetworkResult result = analyzer.solve(ChannelNetwork{{make_reach(5.0, NO_REACH)}});
+
+    AnalysisResult normal = Analyzer{}.solve_section(RectangularSection{3.0}, Flow{5.0, 0.013}, 0.001,
+                                                     UnitSystemConstants::get_mannings_coefficient(false),
+                                                     UnitSystemConstants::get_gravity(false));
+
+    ASSERT_TRUE(result.isValid);
+    EXPECT_DOUBLE_EQ(normal.normalDepth, result.reaches[0].normalDepth);
+    EXPECT_DOUBLE_EQ(normal.normalDepth, result.reaches[0].downstreamDepth);
+    EXPECT_NEAR(normal.normalDepth, result.reaches[0].upstreamDepth, 1e-6);
+}
+
+TEST(NetworkAnalyzerSolving, GivenHighTailwater_WhenSolving_ExpectBackwaterCarriedAcrossJunction)
+{
+    WorkStealingPool pool{2};
+    NetworkAnalyzer analyzer{pool, false};
+
+    NetworkReach upstream = make_reach(4.0, 1);
+    upstream.junctionDrop = 0.1;
+    NetworkResult result = analyzer.solve(ChannelNetwork{{upstream, make_reach(1.0, NO_REACH)}}, 3.0);
+
+    ASSERT_TRUE(result.isValid);
+    const NetworkReachResult& outlet = result.reaches[1];
+    EXPECT_DOUBLE_EQ(3.0, outlet.downstreamDepth);
+    EXPECT_EQ(ProfileType::M1, outlet.profileType);
+    EXPECT_LT(outlet.upstreamDepth, 3.0);
+    EXPECT_GT(outlet.upstreamDepth, outlet.normalDepth);
+
+    EXPECT_DOUBLE_EQ(outlet.upstreamDepth - 0.1, result.reaches[0].downstreamDepth);
+    EXPECT_EQ(ProfileType::M1, result.reaches[0].profileType);
+}
+
+TEST(NetworkAnalyzerSolving, GivenTailwaterBelowCritical_WhenSolving_ExpectCriticalDepthControl)
+{
+    WorkStealingPool pool{1};
+    NetworkAnalyzer analyzer{pool, false};
+
+    NetworkResult result = analyzer.solve(ChannelNetwork{{make_reach(5.0, NO_REACH)}}, 0.1);
+
+    ASSERT_TRUE(result.isValid);
+    EXPECT_DOUBLE_EQ(result.reaches[0].criticalDepth, result.reaches[0].downstreamDepth);
+    EXPECT_EQ(ProfileType::M2, result.reaches[0].profileType);
+}
+
+TEST(NetworkAnalyzerSolving, GivenSteepReach_WhenSolving_ExpectCriticalDepthAtUpstreamEnd)
+{
+    WorkStealingPool pool{1};
+    NetworkAnalyzer analyzer{pool, false};
+
+    // Short enough that the S2 drawdown has not yet reached normal depth.
+    NetworkReach steep = make_reach(5.0, NO_REACH, 0.05);
+    steep.length = 5.0;
+    NetworkResult result = analyzer.solve(ChannelNetwork{{steep}}, 2.0);
+
+    ASSERT_TRUE(result.isValid);
+    const NetworkReachResult& reach = result.reaches[0];
+    EXPECT_LT(reach.normalDepth, reach.criticalDepth);
+    EXPECT_DOUBLE_EQ(reach.criticalDepth, reach.upstreamDepth);
+    EXPECT_LT(reach.downstreamDepth, reach.criticalDepth);
+    EXPECT_GT(reach.downstreamDepth, reach.normalDepth);
+    EXPECT_EQ(ProfileType::S2, reach.profileType);
+}
+
+TEST(NetworkAnalyzerSolving, GivenDryHeadwater_WhenSolving_ExpectValidZeroDepths)
+{
+    WorkStealingPool pool{1};
+    NetworkAnalyzer analyzer{pool, false};
+
+    NetworkResult result = analyzer.solve(ChannelNetwork{{make_reach(0.0, 1), make_reach(2.0, NO_REACH)}});
+
+    ASSERT_TRUE(result.isValid);
+    EXPECT_DOUBLE_EQ(0.0, result.reaches[0].discharge);
+    EXPECT_DOUBLE_EQ(0.0, result.reaches[0].upstreamDepth);
+    EXPECT_DOUBLE_EQ(2.0, result.reaches[1].discharge);
+}
+
+TEST(NetworkAnalyzerSolving, GivenInvalidNetwork_WhenSolving_ExpectErrorAndNoReaches)
+{
+    WorkStealingPool pool{1};
+    NetworkAnalyzer analyzer{pool, false};
+
+    NetworkResult result = analyzer.solve(ChannelNetwork{{make_reach(1.0, 3)}});
+
+    EXPECT_FALSE(result.isValid);
+    EXPECT_EQ(NetworkError::InvalidDownstream, result.error);
+    EXPECT_TRUE(result.reaches.empty());
+}
+
+// ============================================================================
+// DETERMINISM
+// ============================================================================
+
+TEST(NetworkAnalyzerParallel, GivenRandomNetwork_WhenSolvingWithOneAndFourThreads_ExpectIdenticalResults)
+{
+    ChannelNetwork network = make_random_network(2000);
+    WorkStealingPool serialPool{1};
+    WorkStealingPool parallelPool{4};
+
+    NetworkResult serial = NetworkAnalyzer{serialPool, false}.solve(network, 1.5);
+    NetworkResult parallel = NetworkAnalyzer{parallelPool, false}.solve(network, 1.5);
+
+    ASSERT_TRUE(network.is_valid());
+    ASSERT_EQ(serial.reaches.size(), parallel.reaches.size());
+    EXPECT_EQ(serial.failedReachCount, parallel.failedReachCount);
+    EXPECT_LT(serial.failedReachCount, network.get_reach_count() / 100);
+
+    for (std::size_t i = 0; i < serial.reaches.size(); ++i)
+    {
+        EXPECT_EQ(serial.reaches[i].discharge, parallel.reaches[i].discharge);
+        EXPECT_EQ(serial.reaches[i].upstreamDepth, parallel.reaches[i].upstreamDepth);
+        EXPECT_EQ(serial.reaches[i].downstreamDepth, parallel.reaches[i].downstreamDepth);
+        EXPECT_EQ(serial.reaches[i].profileType, parallel.reaches[i].profileType);
+    }
+}
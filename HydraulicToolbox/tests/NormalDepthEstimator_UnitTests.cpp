@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "NormalDepthEstimator.h"
+#include "Analyzer.h"
+#include "Flow.h"
+#include "UnitSystemConstants.h"
+
+namespace
+{
+double geometric_conveyance(const SectionProperties& properties)
+{
+    return properties.area * std::pow(properties.area / properties.wettedPerimeter, 2.0 / 3.0);
+}
+}
+
+// ============================================================================
+// ESTIMATE ACCURACY TESTS
+// ============================================================================
+
+TEST(NormalDepthEstimates, GivenTriangularSection_WhenEstimating_ExpectClosedFormDepth)
+{
+    TriangularSection section{2.0};
+    double depth{2.93};
+
+    double estimate = estimate_normal_depth(section, geometric_conveyance(section.evaluate(depth)));
+
+    EXPECT_NEAR(depth, estimate, 1e-12);
+}
+
+TEST(NormalDepthEstimates, GivenRectangularAndTrapezoidalSections_WhenEstimating_ExpectWithinOnePercent)
+{
+    for (double sideSlope : {0.0, 0.5, 1.3, 2.0, 4.7})
+    {
+        for (double depth : {0.002, 0.05, 1.0, 7.5, 300.0})
+        {
+            TrapezoidalSection section{3.0, sideSlope};
+
+            double estimate = estimate_normal_depth(section, geometric_conveyance(section.evaluate(depth)));
+
+            EXPECT_NEAR(1.0, estimate / depth, 0.01) << "z=" << sideSlope << " y=" << depth;
+        }
+    }
+}
+
+TEST(NormalDepthEstimates, GivenSideSlopeBeyondTable_WhenEstimating_ExpectNoEstimate)
+{
+    TrapezoidalSection section{2.0, 10.0};
+
+    EXPECT_DOUBLE_EQ(0.0, estimate_normal_depth(section, 100.0));
+}
+
+// ============================================================================
+// SOLVER INTEGRATION TESTS
+// ============================================================================
+
+TEST(NormalDepthEstimates, GivenTriangularSection_WhenSolving_ExpectSingleIteration)
+{
+    TriangularSection section{2.0};
+    Flow flow{50.0, 0.013};
+
+    Analyzer analyzer;
+    AnalysisResult result = analyzer.solve_section(section, flow, 0.001,
+                                                   UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                   UnitSystemConstants::GRAVITY_SI);
+
+    EXPECT_TRUE(result.isValid);
+    EXPECT_NEAR(2.930, result.normalDepth, 0.001);
+    EXPECT_EQ(1, result.iterations);
+}
+
+TEST(NormalDepthEstimates, GivenTrapezoidalSection_WhenSolvingWithEstimates_ExpectFewerIterations)
+{
+    TrapezoidalSection section{4.0, 2.0};
+    Flow flow{50.0, 0.013};
+
+    SolverSettings withoutEstimates;
+    withoutEstimates.useDepthEstimates = false;
+
+    AnalysisResult seeded = Analyzer{}.solve_section(section, flow, 0.001,
+                                                     UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                     UnitSystemConstants::GRAVITY_SI);
+    AnalysisResult unseeded = Analyzer{withoutEstimates}.solve_section(section, flow, 0.001,
+                                                                       UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                                       UnitSystemConstants::GRAVITY_SI);
+
+    ASSERT_TRUE(seeded.isValid);
+    ASSERT_TRUE(unseeded.isValid);
+    EXPECT_NEAR(unseeded.normalDepth, seeded.normalDepth, 1e-9);
+    EXPECT_LE(seeded.iterations, 3);
+    EXPECT_LT(seeded.iterations, unseeded.iterations);
+}
+
+TEST(NormalDepthEstimates, GivenDepthBeyondSolverRange_WhenSolvingWithEstimates_ExpectInvalidResult)
+{
+    RectangularSection section{0.01};
+    Flow flow{10000.0, 0.5};
+
+    Analyzer analyzer;
+    AnalysisResult result = analyzer.solve_section(section, flow, 0.00001,
+                                                   UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                   UnitSystemConstants::GRAVITY_SI);
+
+    EXPECT_FALSE(result.isValid);
+}
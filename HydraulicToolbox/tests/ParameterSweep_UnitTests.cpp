@@ -0,0 +1,256 @@
+#include <gtest/gtest.h>
+#include "ParameterSweep.h"
+#include "BatchAnalyzer.h"
+#include "CalculationControl.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+SweepSpecification make_specification()
+{
+    SweepSpecification specification;
+    specification.geometry.channelType = ChannelType::Trapezoidal;
+    specification.geometry.bottomWidth = 3.0;
+    specification.geometry.sideSlope = 1.5;
+    specification.geometry.bedSlope = 0.001;
+    specification.hydraulics.discharge = 10.0;
+    specification.hydraulics.manningN = 0.025;
+    return specification;
+}
+
+// Design-study sweep: b 1-10 m, z 0-4, S 1e-4-1e-2 (log) and Q from a list.
+SweepSpecification make_design_study()
+{
+    SweepSpecification specification = make_specification();
+    specification.axes = {SweepAxis::range(SweepParameter::BottomWidth, 1.0, 10.0, 10),
+                          SweepAxis::range(SweepParameter::SideSlope, 0.0, 4.0, 5),
+                          SweepAxis::range(SweepParameter::BedSlope, 1e-4, 1e-2, 5, SweepScale::Logarithmic),
+                          SweepAxis::list(SweepParameter::Discharge, {5.0, 20.0, 80.0})};
+    return specification;
+}
+}
+
+// ============================================================================
+// CARTESIAN POINTS
+// ============================================================================
+
+TEST(ParameterSweepCartesian, GivenFourAxes_WhenCounting_ExpectProductOfLevels)
+{
+    EXPECT_EQ(10u * 5u * 5u * 3u, make_design_study().get_point_count());
+}
+
+TEST(ParameterSweepCartesian, GivenIndex_WhenGeneratingPoint_ExpectLastAxisFastest)
+{
+    SweepSpecification specification = make_design_study();
+    GeometryData geometry;
+    HydraulicData hydraulics;
+
+    specification.generate_point(0, geometry, hydraulics);
+    EXPECT_DOUBLE_EQ(1.0, geometry.bottomWidth);
+    EXPECT_DOUBLE_EQ(0.0, geometry.sideSlope);
+    EXPECT_NEAR(1e-4, geometry.bedSlope, 1e-16);
+    EXPECT_DOUBLE_EQ(5.0, hydraulics.discharge);
+    EXPECT_DOUBLE_EQ(0.025, hydraulics.manningN);
+
+    specification.generate_point(1, geometry, hydraulics);
+    EXPECT_DOUBLE_EQ(20.0, hydraulics.discharge);
+    EXPECT_DOUBLE_EQ(1.0, geometry.bottomWidth);
+
+    // Level 2 of 5 on the log axis is the geometric midpoint.
+    specification.generate_point(2 * 3, geometry, hydraulics);
+    EXPECT_NEAR(1e-3, geometry.bedSlope, 1e-15);
+
+    specification.generate_point(specification.get_point_count() - 1, geometry, hydraulics);
+    EXPECT_DOUBLE_EQ(10.0, geometry.bottomWidth);
+    EXPECT_DOUBLE_EQ(4.0, geometry.sideSlope);
+    EXPECT_NEAR(1e-2, geometry.bedSlope, 1e-15);
+    EXPECT_DOUBLE_EQ(80.0, hydraulics.discharge);
+}
+
+TEST(ParameterSweepCartesian, GivenInvalidSpecifications_WhenCounting_ExpectZeroPoints)
+{
+    SweepSpecification noChannel = make_design_study();
+    noChannel.geometry.channelType = ChannelType::None;
+
+    SweepSpecification duplicate = make_specification();
+    duplicate.axes = {SweepAxis::list(SweepParameter::Discharge, {1.0}), SweepAxis::list(SweepParameter::Discharge, {2.0})};
+
+    SweepSpecification badLog = make_specification();
+    badLog.axes = {SweepAxis::range(SweepParameter::BedSlope, 0.0, 1e-2, 5, SweepScale::Logarithmic)};
+
+    SweepSpecification noLevels = make_specification();
+    noLevels.axes = {SweepAxis::range(SweepParameter::BedSlope, 1e-4, 1e-2, 0)};
+
+    SweepSpecification overflow = make_specification();
+    overflow.axes = {SweepAxis::range(SweepParameter::BottomWidth, 1.0, 2.0, std::size_t{1} << 32),
+                     SweepAxis::range(SweepParameter::SideSlope, 1.0, 2.0, std::size_t{1} << 32)};
+
+    SweepSpecification noSamples = make_design_study();
+    noSamples.design = SweepDesign::LatinHypercube;
+
+    EXPECT_EQ(0u, noChannel.get_point_count());
+    EXPECT_EQ(0u, duplicate.get_point_count());
+    EXPECT_EQ(0u, badLog.get_point_count());
+    EXPECT_EQ(0u, noLevels.get_point_count());
+    EXPECT_EQ(0u, overflow.get_point_count());
+    EXPECT_EQ(0u, noSamples.get_point_count());
+    EXPECT_EQ(1u, make_specification().get_point_count());
+}
+
+// ============================================================================
+// LATIN HYPERCUBE POINTS
+// ============================================================================
+
+TEST(ParameterSweepLatinHypercube, GivenSamples_WhenGenerating_ExpectOnePointPerStratumOnEveryAxis)
+{
+    SweepSpecification specification = make_specification();
+    specification.design = SweepDesign::LatinHypercube;
+    specification.sampleCount = 1000;
+    specification.axes = {SweepAxis::range(SweepParameter::BottomWidth, 1.0, 10.0, 0),
+                          SweepAxis::range(SweepParameter::BedSlope, 1e-4, 1e-2, 0, SweepScale::Logarithmic)};
+
+    std::vector<int> widthStrata(1000, 0);
+    std::vector<int> slopeStrata(1000, 0);
+    GeometryData geometry;
+    HydraulicData hydraulics;
+
+    for (std::uint64_t i = 0; i < specification.sampleCount; ++i)
+    {
+        specification.generate_point(i, geometry, hydraulics);
+        ++widthStrata[static_cast<std::size_t>((geometry.bottomWidth - 1.0) / 9.0 * 1000.0)];
+        ++slopeStrata[static_cast<std::size_t>(std::log(geometry.bedSlope / 1e-4) / std::log(100.0) * 1000.0)];
+    }
+
+    EXPECT_TRUE(std::all_of(widthStrata.begin(), widthStrata.end(), [](int count) { return count == 1; }));
+    EXPECT_TRUE(std::all_of(slopeStrata.begin(), slopeStrata.end(), [](int count) { return count == 1; }));
+}
+
+TEST(ParameterSweepLatinHypercube, GivenSeed_WhenGenerating_ExpectReproduciblePointsThatDependOnSeed)
+{
+    SweepSpecification specification = make_specification();
+    specification.design = SweepDesign::LatinHypercube;
+    specification.sampleCount = 100;
+    specification.axes = {SweepAxis::range(SweepParameter::Discharge, 1.0, 100.0, 0),
+                          SweepAxis::list(SweepParameter::ManningN, {0.013, 0.025, 0.035})};
+
+    SweepSpecification reseeded = specification;
+    reseeded.seed = 12345;
+
+    GeometryData geometry;
+    HydraulicData first;
+    HydraulicData second;
+    HydraulicData other;
+
+    specification.generate_point(42, geometry, first);
+    specification.generate_point(42, geometry, second);
+    reseeded.generate_point(42, geometry, other);
+
+    EXPECT_EQ(first.discharge, second.discharge);
+    EXPECT_NE(first.discharge, other.discharge);
+    EXPECT_TRUE(first.manningN == 0.013 || first.manningN == 0.025 || first.manningN == 0.035);
+}
+
+// ============================================================================
+// RUNNING
+// ============================================================================
+
+TEST(ParameterSweepRun, GivenSweepOnFourThreads_WhenRunning_ExpectEveryPointOnceAndMatchingBatchResults)
+{
+    WorkStealingPool pool{4};
+    ParameterSweep sweep{pool, false};
+    BatchAnalyzer analyzer{false};
+    SweepSpecification specification = make_design_study();
+
+    std::vector<int> seen(specification.get_point_count(), 0);
+    std::atomic<int> activeSinks{0};
+    bool overlapped{false};
+    bool mismatched{false};
+
+    SweepSummary summary = sweep.run(specification, [&](const SweepChunk& chunk)
+    {
+        overlapped = overlapped || activeSinks.fetch_add(1) != 0;
+
+        for (std::size_t i = 0; i < chunk.count; ++i)
+        {
+            ++seen[chunk.firstPoint + i];
+
+            double depth{0.0};
+            double velocity{0.0};
+            double froudeNumber{0.0};
+            FlowRegime regime{FlowRegime::Subcritical};
+            BatchStatus status{BatchStatus::InvalidInput};
+            BatchInputs inputs{&chunk.bottomWidth[i], &chunk.sideSlope[i], &chunk.discharge[i], &chunk.manningN[i],
+                               &chunk.bedSlope[i], 1};
+            analyzer.solve_for_depth(inputs, BatchOutputs{&depth, &velocity, &froudeNumber, &regime, &status});
+
+            mismatched = mismatched || status != chunk.status[i] || depth != chunk.normalDepth[i];
+        }
+
+        activeSinks.fetch_sub(1);
+    }, nullptr, 64);
+
+    EXPECT_TRUE(summary.isValid);
+    EXPECT_EQ(seen.size(), summary.completedCount);
+    EXPECT_EQ((seen.size() + 63) / 64, summary.chunkCount);
+    EXPECT_EQ(summary.pointCount, summary.convergedCount);
+    EXPECT_TRUE(std::all_of(seen.begin(), seen.end(), [](int count) { return count == 1; }));
+    EXPECT_FALSE(overlapped);
+    EXPECT_FALSE(mismatched);
+}
+
+TEST(ParameterSweepRun, GivenRectangularChannel_WhenRunning_ExpectSideSlopeSolvedAsZero)
+{
+    WorkStealingPool pool{1};
+    ParameterSweep sweep{pool, false};
+    SweepSpecification specification = make_design_study();
+    specification.geometry.channelType = ChannelType::Rectangular;
+
+    bool hasSideSlope{false};
+    sweep.run(specification, [&](const SweepChunk& chunk)
+    {
+        hasSideSlope = hasSideSlope || std::any_of(chunk.sideSlope.begin(), chunk.sideSlope.end(),
+                                                   [](double value) { return value != 0.0; });
+    });
+
+    EXPECT_FALSE(hasSideSlope);
+}
+
+TEST(ParameterSweepRun, GivenCancelFromSink_WhenRunning_ExpectStopWithPartialResults)
+{
+    WorkStealingPool pool{2};
+    ParameterSweep sweep{pool, false};
+    SweepSpecification specification = make_specification();
+    specification.design = SweepDesign::LatinHypercube;
+    specification.sampleCount = 100000;
+    specification.axes = {SweepAxis::range(SweepParameter::Discharge, 1.0, 100.0, 0)};
+
+    double lastProgress{0.0};
+    CalculationControl control{[&lastProgress](double fraction) { lastProgress = fraction; }};
+
+    SweepSummary summary = sweep.run(specification, [&control](const SweepChunk&) { control.cancel(); }, &control, 256);
+
+    EXPECT_TRUE(summary.isCancelled);
+    EXPECT_FALSE(summary.isValid);
+    EXPECT_GE(summary.completedCount, 256u);
+    EXPECT_LT(summary.completedCount, summary.pointCount);
+    EXPECT_DOUBLE_EQ(static_cast<double>(summary.completedCount) / 100000.0, lastProgress);
+}
+
+TEST(ParameterSweepRun, GivenInvalidSpecification_WhenRunning_ExpectNoSinkCalls)
+{
+    WorkStealingPool pool{1};
+    ParameterSweep sweep{pool, false};
+    SweepSpecification specification = make_design_study();
+    specification.geometry.channelType = ChannelType::None;
+
+    int calls{0};
+    SweepSummary summary = sweep.run(specification, [&calls](const SweepChunk&) { ++calls; });
+
+    EXPECT_FALSE(summary.isValid);
+    EXPECT_EQ(0, calls);
+    EXPECT_STREQ("Bed slope", get_sweep_parameter_name(SweepParameter::BedSlope));
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include "RatingCurveGenerator.h"
+#include "ThreadPool.h"
+#include "Analyzer.h"
+#include "UnitSystemConstants.h"
+#include <vector>
+
+namespace
+{
+std::vector<RatingCurveChannel> make_channels(std::size_t count)
+{
+    std::vector<RatingCurveChannel> channels;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        double width = 1.0 + static_cast<double>(i);
+
+        switch (i % 3)
+        {
+        case 0:
+            channels.push_back({RectangularSection{width}, 0.013, 0.001, 5.0});
+            break;
+        case 1:
+            channels.push_back({TrapezoidalSection{width, 2.0}, 0.015, 0.002, 4.0});
+            break;
+        default:
+            channels.push_back({TriangularSection{1.5}, 0.020, 0.0005, 3.0});
+            break;
+        }
+    }
+
+    return channels;
+}
+}
+
+// ============================================================================
+// RATING CURVE VALUES
+// ============================================================================
+
+TEST(RatingCurveGeneratorValues, GivenTrapezoidalChannel_WhenGenerating_ExpectManningDischargeAtEachStage)
+{
+    ThreadPool pool{2};
+    RatingCurveGenerator generator{pool, false};
+    std::vector<RatingCurveChannel> channels{{TrapezoidalSection{4.0, 2.0}, 0.013, 0.001, 5.0}};
+
+    RatingCurveColumns columns = generator.generate_all(channels, 500);
+    TrapezoidalSection section{4.0, 2.0};
+
+    for (std::size_t i = 0; i < 500; i += 37)
+    {
+        double depth = 5.0 * static_cast<double>(i + 1) / 500.0;
+        double expectedDischarge = calculate_manning_discharge(section.calculate_area(depth),
+                                                               section.calculate_wetted_perimeter(depth),
+                                                               0.013, 0.001,
+                                                               UnitSystemConstants::MANNINGS_COEFFICIENT_SI);
+
+        EXPECT_NEAR(depth, columns.depth[i], 1e-12);
+        EXPECT_NEAR(section.calculate_area(depth), columns.area[i], 1e-12);
+        EXPECT_NEAR(expectedDischarge, columns.discharge[i], 1e-9 * expectedDischarge);
+        EXPECT_NEAR(columns.discharge[i] / columns.area[i], columns.velocity[i], 1e-12);
+    }
+}
+
+TEST(RatingCurveGeneratorValues, GivenAnyChannel_WhenGenerating_ExpectDischargeIncreasingWithStage)
+{
+    ThreadPool pool{2};
+    RatingCurveGenerator generator{pool, true};
+    std::vector<RatingCurveChannel> channels = make_channels(3);
+
+    RatingCurveColumns columns = generator.generate_all(channels, 200);
+
+    for (std::size_t c = 0; c < channels.size(); ++c)
+    {
+        for (std::size_t i = 1; i < 200; ++i)
+            EXPECT_GT(columns.discharge[c * 200 + i], columns.discharge[c * 200 + i - 1]);
+    }
+}
+
+TEST(RatingCurveGeneratorValues, GivenInvalidChannel_WhenGenerating_ExpectZeroRows)
+{
+    ThreadPool pool{2};
+    RatingCurveGenerator generator{pool, false};
+    std::vector<RatingCurveChannel> channels{{RectangularSection{5.0}, 0.0, 0.001, 5.0}};
+
+    RatingCurveColumns columns = generator.generate_all(channels, 50);
+
+    for (double discharge : columns.discharge)
+        EXPECT_DOUBLE_EQ(0.0, discharge);
+}
+
+// ============================================================================
+// STREAMING
+// ============================================================================
+
+TEST(RatingCurveGeneratorStreaming, GivenManyChannels_WhenStreaming_ExpectOrderedChunksMatchingMaterializedCurves)
+{
+    ThreadPool pool{4};
+    RatingCurveGenerator generator{pool, false};
+    generator.set_channels_per_chunk(7);
+
+    std::vector<RatingCurveChannel> channels = make_channels(50);
+    std::size_t levelCount{300};
+
+    RatingCurveColumns expected = generator.generate_all(channels, levelCount);
+
+    std::size_t nextChannel{0};
+    std::size_t chunkCount{0};
+
+    generator.generate(channels, levelCount, [&](const RatingCurveChunk& chunk)
+    {
+        EXPECT_EQ(nextChannel, chunk.firstChannel);
+        EXPECT_LE(chunk.channelCount, 7u);
+
+        for (std::size_t row = 0; row < chunk.channelCount * levelCount; ++row)
+        {
+            std::size_t globalRow = chunk.firstChannel * levelCount + row;
+            EXPECT_DOUBLE_EQ(expected.discharge[globalRow], chunk.discharge[row]);
+            EXPECT_DOUBLE_EQ(expected.froudeNumber[globalRow], chunk.froudeNumber[row]);
+        }
+
+        nextChannel += chunk.channelCount;
+        ++chunkCount;
+    });
+
+    EXPECT_EQ(channels.size(), nextChannel);
+    EXPECT_EQ(8u, chunkCount);
+}
+
+TEST(RatingCurveGeneratorStreaming, GivenThrowingConsumer_WhenStreaming_ExpectExceptionPropagates)
+{
+    ThreadPool pool{2};
+    RatingCurveGenerator generator{pool, false};
+    generator.set_channels_per_chunk(2);
+
+    std::vector<RatingCurveChannel> channels = make_channels(10);
+
+    EXPECT_THROW(generator.generate(channels, 100, [](const RatingCurveChunk&) { throw std::runtime_error("stop"); }),
+                 std::runtime_error);
+}
@@ -53,3 +53,23 @@ TEST(RectangularChannelGeometry, GivenNegativeDepth_WhenCreatingChannel_ExpectIn
 
     EXPECT_FALSE(channel.is_valid());
 }
+
+TEST(RectangularChannelGeometry, GivenWidthAndDepth_WhenCalculatingWettedPerimeterDerivative_ExpectTwo)
+{
+    double width{5.0};
+    double depth{2.0};
+
+    RectangularChannel channel{width, depth};
+
+    EXPECT_DOUBLE_EQ(2.0, channel.calculate_wetted_perimeter_derivative());
+}
+
+TEST(RectangularChannelGeometry, GivenDimensions_WhenCalculatingFirstMomentOfArea_ExpectAreaTimesCentroidDepth)
+{
+    double width{5.0};
+    double depth{2.0};
+
+    RectangularChannel channel{width, depth};
+
+    EXPECT_DOUBLE_EQ(10.0, channel.calculate_first_moment_of_area());
+}
@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+#include "RootFinding.h"
+#include <cmath>
+
+// ============================================================================
+// BRENT'S METHOD TESTS
+// ============================================================================
+
+TEST(RootFindingBrent, GivenCubicWithBracketedRoot_WhenSolving_ExpectRoot)
+{
+    auto cubic = [](double x) { return x * x * x - 2.0 * x - 5.0; };
+
+    RootResult result = find_root_brent(cubic, 2.0, 3.0, 1e-12, 100);
+
+    EXPECT_TRUE(result.converged);
+    EXPECT_NEAR(2.0945514815423265, result.root, 1e-10);
+}
+
+TEST(RootFindingBrent, GivenSmoothFunction_WhenSolving_ExpectFewerIterationsThanBisection)
+{
+    auto function = [](double x) { return std::exp(x) - 10.0; };
+
+    RootResult result = find_root_brent(function, 0.0, 10.0, 1e-12, 100);
+
+    // Bisection needs about 44 halvings for this bracket and tolerance.
+    EXPECT_TRUE(result.converged);
+    EXPECT_NEAR(std::log(10.0), result.root, 1e-10);
+    EXPECT_LT(result.iterations, 20);
+}
+
+TEST(RootFindingBrent, GivenEndpointsWithSameSign_WhenSolving_ExpectNotConverged)
+{
+    auto function = [](double x) { return x * x + 1.0; };
+
+    RootResult result = find_root_brent(function, -1.0, 1.0, 1e-12, 100);
+
+    EXPECT_FALSE(result.converged);
+}
@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+#include "ScenarioReader.h"
+#include "ResultWriter.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+std::vector<Scenario> read_all(const std::string& text, ScenarioFormat format, std::string* error = nullptr)
+{
+    std::istringstream input{text};
+    ScenarioReader reader{input, format};
+    std::vector<Scenario> scenarios;
+
+    while (reader.read(scenarios, 2) > 0)
+    {
+    }
+
+    if (error)
+        *error = reader.get_error();
+
+    return scenarios;
+}
+}
+
+// ============================================================================
+// CSV INPUT
+// ============================================================================
+
+TEST(ScenarioReaderCsv, GivenHeaderInAnyOrder_WhenReading_ExpectFieldsMappedByName)
+{
+    std::string text =
+        "bed_slope,manning_n,discharge,side_slope,bottom_width,id\n"
+        "0.001,0.013,10,1.5,3,channel-a\n";
+
+    std::vector<Scenario> scenarios = read_all(text, ScenarioFormat::Csv);
+
+    ASSERT_EQ(1u, scenarios.size());
+    EXPECT_TRUE(scenarios[0].isValid);
+    EXPECT_EQ("channel-a", scenarios[0].id);
+    EXPECT_DOUBLE_EQ(3.0, scenarios[0].bottomWidth);
+    EXPECT_DOUBLE_EQ(1.5, scenarios[0].sideSlope);
+    EXPECT_DOUBLE_EQ(10.0, scenarios[0].discharge);
+    EXPECT_DOUBLE_EQ(0.013, scenarios[0].manningN);
+    EXPECT_DOUBLE_EQ(0.001, scenarios[0].bedSlope);
+}
+
+TEST(ScenarioReaderCsv, GivenOptionalBankRoughness_WhenReading_ExpectBankNOrZero)
+{
+    std::string text =
+        "id,bottom_width,side_slope,discharge,manning_n,bed_slope,bank_manning_n\n"
+        "lined,3,1.5,10,0.013,0.001,0.035\n"
+        "plain,3,1.5,10,0.013,0.001,\n";
+
+    std::vector<Scenario> scenarios = read_all(text, ScenarioFormat::Csv);
+
+    ASSERT_EQ(2u, scenarios.size());
+    EXPECT_TRUE(scenarios[0].isValid);
+    EXPECT_DOUBLE_EQ(0.035, scenarios[0].bankManningN);
+    EXPECT_TRUE(scenarios[1].isValid);
+    EXPECT_DOUBLE_EQ(0.0, scenarios[1].bankManningN);
+}
+
+TEST(ScenarioReaderCsv, GivenShapes_WhenReading_ExpectUnusedDimensionZeroed)
+{
+    std::string text =
+        "shape,bottom_width,side_slope,discharge,manning_n,bed_slope\n"
+        "Rectangular,3,2,10,0.013,0.001\n"
+        "triangular,3,2,10,0.013,0.001\n";
+
+    std::vector<Scenario> scenarios = read_all(text, ScenarioFormat::Csv);
+
+    ASSERT_EQ(2u, scenarios.size());
+    EXPECT_DOUBLE_EQ(3.0, scenarios[0].bottomWidth);
+    EXPECT_DOUBLE_EQ(0.0, scenarios[0].sideSlope);
+    EXPECT_DOUBLE_EQ(0.0, scenarios[1].bottomWidth);
+    EXPECT_DOUBLE_EQ(2.0, scenarios[1].sideSlope);
+}
+
+TEST(ScenarioReaderCsv, GivenCommentsBlankLinesAndQuotedId_WhenReading_ExpectRecordsAndRowIds)
+{
+    std::string text =
+        "# design checks\n"
+        "id,bottom_width,discharge,manning_n,bed_slope\n"
+        "\n"
+        "\"reach 1, left\",3,10,0.013,0.001\n"
+        "# skipped\n"
+        ",4,12,0.013,0.001\r\n";
+
+    std::vector<Scenario> scenarios = read_all(text, ScenarioFormat::Csv);
+
+    ASSERT_EQ(2u, scenarios.size());
+    EXPECT_EQ("reach 1, left", scenarios[0].id);
+    EXPECT_EQ("2", scenarios[1].id);
+    EXPECT_DOUBLE_EQ(0.001, scenarios[1].bedSlope);
+}
+
+TEST(ScenarioReaderCsv, GivenMalformedOrMissingValues_WhenReading_ExpectInvalidRecordsWithReason)
+{
+    std::string text =
+        "shape,bottom_width,side_slope,discharge,manning_n,bed_slope\n"
+        "trapezoidal,3,1,10x,0.013,0.001\n"
+        "trapezoidal,3,,10,0.013,0.001\n"
+        "circular,3,1,10,0.013,0.001\n"
+        "trapezoidal,3,1,10,0.013,0.001\n";
+
+    std::vector<Scenario> scenarios = read_all(text, ScenarioFormat::Csv);
+
+    ASSERT_EQ(4u, scenarios.size());
+    EXPECT_FALSE(scenarios[0].isValid);
+    EXPECT_NE(std::string::npos, scenarios[0].error.find("discharge"));
+    EXPECT_FALSE(scenarios[1].isValid);
+    EXPECT_NE(std::string::npos, scenarios[1].error.find("side_slope"));
+    EXPECT_FALSE(scenarios[2].isValid);
+    EXPECT_NE(std::string::npos, scenarios[2].error.find("shape"));
+    EXPECT_TRUE(scenarios[3].isValid);
+}
+
+TEST(ScenarioReaderCsv, GivenHeaderWithoutKnownColumns_WhenReading_ExpectFatalError)
+{
+    std::string error;
+    std::vector<Scenario> scenarios = read_all("a,b,c\n1,2,3\n", ScenarioFormat::Csv, &error);
+
+    EXPECT_TRUE(scenarios.empty());
+    EXPECT_FALSE(error.empty());
+}
+
+// ============================================================================
+// JSON INPUT
+// ============================================================================
+
+TEST(ScenarioReaderJson, GivenArrayAndJsonLines_WhenReading_ExpectSameScenarios)
+{
+    std::string array =
+        "[\n"
+        "  {\"id\": \"a\", \"shape\": \"trapezoidal\", \"bottom_width\": 3, \"side_slope\": 1.5,\n"
+        "   \"discharge\": 10, \"manning_n\": 0.013, \"bed_slope\": 0.001},\n"
+        "  {\"id\": \"b\", \"shape\": \"triangular\", \"side_slope\": 2, \"discharge\": 1,\n"
+        "   \"manning_n\": 0.015, \"bed_slope\": 0.002, \"notes\": \"ignored\"}\n"
+        "]\n";
+    std::string lines =
+        "{\"id\":\"a\",\"shape\":\"trapezoidal\",\"bottom_width\":3,\"side_slope\":1.5,\"discharge\":10,\"manning_n\":0.013,\"bed_slope\":0.001}\n"
+        "{\"id\":\"b\",\"shape\":\"triangular\",\"side_slope\":2,\"discharge\":1,\"manning_n\":0.015,\"bed_slope\":0.002,\"notes\":\"ignored\"}\n";
+
+    std::vector<Scenario> fromArray = read_all(array, ScenarioFormat::Json);
+    std::vector<Scenario> fromLines = read_all(lines, ScenarioFormat::Json);
+
+    ASSERT_EQ(2u, fromArray.size());
+    ASSERT_EQ(2u, fromLines.size());
+
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        EXPECT_TRUE(fromArray[i].isValid);
+        EXPECT_EQ(fromArray[i].id, fromLines[i].id);
+        EXPECT_DOUBLE_EQ(fromArray[i].bottomWidth, fromLines[i].bottomWidth);
+        EXPECT_DOUBLE_EQ(fromArray[i].sideSlope, fromLines[i].sideSlope);
+        EXPECT_DOUBLE_EQ(fromArray[i].discharge, fromLines[i].discharge);
+    }
+
+    EXPECT_DOUBLE_EQ(0.0, fromArray[1].bottomWidth);
+}
+
+TEST(ScenarioReaderJson, GivenNestedValue_WhenReading_ExpectFatalErrorWithLine)
+{
+    std::string error;
+    std::vector<Scenario> scenarios =
+        read_all("{\"id\":\"a\"}\n{\"discharge\":[1,2]}\n", ScenarioFormat::Json, &error);
+
+    EXPECT_EQ(1u, scenarios.size());
+    EXPECT_NE(std::string::npos, error.find("line 2"));
+}
+
+TEST(ScenarioReaderFormat, GivenLeadingWhitespace_WhenDetecting_ExpectFormatFromFirstCharacter)
+{
+    std::istringstream json{"  \n[{}]"};
+    std::istringstream csv{"id,discharge\n"};
+
+    EXPECT_EQ(ScenarioFormat::Json, ScenarioReader::detect_format(json));
+    EXPECT_EQ(ScenarioFormat::Csv, ScenarioReader::detect_format(csv));
+}
+
+// ============================================================================
+// RESULT OUTPUT
+// ============================================================================
+
+TEST(ResultWriterOutput, GivenMixedStatuses_WhenWritingCsv_ExpectEmptyValuesForUnsolvedRows)
+{
+    std::vector<Scenario> scenarios(2);
+    scenarios[0].id = "a";
+    scenarios[0].isValid = true;
+    scenarios[1].id = "b";
+    scenarios[1].error = "missing discharge";
+
+    BatchResults results;
+    results.status = {BatchStatus::Converged, BatchStatus::InvalidInput};
+    results.normalDepth = {1.5, 0.0};
+    results.velocity = {2.0, 0.0};
+    results.froudeNumber = {0.5, 0.0};
+    results.flowRegime = {FlowRegime::Subcritical, FlowRegime::Subcritical};
+    results.criticalDepth = {1.0, 0.0};
+    results.minimumSpecificEnergy = {1.5, 0.0};
+
+    std::ostringstream output;
+    ResultWriter writer{output, ResultFormat::Csv, false};
+    writer.write_header();
+    writer.write(scenarios, results);
+
+    EXPECT_EQ("id,status,flow_regime,normal_depth,velocity,froude_number,critical_depth,min_specific_energy,error\n"
+              "a,converged,subcritical,1.5,2,0.5,1,1.5,\n"
+              "b,parse_error,,,,,,,missing discharge\n",
+              output.str());
+}
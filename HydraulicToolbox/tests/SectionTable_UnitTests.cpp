@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "SectionTable.h"
+#include "CircularChannel.h"
+#include "RectangularChannel.h"
+#include "TrapezoidalChannel.h"
+#include <cmath>
+
+// ============================================================================
+// LOOKUP
+// ============================================================================
+
+TEST(SectionTableLookup, GivenRectangularChannel_WhenLookingUp_ExpectExactAreaAndTopWidth)
+{
+    RectangularChannel channel{10.0, 0.0};
+    SectionTable table{channel, 5.0, 101};
+
+    SectionTableEntry entry = table.lookup(1.234);
+
+    ASSERT_TRUE(table.is_valid());
+    EXPECT_EQ(101u, table.size());
+    EXPECT_NEAR(12.34, entry.area, 1e-12);
+    EXPECT_DOUBLE_EQ(10.0, entry.topWidth);
+}
+
+TEST(SectionTableLookup, GivenGridDepth_WhenLookingUp_ExpectChannelConveyanceAndFirstMoment)
+{
+    TrapezoidalChannel channel{4.0, 2.0, 0.0};
+    SectionTable table{channel, 4.0, 41};
+
+    channel.set_depth(1.5);
+    double area = channel.calculate_area();
+    double conveyance = area * std::pow(channel.calculate_hydraulic_radius(), 2.0 / 3.0);
+    double firstMoment = channel.calculate_first_moment_of_area();
+
+    SectionTableEntry entry = table.lookup(1.5);
+
+    ASSERT_TRUE(table.is_valid());
+    EXPECT_NEAR(area, entry.area, 1e-12);
+    EXPECT_NEAR(conveyance, entry.conveyance, 1e-12 * conveyance);
+    EXPECT_NEAR(firstMoment, entry.firstMoment, 1e-12);
+}
+
+TEST(SectionTableLookup, GivenDepthBetweenGridPoints_WhenLookingUp_ExpectConveyanceDerivativeNearSlope)
+{
+    TrapezoidalChannel channel{4.0, 2.0, 0.0};
+    SectionTable table{channel, 4.0, 1025};
+
+    double delta{1e-3};
+    double slope = (table.lookup(2.0 + delta).conveyance - table.lookup(2.0 - delta).conveyance) / (2.0 * delta);
+
+    EXPECT_NEAR(slope, table.lookup(2.0).conveyanceDerivative, 1e-3 * slope);
+}
+
+TEST(SectionTableLookup, GivenDepthOutsideTable_WhenLookingUp_ExpectClamped)
+{
+    RectangularChannel channel{10.0, 0.0};
+    SectionTable table{channel, 5.0, 11};
+
+    EXPECT_DOUBLE_EQ(0.0, table.lookup(-1.0).area);
+    EXPECT_DOUBLE_EQ(50.0, table.lookup(9.0).area);
+    EXPECT_DOUBLE_EQ(50.0, table.get_max_area());
+}
+
+// ============================================================================
+// INVERSES
+// ============================================================================
+
+TEST(SectionTableInverse, GivenInterpolatedArea_WhenInvertingDepth_ExpectRoundTrip)
+{
+    TrapezoidalChannel channel{4.0, 2.0, 0.0};
+    SectionTable table{channel, 4.0, 257};
+
+    for (double depth : {0.01, 0.37, 1.0, 2.5, 3.99})
+    {
+        EXPECT_NEAR(depth, table.calculate_depth_for_area(table.lookup(depth).area), 1e-12);
+        EXPECT_NEAR(depth, table.calculate_depth_for_conveyance(table.lookup(depth).conveyance), 1e-12);
+    }
+
+    EXPECT_DOUBLE_EQ(0.0, table.calculate_depth_for_area(0.0));
+    EXPECT_DOUBLE_EQ(4.0, table.calculate_depth_for_area(1e9));
+}
+
+// ============================================================================
+// VALIDITY
+// ============================================================================
+
+TEST(SectionTableValidity, GivenCircularChannel_WhenBuilding_ExpectTableEndsAtMaxConveyanceDepth)
+{
+    CircularChannel channel{2.0, 0.0};
+    SectionTable table{channel, 10.0};
+
+    ASSERT_TRUE(table.is_valid());
+    EXPECT_DOUBLE_EQ(channel.get_max_conveyance_depth(), table.get_max_depth());
+    EXPECT_LT(table.get_max_depth(), 2.0);
+}
+
+TEST(SectionTableValidity, GivenBadInputs_WhenBuilding_ExpectInvalidTable)
+{
+    RectangularChannel channel{10.0, 0.0};
+    RectangularChannel badChannel{-1.0, 0.0};
+
+    EXPECT_FALSE((SectionTable{channel, 0.0}.is_valid()));
+    EXPECT_FALSE((SectionTable{channel, 5.0, 1}.is_valid()));
+    EXPECT_FALSE((SectionTable{badChannel, 5.0}.is_valid()));
+}
+
+TEST(SectionTableValidity, GivenTable_WhenMeasuringFootprint_ExpectEntriesCounted)
+{
+    RectangularChannel channel{10.0, 0.0};
+    SectionTable table{channel, 5.0, 1025};
+
+    EXPECT_GE(table.get_memory_footprint(), 1025 * sizeof(SectionTableEntry));
+}
@@ -0,0 +1,229 @@
+#include <gtest/gtest.h>
+#include "Analyzer.h"
+#include "BatchAnalyzer.h"
+#include "CriticalFlowAnalyzer.h"
+#include "SolverTelemetry.h"
+#include "ThreadPool.h"
+#include "UnitSystemConstants.h"
+#include <vector>
+
+namespace
+{
+constexpr double SLOPE{0.001};
+
+// Enables the process-wide metrics for one test and leaves them off and
+// empty afterwards, so other tests are unaffected.
+class ScopedMetrics
+{
+public:
+    ScopedMetrics()
+    {
+        SolverMetrics::instance().reset();
+        SolverMetrics::instance().set_enabled(true);
+    }
+
+    ~ScopedMetrics()
+    {
+        SolverMetrics::instance().set_enabled(false);
+        SolverMetrics::instance().reset();
+    }
+};
+
+AnalysisResult solve_trapezoid(const Analyzer& analyzer, double discharge, SolverTelemetry* telemetry)
+{
+    return analyzer.solve_section(TrapezoidalSection{4.0, 2.0}, Flow{discharge, 0.015}, SLOPE,
+                                  UnitSystemConstants::MANNINGS_COEFFICIENT_SI, UnitSystemConstants::GRAVITY_SI,
+                                  telemetry);
+}
+}
+
+// ============================================================================
+// PER-SOLVE TELEMETRY
+// ============================================================================
+
+TEST(SolverTelemetrySolve, GivenNewtonSolve_WhenRecording_ExpectOneNestedBracketStepPerIteration)
+{
+    Analyzer analyzer;
+    SolverTelemetry telemetry;
+
+    AnalysisResult result = solve_trapezoid(analyzer, 25.0, &telemetry);
+
+    ASSERT_TRUE(result.isValid);
+    EXPECT_TRUE(telemetry.isConverged);
+    EXPECT_EQ(result.iterations, telemetry.iterations);
+    EXPECT_DOUBLE_EQ(result.residual, telemetry.residual);
+    EXPECT_EQ(static_cast<std::size_t>(result.iterations), telemetry.bracketStepCount);
+    EXPECT_GE(telemetry.elapsedSeconds, 0.0);
+
+    for (std::size_t i = 0; i < telemetry.get_stored_step_count(); ++i)
+    {
+        const BracketStep& step = telemetry.bracketSteps[i];
+        EXPECT_LE(step.lowDepth, step.depth);
+        EXPECT_GE(step.highDepth, step.depth);
+
+        if (i > 0)
+        {
+            EXPECT_GE(step.lowDepth, telemetry.bracketSteps[i - 1].lowDepth);
+            EXPECT_LE(step.highDepth, telemetry.bracketSteps[i - 1].highDepth);
+        }
+    }
+
+    const BracketStep& last = telemetry.bracketSteps[telemetry.get_stored_step_count() - 1];
+    EXPECT_DOUBLE_EQ(result.normalDepth, last.depth);
+    EXPECT_LT(std::abs(last.residual), 1e-9);
+}
+
+TEST(SolverTelemetrySolve, GivenBisectionSolve_WhenRecording_ExpectBracketHalvedEachStep)
+{
+    SolverSettings settings;
+    settings.method = SolverMethod::Bisection;
+    Analyzer analyzer{settings};
+    SolverTelemetry telemetry;
+
+    AnalysisResult result = solve_trapezoid(analyzer, 25.0, &telemetry);
+
+    ASSERT_TRUE(result.isValid);
+    ASSERT_GE(telemetry.get_stored_step_count(), 2u);
+
+    for (std::size_t i = 1; i < telemetry.get_stored_step_count(); ++i)
+    {
+        const BracketStep& previous = telemetry.bracketSteps[i - 1];
+        const BracketStep& step = telemetry.bracketSteps[i];
+        EXPECT_NEAR(0.5 * (previous.highDepth - previous.lowDepth), step.highDepth - step.lowDepth, 1e-9);
+    }
+}
+
+TEST(SolverTelemetrySolve, GivenMoreStepsThanCapacity_WhenRecording_ExpectCountKeptAndStorageCapped)
+{
+    SolverSettings settings;
+    settings.method = SolverMethod::Bisection;
+    settings.dischargeTolerance = 0.0;   // Never met, so every iteration runs
+    settings.maxIterations = 100;
+    Analyzer analyzer{settings};
+    SolverTelemetry telemetry;
+
+    AnalysisResult result = solve_trapezoid(analyzer, 25.0, &telemetry);
+
+    EXPECT_FALSE(result.isValid);
+    EXPECT_FALSE(telemetry.isConverged);
+    EXPECT_EQ(100, telemetry.iterations);
+    EXPECT_EQ(100u, telemetry.bracketStepCount);
+    EXPECT_EQ(SolverTelemetry::MAX_BRACKET_STEPS, telemetry.get_stored_step_count());
+}
+
+TEST(SolverTelemetrySolve, GivenReusedTelemetry_WhenSolvingAgain_ExpectPreviousStepsCleared)
+{
+    Analyzer analyzer;
+    SolverTelemetry telemetry;
+
+    solve_trapezoid(analyzer, 25.0, &telemetry);
+    AnalysisResult invalid = solve_trapezoid(analyzer, -1.0, &telemetry);
+
+    EXPECT_FALSE(invalid.isValid);
+    EXPECT_EQ(0u, telemetry.bracketStepCount);
+    EXPECT_EQ(0, telemetry.iterations);
+}
+
+// ============================================================================
+// METRICS REGISTRY
+// ============================================================================
+
+TEST(SolverMetricsRegistry, GivenDisabledMetrics_WhenSolving_ExpectNothingRecorded)
+{
+    SolverMetrics::instance().reset();
+    Analyzer analyzer;
+
+    solve_trapezoid(analyzer, 25.0, nullptr);
+
+    EXPECT_EQ(0u, SolverMetrics::instance().get_snapshot(MetricSolver::NormalDepth).sampleCount);
+}
+
+TEST(SolverMetricsRegistry, GivenEnabledMetrics_WhenSolving_ExpectCountsIterationsAndHistogram)
+{
+    ScopedMetrics scope;
+    Analyzer analyzer;
+    std::uint64_t iterations{0};
+
+    for (double discharge : {1.0, 10.0, 100.0})
+        iterations += static_cast<std::uint64_t>(solve_trapezoid(analyzer, discharge, nullptr).iterations);
+
+    solve_trapezoid(analyzer, -1.0, nullptr);
+
+    SolverMetricsSnapshot snapshot = SolverMetrics::instance().get_snapshot(MetricSolver::NormalDepth);
+
+    EXPECT_EQ(4u, snapshot.sampleCount);
+    EXPECT_EQ(4u, snapshot.solveCount);
+    EXPECT_EQ(1u, snapshot.failureCount);
+    EXPECT_EQ(iterations, snapshot.iterationCount);
+
+    std::uint64_t bucketTotal{0};
+    for (std::uint64_t count : snapshot.latencyBuckets)
+        bucketTotal += count;
+
+    EXPECT_EQ(4u, bucketTotal);
+    EXPECT_GT(snapshot.get_latency_percentile_seconds(0.5), 0.0);
+    EXPECT_LE(snapshot.get_latency_percentile_seconds(0.5), snapshot.get_latency_percentile_seconds(1.0));
+}
+
+TEST(SolverMetricsRegistry, GivenCriticalAndBatchSolves_WhenRecording_ExpectPerSolverEntries)
+{
+    ScopedMetrics scope;
+
+    CriticalFlowAnalyzer criticalAnalyzer;
+    criticalAnalyzer.solve_section(TrapezoidalSection{4.0, 2.0}, 25.0, UnitSystemConstants::GRAVITY_SI);
+
+    std::vector<double> bottomWidth{4.0, 2.0, 3.0};
+    std::vector<double> sideSlope{2.0, 0.0, 1.0};
+    std::vector<double> discharge{25.0, 5.0, -1.0};
+    std::vector<double> manningN(3, 0.015);
+    std::vector<double> bedSlope(3, SLOPE);
+    BatchInputs inputs{bottomWidth.data(), sideSlope.data(), discharge.data(), manningN.data(), bedSlope.data(), 3};
+
+    std::vector<double> depth(3), velocity(3), froudeNumber(3);
+    std::vector<FlowRegime> flowRegime(3);
+    std::vector<BatchStatus> status(3);
+    BatchAnalyzer batchAnalyzer{false};
+    batchAnalyzer.solve_for_depth(inputs, BatchOutputs{depth.data(), velocity.data(), froudeNumber.data(),
+                                                       flowRegime.data(), status.data()});
+
+    SolverMetricsSnapshot critical = SolverMetrics::instance().get_snapshot(MetricSolver::CriticalDepth);
+    SolverMetricsSnapshot batch = SolverMetrics::instance().get_snapshot(MetricSolver::BatchNormalDepth);
+
+    EXPECT_EQ(1u, critical.sampleCount);
+    EXPECT_EQ(0u, critical.failureCount);
+    EXPECT_EQ(1u, batch.sampleCount);
+    EXPECT_EQ(3u, batch.solveCount);
+    EXPECT_EQ(1u, batch.failureCount);
+    EXPECT_EQ(0u, SolverMetrics::instance().get_snapshot(MetricSolver::NormalDepth).sampleCount);
+}
+
+TEST(SolverMetricsRegistry, GivenConcurrentSolves_WhenRecording_ExpectNoLostSamples)
+{
+    ScopedMetrics scope;
+    ThreadPool pool{4};
+    Analyzer analyzer;
+
+    constexpr std::size_t SOLVE_COUNT{2000};
+
+    pool.parallel_for(SOLVE_COUNT, 50, [&analyzer](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+            solve_trapezoid(analyzer, 1.0 + static_cast<double>(i % 50), nullptr);
+    });
+
+    SolverMetricsSnapshot snapshot = SolverMetrics::instance().get_snapshot(MetricSolver::NormalDepth);
+    EXPECT_EQ(SOLVE_COUNT, snapshot.sampleCount);
+    EXPECT_EQ(0u, snapshot.failureCount);
+}
+
+TEST(SolverMetricsSnapshot, GivenKnownBuckets_WhenTakingPercentiles_ExpectBucketUpperBounds)
+{
+    SolverMetricsSnapshot snapshot;
+    snapshot.latencyBuckets[10] = 90;   // [1024, 2048) ns
+    snapshot.latencyBuckets[20] = 10;   // [~1 ms, ~2 ms)
+
+    EXPECT_DOUBLE_EQ(2048e-9, snapshot.get_latency_percentile_seconds(0.5));
+    EXPECT_DOUBLE_EQ(2048e-9, snapshot.get_latency_percentile_seconds(0.9));
+    EXPECT_DOUBLE_EQ(2097152e-9, snapshot.get_latency_percentile_seconds(0.99));
+    EXPECT_DOUBLE_EQ(0.0, SolverMetricsSnapshot{}.get_latency_percentile_seconds(0.5));
+}
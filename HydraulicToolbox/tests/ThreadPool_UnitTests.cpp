@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include "ThreadPool.h"
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+// ============================================================================
+// PARALLEL FOR TESTS
+// ============================================================================
+
+TEST(ThreadPoolParallelFor, GivenRangeLargerThanGrain_WhenRunning_ExpectEveryIndexVisitedOnce)
+{
+    ThreadPool pool{4};
+    std::vector<int> visits(10007, 0);
+
+    pool.parallel_for(visits.size(), 100, [&visits](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+            ++visits[i];
+    });
+
+    for (int count : visits)
+        EXPECT_EQ(1, count);
+}
+
+TEST(ThreadPoolParallelFor, GivenEmptyRange_WhenRunning_ExpectBodyNotCalled)
+{
+    ThreadPool pool{2};
+    std::atomic<int> calls{0};
+
+    pool.parallel_for(0, 16, [&calls](std::size_t, std::size_t) { ++calls; });
+
+    EXPECT_EQ(0, calls.load());
+}
+
+TEST(ThreadPoolParallelFor, GivenThrowingBody_WhenRunning_ExpectExceptionRethrown)
+{
+    ThreadPool pool{2};
+
+    EXPECT_THROW(pool.parallel_for(10, 1, [](std::size_t begin, std::size_t)
+                                   {
+                                       if (begin == 5)
+                                           throw std::runtime_error("failed range");
+                                   }),
+                 std::runtime_error);
+}
+
+// ============================================================================
+// SUBMIT TESTS
+// ============================================================================
+
+TEST(ThreadPoolSubmit, GivenDefaultThreadCount_WhenConstructing_ExpectAtLeastOneWorker)
+{
+    ThreadPool pool;
+
+    EXPECT_GE(pool.get_thread_count(), 1u);
+}
+
+TEST(ThreadPoolSubmit, GivenSubmittedTasks_WhenWaiting_ExpectAllTasksRun)
+{
+    ThreadPool pool{3};
+    std::atomic<int> sum{0};
+    std::vector<std::future<void>> futures;
+
+    for (int i = 1; i <= 100; ++i)
+        futures.push_back(pool.submit([&sum, i] { sum += i; }));
+
+    ThreadPool::wait_all(futures);
+
+    EXPECT_EQ(5050, sum.load());
+}
@@ -69,3 +69,26 @@ TEST(TrapezoidalChannelGeometry, GivenNegativeDepth_WhenCreatingChannel_ExpectIn
 
     EXPECT_FALSE(channel.is_valid());
 }
+
+TEST(TrapezoidalChannelGeometry, GivenSideSlope_WhenCalculatingWettedPerimeterDerivative_ExpectSlopedWallLength)
+{
+    double bottomWidth{4.0};
+    double sideSlope{2.0};
+    double depth{3.0};
+
+    TrapezoidalChannel channel{bottomWidth, sideSlope, depth};
+
+    double expectedDerivative{4.4721359549995796};
+    EXPECT_DOUBLE_EQ(expectedDerivative, channel.calculate_wetted_perimeter_derivative());
+}
+
+TEST(TrapezoidalChannelGeometry, GivenDimensions_WhenCalculatingFirstMomentOfArea_ExpectAreaTimesCentroidDepth)
+{
+    double bottomWidth{4.0};
+    double sideSlope{2.0};
+    double depth{3.0};
+
+    TrapezoidalChannel channel{bottomWidth, sideSlope, depth};
+
+    EXPECT_DOUBLE_EQ(36.0, channel.calculate_first_moment_of_area());
+}
@@ -54,3 +54,23 @@ TEST(TriangularChannelGeometry, GivenZeroSideSlope_WhenCreatingChannel_ExpectInv
     EXPECT_FALSE(channel.is_valid());
 }
 
+TEST(TriangularChannelGeometry, GivenSideSlope_WhenCalculatingWettedPerimeterDerivative_ExpectSlopedWallLength)
+{
+    double sideSlope{2.0};
+    double depth{3.0};
+
+    TriangularChannel channel{sideSlope, depth};
+
+    double expectedDerivative{4.4721359549995796};
+    EXPECT_DOUBLE_EQ(expectedDerivative, channel.calculate_wetted_perimeter_derivative());
+}
+
+TEST(TriangularChannelGeometry, GivenDimensions_WhenCalculatingFirstMomentOfArea_ExpectAreaTimesCentroidDepth)
+{
+    double sideSlope{2.0};
+    double depth{3.0};
+
+    TriangularChannel channel{sideSlope, depth};
+
+    EXPECT_DOUBLE_EQ(18.0, channel.calculate_first_moment_of_area());
+}
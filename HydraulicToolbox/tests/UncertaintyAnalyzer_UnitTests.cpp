@@ -0,0 +1,276 @@
+#include <gtest/gtest.h>
+#include "UncertaintyAnalyzer.h"
+#include "CalculationControl.h"
+#include "CounterRandom.h"
+#include "ThreadPool.h"
+#include "Analyzer.h"
+#include "UnitSystemConstants.h"
+#include <atomic>
+#include <cmath>
+#include <numeric>
+
+namespace
+{
+UncertaintyInputs make_inputs()
+{
+    return UncertaintyInputs{TrapezoidalSection{4.0, 2.0},
+                             Distribution::triangular(0.011, 0.013, 0.018),
+                             Distribution::normal(10.0, 1.0),
+                             Distribution::log_normal(0.001, 0.1)};
+}
+
+UncertaintySettings make_settings(std::size_t sampleCount)
+{
+    UncertaintySettings settings;
+    settings.sampleCount = sampleCount;
+    return settings;
+}
+}
+
+// ============================================================================
+// COUNTER RANDOM
+// ============================================================================
+
+TEST(CounterRandom, GivenSameKey_WhenDrawing_ExpectSameValue)
+{
+    EXPECT_EQ(counter_random_bits(7, 12345, 3), counter_random_bits(7, 12345, 3));
+    EXPECT_NE(counter_random_bits(7, 12345, 3), counter_random_bits(7, 12345, 4));
+    EXPECT_NE(counter_random_bits(7, 12345, 3), counter_random_bits(8, 12345, 3));
+}
+
+TEST(CounterRandom, GivenManyCounters_WhenDrawingUniforms_ExpectOpenUnitIntervalWithMeanOneHalf)
+{
+    constexpr std::size_t COUNT{100000};
+    double sum{0.0};
+
+    for (std::size_t i = 0; i < COUNT; ++i)
+    {
+        double u = counter_uniform(1, i, 0);
+        ASSERT_GT(u, 0.0);
+        ASSERT_LT(u, 1.0);
+        sum += u;
+    }
+
+    EXPECT_NEAR(0.5, sum / COUNT, 0.005);
+}
+
+// ============================================================================
+// DISTRIBUTIONS
+// ============================================================================
+
+TEST(UncertaintyDistribution, GivenFixed_WhenSampling_ExpectValue)
+{
+    EXPECT_DOUBLE_EQ(0.013, Distribution::fixed(0.013).sample(0.3, 0.7));
+}
+
+TEST(UncertaintyDistribution, GivenUniform_WhenSamplingEndpoints_ExpectBounds)
+{
+    Distribution distribution = Distribution::uniform(2.0, 6.0);
+
+    EXPECT_DOUBLE_EQ(2.0, distribution.sample(0.0, 0.5));
+    EXPECT_DOUBLE_EQ(4.0, distribution.sample(0.5, 0.5));
+    EXPECT_DOUBLE_EQ(6.0, distribution.sample(1.0, 0.5));
+}
+
+TEST(UncertaintyDistribution, GivenTriangular_WhenSamplingModeFraction_ExpectMode)
+{
+    Distribution distribution = Distribution::triangular(1.0, 2.0, 5.0);
+
+    EXPECT_NEAR(2.0, distribution.sample(0.25, 0.5), 1e-12);
+    EXPECT_NEAR(1.0, distribution.sample(0.0, 0.5), 1e-12);
+    EXPECT_NEAR(5.0, distribution.sample(1.0, 0.5), 1e-12);
+}
+
+TEST(UncertaintyDistribution, GivenNormal_WhenSamplingManyCounters_ExpectMeanAndStandardDeviation)
+{
+    constexpr std::size_t COUNT{200000};
+    Distribution distribution = Distribution::normal(3.0, 0.5);
+    double sum{0.0};
+    double sumSquares{0.0};
+
+    for (std::size_t i = 0; i < COUNT; ++i)
+    {
+        double x = distribution.sample(counter_uniform(2, i, 0), counter_uniform(2, i, 1));
+        sum += x;
+        sumSquares += x * x;
+    }
+
+    double mean = sum / COUNT;
+    EXPECT_NEAR(3.0, mean, 0.01);
+    EXPECT_NEAR(0.5, std::sqrt(sumSquares / COUNT - mean * mean), 0.01);
+}
+
+TEST(UncertaintyDistribution, GivenInvalidParameters_WhenValidating_ExpectFalse)
+{
+    EXPECT_FALSE(Distribution::uniform(2.0, 1.0).is_valid());
+    EXPECT_FALSE(Distribution::normal(1.0, -1.0).is_valid());
+    EXPECT_FALSE(Distribution::log_normal(0.0, 0.1).is_valid());
+    EXPECT_FALSE(Distribution::triangular(1.0, 3.0, 2.0).is_valid());
+    EXPECT_TRUE(Distribution::triangular(1.0, 2.0, 3.0).is_valid());
+}
+
+// ============================================================================
+// MONTE CARLO RUN
+// ============================================================================
+
+TEST(UncertaintyAnalyzerRun, GivenFixedInputs_WhenRunning_ExpectDeterministicNormalDepth)
+{
+    ThreadPool pool{2};
+    UncertaintyAnalyzer uncertaintyAnalyzer{pool, false};
+    UncertaintyInputs inputs{RectangularSection{5.0}, Distribution::fixed(0.013), Distribution::fixed(10.0),
+                             Distribution::fixed(0.001)};
+
+    UncertaintyResult result = uncertaintyAnalyzer.run(inputs, make_settings(1000));
+
+    Analyzer analyzer;
+    AnalysisResult expected = analyzer.solve_section(RectangularSection{5.0}, Flow{10.0, 0.013}, 0.001,
+                                                     UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                     UnitSystemConstants::GRAVITY_SI);
+
+    ASSERT_TRUE(result.isValid);
+    EXPECT_EQ(1000u, result.convergedCount);
+    EXPECT_DOUBLE_EQ(expected.normalDepth, result.mean);
+    EXPECT_DOUBLE_EQ(expected.normalDepth, result.minimum);
+    EXPECT_DOUBLE_EQ(expected.normalDepth, result.maximum);
+    EXPECT_NEAR(0.0, result.standardDeviation, 1e-12);
+    EXPECT_NEAR(expected.normalDepth, result.percentile(0.5), 1e-9);
+}
+
+TEST(UncertaintyAnalyzerRun, GivenDifferentThreadCounts_WhenRunning_ExpectIdenticalResults)
+{
+    ThreadPool singlePool{1};
+    ThreadPool multiPool{4};
+    UncertaintySettings settings = make_settings(3 * UncertaintyAnalyzer::CHUNK_SIZE + 123);
+
+    UncertaintyResult single = UncertaintyAnalyzer{singlePool, false}.run(make_inputs(), settings);
+    UncertaintyResult multi = UncertaintyAnalyzer{multiPool, false}.run(make_inputs(), settings);
+
+    ASSERT_TRUE(single.isValid);
+    EXPECT_EQ(single.convergedCount, multi.convergedCount);
+    EXPECT_EQ(single.mean, multi.mean);
+    EXPECT_EQ(single.standardDeviation, multi.standardDeviation);
+    EXPECT_EQ(single.minimum, multi.minimum);
+    EXPECT_EQ(single.maximum, multi.maximum);
+    EXPECT_EQ(single.histogram, multi.histogram);
+    EXPECT_EQ(single.percentile(0.95), multi.percentile(0.95));
+}
+
+TEST(UncertaintyAnalyzerRun, GivenDifferentSeeds_WhenRunning_ExpectDifferentMeans)
+{
+    ThreadPool pool{2};
+    UncertaintyAnalyzer uncertaintyAnalyzer{pool, false};
+    UncertaintySettings settings = make_settings(20000);
+
+    UncertaintyResult first = uncertaintyAnalyzer.run(make_inputs(), settings);
+    settings.seed = 42;
+    UncertaintyResult second = uncertaintyAnalyzer.run(make_inputs(), settings);
+
+    EXPECT_NE(first.mean, second.mean);
+    EXPECT_NEAR(first.mean, second.mean, 0.01 * first.mean);
+}
+
+TEST(UncertaintyAnalyzerRun, GivenVaryingInputs_WhenRunning_ExpectOrderedPercentilesAndCompleteHistogram)
+{
+    ThreadPool pool{2};
+    UncertaintyResult result = UncertaintyAnalyzer{pool, false}.run(make_inputs(), make_settings(50000));
+
+    ASSERT_TRUE(result.isValid);
+    EXPECT_EQ(result.sampleCount, result.convergedCount + result.rejectedCount);
+
+    std::uint64_t histogramTotal = std::accumulate(result.histogram.begin(), result.histogram.end(), std::uint64_t{0});
+    EXPECT_EQ(result.convergedCount, histogramTotal + result.underflowCount + result.overflowCount);
+
+    double p05 = result.percentile(0.05);
+    double p50 = result.percentile(0.50);
+    double p95 = result.percentile(0.95);
+
+    EXPECT_LE(result.minimum, p05);
+    EXPECT_LT(p05, p50);
+    EXPECT_LT(p50, p95);
+    EXPECT_LE(p95, result.maximum);
+    EXPECT_NEAR(result.mean, p50, 0.5 * result.standardDeviation);
+    EXPECT_DOUBLE_EQ(result.minimum, result.percentile(0.0));
+}
+
+TEST(UncertaintyAnalyzerRun, GivenMedianSample_WhenComparingPercentile_ExpectDepthOfMedianInputs)
+{
+    // Depth rises monotonically with n, so the median depth is the depth at the median n.
+    ThreadPool pool{2};
+    UncertaintyInputs inputs{RectangularSection{5.0}, Distribution::uniform(0.010, 0.020), Distribution::fixed(10.0),
+                             Distribution::fixed(0.001)};
+
+    UncertaintyResult result = UncertaintyAnalyzer{pool, false}.run(inputs, make_settings(100000));
+
+    Analyzer analyzer;
+    AnalysisResult expected = analyzer.solve_section(RectangularSection{5.0}, Flow{10.0, 0.015}, 0.001,
+                                                     UnitSystemConstants::MANNINGS_COEFFICIENT_SI,
+                                                     UnitSystemConstants::GRAVITY_SI);
+
+    EXPECT_NEAR(expected.normalDepth, result.percentile(0.5), 0.005 * expected.normalDepth);
+}
+
+TEST(UncertaintyAnalyzerRun, GivenNonPositiveDraws_WhenRunning_ExpectSamplesRejected)
+{
+    ThreadPool pool{2};
+    UncertaintyInputs inputs{RectangularSection{5.0}, Distribution::fixed(0.013), Distribution::uniform(-10.0, 10.0),
+                             Distribution::fixed(0.001)};
+
+    UncertaintyResult result = UncertaintyAnalyzer{pool, false}.run(inputs, make_settings(10000));
+
+    ASSERT_TRUE(result.isValid);
+    EXPECT_GT(result.rejectedCount, 4000u);
+    EXPECT_LT(result.rejectedCount, 6000u);
+    EXPECT_EQ(10000u, result.convergedCount + result.rejectedCount);
+}
+
+TEST(UncertaintyAnalyzerRun, GivenInvalidDistribution_WhenRunning_ExpectInvalidResult)
+{
+    ThreadPool pool{1};
+    UncertaintyInputs inputs = make_inputs();
+    inputs.manningN = Distribution::uniform(0.02, 0.01);
+
+    UncertaintyAnalyzer uncertaintyAnalyzer{pool, false};
+
+    EXPECT_FALSE(uncertaintyAnalyzer.run(inputs, make_settings(100)).isValid);
+}
+
+// ============================================================================
+// CANCELLATION AND PROGRESS
+// ============================================================================
+
+TEST(UncertaintyAnalyzerControl, GivenProgressCallback_WhenRunning_ExpectFinalProgressOfOne)
+{
+    ThreadPool pool{2};
+    std::atomic<double> lastFraction{0.0};
+    std::atomic<int> reportCount{0};
+
+    CalculationControl control{[&](double fraction)
+    {
+        ++reportCount;
+        double previous = lastFraction.load();
+        while (fraction > previous && !lastFraction.compare_exchange_weak(previous, fraction))
+        {
+        }
+    }};
+
+    UncertaintyResult result = UncertaintyAnalyzer{pool, false}.run(make_inputs(),
+                                                                      make_settings(4 * UncertaintyAnalyzer::CHUNK_SIZE),
+                                                                      &control);
+
+    EXPECT_TRUE(result.isValid);
+    EXPECT_EQ(4, reportCount.load());
+    EXPECT_DOUBLE_EQ(1.0, lastFraction.load());
+}
+
+TEST(UncertaintyAnalyzerControl, GivenCancelledControl_WhenRunning_ExpectCancelledInvalidResult)
+{
+    ThreadPool pool{2};
+    CalculationControl control;
+    control.cancel();
+
+    UncertaintyResult result = UncertaintyAnalyzer{pool, false}.run(make_inputs(), make_settings(100000), &control);
+
+    EXPECT_TRUE(result.isCancelled);
+    EXPECT_FALSE(result.isValid);
+    EXPECT_EQ(0u, result.convergedCount);
+}
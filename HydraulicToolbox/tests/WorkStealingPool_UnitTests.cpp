@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include "WorkStealingPool.h"
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+// Binary tree of tasks, `levels` deep below the calling task.
+void spawn_tree(WorkStealingPool& pool, int levels, std::atomic<int>& visits)
+{
+    ++visits;
+
+    if (levels == 0)
+        return;
+
+    pool.spawn([&pool, levels, &visits] { spawn_tree(pool, levels - 1, visits); });
+    pool.spawn([&pool, levels, &visits] { spawn_tree(pool, levels - 1, visits); });
+}
+}
+
+// ============================================================================
+// SPAWN AND WAIT TESTS
+// ============================================================================
+
+TEST(WorkStealingPoolSpawn, GivenDefaultThreadCount_WhenConstructing_ExpectAtLeastOneWorker)
+{
+    WorkStealingPool pool;
+
+    EXPECT_GE(pool.get_thread_count(), 1u);
+}
+
+TEST(WorkStealingPoolSpawn, GivenNestedSpawns_WhenWaiting_ExpectEveryTaskRunOnce)
+{
+    WorkStealingPool pool{4};
+    std::atomic<int> visits{0};
+
+    pool.spawn([&pool, &visits] { spawn_tree(pool, 12, visits); });
+    pool.wait();
+
+    EXPECT_EQ((1 << 13) - 1, visits.load());
+}
+
+TEST(WorkStealingPoolSpawn, GivenTasksFromOutsideThePool_WhenWaiting_ExpectAllResultsWritten)
+{
+    WorkStealingPool pool{3};
+    std::vector<int> values(1000, 0);
+
+    for (std::size_t i = 0; i < values.size(); ++i)
+        pool.spawn([&values, i] { values[i] = static_cast<int>(i) * 2; });
+
+    pool.wait();
+
+    for (std::size_t i = 0; i < values.size(); ++i)
+        EXPECT_EQ(static_cast<int>(i) * 2, values[i]);
+}
+
+TEST(WorkStealingPoolSpawn, GivenNoTasks_WhenWaiting_ExpectImmediateReturn)
+{
+    WorkStealingPool pool{2};
+
+    pool.wait();
+    pool.wait();
+
+    SUCCEED();
+}
+
+TEST(WorkStealingPoolSpawn, GivenThrowingTask_WhenWaiting_ExpectExceptionRethrownOnceAndPoolReusable)
+{
+    WorkStealingPool pool{2};
+    std::atomic<int> calls{0};
+
+    for (int i = 0; i < 10; ++i)
+    {
+        pool.spawn([&calls, i]
+                   {
+                       ++calls;
+                       if (i == 5)
+                           throw std::runtime_error("failed task");
+                   });
+    }
+
+    EXPECT_THROW(pool.wait(), std::runtime_error);
+    EXPECT_EQ(10, calls.load());
+
+    pool.spawn([&calls] { ++calls; });
+    EXPECT_NO_THROW(pool.wait());
+    EXPECT_EQ(11, calls.load());
+}
@@ -1,4 +1,7 @@
 #include "WorkflowController.h"
+#include <QMetaObject>
+#include <QtGlobal>
+#include <atomic>
 
 WorkflowController::WorkflowController(QObject* parent)
     : QObject(parent)
@@ -7,9 +10,28 @@ WorkflowController::WorkflowController(QObject* parent)
     , projectData_{}
     , geometryData_{}
     , hydraulicData_{}
+    , uncertaintyData_{}
     , calculationResults_{}
     , calculator_{}
+    , calculationGeneration_{0}
+    , activeControl_{nullptr}
+    , liveMode_{false}
+    , liveDebounceTimer_{new QTimer(this)}
+    , lastEditTimer_{}
+    , liveRequestTimer_{}
+    , liveRequestGeneration_{0}
+    , lastLiveLatency_{-1}
+    , calculationPool_{CALCULATION_THREAD_COUNT}
 {
+    liveDebounceTimer_->setSingleShot(true);
+    liveDebounceTimer_->setInterval(LIVE_DEBOUNCE_MS);
+    connect(liveDebounceTimer_, &QTimer::timeout, this, &WorkflowController::on_live_debounce_timeout);
+}
+
+WorkflowController::~WorkflowController()
+{
+    if(activeControl_)
+        activeControl_->cancel();
 }
 
 WorkflowStage WorkflowController::get_current_stage() const
@@ -74,10 +96,138 @@ HydraulicData& WorkflowController::get_hydraulic_data()
     return hydraulicData_;
 }
 
+UncertaintyData& WorkflowController::get_uncertainty_data()
+{
+    return uncertaintyData_;
+}
+
 void WorkflowController::perform_calculation()
 {
-    calculationResults_ = calculator_.calculate(projectData_, geometryData_, hydraulicData_);
-    emit calculation_completed(calculationResults_);
+    if(activeControl_)
+        activeControl_->cancel();
+
+    quint64 generation = ++calculationGeneration_;
+
+    // Progress arrives on worker threads; only whole-percent increases are
+    // posted to the GUI thread.
+    auto lastPercent = std::make_shared<std::atomic<int>>(-1);
+    auto progressCallback = [this, generation, lastPercent](double fraction)
+    {
+        int percent = static_cast<int>(fraction * 100.0);
+        int previous = lastPercent->load();
+
+        while(percent > previous)
+        {
+            if(lastPercent->compare_exchange_weak(previous, percent))
+            {
+                QMetaObject::invokeMethod(this, [this, generation, percent]()
+                {
+                    update_calculation_progress(generation, percent);
+                }, Qt::QueuedConnection);
+                return;
+            }
+        }
+    };
+
+    std::shared_ptr<CalculationControl> control = std::make_shared<CalculationControl>(progressCallback);
+    activeControl_ = control;
+
+    emit calculation_started();
+
+    calculationPool_.submit([this, generation, control,
+                             useUsCustomary = projectData_.useUsCustomary,
+                             geometryData = geometryData_,
+                             hydraulicData = hydraulicData_,
+                             uncertaintyData = uncertaintyData_]()
+    {
+        CalculationResults results = calculator_.calculate(useUsCustomary, geometryData, hydraulicData, control.get());
+
+        // One n is drawn for the whole perimeter, so a composite lining gets no band.
+        if(uncertaintyData.isEnabled && results.isValid && hydraulicData.bankManningN <= 0.0)
+            add_uncertainty_band(useUsCustomary, geometryData, hydraulicData, uncertaintyData, control.get(), results);
+
+        if(control->is_cancelled())
+            return;
+
+        QMetaObject::invokeMethod(this, [this, generation, results, geometryData, useUsCustomary]()
+        {
+            finish_calculation(generation, results, geometryData, useUsCustomary);
+        }, Qt::QueuedConnection);
+    });
+}
+
+// Runs on a calculation worker. Fixed distributions take the entered values.
+void WorkflowController::add_uncertainty_band(bool useUsCustomary,
+                                              const GeometryData& geometryData,
+                                              const HydraulicData& hydraulicData,
+                                              const UncertaintyData& uncertaintyData,
+                                              const CalculationControl* control,
+                                              CalculationResults& results)
+{
+    auto resolve = [](const Distribution& distribution, double enteredValue)
+    {
+        return distribution.type == DistributionType::Fixed ? Distribution::fixed(enteredValue) : distribution;
+    };
+
+    Distribution manningN = resolve(uncertaintyData.manningN, hydraulicData.manningN);
+    Distribution discharge = resolve(uncertaintyData.discharge, hydraulicData.discharge);
+    Distribution bedSlope = resolve(uncertaintyData.bedSlope, geometryData.bedSlope);
+
+    UncertaintyResult uncertainty = calculator_.calculate_uncertainty(useUsCustomary, geometryData, manningN,
+                                                                      discharge, bedSlope, control);
+
+    if(uncertainty.isValid)
+    {
+        results.hasUncertainty = true;
+        results.normalDepthLower = uncertainty.percentile(0.05);
+        results.normalDepthMedian = uncertainty.percentile(0.50);
+        results.normalDepthUpper = uncertainty.percentile(0.95);
+    }
+}
+
+void WorkflowController::cancel_calculation()
+{
+    if(!activeControl_)
+        return;
+
+    activeControl_->cancel();
+    activeControl_.reset();
+    ++calculationGeneration_;
+
+    emit calculation_cancelled();
+}
+
+bool WorkflowController::is_calculation_running() const
+{
+    return activeControl_ != nullptr;
+}
+
+void WorkflowController::finish_calculation(quint64 generation, const CalculationResults& results,
+                                            const GeometryData& geometryData, bool useUsCustomary)
+{
+    if(generation != calculationGeneration_)
+        return;
+
+    activeControl_.reset();
+    calculationResults_ = results;
+    emit calculation_completed(calculationResults_, geometryData, useUsCustomary);
+
+    // Slots connected to calculation_completed have redrawn the results by now.
+    if(generation == liveRequestGeneration_)
+    {
+        liveRequestGeneration_ = 0;
+        lastLiveLatency_ = liveRequestTimer_.elapsed();
+        qInfo("Live calculation: %lld ms from last edit to displayed result", static_cast<long long>(lastLiveLatency_));
+        emit live_latency_measured(lastLiveLatency_);
+    }
+}
+
+void WorkflowController::update_calculation_progress(quint64 generation, int percent)
+{
+    if(generation != calculationGeneration_)
+        return;
+
+    emit calculation_progress(percent);
 }
 
 CalculationResults WorkflowController::get_calculation_results() const
@@ -85,10 +235,65 @@ CalculationResults WorkflowController::get_calculation_results() const
     return calculationResults_;
 }
 
+void WorkflowController::set_live_mode(bool enabled)
+{
+    if(liveMode_ == enabled)
+        return;
+
+    liveMode_ = enabled;
+
+    if(liveMode_)
+    {
+        notify_inputs_changed();
+    }
+    else
+    {
+        liveDebounceTimer_->stop();
+        liveRequestGeneration_ = 0;
+    }
+}
+
+bool WorkflowController::is_live_mode() const
+{
+    return liveMode_;
+}
+
+void WorkflowController::notify_inputs_changed()
+{
+    if(!liveMode_)
+        return;
+
+    lastEditTimer_.start();
+    liveDebounceTimer_->start();
+}
+
+qint64 WorkflowController::get_last_live_latency() const
+{
+    return lastLiveLatency_;
+}
+
+void WorkflowController::on_live_debounce_timeout()
+{
+    if(!liveMode_ || !are_inputs_complete())
+        return;
+
+    perform_calculation();
+
+    liveRequestGeneration_ = calculationGeneration_;
+    liveRequestTimer_ = lastEditTimer_;
+}
+
+bool WorkflowController::are_inputs_complete() const
+{
+    return is_stage_complete(WorkflowStage::ProjectSetup)
+           && is_stage_complete(WorkflowStage::GeometryDefinition)
+           && is_stage_complete(WorkflowStage::HydraulicParameters);
+}
+
 bool WorkflowController::has_any_data_entered() const
 {
     // Check if geometry data has been entered
-    if(!geometryData_.channelType.isEmpty() ||
+    if(geometryData_.channelType != ChannelType::None ||
         geometryData_.bottomWidth != 0.0 ||
         geometryData_.sideSlope != 0.0 ||
         geometryData_.bedSlope != 0.0)
@@ -108,11 +313,16 @@ bool WorkflowController::has_any_data_entered() const
 
 void WorkflowController::clear_all_data()
 {
+    // Drop any calculation still running or pending on the old inputs
+    liveDebounceTimer_->stop();
+    cancel_calculation();
+
     // Clear geometry data
     geometryData_ = GeometryData{};
 
     // Clear hydraulic data
     hydraulicData_ = HydraulicData{};
+    uncertaintyData_ = UncertaintyData{};
 
     // Clear calculation results
     calculationResults_ = CalculationResults{};
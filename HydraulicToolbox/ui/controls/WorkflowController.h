@@ -1,10 +1,15 @@
 #ifndef WORKFLOWCONTROLLER_H
 #define WORKFLOWCONTROLLER_H
 
+#include <QElapsedTimer>
 #include <QObject>
 #include <QString>
+#include <QTimer>
 #include <array>
+#include <memory>
+#include "../backend/CalculationControl.h"
 #include "../backend/HydraulicCalculator.h"
+#include "../backend/ThreadPool.h"
 #include "ProjectDataStructures.h"
 
 enum class WorkflowStage
@@ -22,6 +27,7 @@ class WorkflowController : public QObject
 
 public:
     explicit WorkflowController(QObject* parent = nullptr);
+    ~WorkflowController();
 
     WorkflowStage get_current_stage() const;
     bool is_stage_complete(WorkflowStage stage) const;
@@ -33,10 +39,31 @@ public:
     ProjectData& get_project_data();
     GeometryData& get_geometry_data();
     HydraulicData& get_hydraulic_data();
+    UncertaintyData& get_uncertainty_data();
 
+    // Queues a calculation on the worker pool with a snapshot of the current
+    // inputs and returns immediately. A calculation still in flight is
+    // cancelled, and only the newest request emits calculation_completed.
+    // The Monte Carlo band is added only when uncertainty mode is enabled.
     void perform_calculation();
+    void cancel_calculation();
+    bool is_calculation_running() const;
     CalculationResults get_calculation_results() const;
 
+    // Live mode recalculates in the background once the inputs have been
+    // quiet for LIVE_DEBOUNCE_MS, so a burst of keystrokes coalesces into a
+    // single request. Inputs are only solved when the setup, geometry and
+    // hydraulic stages are complete.
+    void set_live_mode(bool enabled);
+    bool is_live_mode() const;
+    void notify_inputs_changed();
+
+    // Milliseconds from the last edit of the newest live request until its
+    // results were displayed; -1 before the first live result.
+    qint64 get_last_live_latency() const;
+
+    static constexpr int LIVE_DEBOUNCE_MS = 150;
+
     // New methods for unit system change handling
     bool has_any_data_entered() const;
     void clear_all_data();
@@ -44,18 +71,57 @@ public:
 signals:
     void current_stage_changed(WorkflowStage newStage);
     void stage_completion_changed(WorkflowStage stage, bool complete);
-    void calculation_completed(const CalculationResults& results);
+    void calculation_started();
+    void calculation_progress(int percent);
+    // Carries the geometry and unit system the results were solved for,
+    // which may differ from the current inputs if they were edited since.
+    void calculation_completed(const CalculationResults& results, const GeometryData& geometryData,
+                               bool useUsCustomary);
+    void calculation_cancelled();
+    void live_latency_measured(qint64 milliseconds);
 
 private:
+    // Two workers let a new request start while a cancelled one unwinds.
+    static constexpr std::size_t CALCULATION_THREAD_COUNT = 2;
+
+    void add_uncertainty_band(bool useUsCustomary,
+                              const GeometryData& geometryData,
+                              const HydraulicData& hydraulicData,
+                              const UncertaintyData& uncertaintyData,
+                              const CalculationControl* control,
+                              CalculationResults& results);
+    void finish_calculation(quint64 generation, const CalculationResults& results,
+                            const GeometryData& geometryData, bool useUsCustomary);
+    void update_calculation_progress(quint64 generation, int percent);
+    void on_live_debounce_timeout();
+    bool are_inputs_complete() const;
+
     WorkflowStage currentStage_;
     std::array<bool, 5> stageComplete_;
 
     ProjectData projectData_;
     GeometryData geometryData_;
     HydraulicData hydraulicData_;
+    UncertaintyData uncertaintyData_;
 
     CalculationResults calculationResults_;
     HydraulicCalculator calculator_;
+
+    // Every request gets the next generation; results and progress from an
+    // older generation are dropped when they reach the GUI thread.
+    quint64 calculationGeneration_;
+    std::shared_ptr<CalculationControl> activeControl_;
+
+    bool liveMode_;
+    QTimer* liveDebounceTimer_;
+    QElapsedTimer lastEditTimer_;      // Restarted on every edit
+    QElapsedTimer liveRequestTimer_;   // lastEditTimer_ as of the newest live request
+    quint64 liveRequestGeneration_;    // 0 when no live request is pending
+    qint64 lastLiveLatency_;
+
+    // Declared last so its workers are joined before the calculator and the
+    // rest of the controller are destroyed.
+    ThreadPool calculationPool_;
 };
 
 #endif // WORKFLOWCONTROLLER_H
@@ -1,5 +1,8 @@
 #include "mainwindow.h"
 #include "./ui_mainwindow.h"
+#include "SolverTelemetry.h"
+#include <QMessageBox>
+#include <QPushButton>
 #include <QVBoxLayout>
 #include <QSizePolicy>
 
@@ -16,10 +19,17 @@ MainWindow::MainWindow(QWidget *parent)
     , saveAction_{nullptr}
     , saveAsAction_{nullptr}
     , exitAction_{nullptr}
+    , analysisMenu_{nullptr}
+    , liveResultsAction_{nullptr}
+    , solverStatisticsAction_{nullptr}
     , workflowController_{nullptr}
 {
     ui->setupUi(this);
 
+    // Counting is cheap; collect from startup so the statistics dialog
+    // covers the whole session.
+    SolverMetrics::instance().set_enabled(true);
+
     workflowController_ = new WorkflowController(this);
 
     setup_ui();
@@ -34,6 +44,12 @@ MainWindow::MainWindow(QWidget *parent)
             this, &MainWindow::on_current_stage_changed);
     connect(workflowController_, &WorkflowController::calculation_completed,
             this, &MainWindow::on_calculation_completed);
+    connect(workflowController_, &WorkflowController::calculation_started,
+            parameterPanel_->get_analysis_results_widget(), &AnalysisResultsWidget::show_calculation_started);
+    connect(workflowController_, &WorkflowController::calculation_progress,
+            parameterPanel_->get_analysis_results_widget(), &AnalysisResultsWidget::set_calculation_progress);
+    connect(workflowController_, &WorkflowController::calculation_cancelled,
+            parameterPanel_->get_analysis_results_widget(), &AnalysisResultsWidget::hide_calculation_progress);
     connect(parameterPanel_, &ParameterPanel::tab_clicked,
             this, &MainWindow::on_tab_clicked);
 
@@ -80,6 +96,25 @@ void MainWindow::setup_menu_bar()
 
     connect(exitAction_, &QAction::triggered, this, &QMainWindow::close);
 
+    analysisMenu_ = menuBar()->addMenu("Analysis");
+
+    liveResultsAction_ = new QAction("Live Results", this);
+    liveResultsAction_->setCheckable(true);
+    liveResultsAction_->setToolTip("Recalculate in the background while inputs are edited");
+    analysisMenu_->addAction(liveResultsAction_);
+
+    connect(liveResultsAction_, &QAction::toggled,
+            workflowController_, &WorkflowController::set_live_mode);
+
+    analysisMenu_->addSeparator();
+
+    solverStatisticsAction_ = new QAction("Solver Statistics...", this);
+    solverStatisticsAction_->setToolTip("Solve counts, iterations and latencies for this session");
+    analysisMenu_->addAction(solverStatisticsAction_);
+
+    connect(solverStatisticsAction_, &QAction::triggered,
+            this, &MainWindow::show_solver_statistics);
+
     unitSystemIndicator_ = new QLabel("US Customary", this);
     unitSystemIndicator_->setStyleSheet(
         "QLabel { "
@@ -173,6 +208,21 @@ void MainWindow::update_input_summary()
     summaryWidget->update_hydraulic_data(workflowController_->get_hydraulic_data());
 }
 
+void MainWindow::show_solver_statistics()
+{
+    QMessageBox dialog(this);
+    dialog.setWindowTitle("Solver Statistics");
+    dialog.setText("Solver activity since startup or the last reset");
+    dialog.setInformativeText(QString::fromStdString(SolverMetrics::instance().format_report()));
+    dialog.setStandardButtons(QMessageBox::Close);
+
+    QPushButton* resetButton = dialog.addButton("Reset", QMessageBox::ResetRole);
+    dialog.exec();
+
+    if(dialog.clickedButton() == resetButton)
+        SolverMetrics::instance().reset();
+}
+
 void MainWindow::on_tab_clicked(WorkflowStage stage)
 {
     workflowController_->set_current_stage(stage);
@@ -202,6 +252,7 @@ void MainWindow::on_project_setup_data_changed()
 
     bool isComplete = widget->is_complete();
     workflowController_->mark_stage_complete(WorkflowStage::ProjectSetup, isComplete);
+    workflowController_->notify_inputs_changed();
 
     update_unit_system_indicator();
 
@@ -220,6 +271,7 @@ void MainWindow::on_geometry_data_changed()
 
     bool isComplete = widget->is_complete();
     workflowController_->mark_stage_complete(WorkflowStage::GeometryDefinition, isComplete);
+    workflowController_->notify_inputs_changed();
 }
 
 void MainWindow::on_hydraulic_parameters_data_changed()
@@ -229,9 +281,13 @@ void MainWindow::on_hydraulic_parameters_data_changed()
     HydraulicParametersWidget* widget = parameterPanel_->get_hydraulic_parameters_widget();
     data.discharge = widget->get_discharge();
     data.manningN = widget->get_mannings_n();
+    data.bankManningN = widget->get_bank_mannings_n();
+    data.roughnessMethod = widget->get_roughness_method();
+    workflowController_->get_uncertainty_data() = widget->get_uncertainty_data();
 
     bool isComplete = widget->is_complete();
     workflowController_->mark_stage_complete(WorkflowStage::HydraulicParameters, isComplete);
+    workflowController_->notify_inputs_changed();
 }
 
 void MainWindow::update_unit_system_indicator()
@@ -244,14 +300,15 @@ void MainWindow::update_unit_system_indicator()
         unitSystemIndicator_->setText("SI Metric");
 }
 
-void MainWindow::on_calculation_completed(const CalculationResults& results)
+// Drawn from the inputs the results were solved for, not the current ones,
+// so an edit made while the calculation ran cannot mismatch the two.
+void MainWindow::on_calculation_completed(const CalculationResults& results, const GeometryData& geometryData,
+                                          bool useUsCustomary)
 {
-    ProjectData& projectData = workflowController_->get_project_data();
-    parameterPanel_->get_analysis_results_widget()->update_results(results, projectData.useUsCustomary);
+    parameterPanel_->get_analysis_results_widget()->update_results(results, useUsCustomary);
 
     if(results.isValid)
     {
-        GeometryData& geometryData = workflowController_->get_geometry_data();
         visualizationPanel_->render_channel(geometryData, results);
     }
 }
@@ -31,9 +31,11 @@ private slots:
     void on_geometry_data_changed();
     void on_hydraulic_parameters_data_changed();
     void on_current_stage_changed(WorkflowStage newStage);
-    void on_calculation_completed(const CalculationResults& results);
+    void on_calculation_completed(const CalculationResults& results, const GeometryData& geometryData,
+                                  bool useUsCustomary);
     void on_unit_system_changed_with_data_clear();
     void update_input_summary();
+    void show_solver_statistics();
 
 private:
     void setup_ui();
@@ -57,6 +59,10 @@ private:
     QAction* saveAsAction_;
     QAction* exitAction_;
 
+    QMenu* analysisMenu_;
+    QAction* liveResultsAction_;
+    QAction* solverStatisticsAction_;
+
     WorkflowController* workflowController_;
 };
 
@@ -186,6 +186,8 @@ void VtkWidget::render_channel(const GeometryData& geometry, const CalculationRe
     waterFlowAnimator_ = std::make_unique<WaterFlowAnimator>(
         geometry, results, currentChannelRenderer_.get());
 
+    // Replace, not accumulate, the particle actor of the previous result.
+    renderer_->RemoveActor(particleActor_);
     particleActor_ = waterFlowAnimator_->get_particle_actor();
     renderer_->AddActor(particleActor_);
     particleActor_->SetVisibility(1);
@@ -194,13 +196,13 @@ void VtkWidget::render_channel(const GeometryData& geometry, const CalculationRe
     start_water_animation();
 }
 
-std::unique_ptr<ChannelRenderer> VtkWidget::create_renderer(const QString& channelType)
+std::unique_ptr<ChannelRenderer> VtkWidget::create_renderer(ChannelType channelType)
 {
-    if(channelType == "Rectangular")
+    if(channelType == ChannelType::Rectangular)
         return std::make_unique<RectangularChannelRenderer>();
-    else if(channelType == "Trapezoidal")
+    else if(channelType == ChannelType::Trapezoidal)
         return std::make_unique<TrapezoidalChannelRenderer>();
-    else if(channelType == "Triangular")
+    else if(channelType == ChannelType::Triangular)
         return std::make_unique<TriangularChannelRenderer>();
 
     return nullptr;
@@ -241,8 +243,6 @@ void VtkWidget::setup_camera_for_geometry(const GeometryData& geometry, const Ca
     camera->SetParallelScale(maxDimension * 0.6);
 
     renderer_->ResetCameraClippingRange();
-
-    renderWindow_->Render();
 }
 
 void VtkWidget::set_camera_view(double posX, double posY, double posZ,
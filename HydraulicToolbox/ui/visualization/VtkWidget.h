@@ -50,7 +50,7 @@ private:
     void set_camera_view(double posX, double posY, double posZ,
                          double upX, double upY, double upZ);
 
-    std::unique_ptr<ChannelRenderer> create_renderer(const QString& channelType);
+    std::unique_ptr<ChannelRenderer> create_renderer(ChannelType channelType);
     void setup_camera_for_geometry(const GeometryData& geometry, const CalculationResults& results);
 
     vtkSmartPointer<vtkRenderer> renderer_;
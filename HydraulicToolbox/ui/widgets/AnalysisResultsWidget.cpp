@@ -6,10 +6,22 @@
 AnalysisResultsWidget::AnalysisResultsWidget(QWidget* parent)
     : QWidget(parent)
     , placeholderLabel_{nullptr}
+    , progressBar_{nullptr}
     , normalDepthLabel_{nullptr}
+    , normalDepthBandLabel_{nullptr}
     , velocityLabel_{nullptr}
     , froudeNumberLabel_{nullptr}
     , flowRegimeLabel_{nullptr}
+    , criticalDepthLabel_{nullptr}
+    , specificEnergyLabel_{nullptr}
+    , minimumSpecificEnergyLabel_{nullptr}
+    , specificForceLabel_{nullptr}
+    , manningNLabel_{nullptr}
+    , manningNSensitivityLabel_{nullptr}
+    , dischargeSensitivityLabel_{nullptr}
+    , bedSlopeSensitivityLabel_{nullptr}
+    , widthSensitivityLabel_{nullptr}
+    , sideSlopeSensitivityLabel_{nullptr}
     , errorLabel_{nullptr}
 {
     setup_ui();
@@ -44,6 +56,13 @@ void AnalysisResultsWidget::setup_ui()
         );
     mainLayout->addWidget(placeholderLabel_);
 
+    progressBar_ = new QProgressBar();
+    progressBar_->setRange(0, 100);
+    progressBar_->setTextVisible(true);
+    progressBar_->setFormat("Calculating... %p%");
+    progressBar_->setVisible(false);
+    mainLayout->addWidget(progressBar_);
+
     QGroupBox* resultsGroup = new QGroupBox("Analysis Results");
     QFormLayout* formLayout = new QFormLayout();
     formLayout->setSpacing(15);
@@ -53,6 +72,10 @@ void AnalysisResultsWidget::setup_ui()
     normalDepthLabel_->setMinimumWidth(300);
     formLayout->addRow("Normal Depth:", normalDepthLabel_);
 
+    normalDepthBandLabel_ = new QLabel("--");
+    normalDepthBandLabel_->setMinimumWidth(300);
+    formLayout->addRow("Normal Depth (5-95%):", normalDepthBandLabel_);
+
     velocityLabel_ = new QLabel("--");
     velocityLabel_->setMinimumWidth(300);
     formLayout->addRow("Average Velocity:", velocityLabel_);
@@ -65,8 +88,55 @@ void AnalysisResultsWidget::setup_ui()
     flowRegimeLabel_->setMinimumWidth(300);
     formLayout->addRow("Flow Regime:", flowRegimeLabel_);
 
+    criticalDepthLabel_ = new QLabel("--");
+    criticalDepthLabel_->setMinimumWidth(300);
+    formLayout->addRow("Critical Depth:", criticalDepthLabel_);
+
+    specificEnergyLabel_ = new QLabel("--");
+    specificEnergyLabel_->setMinimumWidth(300);
+    formLayout->addRow("Specific Energy:", specificEnergyLabel_);
+
+    minimumSpecificEnergyLabel_ = new QLabel("--");
+    minimumSpecificEnergyLabel_->setMinimumWidth(300);
+    formLayout->addRow("Minimum Specific Energy:", minimumSpecificEnergyLabel_);
+
+    specificForceLabel_ = new QLabel("--");
+    specificForceLabel_->setMinimumWidth(300);
+    formLayout->addRow("Specific Force:", specificForceLabel_);
+
+    manningNLabel_ = new QLabel("--");
+    manningNLabel_->setMinimumWidth(300);
+    formLayout->addRow("Manning's n at Normal Depth:", manningNLabel_);
+
     resultsGroup->setLayout(formLayout);
 
+    QGroupBox* sensitivityGroup = new QGroupBox("Normal Depth Sensitivities");
+    QFormLayout* sensitivityLayout = new QFormLayout();
+    sensitivityLayout->setSpacing(15);
+    sensitivityLayout->setLabelAlignment(Qt::AlignRight | Qt::AlignVCenter);
+
+    manningNSensitivityLabel_ = new QLabel("--");
+    manningNSensitivityLabel_->setMinimumWidth(300);
+    sensitivityLayout->addRow("dy/dn (Manning's n):", manningNSensitivityLabel_);
+
+    dischargeSensitivityLabel_ = new QLabel("--");
+    dischargeSensitivityLabel_->setMinimumWidth(300);
+    sensitivityLayout->addRow("dy/dQ (Discharge):", dischargeSensitivityLabel_);
+
+    bedSlopeSensitivityLabel_ = new QLabel("--");
+    bedSlopeSensitivityLabel_->setMinimumWidth(300);
+    sensitivityLayout->addRow("dy/dS (Bed Slope):", bedSlopeSensitivityLabel_);
+
+    widthSensitivityLabel_ = new QLabel("--");
+    widthSensitivityLabel_->setMinimumWidth(300);
+    sensitivityLayout->addRow("dy/db (Bottom Width):", widthSensitivityLabel_);
+
+    sideSlopeSensitivityLabel_ = new QLabel("--");
+    sideSlopeSensitivityLabel_->setMinimumWidth(300);
+    sensitivityLayout->addRow("dy/dz (Side Slope):", sideSlopeSensitivityLabel_);
+
+    sensitivityGroup->setLayout(sensitivityLayout);
+
     errorLabel_ = new QLabel();
     errorLabel_->setWordWrap(true);
     errorLabel_->setAlignment(Qt::AlignCenter);
@@ -85,6 +155,7 @@ void AnalysisResultsWidget::setup_ui()
     mainLayout->addWidget(errorLabel_);
 
     mainLayout->addWidget(resultsGroup);
+    mainLayout->addWidget(sensitivityGroup);
 
     mainLayout->addStretch();
 }
@@ -108,21 +179,60 @@ void AnalysisResultsWidget::apply_styling()
         "  padding: 0 5px; "
         "  left: 10px; "
         "}"
+        "QProgressBar { "
+        "  color: #c0c0c0; "
+        "  background-color: #3c3c3c; "
+        "  border: 1px solid #5a5a5a; "
+        "  border-radius: 3px; "
+        "  text-align: center; "
+        "}"
+        "QProgressBar::chunk { "
+        "  background-color: #0078d4; "
+        "}"
         );
 }
 
+void AnalysisResultsWidget::show_calculation_started()
+{
+    progressBar_->setValue(0);
+    progressBar_->setVisible(true);
+}
+
+void AnalysisResultsWidget::set_calculation_progress(int percent)
+{
+    progressBar_->setValue(percent);
+}
+
+void AnalysisResultsWidget::hide_calculation_progress()
+{
+    progressBar_->setVisible(false);
+}
+
 void AnalysisResultsWidget::update_results(const CalculationResults& results, bool useUsCustomary)
 {
+    hide_calculation_progress();
+
     if(!results.isValid)
     {
-        errorLabel_->setText(results.errorMessage);
+        errorLabel_->setText(get_error_message(results.error));
         errorLabel_->setVisible(true);
         placeholderLabel_->setVisible(true);
 
         normalDepthLabel_->setText("--");
+        normalDepthBandLabel_->setText("--");
         velocityLabel_->setText("--");
         froudeNumberLabel_->setText("--");
         flowRegimeLabel_->setText("--");
+        criticalDepthLabel_->setText("--");
+        specificEnergyLabel_->setText("--");
+        minimumSpecificEnergyLabel_->setText("--");
+        specificForceLabel_->setText("--");
+        manningNLabel_->setText("--");
+        manningNSensitivityLabel_->setText("--");
+        dischargeSensitivityLabel_->setText("--");
+        bedSlopeSensitivityLabel_->setText("--");
+        widthSensitivityLabel_->setText("--");
+        sideSlopeSensitivityLabel_->setText("--");
         return;
     }
 
@@ -131,9 +241,68 @@ void AnalysisResultsWidget::update_results(const CalculationResults& results, bo
 
     QString depthUnit = useUsCustomary ? "ft" : "m";
     QString velocityUnit = useUsCustomary ? "ft/s" : "m/s";
+    QString volumeUnit = useUsCustomary ? "ft³" : "m³";
 
     normalDepthLabel_->setText(QString::number(results.normalDepth, 'f', 3) + " " + depthUnit);
     velocityLabel_->setText(QString::number(results.velocity, 'f', 3) + " " + velocityUnit);
+
+    if(results.hasUncertainty)
+    {
+        normalDepthBandLabel_->setText(QString("%1 - %2 %3 (median %4)")
+                                           .arg(results.normalDepthLower, 0, 'f', 3)
+                                           .arg(results.normalDepthUpper, 0, 'f', 3)
+                                           .arg(depthUnit)
+                                           .arg(results.normalDepthMedian, 0, 'f', 3));
+    }
+    else
+    {
+        normalDepthBandLabel_->setText("--");
+    }
+
     froudeNumberLabel_->setText(QString::number(results.froudeNumber, 'f', 3));
-    flowRegimeLabel_->setText(results.flowRegime);
+    flowRegimeLabel_->setText(get_flow_regime_name(results.flowRegime));
+    specificEnergyLabel_->setText(QString::number(results.specificEnergy, 'f', 3) + " " + depthUnit);
+
+    if(results.hasCriticalDepth)
+    {
+        criticalDepthLabel_->setText(QString::number(results.criticalDepth, 'f', 3) + " " + depthUnit);
+        minimumSpecificEnergyLabel_->setText(QString::number(results.minimumSpecificEnergy, 'f', 3) + " " + depthUnit);
+    }
+    else
+    {
+        criticalDepthLabel_->setText("-- (did not converge)");
+        minimumSpecificEnergyLabel_->setText("-- (did not converge)");
+    }
+
+    specificForceLabel_->setText(QString::number(results.specificForce, 'f', 3) + " " + volumeUnit);
+    manningNLabel_->setText(QString::number(results.manningN, 'f', 4));
+
+    QString dischargeUnit = useUsCustomary ? "cfs" : "m³/s";
+    const NormalDepthSensitivities& sensitivities = results.sensitivities;
+
+    if(sensitivities.isValid)
+    {
+        manningNSensitivityLabel_->setText(QString::number(sensitivities.manningN, 'g', 4) + " " + depthUnit);
+        dischargeSensitivityLabel_->setText(QString::number(sensitivities.discharge, 'g', 4) + " " + depthUnit + " per " + dischargeUnit);
+        bedSlopeSensitivityLabel_->setText(QString::number(sensitivities.bedSlope, 'g', 4) + " " + depthUnit);
+
+        if(sensitivities.hasDimensions)
+        {
+            widthSensitivityLabel_->setText(QString::number(sensitivities.width, 'g', 4));
+            sideSlopeSensitivityLabel_->setText(QString::number(sensitivities.sideSlope, 'g', 4) + " " + depthUnit);
+        }
+        else
+        {
+            widthSensitivityLabel_->setText("--");
+            sideSlopeSensitivityLabel_->setText("--");
+        }
+    }
+    else
+    {
+        manningNSensitivityLabel_->setText("--");
+        dischargeSensitivityLabel_->setText("--");
+        bedSlopeSensitivityLabel_->setText("--");
+        widthSensitivityLabel_->setText("--");
+        sideSlopeSensitivityLabel_->setText("--");
+    }
 }
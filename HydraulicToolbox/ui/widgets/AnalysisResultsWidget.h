@@ -3,6 +3,7 @@
 
 #include <QWidget>
 #include <QLabel>
+#include <QProgressBar>
 #include <QVBoxLayout>
 #include "../backend/HydraulicCalculator.h"
 
@@ -18,6 +19,11 @@ public:
 
     void update_results(const CalculationResults& results, bool useUsCustomary);
 
+public slots:
+    void show_calculation_started();
+    void set_calculation_progress(int percent);
+    void hide_calculation_progress();
+
 signals:
     void data_changed();
 
@@ -26,10 +32,22 @@ private:
     void apply_styling();
 
     QLabel* placeholderLabel_;
+    QProgressBar* progressBar_;
     QLabel* normalDepthLabel_;
+    QLabel* normalDepthBandLabel_;
     QLabel* velocityLabel_;
     QLabel* froudeNumberLabel_;
     QLabel* flowRegimeLabel_;
+    QLabel* criticalDepthLabel_;
+    QLabel* specificEnergyLabel_;
+    QLabel* minimumSpecificEnergyLabel_;
+    QLabel* specificForceLabel_;
+    QLabel* manningNLabel_;
+    QLabel* manningNSensitivityLabel_;
+    QLabel* dischargeSensitivityLabel_;
+    QLabel* bedSlopeSensitivityLabel_;
+    QLabel* widthSensitivityLabel_;
+    QLabel* sideSlopeSensitivityLabel_;
     QLabel* errorLabel_;
 };
 
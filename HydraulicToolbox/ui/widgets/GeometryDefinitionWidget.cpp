@@ -28,9 +28,9 @@ GeometryDefinitionWidget::~GeometryDefinitionWidget()
 {
 }
 
-QString GeometryDefinitionWidget::get_channel_type() const
+ChannelType GeometryDefinitionWidget::get_channel_type() const
 {
-    return channelTypeCombo_->currentText();
+    return static_cast<ChannelType>(channelTypeCombo_->currentData().toInt());
 }
 
 double GeometryDefinitionWidget::get_bottom_width() const
@@ -50,19 +50,19 @@ double GeometryDefinitionWidget::get_bed_slope() const
 
 bool GeometryDefinitionWidget::is_complete() const
 {
-    QString channelType = channelTypeCombo_->currentText();
+    ChannelType channelType = get_channel_type();
 
     if(bedSlopeEdit_->text().isEmpty()) return false;
 
-    if(channelType == "Rectangular")
+    if(channelType == ChannelType::Rectangular)
     {
         return !bottomWidthEdit_->text().isEmpty();
     }
-    else if(channelType == "Trapezoidal")
+    else if(channelType == ChannelType::Trapezoidal)
     {
         return !bottomWidthEdit_->text().isEmpty() && !sideSlopeEdit_->text().isEmpty();
     }
-    else if(channelType == "Triangular")
+    else if(channelType == ChannelType::Triangular)
     {
         return !sideSlopeEdit_->text().isEmpty();
     }
@@ -88,9 +88,9 @@ void GeometryDefinitionWidget::setup_ui()
     QVBoxLayout* typeLayout = new QVBoxLayout();
 
     channelTypeCombo_ = new QComboBox();
-    channelTypeCombo_->addItem("Rectangular");
-    channelTypeCombo_->addItem("Trapezoidal");
-    channelTypeCombo_->addItem("Triangular");
+    channelTypeCombo_->addItem("Rectangular", static_cast<int>(ChannelType::Rectangular));
+    channelTypeCombo_->addItem("Trapezoidal", static_cast<int>(ChannelType::Trapezoidal));
+    channelTypeCombo_->addItem("Triangular", static_cast<int>(ChannelType::Triangular));
     channelTypeCombo_->setMinimumWidth(300);
 
     QListView* comboListView = new QListView(channelTypeCombo_);
@@ -245,23 +245,23 @@ void GeometryDefinitionWidget::on_channel_type_changed(int index)
 
 void GeometryDefinitionWidget::update_geometry_inputs()
 {
-    QString channelType = channelTypeCombo_->currentText();
+    ChannelType channelType = get_channel_type();
 
-    if(channelType == "Rectangular")
+    if(channelType == ChannelType::Rectangular)
     {
         bottomWidthLabel_->setVisible(true);
         bottomWidthEdit_->setVisible(true);
         sideSlopeLabel_->setVisible(false);
         sideSlopeEdit_->setVisible(false);
     }
-    else if(channelType == "Trapezoidal")
+    else if(channelType == ChannelType::Trapezoidal)
     {
         bottomWidthLabel_->setVisible(true);
         bottomWidthEdit_->setVisible(true);
         sideSlopeLabel_->setVisible(true);
         sideSlopeEdit_->setVisible(true);
     }
-    else if(channelType == "Triangular")
+    else if(channelType == ChannelType::Triangular)
     {
         bottomWidthLabel_->setVisible(false);
         bottomWidthEdit_->setVisible(false);
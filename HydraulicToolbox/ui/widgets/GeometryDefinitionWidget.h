@@ -7,6 +7,7 @@
 #include <QLabel>
 #include <QFormLayout>
 #include <QString>
+#include "CalculationInputs.h"
 
 class GeometryDefinitionWidget : public QWidget
 {
@@ -16,7 +17,7 @@ public:
     explicit GeometryDefinitionWidget(QWidget* parent = nullptr);
     ~GeometryDefinitionWidget();
 
-    QString get_channel_type() const;
+    ChannelType get_channel_type() const;
     double get_bottom_width() const;
     double get_side_slope() const;
     double get_bed_slope() const;
@@ -1,26 +1,61 @@
 #include "HydraulicParametersWidget.h"
 #include "UnitSystemConstants.h"
 #include <QVBoxLayout>
-#include <QGroupBox>
-#include <QLabel>
+#include <QHBoxLayout>
 #include <QListView>
 #include <QStyledItemDelegate>
 
+namespace
+{
+// Item data roles holding each material's typical range of n.
+constexpr int MANNINGS_N_MINIMUM_ROLE{Qt::UserRole + 1};
+constexpr int MANNINGS_N_MAXIMUM_ROLE{Qt::UserRole + 2};
+}
+
 HydraulicParametersWidget::HydraulicParametersWidget(QWidget* parent)
     : QWidget(parent)
     , dischargeEdit_{nullptr}
     , manningsMaterialCombo_{nullptr}
+    , manningsNLabel_{nullptr}
     , manningsNEdit_{nullptr}
+    , compositeGroup_{nullptr}
+    , bankMaterialCombo_{nullptr}
+    , bankManningsNEdit_{nullptr}
+    , roughnessMethodCombo_{nullptr}
+    , uncertaintyGroup_{nullptr}
+    , manningsNDistribution_{}
+    , dischargeDistribution_{}
+    , bedSlopeDistribution_{}
     , formLayout_{nullptr}
 {
     setup_ui();
     apply_styling();
-    populate_mannings_materials();
+    populate_mannings_materials(manningsMaterialCombo_);
+    populate_mannings_materials(bankMaterialCombo_);
 
     connect(dischargeEdit_, &QLineEdit::textChanged, this, &HydraulicParametersWidget::data_changed);
     connect(manningsNEdit_, &QLineEdit::textChanged, this, &HydraulicParametersWidget::data_changed);
     connect(manningsMaterialCombo_, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &HydraulicParametersWidget::on_material_selected);
+    connect(bankManningsNEdit_, &QLineEdit::textChanged, this, &HydraulicParametersWidget::data_changed);
+    connect(bankMaterialCombo_, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &HydraulicParametersWidget::on_bank_material_selected);
+    connect(roughnessMethodCombo_, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &HydraulicParametersWidget::data_changed);
+    connect(compositeGroup_, &QGroupBox::toggled, this, &HydraulicParametersWidget::on_composite_lining_toggled);
+    connect(uncertaintyGroup_, &QGroupBox::toggled, this, &HydraulicParametersWidget::data_changed);
+
+    for(const DistributionRow* row : {&manningsNDistribution_, &dischargeDistribution_, &bedSlopeDistribution_})
+    {
+        connect(row->typeCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this, row]()
+        {
+            update_distribution_row(*row);
+            emit data_changed();
+        });
+
+        for(QLineEdit* edit : row->parameterEdits)
+            connect(edit, &QLineEdit::textChanged, this, &HydraulicParametersWidget::data_changed);
+    }
 }
 
 HydraulicParametersWidget::~HydraulicParametersWidget()
@@ -37,9 +72,33 @@ double HydraulicParametersWidget::get_mannings_n() const
     return manningsNEdit_->text().toDouble();
 }
 
+double HydraulicParametersWidget::get_bank_mannings_n() const
+{
+    if(!compositeGroup_->isChecked())
+        return 0.0;
+
+    return bankManningsNEdit_->text().toDouble();
+}
+
+CompositeRoughnessMethod HydraulicParametersWidget::get_roughness_method() const
+{
+    return static_cast<CompositeRoughnessMethod>(roughnessMethodCombo_->currentData().toInt());
+}
+
+UncertaintyData HydraulicParametersWidget::get_uncertainty_data() const
+{
+    UncertaintyData data;
+    data.isEnabled = uncertaintyGroup_->isChecked();
+    data.manningN = read_distribution_row(manningsNDistribution_);
+    data.discharge = read_distribution_row(dischargeDistribution_);
+    data.bedSlope = read_distribution_row(bedSlopeDistribution_);
+    return data;
+}
+
 bool HydraulicParametersWidget::is_complete() const
 {
-    return !dischargeEdit_->text().isEmpty() && !manningsNEdit_->text().isEmpty();
+    bool isBankComplete = !compositeGroup_->isChecked() || !bankManningsNEdit_->text().isEmpty();
+    return !dischargeEdit_->text().isEmpty() && !manningsNEdit_->text().isEmpty() && isBankComplete;
 }
 
 void HydraulicParametersWidget::clear_fields()
@@ -47,6 +106,14 @@ void HydraulicParametersWidget::clear_fields()
     dischargeEdit_->clear();
     manningsMaterialCombo_->setCurrentIndex(0);
     manningsNEdit_->clear();
+    bankMaterialCombo_->setCurrentIndex(0);
+    bankManningsNEdit_->clear();
+    roughnessMethodCombo_->setCurrentIndex(0);
+    compositeGroup_->setChecked(false);
+    clear_distribution_row(manningsNDistribution_);
+    clear_distribution_row(dischargeDistribution_);
+    clear_distribution_row(bedSlopeDistribution_);
+    uncertaintyGroup_->setChecked(false);
 }
 
 void HydraulicParametersWidget::update_placeholders(bool useUsCustomary)
@@ -79,13 +146,164 @@ void HydraulicParametersWidget::setup_ui()
 
     QLabel* materialLabel = new QLabel("Channel Material:");
     manningsMaterialCombo_ = new QComboBox();
-    manningsMaterialCombo_->setMinimumWidth(300);
+    configure_material_combo(manningsMaterialCombo_);
+
+    manningsLayout->addWidget(materialLabel);
+    manningsLayout->addWidget(manningsMaterialCombo_);
+
+    manningsNLabel_ = new QLabel("Manning's n:");
+    manningsNEdit_ = new QLineEdit();
+    manningsNEdit_->setPlaceholderText("Enter or select from materials");
+    manningsNEdit_->setMinimumWidth(300);
+    manningsLayout->addWidget(manningsNLabel_);
+    manningsLayout->addWidget(manningsNEdit_);
+
+    manningsGroup->setLayout(manningsLayout);
+
+    // Banks lined with a different material than the bed, e.g. a concrete
+    // bed with riprap banks. The equivalent n follows the wetted lengths.
+    compositeGroup_ = new QGroupBox("Composite Lining (Bank Material)");
+    compositeGroup_->setCheckable(true);
+    compositeGroup_->setChecked(false);
+    QVBoxLayout* compositeLayout = new QVBoxLayout();
+    compositeLayout->setSpacing(15);
+
+    QLabel* bankMaterialLabel = new QLabel("Bank Material:");
+    bankMaterialCombo_ = new QComboBox();
+    configure_material_combo(bankMaterialCombo_);
+    compositeLayout->addWidget(bankMaterialLabel);
+    compositeLayout->addWidget(bankMaterialCombo_);
+
+    QLabel* bankManningsNLabel = new QLabel("Bank Manning's n:");
+    bankManningsNEdit_ = new QLineEdit();
+    bankManningsNEdit_->setPlaceholderText("Enter or select from materials");
+    bankManningsNEdit_->setMinimumWidth(300);
+    compositeLayout->addWidget(bankManningsNLabel);
+    compositeLayout->addWidget(bankManningsNEdit_);
+
+    QLabel* methodLabel = new QLabel("Composite n Method:");
+    roughnessMethodCombo_ = new QComboBox();
+    configure_material_combo(roughnessMethodCombo_);
+    for(CompositeRoughnessMethod method : {CompositeRoughnessMethod::HortonEinstein,
+                                           CompositeRoughnessMethod::Lotter,
+                                           CompositeRoughnessMethod::Pavlovskii})
+    {
+        roughnessMethodCombo_->addItem(get_composite_roughness_method_name(method), static_cast<int>(method));
+    }
+    compositeLayout->addWidget(methodLabel);
+    compositeLayout->addWidget(roughnessMethodCombo_);
+
+    compositeGroup_->setLayout(compositeLayout);
+
+    // Monte Carlo band for normal depth. Unchecked by default: a run solves
+    // normal depth once per sample.
+    uncertaintyGroup_ = new QGroupBox("Uncertainty Analysis (Monte Carlo)");
+    uncertaintyGroup_->setCheckable(true);
+    uncertaintyGroup_->setChecked(false);
+    QFormLayout* uncertaintyLayout = new QFormLayout();
+    uncertaintyLayout->setSpacing(15);
+    uncertaintyLayout->setLabelAlignment(Qt::AlignRight | Qt::AlignVCenter);
+
+    manningsNDistribution_ = create_distribution_row(uncertaintyLayout, "Manning's n:");
+    dischargeDistribution_ = create_distribution_row(uncertaintyLayout, "Discharge (Q):");
+    bedSlopeDistribution_ = create_distribution_row(uncertaintyLayout, "Bed Slope (S):");
+
+    uncertaintyGroup_->setLayout(uncertaintyLayout);
+
+    hydraulicGroup->setLayout(formLayout_);
+    mainLayout->addWidget(hydraulicGroup);
+    mainLayout->addWidget(manningsGroup);
+    mainLayout->addWidget(compositeGroup_);
+    mainLayout->addWidget(uncertaintyGroup_);
+    mainLayout->addStretch();
+}
+
+HydraulicParametersWidget::DistributionRow HydraulicParametersWidget::create_distribution_row(QFormLayout* layout,
+                                                                                              const QString& label)
+{
+    DistributionRow row;
+    QHBoxLayout* rowLayout = new QHBoxLayout();
+    rowLayout->setSpacing(8);
+
+    row.typeCombo = new QComboBox();
+    configure_material_combo(row.typeCombo);
+    row.typeCombo->setMinimumWidth(150);
+    row.typeCombo->addItem("Fixed (entered value)", static_cast<int>(DistributionType::Fixed));
+    row.typeCombo->addItem("Uniform", static_cast<int>(DistributionType::Uniform));
+    row.typeCombo->addItem("Normal", static_cast<int>(DistributionType::Normal));
+    row.typeCombo->addItem("Log-normal", static_cast<int>(DistributionType::LogNormal));
+    row.typeCombo->addItem("Triangular", static_cast<int>(DistributionType::Triangular));
+    rowLayout->addWidget(row.typeCombo);
+
+    for(QLineEdit*& edit : row.parameterEdits)
+    {
+        edit = new QLineEdit();
+        edit->setMinimumWidth(80);
+        rowLayout->addWidget(edit);
+    }
 
-    QListView* comboListView = new QListView(manningsMaterialCombo_);
+    layout->addRow(label, rowLayout);
+    update_distribution_row(row);
+    return row;
+}
+
+// Shows one edit per parameter of the selected type, named by placeholder.
+void HydraulicParametersWidget::update_distribution_row(const DistributionRow& row)
+{
+    QStringList names;
+
+    switch(static_cast<DistributionType>(row.typeCombo->currentData().toInt()))
+    {
+    case DistributionType::Fixed:
+        break;
+    case DistributionType::Uniform:
+        names << "Lower" << "Upper";
+        break;
+    case DistributionType::Normal:
+        names << "Mean" << "Std. dev.";
+        break;
+    case DistributionType::LogNormal:
+        names << "Median" << "Std. dev. of ln";
+        break;
+    case DistributionType::Triangular:
+        names << "Lower" << "Mode" << "Upper";
+        break;
+    }
+
+    for(int i = 0; i < static_cast<int>(row.parameterEdits.size()); ++i)
+    {
+        row.parameterEdits[i]->setVisible(i < names.size());
+        row.parameterEdits[i]->setPlaceholderText(i < names.size() ? names[i] : QString());
+    }
+}
+
+Distribution HydraulicParametersWidget::read_distribution_row(const DistributionRow& row) const
+{
+    Distribution distribution;
+    distribution.type = static_cast<DistributionType>(row.typeCombo->currentData().toInt());
+    distribution.first = row.parameterEdits[0]->text().toDouble();
+    distribution.second = row.parameterEdits[1]->text().toDouble();
+    distribution.third = row.parameterEdits[2]->text().toDouble();
+    return distribution;
+}
+
+void HydraulicParametersWidget::clear_distribution_row(const DistributionRow& row)
+{
+    row.typeCombo->setCurrentIndex(0);
+
+    for(QLineEdit* edit : row.parameterEdits)
+        edit->clear();
+}
+
+void HydraulicParametersWidget::configure_material_combo(QComboBox* combo)
+{
+    combo->setMinimumWidth(300);
+
+    QListView* comboListView = new QListView(combo);
     comboListView->setSpacing(0);
     comboListView->setFrameShape(QFrame::NoFrame);
-    manningsMaterialCombo_->setView(comboListView);
-    manningsMaterialCombo_->setItemDelegate(new QStyledItemDelegate(manningsMaterialCombo_));
+    combo->setView(comboListView);
+    combo->setItemDelegate(new QStyledItemDelegate(combo));
 
     comboListView->setStyleSheet(
         "QListView { "
@@ -95,9 +313,9 @@ void HydraulicParametersWidget::setup_ui()
         "}"
         );
 
-    if(manningsMaterialCombo_->view()->parentWidget())
+    if(combo->view()->parentWidget())
     {
-        manningsMaterialCombo_->view()->parentWidget()->setStyleSheet(
+        combo->view()->parentWidget()->setStyleSheet(
             "QWidget { "
             "  background-color: #4a4a4a; "
             "  border: none; "
@@ -106,23 +324,6 @@ void HydraulicParametersWidget::setup_ui()
             "}"
             );
     }
-
-    manningsLayout->addWidget(materialLabel);
-    manningsLayout->addWidget(manningsMaterialCombo_);
-
-    QLabel* manningsNLabel = new QLabel("Manning's n:");
-    manningsNEdit_ = new QLineEdit();
-    manningsNEdit_->setPlaceholderText("Enter or select from materials");
-    manningsNEdit_->setMinimumWidth(300);
-    manningsLayout->addWidget(manningsNLabel);
-    manningsLayout->addWidget(manningsNEdit_);
-
-    manningsGroup->setLayout(manningsLayout);
-
-    hydraulicGroup->setLayout(formLayout_);
-    mainLayout->addWidget(hydraulicGroup);
-    mainLayout->addWidget(manningsGroup);
-    mainLayout->addStretch();
 }
 
 void HydraulicParametersWidget::apply_styling()
@@ -209,31 +410,66 @@ void HydraulicParametersWidget::apply_styling()
         );
 }
 
-void HydraulicParametersWidget::populate_mannings_materials()
+void HydraulicParametersWidget::populate_mannings_materials(QComboBox* combo)
+{
+    combo->addItem("-- Select Material --", 0.0);
+    add_material(combo, "PVC / Plastic Pipe (n=0.009)", 0.009, 0.008, 0.011);
+    add_material(combo, "Concrete - Finished (n=0.012)", 0.012, 0.011, 0.013);
+    add_material(combo, "Concrete - Unfinished (n=0.014)", 0.014, 0.012, 0.016);
+    add_material(combo, "Concrete - Gunite (n=0.019)", 0.019, 0.016, 0.023);
+    add_material(combo, "Earth - Clean, Straight (n=0.022)", 0.022, 0.018, 0.025);
+    add_material(combo, "Corrugated Metal (n=0.024)", 0.024, 0.021, 0.030);
+    add_material(combo, "Earth - Gravelly (n=0.025)", 0.025, 0.022, 0.030);
+    add_material(combo, "Earth - Weedy (n=0.030)", 0.030, 0.025, 0.033);
+    add_material(combo, "Natural Channel - Clean (n=0.030)", 0.030, 0.025, 0.033);
+    add_material(combo, "Grass-Lined - Short 2-6 in (n=0.030)", 0.030, 0.025, 0.035);
+    add_material(combo, "Earth - Stony, Cobbles (n=0.035)", 0.035, 0.025, 0.040);
+    add_material(combo, "Grass-Lined - Medium 6-12 in (n=0.035)", 0.035, 0.030, 0.040);
+    add_material(combo, "Natural Channel - Winding (n=0.040)", 0.040, 0.033, 0.045);
+    add_material(combo, "Grass-Lined - Long 12+ in (n=0.050)", 0.050, 0.040, 0.060);
+    add_material(combo, "Natural Channel - Heavy Brush (n=0.075)", 0.075, 0.050, 0.100);
+}
+
+void HydraulicParametersWidget::add_material(QComboBox* combo, const QString& name, double manningsN,
+                                             double minimumN, double maximumN)
 {
-    manningsMaterialCombo_->addItem("-- Select Material --", 0.0);
-    manningsMaterialCombo_->addItem("PVC / Plastic Pipe (n=0.009)", 0.009);
-    manningsMaterialCombo_->addItem("Concrete - Finished (n=0.012)", 0.012);
-    manningsMaterialCombo_->addItem("Concrete - Unfinished (n=0.014)", 0.014);
-    manningsMaterialCombo_->addItem("Concrete - Gunite (n=0.019)", 0.019);
-    manningsMaterialCombo_->addItem("Earth - Clean, Straight (n=0.022)", 0.022);
-    manningsMaterialCombo_->addItem("Corrugated Metal (n=0.024)", 0.024);
-    manningsMaterialCombo_->addItem("Earth - Gravelly (n=0.025)", 0.025);
-    manningsMaterialCombo_->addItem("Earth - Weedy (n=0.030)", 0.030);
-    manningsMaterialCombo_->addItem("Natural Channel - Clean (n=0.030)", 0.030);
-    manningsMaterialCombo_->addItem("Grass-Lined - Short 2-6 in (n=0.030)", 0.030);
-    manningsMaterialCombo_->addItem("Earth - Stony, Cobbles (n=0.035)", 0.035);
-    manningsMaterialCombo_->addItem("Grass-Lined - Medium 6-12 in (n=0.035)", 0.035);
-    manningsMaterialCombo_->addItem("Natural Channel - Winding (n=0.040)", 0.040);
-    manningsMaterialCombo_->addItem("Grass-Lined - Long 12+ in (n=0.050)", 0.050);
-    manningsMaterialCombo_->addItem("Natural Channel - Heavy Brush (n=0.075)", 0.075);
+    combo->addItem(name, manningsN);
+
+    int index = combo->count() - 1;
+    combo->setItemData(index, minimumN, MANNINGS_N_MINIMUM_ROLE);
+    combo->setItemData(index, maximumN, MANNINGS_N_MAXIMUM_ROLE);
 }
 
+// A material also suggests a triangular n over its typical range, with the
+// material's n as the mode.
 void HydraulicParametersWidget::on_material_selected(int index)
 {
     if(index > 0)
     {
         double nValue = manningsMaterialCombo_->currentData().toDouble();
         manningsNEdit_->setText(QString::number(nValue, 'f', 3));
+
+        double minimumN = manningsMaterialCombo_->itemData(index, MANNINGS_N_MINIMUM_ROLE).toDouble();
+        double maximumN = manningsMaterialCombo_->itemData(index, MANNINGS_N_MAXIMUM_ROLE).toDouble();
+        manningsNDistribution_.typeCombo->setCurrentIndex(
+            manningsNDistribution_.typeCombo->findData(static_cast<int>(DistributionType::Triangular)));
+        manningsNDistribution_.parameterEdits[0]->setText(QString::number(minimumN, 'f', 3));
+        manningsNDistribution_.parameterEdits[1]->setText(QString::number(nValue, 'f', 3));
+        manningsNDistribution_.parameterEdits[2]->setText(QString::number(maximumN, 'f', 3));
+    }
+}
+
+void HydraulicParametersWidget::on_bank_material_selected(int index)
+{
+    if(index > 0)
+    {
+        double nValue = bankMaterialCombo_->currentData().toDouble();
+        bankManningsNEdit_->setText(QString::number(nValue, 'f', 3));
     }
 }
+
+void HydraulicParametersWidget::on_composite_lining_toggled(bool isChecked)
+{
+    manningsNLabel_->setText(isChecked ? "Bed Manning's n:" : "Manning's n:");
+    emit data_changed();
+}
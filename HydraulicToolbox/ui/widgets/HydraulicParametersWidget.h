@@ -5,6 +5,11 @@
 #include <QLineEdit>
 #include <QComboBox>
 #include <QFormLayout>
+#include <QGroupBox>
+#include <QLabel>
+#include <array>
+#include "CompositeRoughness.h"
+#include "ProjectDataStructures.h"
 
 class HydraulicParametersWidget : public QWidget
 {
@@ -16,6 +21,15 @@ public:
 
     double get_discharge() const;
     double get_mannings_n() const;
+
+    // Bank n of a composite lining, or 0 when the channel is lined uniformly.
+    // With a composite lining, get_mannings_n() is the bed n.
+    double get_bank_mannings_n() const;
+    CompositeRoughnessMethod get_roughness_method() const;
+
+    // Distributions of the uncertainty group; isEnabled follows its check box.
+    UncertaintyData get_uncertainty_data() const;
+
     bool is_complete() const;
 
     void clear_fields();
@@ -25,14 +39,38 @@ signals:
     void data_changed();
 
 private:
+    // Distribution type and up to three parameters for one uncertain input.
+    struct DistributionRow
+    {
+        QComboBox* typeCombo{nullptr};
+        std::array<QLineEdit*, 3> parameterEdits{};
+    };
+
     void setup_ui();
     void apply_styling();
-    void populate_mannings_materials();
+    void configure_material_combo(QComboBox* combo);
+    void populate_mannings_materials(QComboBox* combo);
+    void add_material(QComboBox* combo, const QString& name, double manningsN, double minimumN, double maximumN);
     void on_material_selected(int index);
+    void on_bank_material_selected(int index);
+    void on_composite_lining_toggled(bool isChecked);
+    DistributionRow create_distribution_row(QFormLayout* layout, const QString& label);
+    void update_distribution_row(const DistributionRow& row);
+    Distribution read_distribution_row(const DistributionRow& row) const;
+    void clear_distribution_row(const DistributionRow& row);
 
     QLineEdit* dischargeEdit_;
     QComboBox* manningsMaterialCombo_;
+    QLabel* manningsNLabel_;
     QLineEdit* manningsNEdit_;
+    QGroupBox* compositeGroup_;
+    QComboBox* bankMaterialCombo_;
+    QLineEdit* bankManningsNEdit_;
+    QComboBox* roughnessMethodCombo_;
+    QGroupBox* uncertaintyGroup_;
+    DistributionRow manningsNDistribution_;
+    DistributionRow dischargeDistribution_;
+    DistributionRow bedSlopeDistribution_;
     QFormLayout* formLayout_;
 };
 
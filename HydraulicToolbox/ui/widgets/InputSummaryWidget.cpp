@@ -300,15 +300,15 @@ void InputSummaryWidget::update_geometry_section(const GeometryData& data)
         }
     };
 
-    add_field("Channel Type", data.channelType);
+    add_field("Channel Type", get_channel_type_name(data.channelType));
 
-    if(data.channelType == "Rectangular" || data.channelType == "Trapezoidal")
+    if(data.channelType == ChannelType::Rectangular || data.channelType == ChannelType::Trapezoidal)
     {
         if(data.bottomWidth > 0.0)
             add_field("Bottom Width", format_with_units(data.bottomWidth, lengthUnit));
     }
 
-    if(data.channelType == "Trapezoidal" || data.channelType == "Triangular")
+    if(data.channelType == ChannelType::Trapezoidal || data.channelType == ChannelType::Triangular)
     {
         if(data.sideSlope > 0.0)
             add_field("Side Slope (H:V)", QString::number(data.sideSlope, 'g'));
@@ -357,7 +357,13 @@ void InputSummaryWidget::update_hydraulic_section(const HydraulicData& data)
         add_field("Discharge", format_with_units(data.discharge, dischargeUnit));
 
     if(data.manningN > 0.0)
-        add_field("Manning's n", QString::number(data.manningN, 'g'));
+        add_field(data.bankManningN > 0.0 ? "Bed Manning's n" : "Manning's n", QString::number(data.manningN, 'g'));
+
+    if(data.bankManningN > 0.0)
+    {
+        add_field("Bank Manning's n", QString::number(data.bankManningN, 'g'));
+        add_field("Composite n Method", get_composite_roughness_method_name(data.roughnessMethod));
+    }
 
     hydraulicSection_->set_content_widget(content);
 }
@@ -386,7 +392,7 @@ bool InputSummaryWidget::has_any_data() const
     const HydraulicData& hydraulicData = controller_->get_hydraulic_data();
 
     return !projectData.projectName.isEmpty() ||
-           !geometryData.channelType.isEmpty() ||
+           geometryData.channelType != ChannelType::None ||
            hydraulicData.discharge > 0.0;
 }
 